@@ -0,0 +1,10 @@
+
+// Automatically generated. Do not edit.
+
+#ifndef CONFIG_YTIL_CON_ART_CFG_H_INCLUDED
+#define CONFIG_YTIL_CON_ART_CFG_H_INCLUDED
+
+// Keep a key list in ART nodes with 33-64 children and search it with AVX-512BW or AVX2 instead of keeping a 256 byte key index. Ignored on targets without AVX2.
+#define ART_NODE64_SIMD
+
+#endif
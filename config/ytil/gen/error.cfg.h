@@ -0,0 +1,10 @@
+
+// Automatically generated. Do not edit.
+
+#ifndef CONFIG_YTIL_GEN_ERROR_CFG_H_INCLUDED
+#define CONFIG_YTIL_GEN_ERROR_CFG_H_INCLUDED
+
+// Maximum number of error stack entries.
+#define ERROR_STACK_SIZE 20
+
+#endif
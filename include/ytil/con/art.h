@@ -38,6 +38,9 @@ typedef enum art_error
     E_ART_CALLBACK,     ///< callback error
     E_ART_EMPTY,        ///< ART is empty
     E_ART_EXISTS,       ///< node already exists
+    E_ART_FILE,         ///< file error
+    E_ART_FROZEN,       ///< ART is frozen
+    E_ART_IMAGE,        ///< invalid ART image
     E_ART_INVALID_KEY,  ///< invalid key
     E_ART_NOT_FOUND,    ///< node not found
 } art_error_id;
@@ -54,14 +57,41 @@ ERROR_DECLARE(ART);
 /// For these cases the sort mode specifies whether to keep them sorted or not.
 /// Keeping them unsorted will result in faster insert and remove operations
 /// but will also affect the fold order.
+///
+/// The optimistic mode may be or'ed to either sort mode.
+/// Lookups then compare only node paths stored inline in the node
+/// and skip the heap allocated remainder of long paths.
+/// The full key is stored once more with each leaf and verified there.
+/// This trades leaf memory for fewer cache misses on trees with long paths.
+///
+/// The slab mode may be or'ed to either sort mode.
+/// Nodes are then carved out of per-type slabs and recycled via free lists
+/// instead of being allocated separately. Slabs are only released
+/// on art_clear() and art_free(), which skip traversing the nodes
+/// if there are no node data destructors and no heap allocated paths.
+///
+/// The concurrent mode may be or'ed to either sort mode and implies
+/// the optimistic mode. art_get(), art_get_data() and the art_find() family
+/// may then be called from any number of threads without locking,
+/// concurrently to one modifying thread at a time. Modifying functions
+/// and art_fold(), art_complete() and art_memsize() are serialized by a lock.
+/// Readers validate per-node versions and restart on concurrent modification.
+/// Removed nodes are freed only after all readers which might access them
+/// have finished. Nodes returned by readers may nonetheless be removed
+/// concurrently, use art_get_data() or art_find_data() to read node data safely.
+/// Callbacks must not modify the ART.
 typedef enum art_mode
 {
-    ART_MODE_ORDERED,   ///< nodes are inserted in ascending order
-    ART_MODE_UNORDERED, ///< nodes are appended
+    ART_MODE_ORDERED    = 0,    ///< nodes are inserted in ascending order
+    ART_MODE_UNORDERED  = 1,    ///< nodes are appended
+    ART_MODE_OPTIMISTIC = 2,    ///< skip long node paths on lookup, verify key at leaf
+    ART_MODE_SLAB       = 4,    ///< allocate nodes from per-type slabs
+    ART_MODE_CONCURRENT = 8,    ///< lock-free readers concurrent to a single writer
 } art_mode_id;
 
 struct art;
 struct art_node;
+struct art_iter;
 
 typedef       struct art    *art_ct;        ///< ART type
 typedef const struct art    *art_const_ct;  ///< const ART type
@@ -69,6 +99,38 @@ typedef const struct art    *art_const_ct;  ///< const ART type
 typedef       struct art_node   *art_node_ct;       ///< ART node type
 typedef const struct art_node   *art_node_const_ct; ///< const ART node type
 
+typedef       struct art_iter   *art_iter_ct;       ///< ART iterator type
+typedef const struct art_iter   *art_iter_const_ct; ///< const ART iterator type
+
+#define ART_STATS_DEPTH 32  ///< size of art_stats_st depth histogram
+
+/// ART stats node type
+typedef enum art_stats_node
+{
+    ART_STATS_LEAF,     ///< leaf nodes
+    ART_STATS_NODE4,    ///< inner nodes with 0-4 children
+    ART_STATS_NODE8,    ///< inner nodes with 5-8 children
+    ART_STATS_NODE16,   ///< inner nodes with 9-16 children
+    ART_STATS_NODE32,   ///< inner nodes with 17-32 children
+    ART_STATS_NODE64,   ///< inner nodes with 33-64 children
+    ART_STATS_NODE128,  ///< inner nodes with 65-128 children
+    ART_STATS_NODE256,  ///< inner nodes with 129-256 children
+    ART_STATS_TYPES,    ///< number of node types
+} art_stats_node_id;
+
+/// ART stats
+typedef struct art_stats
+{
+    size_t  nodes[ART_STATS_TYPES];     ///< number of nodes per type
+    size_t  memsize[ART_STATS_TYPES];   ///< allocated node size per type, without heap paths and keys
+    double  fill[ART_STATS_TYPES];      ///< average fill factor of inner node types
+    size_t  path_bytes;                 ///< total length of node paths
+    size_t  path_heap;                  ///< number of node paths stored on the heap
+    size_t  depth[ART_STATS_DEPTH];     ///< number of leaves per depth, last bucket collects deeper leaves
+    size_t  depth_max;                  ///< max leaf depth
+    double  depth_avg;                  ///< average leaf depth, number of inner nodes visited by lookup
+} art_stats_st;
+
 /// ART node size callback
 ///
 /// \param art      ART
@@ -111,12 +173,34 @@ typedef int (*art_fold_cb)(art_const_ct art, str_const_ct key, void *data, void
 
 /// Create new ART.
 ///
-/// \param mode     sort mode
+/// \param mode     sort mode, may be or'ed with ART_MODE_OPTIMISTIC, ART_MODE_SLAB
+///                 and ART_MODE_CONCURRENT
 ///
 /// \returns                    new ART
 /// \retval NULL/E_GENERIC_OOM  out of memory
 art_ct art_new(art_mode_id mode);
 
+/// Open frozen ART image written by art_freeze().
+///
+/// The image is mapped read-only and shared with all other processes
+/// mapping the same file. Nodes are served straight from the mapping,
+/// opening takes constant time independent of the ART size.
+///
+/// A frozen ART supports art_get(), art_get_data(), the art_find() family,
+/// the art_fold() family and art_complete(). Children are visited
+/// in ascending key order. Modifying functions and art_iter_new()
+/// fail with E_ART_FROZEN, art_remove() and art_node_set() must not be used.
+/// art_clear() unmaps the image and leaves an empty, modifiable ART.
+///
+/// \param file     image file
+///
+/// \returns                        frozen ART
+/// \retval NULL/E_ART_FILE         failed to open \p file
+/// \retval NULL/E_ART_IMAGE        \p file is no ART image of this platform
+/// \retval NULL/E_GENERIC_SYSTEM   failed to map \p file
+/// \retval NULL/E_GENERIC_OOM      out of memory
+art_ct art_open_mmap(str_const_ct file);
+
 /// Free ART.
 ///
 /// \param art      ART
@@ -190,6 +274,17 @@ size_t art_memsize(art_const_ct art);
 /// \returns        allocated size in bytes
 size_t art_memsize_f(art_const_ct art, art_size_cb size, const void *ctx);
 
+/// Get node statistics of ART.
+///
+/// Counts nodes per type, their fill factor, path lengths and leaf depths.
+///
+/// \param art      ART
+/// \param stats    stats to fill
+///
+/// \retval 0                   success
+/// \retval -1/E_ART_FROZEN     ART is frozen
+int art_stats(art_const_ct art, art_stats_st *stats);
+
 /// Reconstruct node key.
 ///
 /// \param node     node to reconstruct key for
@@ -264,6 +359,21 @@ void *art_get_data(art_const_ct art, str_const_ct key);
 #define art_get_value(art, key, type) \
     POINTER_TO_VALUE(art_get_data(art, key), type)
 
+/// Get multiple nodes.
+///
+/// The keys are walked down the ART interleaved, one level at a time,
+/// prefetching the next node of each key while the others are processed.
+/// This hides memory latency on trees exceeding the cache.
+/// In concurrent mode and for frozen ARTs the keys are looked up one by one.
+///
+/// \param art          ART
+/// \param keys         node keys
+/// \param n            number of keys
+/// \param[out] nodes   nodes, NULL for keys not found
+///
+/// \returns            number of nodes found
+size_t art_get_batch(art_const_ct art, const str_const_ct *keys, size_t n, art_node_ct *nodes);
+
 /// Set or insert node.
 ///
 /// \param art      ART
@@ -272,6 +382,7 @@ void *art_get_data(art_const_ct art, str_const_ct key);
 ///
 /// \returns                        new node
 /// \retval NULL/E_ART_INVALID_KEY  invalid node key
+/// \retval NULL/E_ART_FROZEN       ART is frozen
 /// \retval NULL/E_GENERIC_OOM      out of memory
 art_node_ct art_set(art_ct art, str_const_ct key, const void *data);
 
@@ -297,6 +408,7 @@ art_node_ct art_set(art_ct art, str_const_ct key, const void *data);
 /// \returns                        new node
 /// \retval NULL/E_ART_INVALID_KEY  invalid node key
 /// \retval NULL/E_ART_EXISTS       node with \p key already existing
+/// \retval NULL/E_ART_FROZEN       ART is frozen
 /// \retval NULL/E_GENERIC_OOM      out of memory
 art_node_ct art_insert(art_ct art, str_const_ct key, const void *data);
 
@@ -313,6 +425,27 @@ art_node_ct art_insert(art_ct art, str_const_ct key, const void *data);
 #define art_insert_value(art, key, value) \
     art_insert(art, key, VALUE_TO_POINTER(value))
 
+/// Insert many nodes at once.
+///
+/// If the ART is empty, the keys are sorted if necessary
+/// and the tree is built in a single pass with each node
+/// created at its final type. On error the ART is left empty.
+///
+/// If the ART is not empty, the keys are inserted one after another.
+/// On error the keys inserted so far are kept.
+///
+/// \param art      ART
+/// \param keys     node keys
+/// \param values   data to set nodes with, may be NULL
+/// \param n        number of keys
+///
+/// \retval 0                       success
+/// \retval -1/E_ART_INVALID_KEY    invalid node key
+/// \retval -1/E_ART_EXISTS         duplicate key or node with key already existing
+/// \retval -1/E_ART_FROZEN         ART is frozen
+/// \retval -1/E_GENERIC_OOM        out of memory
+int art_bulk_load(art_ct art, const str_ct *keys, const void *const *values, size_t n);
+
 /// Remove node.
 ///
 /// \param art      ART
@@ -325,6 +458,7 @@ void art_remove(art_ct art, art_node_ct node);
 /// \param prefix   prefix of nodes to remove, may be NULL
 ///
 /// \retval 0                   success
+/// \retval -1/E_ART_FROZEN     ART is frozen
 /// \retval -1/E_ART_NOT_FOUND  \p prefix not found
 int art_remove_p(art_ct art, str_const_ct prefix);
 
@@ -336,6 +470,7 @@ int art_remove_p(art_ct art, str_const_ct prefix);
 /// \param ctx      \p dtor context
 ///
 /// \retval 0                   success
+/// \retval -1/E_ART_FROZEN     ART is frozen
 /// \retval -1/E_ART_NOT_FOUND  \p prefix not found
 int art_remove_pf(art_ct art, str_const_ct prefix, art_dtor_cb dtor, const void *ctx);
 
@@ -824,5 +959,88 @@ int art_fold_prk(art_ct art, str_const_ct prefix, art_fold_cb fold, const void *
 /// \retval NULL/E_GENERIC_OOM      out of memory
 str_ct art_complete(art_const_ct art, str_const_ct prefix);
 
+/// Write position independent image of ART to file.
+///
+/// Nodes are packed to their actual number of children and linked
+/// by offsets relative to the image start. Node data is stored as is,
+/// pointers will not be valid in other processes, only use values
+/// or offsets into other shared memory.
+/// The image uses the byte order and word size of the writing platform.
+///
+/// \param art      ART
+/// \param file     image file to create or truncate
+///
+/// \retval 0                       success
+/// \retval -1/E_ART_FILE           failed to open \p file
+/// \retval -1/E_GENERIC_SYSTEM     failed to write \p file
+/// \retval -1/E_GENERIC_OOM        out of memory
+int art_freeze(art_const_ct art, str_const_ct file);
+
+/// Create new ART iterator over key range.
+///
+/// The iterator visits leaf nodes in ascending key order,
+/// independent of the sort mode. It keeps the path to the current node
+/// on an explicit stack, moving to the next or previous node does not
+/// start over from the root.
+///
+/// Modifying the ART invalidates the iterator, except for art_node_set().
+/// In concurrent mode iterators must not be used concurrently to modifications.
+///
+/// \param art      ART
+/// \param lo       smallest key to visit, may be NULL
+/// \param hi       key to stop before, may be NULL
+///
+/// \returns                    new ART iterator
+/// \retval NULL/E_ART_FROZEN   ART is frozen
+/// \retval NULL/E_GENERIC_OOM  out of memory
+art_iter_ct art_iter_new(art_const_ct art, str_const_ct lo, str_const_ct hi);
+
+/// Free ART iterator.
+///
+/// \param iter     iterator
+void art_iter_free(art_iter_ct iter);
+
+/// Move iterator to first node with key not less than key.
+///
+/// \param iter     iterator
+/// \param key      key to seek, if NULL or less than lower range bound seek lower bound
+///
+/// \returns                        ART leaf node
+/// \retval NULL/E_ART_NOT_FOUND    no node in range
+/// \retval NULL/E_GENERIC_OOM      out of memory
+art_node_ct art_iter_seek(art_iter_ct iter, str_const_ct key);
+
+/// Move iterator to next node.
+///
+/// If the iterator is not positioned, move to the first node in range.
+/// If no node is left in range, the iterator is no longer positioned.
+///
+/// \param iter     iterator
+///
+/// \returns                        ART leaf node
+/// \retval NULL/E_ART_NOT_FOUND    no node left in range
+/// \retval NULL/E_GENERIC_OOM      out of memory
+art_node_ct art_iter_next(art_iter_ct iter);
+
+/// Move iterator to previous node.
+///
+/// If the iterator is not positioned, move to the last node in range.
+/// If no node is left in range, the iterator is no longer positioned.
+///
+/// \param iter     iterator
+///
+/// \returns                        ART leaf node
+/// \retval NULL/E_ART_NOT_FOUND    no node left in range
+/// \retval NULL/E_GENERIC_OOM      out of memory
+art_node_ct art_iter_prev(art_iter_ct iter);
+
+/// Get key of current iterator node.
+///
+/// \param iter     iterator
+///
+/// \returns                        key of current node, valid until iterator is moved
+/// \retval NULL/E_ART_NOT_FOUND    iterator is not positioned
+str_const_ct art_iter_key(art_iter_const_ct iter);
+
 
 #endif // ifndef YTIL_CON_ART_H_INCLUDED
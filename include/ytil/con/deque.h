@@ -0,0 +1,462 @@
+/*
+ * Copyright (c) 2026 Martin Rödel a.k.a. Yomin Nimoy
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/// \file
+
+#ifndef YTIL_CON_DEQUE_H_INCLUDED
+#define YTIL_CON_DEQUE_H_INCLUDED
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <sys/types.h>
+#include <ytil/gen/error.h>
+
+
+/// deque error
+typedef enum deque_error
+{
+    E_DEQUE_CALLBACK,       ///< callback error
+    E_DEQUE_EMPTY,          ///< deque is empty
+    E_DEQUE_OUT_OF_BOUNDS,  ///< out of bounds element access
+} deque_error_id;
+
+/// deque error type declaration
+ERROR_DECLARE(DEQUE);
+
+
+struct deque;
+typedef       struct deque  *deque_ct;          ///< deque type
+typedef const struct deque  *deque_const_ct;    ///< const deque type
+
+/// deque element size callback
+///
+/// \param deque    deque
+/// \param elem     element to get size of
+/// \param ctx      callback context
+///
+/// \returns        size of element
+typedef size_t (*deque_size_cb)(deque_const_ct deque, const void *elem, void *ctx);
+
+/// deque element dtor callback
+///
+/// \param deque    deque
+/// \param elem     element to destroy
+/// \param ctx      callback context
+typedef void (*deque_dtor_cb)(deque_const_ct deque, void *elem, void *ctx);
+
+/// deque element fold callback
+///
+/// \param deque    deque
+/// \param index    element index
+/// \param elem     element
+/// \param ctx      callback context
+///
+/// \retval 0       continue fold
+/// \retval <0      stop fold with error
+/// \retval >0      stop fold
+typedef int (*deque_fold_cb)(deque_const_ct deque, size_t index, void *elem, void *ctx);
+
+
+/// Create new deque.
+///
+/// The elements are stored in fixed size chunks referenced by a chunk table.
+/// Pushing and popping at both ends takes amortized constant time
+/// and does not move other elements. Elements are accessed in constant time
+/// as long as only the ends are modified. Inserting or removing elements
+/// in the middle moves at most one chunk and marks the deque as sparse,
+/// which makes element access linear in the number of chunks
+/// until the deque is emptied.
+///
+/// \param elemsize     size of element
+///
+/// \returns                    new deque
+/// \retval NULL/E_GENERIC_OOM  out of memory
+deque_ct deque_new(size_t elemsize);
+
+/// Create new deque with specific chunk size.
+///
+/// Middle inserts and removes take O(chunksize + size / chunksize),
+/// a chunk size near the square root of the expected size minimizes it.
+///
+/// \param chunksize    number of elements per chunk, rounded up to power of 2
+/// \param elemsize     size of element
+///
+/// \returns                    new deque
+/// \retval NULL/E_GENERIC_OOM  out of memory
+deque_ct deque_new_c(size_t chunksize, size_t elemsize);
+
+/// Free deque.
+///
+/// \param deque    deque
+void deque_free(deque_ct deque);
+
+/// Destroy elements and free deque.
+///
+/// \param deque    deque
+/// \param dtor     callback to destroy element, may be NULL
+/// \param ctx      \p dtor context
+void deque_free_f(deque_ct deque, deque_dtor_cb dtor, const void *ctx);
+
+/// Remove all elements.
+///
+/// \param deque    deque
+void deque_clear(deque_ct deque);
+
+/// Destroy and remove all elements.
+///
+/// \param deque    deque
+/// \param dtor     callback to destroy element, may be NULL
+/// \param ctx      \p dtor context
+void deque_clear_f(deque_ct deque, deque_dtor_cb dtor, const void *ctx);
+
+/// Check if deque is empty.
+///
+/// \param deque    deque
+///
+/// \retval true    deque is empty
+/// \retval false   deque is not empty
+bool deque_is_empty(deque_const_ct deque);
+
+/// Get number of elements.
+///
+/// \param deque    deque
+///
+/// \returns        number of elements
+size_t deque_size(deque_const_ct deque);
+
+/// Get element size.
+///
+/// \param deque    deque
+///
+/// \returns        element size
+size_t deque_elemsize(deque_const_ct deque);
+
+/// Get number of elements per chunk.
+///
+/// \param deque    deque
+///
+/// \returns        number of elements per chunk
+size_t deque_chunksize(deque_const_ct deque);
+
+/// Get allocated memory size.
+///
+/// \param deque    deque
+///
+/// \returns        allocated memory size
+size_t deque_memsize(deque_const_ct deque);
+
+/// Get allocated memory size.
+///
+/// \param deque    deque
+/// \param size     callback to get element size, may be NULL
+/// \param ctx      \p size context
+///
+/// \returns        allocated memory size
+size_t deque_memsize_f(deque_const_ct deque, deque_size_cb size, const void *ctx);
+
+/// Get pointer to deque element at position.
+///
+/// \param deque    deque
+/// \param pos      position of element, negative value counts from last element
+///
+/// \returns                            pointer to element
+/// \retval NULL/E_DEQUE_OUT_OF_BOUNDS  \p pos is out of bounds
+void *deque_at(deque_const_ct deque, ssize_t pos);
+
+/// Get deque element casted to pointer at position.
+///
+/// \note Deque element size must be equal to sizeof(void*).
+/// \note To distinguish a stored NULL pointer from an error,
+///       call error_clear() before calling this function
+///       and evaluate e.g. error_depth() afterwards.
+///
+/// \param deque    deque
+/// \param pos      position of element, negative value counts from last element
+///
+/// \returns                            element casted to pointer
+/// \retval NULL/E_DEQUE_OUT_OF_BOUNDS  \p pos is out of bounds
+void *deque_at_p(deque_const_ct deque, ssize_t pos);
+
+/// Get pointer to first deque element.
+///
+/// \param deque    deque
+///
+/// \returns                    pointer to element
+/// \retval NULL/E_DEQUE_EMPTY  deque is empty
+void *deque_first(deque_const_ct deque);
+
+/// Get pointer to last deque element.
+///
+/// \param deque    deque
+///
+/// \returns                    pointer to element
+/// \retval NULL/E_DEQUE_EMPTY  deque is empty
+void *deque_last(deque_const_ct deque);
+
+/// Get element from deque.
+///
+/// \param      deque   deque
+/// \param[out] dst     element to fill, may be NULL
+/// \param      pos     position of element, negative value counts from last element
+///
+/// \retval 0                           success
+/// \retval -1/E_DEQUE_OUT_OF_BOUNDS    \p pos is out of bounds
+int deque_get(deque_const_ct deque, void *dst, ssize_t pos);
+
+/// Push empty element onto end of deque.
+///
+/// \param deque    deque
+///
+/// \returns                    pointer to new element
+/// \retval NULL/E_GENERIC_OOM  out of memory
+void *deque_push(deque_ct deque);
+
+/// Push element onto end of deque.
+///
+/// \param deque    deque
+/// \param elem     pointer to element, may be NULL
+///
+/// \returns                    pointer to new element
+/// \retval NULL/E_GENERIC_OOM  out of memory
+void *deque_push_e(deque_ct deque, const void *elem);
+
+/// Push pointer onto end of deque.
+///
+/// \note Deque element size must be equal to sizeof(void*).
+///
+/// \param deque    deque
+/// \param ptr      pointer to push
+///
+/// \returns                    pointer to new element
+/// \retval NULL/E_GENERIC_OOM  out of memory
+void *deque_push_p(deque_ct deque, const void *ptr);
+
+/// Push empty element onto front of deque.
+///
+/// \param deque    deque
+///
+/// \returns                    pointer to new element
+/// \retval NULL/E_GENERIC_OOM  out of memory
+void *deque_push_front(deque_ct deque);
+
+/// Push element onto front of deque.
+///
+/// \param deque    deque
+/// \param elem     pointer to element, may be NULL
+///
+/// \returns                    pointer to new element
+/// \retval NULL/E_GENERIC_OOM  out of memory
+void *deque_push_front_e(deque_ct deque, const void *elem);
+
+/// Push pointer onto front of deque.
+///
+/// \note Deque element size must be equal to sizeof(void*).
+///
+/// \param deque    deque
+/// \param ptr      pointer to push
+///
+/// \returns                    pointer to new element
+/// \retval NULL/E_GENERIC_OOM  out of memory
+void *deque_push_front_p(deque_ct deque, const void *ptr);
+
+/// Insert empty element at position.
+///
+/// \param deque    deque
+/// \param pos      position to insert at, negative value counts from last element
+///
+/// \returns                            pointer to new element
+/// \retval NULL/E_DEQUE_OUT_OF_BOUNDS  \p pos is out of bounds
+/// \retval NULL/E_GENERIC_OOM          out of memory
+void *deque_insert(deque_ct deque, ssize_t pos);
+
+/// Insert element at position.
+///
+/// \param deque    deque
+/// \param pos      position to insert at, negative value counts from last element
+/// \param elem     pointer to element, may be NULL
+///
+/// \returns                            pointer to new element
+/// \retval NULL/E_DEQUE_OUT_OF_BOUNDS  \p pos is out of bounds
+/// \retval NULL/E_GENERIC_OOM          out of memory
+void *deque_insert_e(deque_ct deque, ssize_t pos, const void *elem);
+
+/// Insert pointer at position.
+///
+/// \note Deque element size must be equal to sizeof(void*).
+///
+/// \param deque    deque
+/// \param pos      position to insert at, negative value counts from last element
+/// \param ptr      pointer to insert
+///
+/// \returns                            pointer to new element
+/// \retval NULL/E_DEQUE_OUT_OF_BOUNDS  \p pos is out of bounds
+/// \retval NULL/E_GENERIC_OOM          out of memory
+void *deque_insert_p(deque_ct deque, ssize_t pos, const void *ptr);
+
+/// Remove last element.
+///
+/// \param deque    deque
+///
+/// \retval 0                   success
+/// \retval -1/E_DEQUE_EMPTY    deque is empty
+int deque_pop(deque_ct deque);
+
+/// Get and remove last element.
+///
+/// \param      deque   deque
+/// \param[out] dst     pointer to element to fill, may be NULL
+///
+/// \retval 0                   success
+/// \retval -1/E_DEQUE_EMPTY    deque is empty
+int deque_pop_e(deque_ct deque, void *dst);
+
+/// Remove and return last element casted to pointer.
+///
+/// \note Deque element size must be equal to sizeof(void*).
+/// \note To distinguish a stored NULL pointer from an error,
+///       call error_clear() before calling this function
+///       and evaluate e.g. error_depth() afterwards.
+///
+/// \param deque    deque
+///
+/// \returns                    element casted to pointer
+/// \retval NULL/E_DEQUE_EMPTY  deque is empty
+void *deque_pop_p(deque_ct deque);
+
+/// Destroy and remove last element.
+///
+/// \param deque    deque
+/// \param dtor     callback to destroy element, may be NULL
+/// \param ctx      \p dtor context
+///
+/// \retval 0                   success
+/// \retval -1/E_DEQUE_EMPTY    deque is empty
+int deque_pop_f(deque_ct deque, deque_dtor_cb dtor, const void *ctx);
+
+/// Remove first element.
+///
+/// \param deque    deque
+///
+/// \retval 0                   success
+/// \retval -1/E_DEQUE_EMPTY    deque is empty
+int deque_pop_front(deque_ct deque);
+
+/// Get and remove first element.
+///
+/// \param      deque   deque
+/// \param[out] dst     pointer to element to fill, may be NULL
+///
+/// \retval 0                   success
+/// \retval -1/E_DEQUE_EMPTY    deque is empty
+int deque_pop_front_e(deque_ct deque, void *dst);
+
+/// Remove and return first element casted to pointer.
+///
+/// \note Deque element size must be equal to sizeof(void*).
+/// \note To distinguish a stored NULL pointer from an error,
+///       call error_clear() before calling this function
+///       and evaluate e.g. error_depth() afterwards.
+///
+/// \param deque    deque
+///
+/// \returns                    element casted to pointer
+/// \retval NULL/E_DEQUE_EMPTY  deque is empty
+void *deque_pop_front_p(deque_ct deque);
+
+/// Destroy and remove first element.
+///
+/// \param deque    deque
+/// \param dtor     callback to destroy element, may be NULL
+/// \param ctx      \p dtor context
+///
+/// \retval 0                   success
+/// \retval -1/E_DEQUE_EMPTY    deque is empty
+int deque_pop_front_f(deque_ct deque, deque_dtor_cb dtor, const void *ctx);
+
+/// Remove element at position.
+///
+/// \param deque    deque
+/// \param pos      position of element, negative value counts from last element
+///
+/// \retval 0                           success
+/// \retval -1/E_DEQUE_OUT_OF_BOUNDS    \p pos is out of bounds
+int deque_remove_at(deque_ct deque, ssize_t pos);
+
+/// Get and remove element at position.
+///
+/// \param      deque   deque
+/// \param[out] dst     pointer to element to fill, may be NULL
+/// \param      pos     position of element, negative value counts from last element
+///
+/// \retval 0                           success
+/// \retval -1/E_DEQUE_OUT_OF_BOUNDS    \p pos is out of bounds
+int deque_remove_at_e(deque_ct deque, void *dst, ssize_t pos);
+
+/// Remove and return element casted to pointer at position.
+///
+/// \note Deque element size must be equal to sizeof(void*).
+/// \note To distinguish a stored NULL pointer from an error,
+///       call error_clear() before calling this function
+///       and evaluate e.g. error_depth() afterwards.
+///
+/// \param deque    deque
+/// \param pos      position of element, negative value counts from last element
+///
+/// \returns                            element casted to pointer
+/// \retval NULL/E_DEQUE_OUT_OF_BOUNDS  \p pos is out of bounds
+void *deque_remove_at_p(deque_ct deque, ssize_t pos);
+
+/// Destroy and remove element at position.
+///
+/// \param deque    deque
+/// \param pos      position of element, negative value counts from last element
+/// \param dtor     callback to destroy element, may be NULL
+/// \param ctx      \p dtor context
+///
+/// \retval 0                           success
+/// \retval -1/E_DEQUE_OUT_OF_BOUNDS    \p pos is out of bounds
+int deque_remove_at_f(deque_ct deque, ssize_t pos, deque_dtor_cb dtor, const void *ctx);
+
+/// Fold over all elements, starting with first element.
+///
+/// \param deque    deque
+/// \param fold     callback to invoke on each element
+/// \param ctx      \p fold context
+///
+/// \retval 0                   success
+/// \retval <0/E_DEQUE_CALLBACK \p fold error
+/// \retval >0                  \p fold rc
+int deque_fold(deque_const_ct deque, deque_fold_cb fold, const void *ctx);
+
+/// Fold over all elements, starting with last element.
+///
+/// \param deque    deque
+/// \param fold     callback to invoke on each element
+/// \param ctx      \p fold context
+///
+/// \retval 0                   success
+/// \retval <0/E_DEQUE_CALLBACK \p fold error
+/// \retval >0                  \p fold rc
+int deque_fold_r(deque_const_ct deque, deque_fold_cb fold, const void *ctx);
+
+
+#endif
@@ -54,6 +54,18 @@ typedef const struct list   *list_const_ct; ///< const list type
 typedef       struct list_node  *list_node_ct;          ///< list node type
 typedef const struct list_node  *list_node_const_ct;    ///< const list node type
 
+/// intrusive list link
+///
+/// Embed a link into a struct to chain it into an intrusive list
+/// without allocating nodes. The list head is a link itself,
+/// initialized with list_link_init(). Use list_link_entry()
+/// to get the containing struct of a link.
+typedef struct list_link
+{
+    struct list_link    *prev;  ///< previous link
+    struct list_link    *next;  ///< next link
+} list_link_st;
+
 /// list node size callback
 ///
 /// \param list     list
@@ -114,6 +126,27 @@ list_ct list_new(void);
 /// \param list     list
 void list_free(list_ct list);
 
+/// Set maximum number of released nodes to pool.
+///
+/// Nodes of removed data are kept in a per list pool up to \p max nodes
+/// and reused for new data instead of allocating new nodes.
+/// Surplus pooled nodes are freed.
+///
+/// \param list     list
+/// \param max      maximum number of nodes to pool, 0 disables pooling
+void list_set_pool(list_ct list, size_t max);
+
+/// Allocate nodes into pool in advance.
+///
+/// The maximum pool size is raised to \p n if smaller.
+///
+/// \param list     list
+/// \param n        number of nodes the pool shall hold
+///
+/// \retval 0                   success
+/// \retval -1/E_GENERIC_OOM    out of memory
+int list_reserve(list_ct list, size_t n);
+
 /// Destroy nodes and free list.
 ///
 /// \param list     list
@@ -586,6 +619,37 @@ size_t list_find_remove_all_f(list_ct list, list_pred_cb pred, const void *pred_
 /// \param node2    second node
 void list_swap(list_node_const_ct node1, list_node_const_ct node2);
 
+/// Move node before another node.
+///
+/// The node is relinked without reallocation and may be moved
+/// between different lists.
+///
+/// \param dst      destination list
+/// \param suc      node in \p dst to move before, if NULL append to \p dst
+/// \param src      source list
+/// \param node     node in \p src to move
+void list_move_before(list_ct dst, list_node_const_ct suc, list_ct src, list_node_ct node);
+
+/// Move node after another node.
+///
+/// The node is relinked without reallocation and may be moved
+/// between different lists.
+///
+/// \param dst      destination list
+/// \param pre      node in \p dst to move after, if NULL prepend to \p dst
+/// \param src      source list
+/// \param node     node in \p src to move
+void list_move_after(list_ct dst, list_node_const_ct pre, list_ct src, list_node_ct node);
+
+/// Move all nodes of list into another list.
+///
+/// The nodes are relinked in constant time, \p src is left empty.
+///
+/// \param dst      destination list
+/// \param pre      node in \p dst to insert after, if NULL prepend to \p dst
+/// \param src      source list, must not be \p dst
+void list_splice(list_ct dst, list_node_const_ct pre, list_ct src);
+
 /// Fold over all nodes in list, starting with first node.
 ///
 /// \param list     list
@@ -608,5 +672,92 @@ int list_fold(list_const_ct list, list_fold_cb fold, const void *ctx);
 /// \retval >0                  \p fold rc
 int list_fold_r(list_const_ct list, list_fold_cb fold, const void *ctx);
 
+/// Get struct containing intrusive list link.
+///
+/// \param link     list link
+/// \param type     type of containing struct
+/// \param member   name of link member in \p type
+///
+/// \returns        pointer to containing struct
+#define list_link_entry(link, type, member) \
+    ((type *)((char *)(link) - offsetof(type, member)))
+
+/// Iterate over intrusive list.
+///
+/// \param head     list head
+/// \param link     link variable to update
+#define list_link_foreach(head, link) \
+    for(link = (head)->next; link != (head); link = link->next)
+
+/// Iterate over intrusive list in reverse.
+///
+/// \param head     list head
+/// \param link     link variable to update
+#define list_link_foreach_r(head, link) \
+    for(link = (head)->prev; link != (head); link = link->prev)
+
+/// Initialize intrusive list head or unlinked link.
+///
+/// \param head     list head
+void list_link_init(list_link_st *head);
+
+/// Check if intrusive list is empty.
+///
+/// \param head     list head
+///
+/// \retval true    list is empty
+/// \retval false   list is not empty
+bool list_link_is_empty(const list_link_st *head);
+
+/// Check if link is part of an intrusive list.
+///
+/// \param link     initialized link
+///
+/// \retval true    link is linked
+/// \retval false   link is not linked
+bool list_link_is_linked(const list_link_st *link);
+
+/// Get number of links in intrusive list.
+///
+/// \param head     list head
+///
+/// \returns        number of links
+size_t list_link_size(const list_link_st *head);
+
+/// Insert link before other link.
+///
+/// \param suc      link to insert before, list head to append
+/// \param link     unlinked link to insert
+void list_link_insert_before(list_link_st *suc, list_link_st *link);
+
+/// Insert link after other link.
+///
+/// \param pre      link to insert after, list head to prepend
+/// \param link     unlinked link to insert
+void list_link_insert_after(list_link_st *pre, list_link_st *link);
+
+/// Remove link from its intrusive list.
+///
+/// The link is reinitialized unlinked.
+///
+/// \param link     linked link
+void list_link_remove(list_link_st *link);
+
+/// Move link before other link.
+///
+/// The links may be part of different lists.
+///
+/// \param suc      link to move before, list head to move to back
+/// \param link     linked link to move
+void list_link_move_before(list_link_st *suc, list_link_st *link);
+
+/// Move link after other link.
+///
+/// The links may be part of different lists.
+///
+/// \param pre      link to move after, list head to move to front
+/// \param link     linked link to move
+void list_link_move_after(list_link_st *pre, list_link_st *link);
+
 
 #endif // ifndef YTIL_CON_LIST_H_INCLUDED
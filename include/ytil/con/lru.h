@@ -0,0 +1,263 @@
+/*
+ * Copyright (c) 2026 Martin Rödel a.k.a. Yomin Nimoy
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/// \file
+
+#ifndef YTIL_CON_LRU_H_INCLUDED
+#define YTIL_CON_LRU_H_INCLUDED
+
+#include <ytil/def/cast.h>
+#include <ytil/gen/error.h>
+#include <ytil/gen/str.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+
+/// LRU error
+typedef enum lru_error
+{
+    E_LRU_INVALID_KEY,  ///< invalid key
+    E_LRU_NOT_FOUND,    ///< entry not found
+} lru_error_id;
+
+/// LRU error type declaration
+ERROR_DECLARE(LRU);
+
+struct lru;
+
+typedef       struct lru    *lru_ct;        ///< LRU type
+typedef const struct lru    *lru_const_ct;  ///< const LRU type
+
+/// LRU entry dtor callback
+///
+/// \param lru      LRU
+/// \param data     entry data to destroy
+/// \param ctx      callback context
+typedef void (*lru_dtor_cb)(lru_const_ct lru, void *data, void *ctx);
+
+
+/// Create new LRU cache.
+///
+/// Entries are indexed by an ART and chained into an intrusive list
+/// in order of use. Lookup, touch, insert and eviction take constant time
+/// with respect to the number of entries.
+///
+/// \param capacity     maximum number of entries, must not be 0
+///
+/// \returns                    new LRU cache
+/// \retval NULL/E_GENERIC_OOM  out of memory
+lru_ct lru_new(size_t capacity);
+
+/// Free LRU cache.
+///
+/// \param lru      LRU cache
+void lru_free(lru_ct lru);
+
+/// Destroy entries and free LRU cache.
+///
+/// \param lru      LRU cache
+/// \param dtor     callback to destroy entry data, may be NULL
+/// \param ctx      \p dtor context
+void lru_free_f(lru_ct lru, lru_dtor_cb dtor, const void *ctx);
+
+/// Remove all entries.
+///
+/// \param lru      LRU cache
+void lru_clear(lru_ct lru);
+
+/// Destroy and remove all entries.
+///
+/// \param lru      LRU cache
+/// \param dtor     callback to destroy entry data, may be NULL
+/// \param ctx      \p dtor context
+void lru_clear_f(lru_ct lru, lru_dtor_cb dtor, const void *ctx);
+
+/// Check if LRU cache is empty.
+///
+/// \param lru      LRU cache
+///
+/// \retval true    LRU cache is empty
+/// \retval false   LRU cache is not empty
+bool lru_is_empty(lru_const_ct lru);
+
+/// Get number of entries.
+///
+/// \param lru      LRU cache
+///
+/// \returns        number of entries
+size_t lru_size(lru_const_ct lru);
+
+/// Get maximum number of entries.
+///
+/// \param lru      LRU cache
+///
+/// \returns        maximum number of entries
+size_t lru_capacity(lru_const_ct lru);
+
+/// Get entry data and mark entry as most recently used.
+///
+/// \note To distinguish a stored NULL pointer from an error,
+///       call error_clear() before calling this function
+///       and evaluate e.g. error_depth() afterwards.
+///
+/// \param lru      LRU cache
+/// \param key      entry key
+///
+/// \returns                        entry data
+/// \retval NULL/E_LRU_NOT_FOUND    entry not found
+void *lru_get(lru_ct lru, str_const_ct key);
+
+/// Get entry value and mark entry as most recently used.
+///
+/// \param lru      LRU cache
+/// \param key      entry key
+/// \param type     type to cast data pointer to
+///
+/// \returns                        entry data pointer casted to \p type
+/// \retval NULL/E_LRU_NOT_FOUND    entry not found
+#define lru_get_value(lru, key, type) \
+    POINTER_TO_VALUE(lru_get(lru, key), type)
+
+/// Get entry data without changing the order of use.
+///
+/// \note To distinguish a stored NULL pointer from an error,
+///       call error_clear() before calling this function
+///       and evaluate e.g. error_depth() afterwards.
+///
+/// \param lru      LRU cache
+/// \param key      entry key
+///
+/// \returns                        entry data
+/// \retval NULL/E_LRU_NOT_FOUND    entry not found
+void *lru_peek(lru_const_ct lru, str_const_ct key);
+
+/// Get entry value without changing the order of use.
+///
+/// \param lru      LRU cache
+/// \param key      entry key
+/// \param type     type to cast data pointer to
+///
+/// \returns                        entry data pointer casted to \p type
+/// \retval NULL/E_LRU_NOT_FOUND    entry not found
+#define lru_peek_value(lru, key, type) \
+    POINTER_TO_VALUE(lru_peek(lru, key), type)
+
+/// Check if entry exists without changing the order of use.
+///
+/// \param lru      LRU cache
+/// \param key      entry key
+///
+/// \retval true    entry exists
+/// \retval false   entry does not exist
+bool lru_contains(lru_const_ct lru, str_const_ct key);
+
+/// Insert or replace entry and mark it as most recently used.
+///
+/// If the cache is full, the least recently used entry is evicted.
+///
+/// \param lru      LRU cache
+/// \param key      entry key
+/// \param data     entry data
+///
+/// \retval 0                       success
+/// \retval -1/E_LRU_INVALID_KEY    \p key is empty
+/// \retval -1/E_GENERIC_OOM        out of memory
+int lru_put(lru_ct lru, str_const_ct key, const void *data);
+
+/// Insert or replace entry with value and mark it as most recently used.
+///
+/// If the cache is full, the least recently used entry is evicted.
+///
+/// \param lru      LRU cache
+/// \param key      entry key
+/// \param value    entry value
+///
+/// \retval 0                       success
+/// \retval -1/E_LRU_INVALID_KEY    \p key is empty
+/// \retval -1/E_GENERIC_OOM        out of memory
+#define lru_put_value(lru, key, value) \
+    lru_put(lru, key, VALUE_TO_POINTER(value))
+
+/// Insert or replace entry and mark it as most recently used.
+///
+/// If the cache is full, the least recently used entry is evicted.
+/// The data of a replaced or evicted entry is destroyed.
+///
+/// \param lru      LRU cache
+/// \param key      entry key
+/// \param data     entry data
+/// \param dtor     callback to destroy replaced or evicted entry data, may be NULL
+/// \param ctx      \p dtor context
+///
+/// \retval 0                       success
+/// \retval -1/E_LRU_INVALID_KEY    \p key is empty
+/// \retval -1/E_GENERIC_OOM        out of memory
+int lru_put_f(lru_ct lru, str_const_ct key, const void *data, lru_dtor_cb dtor, const void *ctx);
+
+/// Remove entry.
+///
+/// \param lru      LRU cache
+/// \param key      entry key
+///
+/// \retval 0                   success
+/// \retval -1/E_LRU_NOT_FOUND  entry not found
+int lru_remove(lru_ct lru, str_const_ct key);
+
+/// Destroy and remove entry.
+///
+/// \param lru      LRU cache
+/// \param key      entry key
+/// \param dtor     callback to destroy entry data, may be NULL
+/// \param ctx      \p dtor context
+///
+/// \retval 0                   success
+/// \retval -1/E_LRU_NOT_FOUND  entry not found
+int lru_remove_f(lru_ct lru, str_const_ct key, lru_dtor_cb dtor, const void *ctx);
+
+/// Get data of least recently used entry.
+///
+/// \param lru      LRU cache
+///
+/// \returns                        entry data
+/// \retval NULL/E_LRU_NOT_FOUND    LRU cache is empty
+void *lru_oldest(lru_const_ct lru);
+
+/// Evict least recently used entry.
+///
+/// \param lru      LRU cache
+///
+/// \retval 0                   success
+/// \retval -1/E_LRU_NOT_FOUND  LRU cache is empty
+int lru_evict(lru_ct lru);
+
+/// Destroy and evict least recently used entry.
+///
+/// \param lru      LRU cache
+/// \param dtor     callback to destroy entry data, may be NULL
+/// \param ctx      \p dtor context
+///
+/// \retval 0                   success
+/// \retval -1/E_LRU_NOT_FOUND  LRU cache is empty
+int lru_evict_f(lru_ct lru, lru_dtor_cb dtor, const void *ctx);
+
+
+#endif
@@ -0,0 +1,336 @@
+/*
+ * Copyright (c) 2026 Martin Rödel a.k.a. Yomin Nimoy
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/// \file
+
+#ifndef YTIL_CON_MAP_H_INCLUDED
+#define YTIL_CON_MAP_H_INCLUDED
+
+#include <ytil/gen/error.h>
+#include <ytil/gen/str.h>
+#include <ytil/def/cast.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+
+/// map error
+typedef enum map_error
+{
+    E_MAP_CALLBACK,     ///< callback error
+    E_MAP_EXISTS,       ///< node already exists
+    E_MAP_NOT_FOUND,    ///< node not found
+} map_error_id;
+
+/// map error type declaration
+ERROR_DECLARE(MAP);
+
+struct map;
+struct map_node;
+
+typedef       struct map    *map_ct;        ///< map type
+typedef const struct map    *map_const_ct;  ///< const map type
+
+typedef       struct map_node   *map_node_ct;       ///< map node type
+typedef const struct map_node   *map_node_const_ct; ///< const map node type
+
+/// map node size callback
+///
+/// \param map      map
+/// \param data     node data to get size of
+/// \param ctx      callback context
+///
+/// \returns        size of node
+typedef size_t (*map_size_cb)(map_const_ct map, const void *data, void *ctx);
+
+/// map node dtor callback
+///
+/// \param map      map
+/// \param data     node data to destroy
+/// \param ctx      callback context
+typedef void (*map_dtor_cb)(map_const_ct map, void *data, void *ctx);
+
+/// map node fold callback
+///
+/// \param map      map
+/// \param key      node key
+/// \param data     node data
+/// \param ctx      callback context
+///
+/// \retval 0       continue fold
+/// \retval <0      stop fold with error
+/// \retval >0      stop fold
+typedef int (*map_fold_cb)(map_const_ct map, str_const_ct key, void *data, void *ctx);
+
+
+/// Create new map.
+///
+/// The map is an unordered open addressing hash table.
+/// Slots are organized in groups of 16, each slot having a control byte
+/// holding 7 bits of the key hash. A lookup compares the control bytes
+/// of a whole group at once and only compares keys of slots
+/// whose control byte matches.
+///
+/// Keys are hashed with str_hash(), so keys caching their hash,
+/// like interned strs, are not rehashed on each lookup.
+///
+/// Nodes are moved when the table grows, node pointers are invalidated
+/// by map_set(), map_insert() and map_reserve().
+///
+/// \returns                    new map
+/// \retval NULL/E_GENERIC_OOM  out of memory
+map_ct map_new(void);
+
+/// Free map.
+///
+/// \param map      map
+void map_free(map_ct map);
+
+/// Destroy nodes and free map.
+///
+/// \param map      map
+/// \param dtor     callback to destroy node data, may be NULL
+/// \param ctx      \p dtor context
+void map_free_f(map_ct map, map_dtor_cb dtor, const void *ctx);
+
+/// Free map if empty.
+///
+/// \param map      map
+///
+/// \retval map     map is not empty
+/// \retval NULL    map was empty and was freed
+map_ct map_free_if_empty(map_ct map);
+
+/// Remove all nodes.
+///
+/// \param map      map
+void map_clear(map_ct map);
+
+/// Destroy and remove all nodes.
+///
+/// \param map      map
+/// \param dtor     callback to destroy node data, may be NULL
+/// \param ctx      \p dtor context
+void map_clear_f(map_ct map, map_dtor_cb dtor, const void *ctx);
+
+/// Check if map is empty.
+///
+/// \param map      map
+///
+/// \retval true    map is empty
+/// \retval false   map is not empty
+bool map_is_empty(map_const_ct map);
+
+/// Get number of nodes.
+///
+/// \param map      map
+///
+/// \returns        number of nodes
+size_t map_size(map_const_ct map);
+
+/// Get number of slots.
+///
+/// \param map      map
+///
+/// \returns        number of slots
+size_t map_capacity(map_const_ct map);
+
+/// Get allocated memory size.
+///
+/// \param map      map
+///
+/// \returns        allocated memory size
+size_t map_memsize(map_const_ct map);
+
+/// Get allocated memory size.
+///
+/// \param map      map
+/// \param size     callback to get node data size, may be NULL
+/// \param ctx      \p size context
+///
+/// \returns        allocated memory size
+size_t map_memsize_f(map_const_ct map, map_size_cb size, const void *ctx);
+
+/// Reserve slots for nodes.
+///
+/// \param map      map
+/// \param n        number of nodes to hold without growing
+///
+/// \retval 0                   success
+/// \retval -1/E_GENERIC_OOM    out of memory
+int map_reserve(map_ct map, size_t n);
+
+/// Get node key.
+///
+/// \param node     node to get key from
+///
+/// \returns        node key
+str_const_ct map_node_key(map_node_const_ct node);
+
+/// Get node data.
+///
+/// \param node     node to get data from
+///
+/// \returns        node data
+void *map_node_data(map_node_const_ct node);
+
+/// Get node value.
+///
+/// \param node     node to get value from
+/// \param type     type to cast data pointer to
+///
+/// \returns        node data pointer casted to \p type
+#define map_node_value(node, type) \
+    POINTER_TO_VALUE(map_node_data(node), type)
+
+/// Set node data.
+///
+/// \param node     node to set
+/// \param data     data to set
+void map_node_set(map_node_ct node, const void *data);
+
+/// Set node value.
+///
+/// \param node     node to set
+/// \param value    value to set
+#define map_node_set_value(node, value) \
+    map_node_set(node, VALUE_TO_POINTER(value))
+
+/// Get node.
+///
+/// \param map      map
+/// \param key      node key
+///
+/// \returns                        node
+/// \retval NULL/E_MAP_NOT_FOUND    node not found
+map_node_ct map_get(map_const_ct map, str_const_ct key);
+
+/// Get node data.
+///
+/// \note To distinguish a stored NULL pointer from an error,
+///       call error_clear() before calling this function
+///       and evaluate e.g. error_depth() afterwards.
+///
+/// \param map      map
+/// \param key      node key
+///
+/// \returns                        node data
+/// \retval NULL/E_MAP_NOT_FOUND    node not found
+void *map_get_data(map_const_ct map, str_const_ct key);
+
+/// Get node value.
+///
+/// \note To distinguish a stored NULL pointer from an error,
+///       call error_clear() before calling this function
+///       and evaluate e.g. error_depth() afterwards.
+///
+/// \param map      map
+/// \param key      node key
+/// \param type     type to cast data pointer to
+///
+/// \returns                        node data pointer casted to \p type
+/// \retval NULL/E_MAP_NOT_FOUND    node not found
+#define map_get_value(map, key, type) \
+    POINTER_TO_VALUE(map_get_data(map, key), type)
+
+/// Set or insert node.
+///
+/// \param map      map
+/// \param key      node key
+/// \param data     data to set
+///
+/// \returns                    node
+/// \retval NULL/E_GENERIC_OOM  out of memory
+map_node_ct map_set(map_ct map, str_const_ct key, const void *data);
+
+/// Set or insert node with value.
+///
+/// \param map      map
+/// \param key      node key
+/// \param value    value to set
+///
+/// \returns                    node
+/// \retval NULL/E_GENERIC_OOM  out of memory
+#define map_set_value(map, key, value) \
+    map_set(map, key, VALUE_TO_POINTER(value))
+
+/// Insert node.
+///
+/// \param map      map
+/// \param key      node key
+/// \param data     data to set node with
+///
+/// \returns                    new node
+/// \retval NULL/E_MAP_EXISTS   node with \p key already existing
+/// \retval NULL/E_GENERIC_OOM  out of memory
+map_node_ct map_insert(map_ct map, str_const_ct key, const void *data);
+
+/// Insert node with value.
+///
+/// \param map      map
+/// \param key      node key
+/// \param value    value to set node with
+///
+/// \returns                    new node
+/// \retval NULL/E_MAP_EXISTS   node with \p key already existing
+/// \retval NULL/E_GENERIC_OOM  out of memory
+#define map_insert_value(map, key, value) \
+    map_insert(map, key, VALUE_TO_POINTER(value))
+
+/// Remove node.
+///
+/// \param map      map
+/// \param node     node to remove
+void map_remove(map_ct map, map_node_ct node);
+
+/// Remove node with key.
+///
+/// \param map      map
+/// \param key      node key
+///
+/// \retval 0                   success
+/// \retval -1/E_MAP_NOT_FOUND  node not found
+int map_remove_k(map_ct map, str_const_ct key);
+
+/// Destroy and remove node with key.
+///
+/// \param map      map
+/// \param key      node key
+/// \param dtor     callback to destroy node data, may be NULL
+/// \param ctx      \p dtor context
+///
+/// \retval 0                   success
+/// \retval -1/E_MAP_NOT_FOUND  node not found
+int map_remove_kf(map_ct map, str_const_ct key, map_dtor_cb dtor, const void *ctx);
+
+/// Fold over all nodes in map in unspecified order.
+///
+/// \param map      map
+/// \param fold     callback to invoke on each node
+/// \param ctx      \p fold context
+///
+/// \retval 0                   success
+/// \retval <0/E_MAP_CALLBACK   \p fold error
+/// \retval >0                  \p fold rc
+int map_fold(map_const_ct map, map_fold_cb fold, const void *ctx);
+
+
+#endif
@@ -36,6 +36,7 @@ typedef enum ring_error
     E_RING_CALLBACK,        ///< callback error
     E_RING_EMPTY,           ///< ring is empty
     E_RING_FULL,            ///< ring is full
+    E_RING_UNSUPPORTED,     ///< operation not supported on this platform
 } ring_error_id;
 
 /// ring error type declaration
@@ -104,6 +105,73 @@ ring_ct ring_new(size_t elemsize);
 /// \retval NULL/E_GENERIC_OOM  out of memory
 ring_ct ring_new_c(size_t capacity, size_t elemsize);
 
+/// Create new ring with power of 2 capacity.
+///
+/// Element positions of rings with power of 2 capacity
+/// are wrapped with a mask instead of a modulo.
+///
+/// \param capacity     minimum ring size in number of elements,
+///                     rounded up to next power of 2
+/// \param elemsize     element size
+///
+/// \returns                    new ring
+/// \retval NULL/E_GENERIC_OOM  out of memory
+ring_ct ring_new_pow2(size_t capacity, size_t elemsize);
+
+/// Create new ring with mirrored memory.
+///
+/// The ring memory is mapped twice back to back, so that elements
+/// wrapping around the end of the ring are contiguous in memory.
+/// ring_peek_span() and ring_reserve_span() return all stored elements
+/// respectively all free slots as one span.
+/// Only supported on Linux.
+///
+/// \param capacity     minimum ring size in number of elements,
+///                     rounded up to span whole pages
+/// \param elemsize     element size
+///
+/// \returns                        new ring
+/// \retval NULL/E_GENERIC_OOM      out of memory
+/// \retval NULL/E_GENERIC_SYSTEM   system error
+/// \retval NULL/E_RING_UNSUPPORTED not supported on this platform
+ring_ct ring_new_mirror(size_t capacity, size_t elemsize);
+
+/// Create new lock-free single producer single consumer ring.
+///
+/// One thread may put elements while another thread gets elements
+/// concurrently. The capacity is rounded up to a power of 2.
+///
+/// Concurrent rings support putting with ring_put_e() and ring_put_n(),
+/// getting with ring_get(), ring_get_p() and ring_get_n()
+/// and the informational functions.
+/// ring_put_e() returns the passed element instead of the ring element,
+/// which may already be consumed once it is put.
+/// All other functions must not be used concurrently to puts and gets.
+/// Functions accessing elements in place, the head or overwriting are
+/// not supported.
+///
+/// \param capacity     ring size in number of elements
+/// \param elemsize     element size
+///
+/// \returns                    new ring
+/// \retval NULL/E_GENERIC_OOM  out of memory
+ring_ct ring_new_spsc(size_t capacity, size_t elemsize);
+
+/// Create new lock-free multi producer multi consumer ring.
+///
+/// Any number of threads may put and get elements concurrently.
+/// Producers and consumers reserve slots with a compare-and-swap
+/// and commit them in reservation order.
+/// The capacity is rounded up to a power of 2.
+/// See ring_new_spsc() for the supported functions.
+///
+/// \param capacity     ring size in number of elements
+/// \param elemsize     element size
+///
+/// \returns                    new ring
+/// \retval NULL/E_GENERIC_OOM  out of memory
+ring_ct ring_new_mpmc(size_t capacity, size_t elemsize);
+
 /// Free ring.
 ///
 /// \param ring     ring
@@ -220,6 +288,8 @@ size_t ring_memsize_f(ring_const_ct ring, ring_size_cb size, const void *ctx);
 
 /// Put empty element into ring.
 ///
+/// \note not supported on concurrent rings
+///
 /// \param ring     ring
 ///
 /// \returns                    pointer to new element
@@ -230,9 +300,9 @@ void *ring_put(ring_ct ring);
 /// Put element into ring.
 ///
 /// \param ring     ring
-/// \param elem     pointer to element, may be NULL
+/// \param elem     pointer to element, may be NULL if ring is not concurrent
 ///
-/// \returns                    pointer to new element
+/// \returns                    pointer to new element, \p elem if ring is concurrent
 /// \retval NULL/E_RING_FULL    ring is full
 /// \retval NULL/E_GENERIC_OOM  out of memory
 void *ring_put_e(ring_ct ring, const void *elem);
@@ -240,6 +310,7 @@ void *ring_put_e(ring_ct ring, const void *elem);
 /// Put pointer into ring.
 ///
 /// \note ring element size must be equal to sizeof(void*).
+/// \note not supported on concurrent rings, use ring_put_e()
 ///
 /// \param ring     ring
 /// \param ptr      pointer
@@ -249,6 +320,17 @@ void *ring_put_e(ring_ct ring, const void *elem);
 /// \retval NULL/E_GENERIC_OOM  out of memory
 void *ring_put_p(ring_ct ring, const void *ptr);
 
+/// Put up to n elements into ring.
+///
+/// \param ring     ring
+/// \param elems    array of elements, may be NULL to put empty elements
+/// \param n        number of elements
+///
+/// \returns                    number of elements put
+/// \retval 0/E_RING_FULL       ring is full
+/// \retval 0/E_GENERIC_OOM     out of memory
+size_t ring_put_n(ring_ct ring, const void *elems, size_t n);
+
 /// Put empty element into ring, overwrite tail if full.
 ///
 /// \param ring     ring
@@ -344,6 +426,59 @@ int ring_get(ring_ct ring, void *dst);
 /// \retval NULL/E_RING_EMPTY   ring is empty
 void *ring_get_p(ring_ct ring);
 
+/// Get contiguous span of elements starting at tail.
+///
+/// Mirrored rings return all elements, other rings
+/// the elements up to the end of the ring memory.
+/// Consume the elements with ring_get_n() and NULL destination.
+///
+/// \param      ring    ring
+/// \param[out] n       number of elements in span
+///
+/// \returns                    pointer to tail element
+/// \retval NULL/E_RING_EMPTY   ring is empty
+void *ring_peek_span(ring_const_ct ring, size_t *n);
+
+/// Reserve contiguous span of free slots after head.
+///
+/// Mirrored rings return all free slots, other rings
+/// the free slots up to the end of the ring memory.
+/// Fill the slots and publish them with ring_commit_span().
+///
+/// \param      ring    ring
+/// \param[out] n       number of free slots in span
+///
+/// \returns                    pointer to first free slot
+/// \retval NULL/E_RING_FULL    ring is full
+/// \retval NULL/E_GENERIC_OOM  out of memory
+void *ring_reserve_span(ring_ct ring, size_t *n);
+
+/// Commit slots filled after ring_reserve_span().
+///
+/// \param ring     ring
+/// \param n        number of slots to commit, at most the reserved number
+void ring_commit_span(ring_ct ring, size_t n);
+
+/// Copy up to n tail ring elements without removing them.
+///
+/// \param      ring    ring
+/// \param[out] dst     array of elements to fill
+/// \param      n       number of elements
+///
+/// \returns                    number of elements copied
+/// \retval 0/E_RING_EMPTY      ring is empty
+size_t ring_peek_n(ring_const_ct ring, void *dst, size_t n);
+
+/// Get and remove up to n tail ring elements.
+///
+/// \param      ring    ring
+/// \param[out] dst     array of elements to fill, may be NULL
+/// \param      n       number of elements
+///
+/// \returns                    number of elements removed
+/// \retval 0/E_RING_EMPTY      ring is empty
+size_t ring_get_n(ring_ct ring, void *dst, size_t n);
+
 /// Get pointer to head ring element.
 ///
 /// \param ring     ring
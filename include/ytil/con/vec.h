@@ -30,6 +30,7 @@
 #include <stdarg.h>
 #include <sys/types.h>
 #include <ytil/gen/error.h>
+#include <ytil/ext/alloca.h>
 
 
 /// vector error
@@ -37,6 +38,7 @@ typedef enum vec_error
 {
     E_VEC_CALLBACK,         ///< callback error
     E_VEC_EMPTY,            ///< vector is empty
+    E_VEC_EXISTS,           ///< element already exists
     E_VEC_NO_BUFFER,        ///< no buffer allocated
     E_VEC_NOT_FOUND,        ///< element not found
     E_VEC_OUT_OF_BOUNDS,    ///< out of bounds element access
@@ -45,6 +47,14 @@ typedef enum vec_error
 /// vector error type declaration
 ERROR_DECLARE(VEC);
 
+/// vector growth policy
+typedef enum vec_growth
+{
+    VEC_GROWTH_FACTOR,      ///< multiply capacity by factor (default 2)
+    VEC_GROWTH_STEP,        ///< add fixed number of elements
+    VEC_GROWTH_POW2,        ///< round capacity up to power of 2
+} vec_growth_id;
+
 
 struct vector;
 typedef       struct vector *vec_ct;        ///< vector type
@@ -128,6 +138,38 @@ vec_ct vec_new(size_t elemsize);
 /// \retval NULL/E_GENERIC_OOM  out of memory
 vec_ct vec_new_c(size_t capacity, size_t elemsize);
 
+/// Get size of inline vector buffer.
+///
+/// \param capacity     inline capacity in number of elements
+/// \param elemsize     element size
+///
+/// \returns            size in bytes of buffer to pass to vec_init_inline()
+size_t vec_inline_size(size_t capacity, size_t elemsize);
+
+/// Init vector with inline storage.
+///
+/// The vector head and the first \p capacity elements are stored in \p buf.
+/// The vector spills to the heap when outgrowing \p buf
+/// and moves back when shrinking to \p capacity again.
+/// \p buf must not be moved while the vector is in use.
+/// vec_free() releases heap memory only.
+///
+/// \param buf          buffer of vec_inline_size() bytes, suitably aligned
+/// \param capacity     inline capacity in number of elements
+/// \param elemsize     element size
+///
+/// \returns            initialized vector
+vec_ct vec_init_inline(void *buf, size_t capacity, size_t elemsize);
+
+/// Create new vector with inline storage on the stack.
+///
+/// \param capacity     inline capacity in number of elements
+/// \param elemsize     element size
+///
+/// \returns            new vector
+#define vec_new_inline(capacity, elemsize) \
+    vec_init_inline(alloca(vec_inline_size((capacity), (elemsize))), (capacity), (elemsize))
+
 /// Free vector.
 ///
 /// \param vec      vector
@@ -232,6 +274,33 @@ size_t vec_capacity(vec_const_ct vec);
 /// \returns        minimum capacity in number of elements
 size_t vec_min_capacity(vec_const_ct vec);
 
+/// Set vector growth policy.
+///
+/// The policy determines the capacity to grow to if the vector is full
+/// and the capacity to shrink to if the fill level gets too low.
+///
+/// \param vec      vector
+/// \param growth   growth policy
+/// \param arg      VEC_GROWTH_FACTOR: factor, at least 2,
+///                 VEC_GROWTH_STEP: number of elements, at least 1,
+///                 VEC_GROWTH_POW2: ignored
+void vec_set_growth(vec_ct vec, vec_growth_id growth, size_t arg);
+
+/// Set threshold to back vector memory with anonymous mapping.
+///
+/// Buffers of at least \p threshold bytes are mapped instead of allocated
+/// on the heap and advised to use transparent huge pages. Growing and
+/// shrinking remaps the buffer without copying. Buffers moving across
+/// \p threshold are moved between heap and mapping.
+/// Only supported on Linux, ignored elsewhere.
+///
+/// \param vec          vector
+/// \param threshold    minimum buffer size in bytes to map, 0 to disable
+///
+/// \retval 0                   success
+/// \retval -1/E_GENERIC_OOM    out of memory
+int vec_set_mmap(vec_ct vec, size_t threshold);
+
 /// Get allocated size of vector.
 ///
 /// \param vec      vector
@@ -1057,6 +1126,7 @@ int vec_swap(vec_ct vec, ssize_t pos1, ssize_t pos2);
 ///
 /// After removing the buffer it is unset until the next push/insert operation.
 /// The new buffer is allocated with the minimum capacity.
+/// Inline buffers are copied to the heap.
 ///
 /// \param      vec         vector
 /// \param[out] buf         buffer pointer to set
@@ -1065,6 +1135,7 @@ int vec_swap(vec_ct vec, ssize_t pos1, ssize_t pos2);
 ///
 /// \retval 0                   success
 /// \retval -1/E_VEC_NO_BUFFER  no buffer allocated
+/// \retval -1/E_GENERIC_OOM    out of memory
 int vec_get_buffer(vec_ct vec, void **buf, size_t *size, size_t *capacity);
 
 /// Truncate vector to n elements.
@@ -1129,10 +1200,154 @@ int vec_fold_r(vec_const_ct vec, vec_fold_cb fold, const void *ctx);
 
 /// Sort vector.
 ///
+/// Sort by pattern-defeating quicksort, not stable.
+///
 /// \param vec      vector
 /// \param sort     callback to compare two elements
 /// \param ctx      \p sort context
 void vec_sort(vec_ct vec, vec_sort_cb sort, const void *ctx);
 
+/// Sort vector of uint32_t by radix sort.
+///
+/// \param vec      vector
+///
+/// \retval 0                   success
+/// \retval -1/E_GENERIC_OOM    out of memory
+int vec_sort_u32(vec_ct vec);
+
+/// Sort vector of uint64_t by radix sort.
+///
+/// \param vec      vector
+///
+/// \retval 0                   success
+/// \retval -1/E_GENERIC_OOM    out of memory
+int vec_sort_u64(vec_ct vec);
+
+/// Sort vector of int32_t by radix sort.
+///
+/// \param vec      vector
+///
+/// \retval 0                   success
+/// \retval -1/E_GENERIC_OOM    out of memory
+int vec_sort_i32(vec_ct vec);
+
+/// Sort vector of int64_t by radix sort.
+///
+/// \param vec      vector
+///
+/// \retval 0                   success
+/// \retval -1/E_GENERIC_OOM    out of memory
+int vec_sort_i64(vec_ct vec);
+
+/// Sort vector in parallel.
+///
+/// Vectors of at least one million elements are split into \p threads chunks
+/// which are sorted concurrently and merged pairwise, smaller vectors are
+/// sorted by vec_sort(). \p sort must be safe to call from multiple threads.
+///
+/// \param vec      vector
+/// \param sort     callback to compare two elements
+/// \param ctx      \p sort context
+/// \param threads  number of threads to use
+///
+/// \retval 0                   success
+/// \retval -1/E_GENERIC_OOM    out of memory
+int vec_sort_parallel(vec_ct vec, vec_sort_cb sort, const void *ctx, size_t threads);
+
+/// Enable sorted set mode.
+///
+/// Sort vector and remove duplicate elements, keeping one of each.
+/// The sort is not stable, which duplicate is kept is unspecified.
+/// In sorted set mode elements are added by vec_insert_sorted() and
+/// vec_merge_sorted() only, which keep the vector sorted and unique.
+/// Positional push, insert, set, swap and sort operations must not be used.
+/// Removing elements is allowed.
+///
+/// \param vec      vector
+/// \param sort     callback to compare two elements, NULL to disable sorted set mode
+/// \param ctx      \p sort context
+///
+/// \returns        number of removed duplicates
+size_t vec_set_sorted(vec_ct vec, vec_sort_cb sort, const void *ctx);
+
+/// Enable sorted set mode, destroy removed duplicates.
+///
+/// \param vec          vector
+/// \param sort         callback to compare two elements, NULL to disable sorted set mode
+/// \param sort_ctx     \p sort context
+/// \param dtor         callback to destroy removed duplicates, may be NULL
+/// \param dtor_ctx     \p dtor context
+///
+/// \returns            number of removed duplicates
+size_t vec_set_sorted_f(vec_ct vec, vec_sort_cb sort, const void *sort_ctx, vec_dtor_cb dtor, const void *dtor_ctx);
+
+/// Check if vector is in sorted set mode.
+///
+/// \param vec      vector
+///
+/// \retval true    vector is in sorted set mode
+/// \retval false   vector is not in sorted set mode
+bool vec_is_sorted(vec_const_ct vec);
+
+/// Get position of first element not less than key in sorted vector.
+///
+/// \param vec      vector sorted by \p sort
+/// \param key      key to compare elements with, passed as first \p sort argument
+/// \param sort     callback to compare key with element, NULL to use sorted set comparator
+/// \param ctx      \p sort context
+///
+/// \returns        element position, vector size if all elements are less
+size_t vec_lower_bound(vec_const_ct vec, const void *key, vec_sort_cb sort, const void *ctx);
+
+/// Get position of first element greater than key in sorted vector.
+///
+/// \param vec      vector sorted by \p sort
+/// \param key      key to compare elements with, passed as first \p sort argument
+/// \param sort     callback to compare key with element, NULL to use sorted set comparator
+/// \param ctx      \p sort context
+///
+/// \returns        element position, vector size if no element is greater
+size_t vec_upper_bound(vec_const_ct vec, const void *key, vec_sort_cb sort, const void *ctx);
+
+/// Find element by binary search in sorted vector.
+///
+/// \param vec      vector sorted by \p sort
+/// \param key      key to compare elements with, passed as first \p sort argument
+/// \param sort     callback to compare key with element, NULL to use sorted set comparator
+/// \param ctx      \p sort context
+///
+/// \returns                        first element matching \p key
+/// \retval NULL/E_VEC_NOT_FOUND    no element matches \p key
+void *vec_bsearch(vec_const_ct vec, const void *key, vec_sort_cb sort, const void *ctx);
+
+/// Insert element into sorted vector.
+///
+/// The element is inserted after equal elements.
+///
+/// \param vec      vector sorted by \p sort
+/// \param elem     element to insert
+/// \param sort     callback to compare two elements, NULL to use sorted set comparator
+/// \param ctx      \p sort context
+///
+/// \returns                    inserted element
+/// \retval NULL/E_VEC_EXISTS   vector is in sorted set mode and contains equal element
+/// \retval NULL/E_GENERIC_OOM  out of memory
+void *vec_insert_sorted(vec_ct vec, const void *elem, vec_sort_cb sort, const void *ctx);
+
+/// Merge sorted vector into sorted vector.
+///
+/// Elements of \p src are copied after equal elements of \p vec.
+/// In sorted set mode elements already in \p vec and repeated
+/// elements of \p src are skipped.
+///
+/// \param vec      vector sorted by \p sort
+/// \param src      vector sorted by \p sort to merge
+/// \param sort     callback to compare two elements, NULL to use sorted set comparator
+/// \param ctx      \p sort context
+///
+/// \retval 0                   success
+/// \retval -1/E_GENERIC_OOM    out of memory
+int vec_merge_sorted(vec_ct vec, vec_const_ct src, vec_sort_cb sort, const void *ctx);
+
 
 #endif // ifndef YTIL_CON_VEC_H_INCLUDED
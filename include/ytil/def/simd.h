@@ -65,7 +65,7 @@
 ///
 /// \returns        index of key
 /// \retval -1      key not found
-extern inline int simd64_index8(const void *data, unsigned int size, int8_t key)
+static inline int simd64_index8(const void *data, unsigned int size, int8_t key)
 {
     __m64 cmp;
     int mask;
@@ -76,6 +76,17 @@ extern inline int simd64_index8(const void *data, unsigned int size, int8_t key)
     return mask ? CTZ(mask) : -1;
 }
 
+/// Get mask of 8 bit keys matching in 64 bits of data.
+///
+/// \param data     data to search
+/// \param key      key to match
+///
+/// \returns        bit mask, bit i set if byte i matches \p key
+static inline unsigned int simd64_mask8(const void *data, int8_t key)
+{
+    return _mm_movemask_pi8(_mm_cmpeq_pi8(_mm_set1_pi8(key), *(__m64 *)data));
+}
+
 /// Find index of 8 bit key in 128 bits of data.
 ///
 /// \param data     data to search
@@ -84,7 +95,7 @@ extern inline int simd64_index8(const void *data, unsigned int size, int8_t key)
 ///
 /// \returns        index of key
 /// \retval -1      key not found
-extern inline int simd128_index8(const void *data, unsigned int size, int8_t key)
+static inline int simd128_index8(const void *data, unsigned int size, int8_t key)
 {
 #if SIMD512
 
@@ -120,6 +131,29 @@ extern inline int simd128_index8(const void *data, unsigned int size, int8_t key
 #endif // if SIMD512
 }
 
+/// Get mask of 8 bit keys matching in 128 bits of data.
+///
+/// \param data     data to search
+/// \param key      key to match
+///
+/// \returns        bit mask, bit i set if byte i matches \p key
+static inline unsigned int simd128_mask8(const void *data, int8_t key)
+{
+#if SIMD512
+
+    return _mm_cmpeq_epi8_mask(_mm_set1_epi8(key), _mm_loadu_si128(data));
+
+#elif SIMD128
+
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(key), _mm_loadu_si128(data)));
+
+#else // if SIMD512
+
+    return simd64_mask8(data, key) | simd64_mask8(((unsigned char *)data) + 8, key) << 8;
+
+#endif // if SIMD512
+}
+
 /// Find index of 8 bit key in 256 bits of data.
 ///
 /// \param data     data to search
@@ -128,13 +162,13 @@ extern inline int simd128_index8(const void *data, unsigned int size, int8_t key
 ///
 /// \returns        index of key
 /// \retval -1      key not found
-extern inline int simd256_index8(const void *data, unsigned int size, int8_t key)
+static inline int simd256_index8(const void *data, unsigned int size, int8_t key)
 {
 #if SIMD512
 
     __mmask32 mask;
 
-    mask    = _mm256_cmpeq_epi8_mask(_mm256_set1_epi8(key), _mm_loadu_si256(data));
+    mask    = _mm256_cmpeq_epi8_mask(_mm256_set1_epi8(key), _mm256_loadu_si256(data));
     mask    &= BM(size);
 
     return mask ? CTZ(mask) : -1;
@@ -164,6 +198,48 @@ extern inline int simd256_index8(const void *data, unsigned int size, int8_t key
 #endif // if SIMD512
 }
 
+/// Get mask of 8 bit keys matching in 256 bits of data.
+///
+/// \param data     data to search
+/// \param key      key to match
+///
+/// \returns        bit mask, bit i set if byte i matches \p key
+static inline uint32_t simd256_mask8(const void *data, int8_t key)
+{
+#if SIMD512
+
+    return _mm256_cmpeq_epi8_mask(_mm256_set1_epi8(key), _mm256_loadu_si256(data));
+
+#elif SIMD256
+
+    return (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_set1_epi8(key), _mm256_loadu_si256(data)));
+
+#else // if SIMD512
+
+    return simd128_mask8(data, key) | (uint32_t)simd128_mask8(((unsigned char *)data) + 16, key) << 16;
+
+#endif // if SIMD512
+}
+
+/// Get mask of 8 bit keys matching in 512 bits of data.
+///
+/// \param data     data to search
+/// \param key      key to match
+///
+/// \returns        bit mask, bit i set if byte i matches \p key
+static inline uint64_t simd512_mask8(const void *data, int8_t key)
+{
+#if SIMD512
+
+    return _mm512_cmpeq_epi8_mask(_mm512_set1_epi8(key), _mm512_loadu_si512(data));
+
+#else
+
+    return simd256_mask8(data, key) | (uint64_t)simd256_mask8(((unsigned char *)data) + 32, key) << 32;
+
+#endif // if SIMD512
+}
+
 /// Find index of 8 bit key in 512 bits of data.
 ///
 /// \param data     data to search
@@ -172,7 +248,7 @@ extern inline int simd256_index8(const void *data, unsigned int size, int8_t key
 ///
 /// \returns        index of key
 /// \retval -1      key not found
-extern inline int simd512_index8(const void *data, unsigned int size, int8_t key)
+static inline int simd512_index8(const void *data, unsigned int size, int8_t key)
 {
 #if SIMD512
 
@@ -206,7 +282,7 @@ extern inline int simd512_index8(const void *data, unsigned int size, int8_t key
 ///
 /// \returns        index of key
 /// \retval -1      key not found
-extern inline int simd1024_index8(const void *data, unsigned int size, int8_t key)
+static inline int simd1024_index8(const void *data, unsigned int size, int8_t key)
 {
     int index;
 
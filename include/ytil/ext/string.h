@@ -157,8 +157,11 @@ size_t memcaseprefix(const void *mem1, const void *mem2, size_t size);
 
 // scan str haystack for first occurence of str needle (system provided)
 // char *strstr(const char *haystack, const char *needle);
-// scan mem haystack first occurence of mem needle
+// scan mem haystack for first occurence of mem needle
+// SIMD first/last byte filter for short needles, Two-Way for long needles
 void *memmem(const void *haystack, size_t ssize, const void *needle, size_t nsize);
+// scan mem haystack for last occurence of mem needle
+void *memrmem(const void *haystack, size_t ssize, const void *needle, size_t nsize);
 
 // compare two strings (system provided)
 // int strcmp(const char *str1, const char *str2);
@@ -30,6 +30,7 @@
 #include <stdbool.h>
 #include <stdarg.h>
 #include <string.h>
+#include <stdint.h>
 #include <sys/types.h>
 
 
@@ -38,11 +39,13 @@ typedef enum str_error
       E_STR_BINARY
     , E_STR_CONST
     , E_STR_EMPTY
+    , E_STR_END
     , E_STR_INVALID_CSTR
     , E_STR_INVALID_CALLBACK
     , E_STR_INVALID_DATA
     , E_STR_INVALID_FORMAT
     , E_STR_INVALID_LENGTH
+    , E_STR_NOT_FOUND
     , E_STR_OUT_OF_BOUNDS
     , E_STR_UNREFERENCED
     , E_STR_VOLATILE
@@ -55,6 +58,11 @@ ERROR_DECLARE(STR);
 typedef struct str       *str_ct;
 typedef const struct str *str_const_ct;
 
+typedef struct vector    *vec_ct;   // see ytil/con/vec.h
+
+// upper bound of str head size in bytes, for static str head storage
+#define STR_HEAD_SIZE 32
+
 
 // get length of str
 size_t str_len(str_const_ct str);
@@ -77,6 +85,8 @@ bool str_is_const(str_const_ct str);
 bool str_is_volatile(str_const_ct str);
 // check if str is binary (may contain control chars and/or no null terminator)
 bool str_is_binary(str_const_ct str);
+// check if str is interned i.e. canonical and immortal
+bool str_is_interned(str_const_ct str);
 
 // check if str data is allocated
 bool str_data_is_heap(str_const_ct str);
@@ -471,6 +481,106 @@ str_ct  str_replace_cn(str_ct str, const char *sub, size_t sublen, const char *n
 str_ct  str_replace_b(str_ct str, const void *sub, size_t sublen, const void *nsub, size_t nsublen);
 #define str_replace_bl(str, sub, nsub) str_replace_b(str, sub, sizeof(sub)-1, nsub, sizeof(nsub)-1)
 
+// get position of first occurence of sub str in str, -1/E_STR_NOT_FOUND if none
+ssize_t str_find(str_const_ct str, str_const_ct sub);
+// get position of first occurence of sub cstr in str
+ssize_t str_find_c(str_const_ct str, const char *sub);
+// get position of first occurence of sub cstr[0:len] in str
+ssize_t str_find_cn(str_const_ct str, const char *sub, size_t len);
+#define str_find_l(str, sub) str_find_cn(str, sub, sizeof(sub)-1)
+// get position of first occurence of sub data in str
+ssize_t str_find_b(str_const_ct str, const void *sub, size_t len);
+
+// get position of last occurence of sub str in str, -1/E_STR_NOT_FOUND if none
+ssize_t str_rfind(str_const_ct str, str_const_ct sub);
+// get position of last occurence of sub cstr in str
+ssize_t str_rfind_c(str_const_ct str, const char *sub);
+// get position of last occurence of sub cstr[0:len] in str
+ssize_t str_rfind_cn(str_const_ct str, const char *sub, size_t len);
+#define str_rfind_l(str, sub) str_rfind_cn(str, sub, sizeof(sub)-1)
+// get position of last occurence of sub data in str
+ssize_t str_rfind_b(str_const_ct str, const void *sub, size_t len);
+
+// create new vec of size_t positions of all non-overlapping occurences
+// of non-empty sub str in str, left to right
+vec_ct  str_find_all(str_const_ct str, str_const_ct sub);
+// create new vec of positions of all occurences of sub cstr in str
+vec_ct  str_find_all_c(str_const_ct str, const char *sub);
+// create new vec of positions of all occurences of sub cstr[0:len] in str
+vec_ct  str_find_all_cn(str_const_ct str, const char *sub, size_t len);
+#define str_find_all_l(str, sub) str_find_all_cn(str, sub, sizeof(sub)-1)
+// create new vec of positions of all occurences of sub data in str
+vec_ct  str_find_all_b(str_const_ct str, const void *sub, size_t len);
+
+
+/* split iterator
+ * - lives on the stack, str_split_free releases it
+ * - holds one reference on a heap str, transient strs are only borrowed
+ * - fields are transient, const, binary views into the str data,
+ *   valid until the next call of str_split_next, nothing is allocated
+ * - fields are not null terminated, use str_dup to keep one
+ * - n delimiters yield n+1 fields, the empty str yields one empty field
+*/
+
+// str split iterator state
+typedef struct str_split
+{
+    str_const_ct str;   // str to split
+    const void *delim;  // delimiter set or sub str
+    size_t dlen;        // delimiter set or sub str length
+    size_t pos;         // start of next field
+    int c;              // delimiter char
+    uint8_t mode;       // delimiter type
+    bool ref;           // str is referenced by iterator
+    bool done;          // last field returned
+    union
+    {
+        max_align_t align;
+        unsigned char mem[STR_HEAD_SIZE];
+    } field;            // storage for the transient field head
+} str_split_st;
+
+// init iterator splitting str at each char c
+str_split_st *str_split_init(str_split_st *split, str_const_ct str, char c);
+// init iterator splitting str at each char in set cstr
+str_split_st *str_split_init_set(str_split_st *split, str_const_ct str, const char *set);
+// init iterator splitting str at each occurence of non-empty sub data
+str_split_st *str_split_init_sub(str_split_st *split, str_const_ct str, const void *sub, size_t len);
+#define str_split_init_l(split, str, sub) str_split_init_sub(split, str, sub, sizeof(sub)-1)
+// get next field, NULL/E_STR_END after last field
+str_ct str_split_next(str_split_st *split);
+// release iterator
+void str_split_free(str_split_st *split);
+
+// get 64 bit hash of str data, equal data yields equal hash regardless of flags
+// interned strs are hashed once on creation, other strs on each call
+uint64_t str_hash(str_const_ct str);
+// get 64 bit hash of data, same as str_hash of str with this data
+uint64_t str_hash_b(const void *data, size_t len);
+
+
+/* interned strings
+ * - one canonical str per content, compare interned strs by pointer
+ * - const and immortal, str_ref/str_unref are no-ops
+ * - static data, str_dup references instead of copying
+ * - binary if data contains null bytes, null terminated anyway
+ * - thread-safe, lookups of already interned content take no lock
+*/
+
+// get interned str with content of str
+str_ct str_intern(str_const_ct str);
+// get interned str with content of cstr
+str_ct str_intern_c(const char *cstr);
+// get interned str with content of cstr[0:len]
+str_ct str_intern_cn(const char *cstr, size_t len);
+#define str_intern_l(lit) str_intern_cn(lit, sizeof(lit)-1)
+// get interned str with content of data
+str_ct str_intern_b(const void *data, size_t len);
+// get number of interned strs
+size_t str_intern_count(void);
+// free all interned strs, none may be in use anymore
+void str_intern_free(void);
+
 // create new heap str from data[pos] of len
 // duplicate data if not static or (not binary and not suffix)
 str_ct str_substr(str_const_ct str, ssize_t pos, size_t len);
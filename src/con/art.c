@@ -23,11 +23,24 @@
 /// \file
 
 #include <ytil/con/art.h>
+#include <ytil/con/art.cfg.h>
 #include <ytil/ext/string.h>
 #include <ytil/def.h>
 #include <ytil/def/magic.h>
+#include <ytil/def/os.h>
 #include <ytil/def/simd.h>
 #include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <sched.h>
+
+#if OS_UNIX
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
 
 
 #define WITH_KEY    true    ///< reconstruct node key
@@ -38,6 +51,33 @@
 
 #define MAGIC       define_magic("ART") ///< ART magic
 #define NODE_MAGIC  define_magic("ARN") ///< ART node magic
+#define ITER_MAGIC  define_magic("ARI") ///< ART iterator magic
+
+#define PATH_INLINE 16                                          ///< max length of inline paths
+#define PATH_PREFIX (PATH_INLINE - sizeof(unsigned char *))     ///< inline prefix length of heap paths
+
+#define SLAB_SIZE   16384   ///< size of node slabs in slab mode
+
+#if defined(ART_NODE64_SIMD) && SIMD256
+    #define NODE64_LIST 1   ///< node64 keeps a key list searched by simd512_index8
+#endif
+
+#define ITER_STACK  16  ///< initial capacity of iterator stack
+#define BATCH_SIZE  16  ///< number of keys walked interleaved by art_get_batch
+
+#define SYNC_STRIPES    16  ///< number of reader counters per epoch in concurrent mode
+#define SYNC_LINE       64  ///< cache line size to pad reader counters to
+#define SYNC_RETIRE     64  ///< number of retired nodes to collect before freeing them
+#define VERSION_LOCKED  1U  ///< node version lock bit
+
+#define IMAGE_MAGIC     "YTILART"   ///< ART image magic
+#define IMAGE_VERSION   1           ///< ART image format version
+#define IMAGE_ALIGN     8           ///< ART image node alignment
+#define IMAGE_LIST_MAX  32          ///< max number of children of image list nodes
+#define IMAGE_INDEX_MAX 223         ///< max number of children of image index nodes
+
+/// Align ART image offset.
+#define IMAGE_PAD(len)  (((len) + IMAGE_ALIGN - 1) & ~(uint64_t)(IMAGE_ALIGN - 1))
 
 /*
  * 2000000 iterations of each method to find key in x bytes
@@ -70,6 +110,18 @@
  * use index search for nodes with size overhead <= 1/4
  * use intrinsics/binary search when suitable intrinsics available
  *
+ * node64 lookups, art_bench_get_node64, 37 children per inner node
+ * debug build, average of 3 runs, ordered and unordered mode alike
+ *
+ * node64               ns/get  bytes
+ * index                157     4722280
+ * list simd512         138     4455784
+ * list 2 * simd256     162     4455784
+ *
+ * with AVX-512BW the list is faster and smaller than the index,
+ * with AVX2 only it is on par and smaller
+ * use list search for node64 if ART_NODE64_SIMD is configured and AVX2 available
+ *
  */
 
 
@@ -86,6 +138,19 @@ typedef enum art_node_type
     NODE256,    ///< node with 129-256 children
 } art_node_id;
 
+/// ART image node type
+///
+/// Image node types do not overlap with art_node_id, the type is the first
+/// byte of both node layouts. This allows art_node_data() and art_node_key()
+/// to tell image leaf nodes apart.
+typedef enum art_image_node_type
+{
+    IMAGE_LEAF = 0x80,  ///< leaf node
+    IMAGE_LIST,         ///< node with sorted key list, up to IMAGE_LIST_MAX children
+    IMAGE_INDEX,        ///< node with key index, up to IMAGE_INDEX_MAX children
+    IMAGE_FULL,         ///< node with 256 child slots
+} art_image_node_id;
+
 /// ART traverse order
 typedef enum art_traverse_order
 {
@@ -95,13 +160,21 @@ typedef enum art_traverse_order
     TRAV_POST,  ///< post-order traversal
 } art_traverse_id;
 
+/// ART leaf key
+typedef struct art_key
+{
+    size_t          len;    ///< key length
+    unsigned char   data[]; ///< key
+} art_key_st;
+
 /// ART leaf node
 typedef struct art_leaf
 {
     DEBUG_MAGIC
     DEBUG_MEMBER(art_ct art)
 
-    void *data;     ///< node data
+    void        *data;  ///< node data
+    art_key_st  *key;   ///< full node key, optimistic mode only
 } art_leaf_st;
 
 /// ART node4
@@ -135,7 +208,11 @@ typedef struct art_node32
 /// ART node64
 typedef struct art_node64
 {
+#if NODE64_LIST
+    unsigned char   key[64];    ///< key list
+#else
     unsigned char   key[256];   ///< key index
+#endif
     art_node_ct     child[64];  ///< child list
 } art_node64_st;
 
@@ -152,6 +229,22 @@ typedef struct art_node256
     art_node_ct child[256];     ///< child index
 } art_node256_st;
 
+/// ART node path
+///
+/// Paths up to PATH_INLINE bytes are stored inline.
+/// Longer paths are allocated on the heap
+/// and their first PATH_PREFIX bytes are kept inline.
+typedef union art_path
+{
+    unsigned char   data[PATH_INLINE];  ///< inline path
+
+    struct
+    {
+        unsigned char   prefix[PATH_PREFIX];    ///< inline path prefix
+        unsigned char   *data;                  ///< heap path
+    } heap; ///< heap path
+} art_path_un;
+
 /// ART node value
 typedef union art_value
 {
@@ -173,13 +266,90 @@ typedef struct art_node
     uint16_t        size;       ///< number of child nodes
 
     uint32_t        path_len;   ///< node path length
-    unsigned char   *path;      ///< node path
+    atomic_uint     version;    ///< node version, concurrent mode only
+    art_path_un     path;       ///< node path
 
     art_node_ct parent;         ///< parent node
 
     art_value_un v;             ///< node value
 } art_node_st;
 
+/// ART node slab
+typedef struct art_slab
+{
+    struct art_slab *next;  ///< next slab
+    unsigned char   mem[];  ///< node memory
+} art_slab_st;
+
+/// ART node pool
+typedef struct art_pool
+{
+    art_node_ct     free;   ///< released nodes, linked via parent
+    unsigned char   *next;  ///< next unused node in current slab
+    unsigned char   *end;   ///< end of current slab
+} art_pool_st;
+
+/// ART reader counter
+typedef struct art_reader
+{
+    atomic_size_t   count;                              ///< number of active readers
+    char            pad[SYNC_LINE - sizeof(size_t)];    ///< cache line padding
+} art_reader_st;
+
+/// ART concurrency state
+///
+/// Writers are serialized by the writer lock and lock each node they modify
+/// by setting the lock bit of the node version. Readers do not lock,
+/// they validate the versions of the nodes they visited and restart on change.
+/// Readers announce themselves in the reader counters of the current epoch.
+/// Nodes removed by writers are retired and only freed
+/// after all readers of the previous epoch are gone.
+typedef struct art_sync
+{
+    atomic_flag     writer;                     ///< writer lock
+    atomic_uint     root;                       ///< root slot version
+    atomic_uint     epoch;                      ///< reader epoch
+    art_reader_st   readers[2][SYNC_STRIPES];   ///< reader counters per epoch parity
+    art_node_ct     retired;                    ///< retired nodes, linked via parent
+    size_t          retired_count;              ///< number of retired nodes
+} art_sync_st;
+
+/// ART image header
+typedef struct art_image
+{
+    char        magic[8];   ///< IMAGE_MAGIC
+    uint32_t    version;    ///< IMAGE_VERSION, mismatches on foreign byte order
+    uint32_t    ptr_size;   ///< size of data pointers of writing platform
+    uint64_t    size;       ///< number of leaf nodes
+    uint64_t    root;       ///< root node offset, 0 if empty
+    uint64_t    len;        ///< image length
+} art_image_st;
+
+/// ART image leaf node
+typedef struct art_image_leaf
+{
+    uint8_t         type;   ///< IMAGE_LEAF
+    uint8_t         pad[3]; ///< padding
+    uint32_t        len;    ///< key length
+    uint64_t        data;   ///< node data
+    unsigned char   key[];  ///< full node key
+} art_image_leaf_st;
+
+/// ART image inner node
+///
+/// The node path is followed by the key list of list nodes
+/// or the key index of index nodes and, aligned to IMAGE_ALIGN,
+/// the child offsets in ascending key order.
+/// Full nodes have 256 child offsets, missing children are 0.
+typedef struct art_image_node
+{
+    uint8_t         type;       ///< node type
+    uint8_t         pad;        ///< padding
+    uint16_t        size;       ///< number of children
+    uint32_t        path_len;   ///< node path length
+    unsigned char   path[];     ///< node path
+} art_image_node_st;
+
 /// ART
 typedef struct art
 {
@@ -187,7 +357,18 @@ typedef struct art
 
     art_node_ct root;       ///< root node
     size_t      size;       ///< number of ART nodes
+    size_t      heap;       ///< number of heap allocated paths and keys
     bool        ordered;    ///< sort order mode
+    bool        optimistic; ///< optimistic lookup mode
+    bool        slab;       ///< slab allocation mode
+
+    art_slab_st *slabs;             ///< node slabs
+    size_t      slab_mem;           ///< size of all node slabs
+    art_pool_st pool[NODE256 + 1];  ///< node pools per node type
+
+    art_sync_st *sync;              ///< concurrency state, concurrent mode only
+
+    const art_image_st *image;      ///< mapped image, frozen ART only
 } art_st;
 
 /// ART error type definition
@@ -195,6 +376,9 @@ ERROR_DEFINE_LIST(ART,
     ERROR_INFO(E_ART_CALLBACK,    "Callback error."),
     ERROR_INFO(E_ART_EMPTY,       "ART is empty."),
     ERROR_INFO(E_ART_EXISTS,      "Node already exists."),
+    ERROR_INFO(E_ART_FILE,        "File error."),
+    ERROR_INFO(E_ART_FROZEN,      "ART is frozen."),
+    ERROR_INFO(E_ART_IMAGE,       "Invalid ART image."),
     ERROR_INFO(E_ART_INVALID_KEY, "Invalid key."),
     ERROR_INFO(E_ART_NOT_FOUND,   "Node not found.")
 );
@@ -202,6 +386,148 @@ ERROR_DEFINE_LIST(ART,
 /// default error type for ART module
 #define ERROR_TYPE_DEFAULT ERROR_TYPE_ART
 
+/// next reader counter stripe to assign to a thread
+static atomic_size_t art_sync_stripes;
+
+/// reader counter stripe of current thread, SIZE_MAX if not yet assigned
+static _Thread_local size_t art_sync_stripe = SIZE_MAX;
+
+
+/// Read node version.
+///
+/// \param version      version to read
+/// \param[out] value   version value
+///
+/// \retval true        version is unlocked
+/// \retval false       version is locked
+static inline bool art_version_read(const atomic_uint *version, unsigned int *value)
+{
+    *value = atomic_load_explicit(version, memory_order_acquire);
+
+    return !(*value & VERSION_LOCKED);
+}
+
+/// Check that node version did not change since read.
+///
+/// \param version  version to check
+/// \param value    version value read before
+///
+/// \retval true    version did not change
+/// \retval false   version changed
+static inline bool art_version_check(const atomic_uint *version, unsigned int value)
+{
+    atomic_thread_fence(memory_order_acquire);
+
+    return atomic_load_explicit(version, memory_order_relaxed) == value;
+}
+
+/// Lock version.
+///
+/// Only writers holding the writer lock may lock versions.
+///
+/// \param version  version to lock
+static inline void art_version_lock(atomic_uint *version)
+{
+    atomic_store_explicit(version,
+        atomic_load_explicit(version, memory_order_relaxed) + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+}
+
+/// Unlock version.
+///
+/// \param version  version to unlock
+static inline void art_version_unlock(atomic_uint *version)
+{
+    atomic_store_explicit(version,
+        atomic_load_explicit(version, memory_order_relaxed) + 1, memory_order_release);
+}
+
+/// Lock node for modification in concurrent mode.
+///
+/// \param art      ART
+/// \param node     node to lock, NULL to lock root slot
+static inline void art_node_lock(art_const_ct art, art_node_ct node)
+{
+    if(art->sync)
+        art_version_lock(node ? &node->version : &art->sync->root);
+}
+
+/// Unlock node after modification in concurrent mode.
+///
+/// \param art      ART
+/// \param node     node to unlock, NULL to unlock root slot
+static inline void art_node_unlock(art_const_ct art, art_node_ct node)
+{
+    if(art->sync)
+        art_version_unlock(node ? &node->version : &art->sync->root);
+}
+
+/// Begin read section in concurrent mode.
+///
+/// \param art      ART
+///
+/// \returns        reader counter to pass to art_read_end()
+static atomic_size_t *art_read_begin(art_const_ct art)
+{
+    atomic_size_t *count;
+    unsigned int epoch;
+
+    if(art_sync_stripe == SIZE_MAX)
+        art_sync_stripe = atomic_fetch_add(&art_sync_stripes, 1) % SYNC_STRIPES;
+
+    while(1)
+    {
+        epoch = atomic_load(&art->sync->epoch);
+        count = &art->sync->readers[epoch & 1][art_sync_stripe].count;
+
+        atomic_fetch_add(count, 1);
+
+        if(atomic_load(&art->sync->epoch) == epoch)
+            return count;
+
+        atomic_fetch_sub(count, 1);
+    }
+}
+
+/// End read section in concurrent mode.
+///
+/// \param count    reader counter returned by art_read_begin()
+static inline void art_read_end(atomic_size_t *count)
+{
+    atomic_fetch_sub_explicit(count, 1, memory_order_release);
+}
+
+/// Begin write section.
+///
+/// In concurrent mode acquire the writer lock.
+///
+/// \param art      ART
+static inline void art_write_begin(art_const_ct art)
+{
+    if(art->sync)
+        while(atomic_flag_test_and_set_explicit(&art->sync->writer, memory_order_acquire))
+            sched_yield();
+}
+
+static void art_sync_reclaim(art_ct art);
+
+/// End write section.
+///
+/// In concurrent mode free retired nodes if enough were collected
+/// and release the writer lock.
+///
+/// \param art      ART
+static inline void art_write_end(art_ct art)
+{
+    if(art->sync)
+    {
+        if(art->sync->retired_count >= SYNC_RETIRE)
+            art_sync_reclaim(art);
+
+        atomic_flag_clear_explicit(&art->sync->writer, memory_order_release);
+    }
+}
+
 
 /// Get transient lookup path from key.
 ///
@@ -227,40 +553,47 @@ ERROR_DEFINE_LIST(ART,
 /// \returns        node path
 static inline unsigned char *art_node_get_path(art_node_const_ct node)
 {
-    if(node->path_len <= sizeof(unsigned char *))
-        return (unsigned char *)&node->path;
+    if(node->path_len <= PATH_INLINE)
+        return (unsigned char *)node->path.data;
     else
-        return node->path;
+        return node->path.heap.data;
 }
 
 /// Drop prefix from node path.
 ///
+/// \param art      ART
 /// \param node     node to drop path from
 /// \param prefix   number of bytes to drom from path
-static void art_node_drop_path(art_node_ct node, size_t prefix)
+static void art_node_drop_path(art_ct art, art_node_ct node, size_t prefix)
 {
     size_t len = node->path_len - prefix;
     unsigned char *path;
 
-    if(node->path_len <= sizeof(unsigned char *))
+    if(node->path_len <= PATH_INLINE)
     {
-        path = (unsigned char *)&node->path;
-        memcpy(path, &path[prefix], len);
+        path = node->path.data;
+        memmove(path, &path[prefix], len);
     }
-    else if(len <= sizeof(unsigned char *))
+    else if(len <= PATH_INLINE)
     {
-        path = node->path;
-        memcpy(&node->path, &node->path[prefix], len);
+        path = node->path.heap.data;
+        memcpy(node->path.data, &path[prefix], len);
         free(path);
-    }
-    else if((path = memdup(&node->path[prefix], len)))
-    {
-        free(node->path);
-        node->path = path;
+        art->heap--;
     }
     else
     {
-        memmove(node->path, &node->path[prefix], len);
+        if((path = memdup(&node->path.heap.data[prefix], len)))
+        {
+            free(node->path.heap.data);
+            node->path.heap.data = path;
+        }
+        else
+        {
+            memmove(node->path.heap.data, &node->path.heap.data[prefix], len);
+        }
+
+        memcpy(node->path.heap.prefix, node->path.heap.data, PATH_PREFIX);
     }
 
     node->path_len = len;
@@ -268,6 +601,7 @@ static void art_node_drop_path(art_node_ct node, size_t prefix)
 
 /// Prepend prefix and key to node path.
 ///
+/// \param art      ART
 /// \param node     node to prepend path to
 /// \param prefix   prefix to prepend
 /// \param len      length of \p prefix
@@ -275,13 +609,13 @@ static void art_node_drop_path(art_node_ct node, size_t prefix)
 ///
 /// \retval 0                   success
 /// \retval -1/E_GENERIC_OOM    ouf of memory
-static int art_node_prepend_path(art_node_ct node, const unsigned char *prefix, size_t len, unsigned char key)
+static int art_node_prepend_path(art_ct art, art_node_ct node, const unsigned char *prefix, size_t len, unsigned char key)
 {
     unsigned char *path;
 
-    if(node->path_len + len + 1 <= sizeof(unsigned char *))
+    if(node->path_len + len + 1 <= PATH_INLINE)
     {
-        path = art_node_get_path(node);
+        path = node->path.data;
         memmove(&path[len + 1], path, node->path_len);
         memcpy(path, prefix, len);
         path[len] = key;
@@ -295,10 +629,13 @@ static int art_node_prepend_path(art_node_ct node, const unsigned char *prefix,
         path[len] = key;
         memcpy(&path[len + 1], art_node_get_path(node), node->path_len);
 
-        if(node->path_len > sizeof(unsigned char *))
-            free(node->path);
+        if(node->path_len > PATH_INLINE)
+            free(node->path.heap.data);
+        else
+            art->heap++;
 
-        node->path = path;
+        node->path.heap.data = path;
+        memcpy(node->path.heap.prefix, path, PATH_PREFIX);
     }
 
     node->path_len += len + 1;
@@ -421,6 +758,24 @@ static inline art_node_ct *art_node32_get_child(art_node_const_ct node, unsigned
     return index < 0 ? NULL : (art_node_ct *)&node->v.n32.child[index];
 }
 
+#if NODE64_LIST
+/// Get child node slot from a node64.
+///
+/// Uses AVX-512BW or two AVX2 compares.
+///
+/// \param node     node to get child from
+/// \param key      key of child node
+///
+/// \returns        child node slot
+/// \retval NULL    key not found
+static inline art_node_ct *art_node64_get_child(art_node_const_ct node, unsigned char key)
+{
+    int index = simd512_index8(node->v.n64.key, node->size, key);
+
+    return index < 0 ? NULL : (art_node_ct *)&node->v.n64.child[index];
+}
+#endif
+
 /// Get child node slot from node.
 ///
 /// \param node     node to get child from
@@ -447,9 +802,13 @@ static art_node_ct *art_node_get_child(art_node_const_ct node, unsigned char key
         return art_node32_get_child(node, key);
 
     case NODE64:
+#if NODE64_LIST
+        return art_node64_get_child(node, key);
+#else
         index = node->v.n64.key[key];
 
         return index == 0xff ? NULL : (art_node_ct *)&node->v.n64.child[index];
+#endif
 
     case NODE128:
         index = node->v.n128.key[key];
@@ -515,6 +874,149 @@ static art_node_ct art_lookup(art_const_ct art, art_node_const_ct node, str_ct k
     }
 }
 
+/// Find leaf node which full path matches key optimistically.
+///
+/// Only the inline part of node paths is compared on the way down,
+/// the heap allocated remainder of long paths is skipped.
+/// The full key is verified once at the leaf.
+///
+/// \param art      ART
+/// \param key      key to match
+///
+/// \returns        matching leaf node
+/// \retval NULL    no leaf node matches \p key
+static art_node_ct art_lookup_optimistic(art_const_ct art, str_const_ct key)
+{
+    const unsigned char *bytes = str_buc(key);
+    size_t len = str_len(key), depth = 0;
+    art_node_ct node, *child;
+
+    for(node = art->root; node; node = *child)
+    {
+        if(depth + node->path_len > len)
+            return NULL;
+
+        if(memcmp(node->path.data, &bytes[depth],
+            node->path_len <= PATH_INLINE ? node->path_len : PATH_PREFIX))
+            return NULL;
+
+        depth += node->path_len;
+
+        if(node->type == LEAF)
+            return node->v.leaf.key->len == len && !memcmp(node->v.leaf.key->data, bytes, len) ? node : NULL;
+
+        if(depth == len || !(child = art_node_get_child(node, bytes[depth])))
+            return NULL;
+
+        depth++;
+    }
+
+    return NULL;
+}
+
+/// Descend ART along key in concurrent mode.
+///
+/// Only the inline part of node paths is compared on the way down.
+/// Each child pointer is validated against the version of its parent
+/// before the child is touched, so stale slots are never dereferenced.
+/// The parent is validated again after the child version was read.
+///
+/// \param      art      ART
+/// \param      key      key to descend along
+/// \param      len      key length
+/// \param      prefix   if true stop at first node covering \p key, else descend to leaf
+/// \param[out] node     reached node, NULL if \p key does not match
+/// \param[out] version  version of reached node
+///
+/// \retval true         descent is consistent
+/// \retval false        concurrent modification detected, restart
+static bool art_descend_concurrent(art_const_ct art, const unsigned char *key, size_t len, bool prefix, art_node_ct *node, unsigned int *version)
+{
+    const atomic_uint *owner = &art->sync->root;
+    unsigned int owner_version, child_version;
+    art_node_ct child, *slot;
+    size_t depth = 0, path_len;
+
+    *node = NULL;
+
+    if(!art_version_read(owner, &owner_version))
+        return false;
+
+    child = art->root;
+
+    if(!art_version_check(owner, owner_version))
+        return false;
+
+    for(; child; depth++)
+    {
+        if(  !art_version_read(&child->version, &child_version)
+          || !art_version_check(owner, owner_version))
+            return false;
+
+        owner           = &child->version;
+        owner_version   = child_version;
+        path_len        = child->path_len;
+
+        if(memcmp(child->path.data, &key[depth],
+            MIN(path_len <= PATH_INLINE ? path_len : PATH_PREFIX, len - depth)))
+            break;
+
+        if(prefix && depth + path_len >= len)
+        {
+            *node       = child;
+            *version    = child_version;
+            break;
+        }
+
+        if(depth + path_len > len)
+            break;
+
+        depth += path_len;
+
+        if(child->type == LEAF)
+        {
+            *node       = child;
+            *version    = child_version;
+            break;
+        }
+
+        if(depth == len || !(slot = art_node_get_child(child, key[depth])))
+            break;
+
+        child = *slot;
+
+        if(!art_version_check(owner, owner_version))
+            return false;
+    }
+
+    return art_version_check(owner, owner_version);
+}
+
+/// Find leaf node which full path matches key in concurrent mode.
+///
+/// Must be called inside a read section.
+///
+/// \param art      ART
+/// \param key      key to match
+///
+/// \returns        matching leaf node
+/// \retval NULL    no leaf node matches \p key
+static art_node_ct art_lookup_concurrent(art_const_ct art, str_const_ct key)
+{
+    const unsigned char *bytes = str_buc(key);
+    size_t len = str_len(key);
+    unsigned int version;
+    art_node_ct node;
+
+    while(!art_descend_concurrent(art, bytes, len, false, &node, &version))
+        sched_yield();
+
+    if(!node || node->v.leaf.key->len != len || memcmp(node->v.leaf.key->data, bytes, len))
+        return NULL;
+
+    return node;
+}
+
 /// ART traverse callback.
 ///
 /// \param art      ART
@@ -535,6 +1037,13 @@ typedef struct art_traverse_state
     bool            reverse;    ///< reverse traverse direction
     art_traverse_cb cb;         ///< traverse callback
     void            *ctx;       ///< traverse callback context
+
+    bool                sync;           ///< validate node versions, concurrent mode only
+    bool                restart;        ///< concurrent modification detected
+    const atomic_uint   *owner;         ///< version of node which children are traversed
+    unsigned int        owner_version;  ///< owner version value
+    const unsigned char *prefix;        ///< prefix leaf keys must match
+    size_t              prefix_len;     ///< prefix length
 } art_traverse_st;
 
 static int art_traverse_node(art_ct art, size_t pos, art_node_ct node, art_traverse_st *state);
@@ -579,7 +1088,7 @@ static int art_traverse_index(art_ct art, unsigned char *keys, art_node_ct *chil
     size_t i, pos;
     int rc;
 
-    for(i = 0, pos = 0; pos < size; i++)
+    for(i = 0, pos = 0; i < 256 && pos < size; i++)
         if((key = keys[state->reverse ? 255 - i : i]) != 0xff)
         {
             if((rc = art_traverse_node(art, pos, children[key], state)))
@@ -604,7 +1113,7 @@ static inline int art_traverse_node256(art_ct art, art_node_ct node, art_travers
     size_t i, pos;
     int rc;
 
-    for(i = 0, pos = 0; pos < node->size; i++)
+    for(i = 0, pos = 0; i < 256 && pos < node->size; i++)
         if((child = node->v.n256.child[state->reverse ? 255 - i : i]))
         {
             if((rc = art_traverse_node(art, pos, child, state)))
@@ -616,82 +1125,159 @@ static inline int art_traverse_node256(art_ct art, art_node_ct node, art_travers
     return 0;
 }
 
-/// Traverse children of node.
+/// Traverse children of inner node.
 ///
 /// \param art      ART
-/// \param pos      position of node in traverse direction
 /// \param node     node which children to traverse
 /// \param state    traverse state
 ///
-/// \returns                    traverse rc
-/// \retval -1/E_GENERIC_OOM    out of memory
-static int art_traverse_node(art_ct art, size_t pos, art_node_ct node, art_traverse_st *state)
+/// \returns        traverse rc
+static int art_traverse_children(art_ct art, art_node_ct node, art_traverse_st *state)
 {
-    size_t path_len = node->path_len;
-    int rc          = 0;
+    switch(node->type)
+    {
+    case NODE4:
+        return art_traverse_list(art, node->v.n4.child, node->size, state);
 
-    if(  state->order == TRAV_IN && node->parent && pos > 0
-      && (rc = error_pass_int(state->cb(art, node->parent, state->path, state->ctx))))
-        return rc;
+    case NODE8:
+        return art_traverse_list(art, node->v.n8.child, node->size, state);
 
-    if(state->path)
-    {
-        if(  (node->parent && !str_append_set(state->path, 1, node->key))
-          || !str_append_b(state->path, art_node_get_path(node), path_len))
-            return error_wrap(), -1;
+    case NODE16:
+        return art_traverse_list(art, node->v.n16.child, node->size, state);
 
-        if(node->parent)
-            path_len++; // remember to drop node->key
+    case NODE32:
+        return art_traverse_list(art, node->v.n32.child, node->size, state);
 
-    }
+    case NODE64:
+#if NODE64_LIST
+        return art_traverse_list(art, node->v.n64.child, node->size, state);
+#else
+        return art_traverse_index(art,
+            node->v.n64.key, node->v.n64.child, node->size, state);
+#endif
 
-    if(node->type == LEAF)
-    {
-        rc = error_pass_int(state->cb(art, node, state->path, state->ctx));
-    }
-    else
-    {
-        if(state->order == TRAV_PRE)
-            rc = error_pass_int(state->cb(art, node, state->path, state->ctx));
+    case NODE128:
+        return art_traverse_index(art,
+            node->v.n128.key, node->v.n128.child, node->size, state);
 
-        if(!rc)
-        {
-            switch(node->type)
-            {
-            case NODE4:
-                rc = art_traverse_list(art, node->v.n4.child, node->size, state);
-                break;
+    case NODE256:
+        return art_traverse_node256(art, node, state);
 
-            case NODE8:
-                rc = art_traverse_list(art, node->v.n8.child, node->size, state);
-                break;
+    default:
+        abort();
+    }
+}
 
-            case NODE16:
-                rc = art_traverse_list(art, node->v.n16.child, node->size, state);
-                break;
+/// Traverse leaf nodes in concurrent mode.
+///
+/// The node pointer is validated against the version of its parent before
+/// the node is touched and again after the node version was read.
+/// The node version is validated after the children were traversed.
+/// The node path is reconstructed from the leaf keys.
+///
+/// \param art      ART
+/// \param node     node which children to traverse
+/// \param state    traverse state
+///
+/// \returns                    traverse rc
+/// \retval 1                   restart if state->restart is set
+/// \retval -1/E_GENERIC_OOM    out of memory
+static int art_traverse_node_concurrent(art_ct art, art_node_ct node, art_traverse_st *state)
+{
+    const atomic_uint *owner = state->owner;
+    unsigned int version, owner_version = state->owner_version;
+    art_key_st *key;
+    int rc;
 
-            case NODE32:
-                rc = art_traverse_list(art, node->v.n32.child, node->size, state);
-                break;
+    if(owner && !art_version_check(owner, owner_version))
+        return state->restart = true, 1;
 
-            case NODE64:
-                rc = art_traverse_index(art,
-                    node->v.n64.key, node->v.n64.child, node->size, state);
-                break;
+    if(  !node || !art_version_read(&node->version, &version)
+      || (owner && !art_version_check(owner, owner_version)))
+        return state->restart = true, 1;
 
-            case NODE128:
-                rc = art_traverse_index(art,
-                    node->v.n128.key, node->v.n128.child, node->size, state);
-                break;
+    if(node->type != LEAF)
+    {
+        state->owner            = &node->version;
+        state->owner_version    = version;
 
-            case NODE256:
-                rc = art_traverse_node256(art, node, state);
-                break;
+        rc = art_traverse_children(art, node, state);
 
-            default:
-                abort();
-            }
-        }
+        state->owner            = owner;
+        state->owner_version    = owner_version;
+
+        if(!rc && !art_version_check(&node->version, version))
+            return state->restart = true, 1;
+
+        return rc;
+    }
+
+    key = node->v.leaf.key;
+
+    if(!art_version_check(&node->version, version))
+        return state->restart = true, 1;
+
+    // inline path compare on descent may have skipped part of the prefix
+    if(  state->prefix_len
+      && (key->len < state->prefix_len || memcmp(key->data, state->prefix, state->prefix_len)))
+        return 0;
+
+    if(state->path && !str_append_b(state->path, key->data, key->len))
+        return error_wrap(), -1;
+
+    rc = error_pass_int(state->cb(art, node, state->path, state->ctx));
+
+    if(state->path)
+        str_cut_tail(state->path, key->len);
+
+    return rc;
+}
+
+/// Traverse children of node.
+///
+/// \param art      ART
+/// \param pos      position of node in traverse direction
+/// \param node     node which children to traverse
+/// \param state    traverse state
+///
+/// \returns                    traverse rc
+/// \retval -1/E_GENERIC_OOM    out of memory
+static int art_traverse_node(art_ct art, size_t pos, art_node_ct node, art_traverse_st *state)
+{
+    size_t path_len;
+    int rc = 0;
+
+    if(state->sync)
+        return art_traverse_node_concurrent(art, node, state);
+
+    path_len = node->path_len;
+
+    if(  state->order == TRAV_IN && node->parent && pos > 0
+      && (rc = error_pass_int(state->cb(art, node->parent, state->path, state->ctx))))
+        return rc;
+
+    if(state->path)
+    {
+        if(  (node->parent && !str_append_set(state->path, 1, node->key))
+          || !str_append_b(state->path, art_node_get_path(node), path_len))
+            return error_wrap(), -1;
+
+        if(node->parent)
+            path_len++; // remember to drop node->key
+
+    }
+
+    if(node->type == LEAF)
+    {
+        rc = error_pass_int(state->cb(art, node, state->path, state->ctx));
+    }
+    else
+    {
+        if(state->order == TRAV_PRE)
+            rc = error_pass_int(state->cb(art, node, state->path, state->ctx));
+
+        if(!rc)
+            rc = art_traverse_children(art, node, state);
 
         if(!rc && state->order == TRAV_POST)
             rc = error_pass_int(state->cb(art, node, state->path, state->ctx));
@@ -755,1441 +1341,3520 @@ static int art_traverse(art_ct art, art_node_ct node, str_const_ct prefix, art_t
     return rc;
 }
 
-art_ct art_new(art_mode_id mode)
+/// Traverse leaf nodes of ART in concurrent mode.
+///
+/// Must be called inside a read section.
+/// Traversal is restarted from the top on concurrent modification,
+/// \p traverse may be invoked on the same node more than once.
+///
+/// \param art      ART
+/// \param prefix   prefix to lookup first, may be NULL
+/// \param key      if true reconstruct node key
+/// \param reverse  if true begin with largest key else smallest key
+/// \param traverse callback to invoke on each leaf node
+/// \param ctx      \p traverse context
+///
+/// \returns                    \p traverse rc
+/// \retval -1/E_ART_NOT_FOUND  no node with \p prefix found
+/// \retval -1/E_GENERIC_OOM    out of memory
+static int art_traverse_concurrent(art_ct art, str_const_ct prefix, bool key, bool reverse, art_traverse_cb traverse, void *ctx)
 {
-    art_ct art;
+    art_traverse_st state = { .order = TRAV_LEAF, .reverse = reverse, .cb = traverse, .ctx = ctx, .sync = true, .prefix = (const unsigned char *)"" };
+    unsigned int version;
+    art_node_ct node;
+    str_ct lookup;
+    int rc;
 
-    if(!(art = calloc(1, sizeof(art_st))))
-        return error_wrap_last_errno(calloc), NULL;
+    if(prefix)
+    {
+        lookup              = art_path_new(prefix);
+        state.prefix        = str_buc(lookup);
+        state.prefix_len    = str_len(lookup);
+    }
 
-    init_magic(art);
+    if(key && !(state.path = str_prepare_bc(0, 10)))
+        return error_wrap(), -1;
 
-    art->ordered = mode == ART_MODE_ORDERED;
+    if(key)
+        str_mark_volatile(state.path);
 
-    return art;
-}
+    do
+    {
+        state.restart = false;
 
-static int art_node_remove(art_ct art, art_node_ct node, str_const_ct prefix, art_dtor_cb dtor, const void *ctx);
+        while(!art_descend_concurrent(art, state.prefix, state.prefix_len, true, &node, &version))
+            sched_yield();
 
-void art_free(art_ct art)
-{
-    assert_magic(art);
+        if(!node)
+        {
+            error_set(E_ART_NOT_FOUND);
+            rc = -1;
+        }
+        else if(  !(rc = error_pass_int(art_traverse_node(art, 0, node, &state)))
+               && !art_version_check(&node->version, version))
+        {
+            state.restart = true;
+        }
 
-    art_node_remove(art, art->root, NO_PREFIX, NULL, NULL);
-    free(art);
-}
+        if(state.restart)
+            sched_yield();
+    }
+    while(state.restart);
 
-void art_free_f(art_ct art, art_dtor_cb dtor, const void *ctx)
-{
-    assert_magic(art);
+    if(key)
+        str_unref(state.path);
 
-    art_node_remove(art, art->root, NO_PREFIX, dtor, ctx);
-    free(art);
+    return rc;
 }
 
-art_ct art_free_if_empty(art_ct art)
+/// Get ART image node.
+///
+/// \param art      frozen ART
+/// \param offset   node offset
+///
+/// \returns        image node
+static inline const art_image_node_st *art_image_get_node(art_const_ct art, uint64_t offset)
 {
-    return art_free_if_empty_f(art, NULL, NULL);
+    return (const art_image_node_st *)((const unsigned char *)art->image + offset);
 }
 
-art_ct art_free_if_empty_f(art_ct art, art_dtor_cb dtor, const void *ctx)
+/// Get child offsets of ART image node.
+///
+/// \param node     image inner node
+///
+/// \returns        child offsets
+static const uint64_t *art_image_get_children(const art_image_node_st *node)
 {
-    assert_magic(art);
+    uint64_t len = sizeof(art_image_node_st) + node->path_len;
 
-    if(art->size)
-        return art;
+    switch(node->type)
+    {
+    case IMAGE_LIST:
+        len += node->size;
+        break;
 
-    art_free_f(art, dtor, ctx);
+    case IMAGE_INDEX:
+        len += 256;
+        break;
 
-    return NULL;
-}
+    case IMAGE_FULL:
+        break;
 
-void art_clear(art_ct art)
-{
-    assert_magic(art);
+    default:
+        abort();
+    }
 
-    art_node_remove(art, art->root, NO_PREFIX, NULL, NULL);
+    return (const uint64_t *)((const unsigned char *)node + IMAGE_PAD(len));
 }
 
-void art_clear_f(art_ct art, art_dtor_cb dtor, const void *ctx)
+/// Get child of ART image node.
+///
+/// \param node     image inner node
+/// \param key      child key
+///
+/// \returns        child offset
+/// \retval 0       child not found
+static uint64_t art_image_get_child(const art_image_node_st *node, unsigned char key)
 {
-    assert_magic(art);
-
-    art_node_remove(art, art->root, NO_PREFIX, dtor, ctx);
-}
+    const unsigned char *keys = node->path + node->path_len, *pos;
+    const uint64_t *children = art_image_get_children(node);
 
-bool art_is_empty(art_const_ct art)
-{
-    try_magic(art);
+    switch(node->type)
+    {
+    case IMAGE_LIST:
+        return (pos = memchr(keys, key, node->size)) ? children[pos - keys] : 0;
 
-    return !art || !art->size;
-}
+    case IMAGE_INDEX:
+        return keys[key] != 0xff ? children[keys[key]] : 0;
 
-size_t art_size(art_const_ct art)
-{
-    try_magic(art);
+    case IMAGE_FULL:
+        return children[key];
 
-    return art ? art->size : 0;
+    default:
+        abort();
+    }
 }
 
-/// Get ART node size.
+/// Lookup ART image node with prefix.
 ///
-/// \param type     node type
+/// \param art          frozen ART
+/// \param prefix       prefix to lookup
+/// \param[out] depth   length of \p prefix before path of returned node
 ///
-/// \returns        ART node size in bytes.
-static size_t art_node_size(art_node_id type)
+/// \returns            offset of first node with \p prefix
+/// \retval 0           no node with \p prefix found
+static uint64_t art_image_lookup(art_const_ct art, str_const_ct prefix, size_t *depth)
 {
-    size_t size = sizeof(art_node_st) - sizeof(art_value_un);
+    const unsigned char *key = str_buc(prefix);
+    const art_image_node_st *node;
+    const art_image_leaf_st *leaf;
+    size_t len = str_len(prefix), pos = 0;
+    uint64_t offset;
 
-    switch(type)
+    for(offset = art->image->root; offset; pos++)
     {
-    case LEAF:
-        return size + sizeof(art_leaf_st);
-
-    case NODE4:
-        return size + sizeof(art_node4_st);
+        node = art_image_get_node(art, offset);
+        *depth = pos;
 
-    case NODE8:
-        return size + sizeof(art_node8_st);
-
-    case NODE16:
-        return size + sizeof(art_node16_st);
+        if(node->type == IMAGE_LEAF)
+        {
+            leaf = (const art_image_leaf_st *)node;
 
-    case NODE32:
-        return size + sizeof(art_node32_st);
+            if(leaf->len < len || memcmp(&leaf->key[pos], &key[pos], len - pos))
+                return 0;
 
-    case NODE64:
-        return size + sizeof(art_node64_st);
+            return offset;
+        }
 
-    case NODE128:
-        return size + sizeof(art_node128_st);
+        if(memcmp(node->path, &key[pos], MIN(node->path_len, len - pos)))
+            return 0;
 
-    case NODE256:
-        return size + sizeof(art_node256_st);
+        if((pos += node->path_len) >= len)
+            return offset;
 
-    default:
-        abort();
+        offset = art_image_get_child(node, key[pos]);
     }
+
+    return 0;
 }
 
-/// ART memsize state
-typedef struct art_memsize_state
+/// Get leaf node of frozen ART.
+///
+/// \param art      frozen ART
+/// \param key      node key
+///
+/// \returns                        ART image leaf node
+/// \retval NULL/E_ART_NOT_FOUND    node not found
+static art_node_ct art_image_get(art_const_ct art, str_const_ct key)
 {
-    art_size_cb nsize;  ///< node data size callback
-    void        *ctx;   ///< node data size callback context
-    size_t      size;   ///< size accumulator
-} art_memsize_st;
+    const art_image_leaf_st *leaf;
+    str_ct path = art_path_new(key);
+    uint64_t offset;
+    size_t depth;
+
+    if(  !(offset = art_image_lookup(art, path, &depth))
+      || (leaf = (const art_image_leaf_st *)art_image_get_node(art, offset))->type != IMAGE_LEAF
+      || leaf->len != str_len(path))
+        return error_set(E_ART_NOT_FOUND), NULL;
 
-/// ART traverse callback for accumulating allocated ART size.
+    return (art_node_ct)leaf;
+}
+
+/// Traverse leaf nodes of ART image node.
 ///
-/// \implements art_traverse_cb
+/// \param art      frozen ART
+/// \param offset   node offset
+/// \param state    traverse state
 ///
-/// \retval 0   always success
-static int art_traverse_memsize(art_ct art, art_node_ct node, str_ct path, void *ctx)
+/// \returns        traverse rc
+static int art_image_traverse_node(art_ct art, uint64_t offset, art_traverse_st *state)
 {
-    art_memsize_st *state = ctx;
+    const art_image_node_st *node = art_image_get_node(art, offset);
+    const art_image_leaf_st *leaf;
+    const uint64_t *children;
+    size_t i, size;
+    int rc;
+
+    if(node->type == IMAGE_LEAF)
+    {
+        leaf = (const art_image_leaf_st *)node;
 
-    state->size += art_node_size(node->type);
+        if(state->path)
+        {
+            str_clear(state->path);
 
-    if(node->path_len > sizeof(unsigned char *))
-        state->size += node->path_len;
+            if(!str_append_b(state->path, leaf->key, leaf->len))
+                return error_wrap(), -1;
+        }
 
-    if(node->type == LEAF && state->nsize)
-        state->size += state->nsize(art, node->v.leaf.data, state->ctx);
+        return error_pass_int(state->cb(art, (art_node_ct)leaf, state->path, state->ctx));
+    }
+
+    children    = art_image_get_children(node);
+    size        = node->type == IMAGE_FULL ? 256 : node->size;
+
+    for(i = 0; i < size; i++)
+        if(  (offset = children[state->reverse ? size - i - 1 : i])
+          && (rc = art_image_traverse_node(art, offset, state)))
+            return rc;
 
     return 0;
 }
 
-size_t art_memsize(art_const_ct art)
+/// Traverse leaf nodes of frozen ART in ascending or descending key order.
+///
+/// \param art      frozen ART
+/// \param prefix   prefix to lookup first, may be NULL
+/// \param key      if true pass node key
+/// \param reverse  if true begin with largest key else smallest key
+/// \param traverse callback to invoke on each leaf node
+/// \param ctx      \p traverse context
+///
+/// \returns                    \p traverse rc
+/// \retval -1/E_ART_NOT_FOUND  no node with \p prefix found
+/// \retval -1/E_GENERIC_OOM    out of memory
+static int art_image_traverse(art_ct art, str_const_ct prefix, bool key, bool reverse, art_traverse_cb traverse, void *ctx)
 {
-    return art_memsize_f(art, NULL, NULL);
-}
+    art_traverse_st state = { .order = TRAV_LEAF, .reverse = reverse, .cb = traverse, .ctx = ctx };
+    uint64_t offset = art->image->root;
+    size_t depth;
+    int rc;
 
-size_t art_memsize_f(art_const_ct art, art_size_cb size, const void *ctx)
-{
-    art_memsize_st state = { .nsize = size, .ctx = (void *)ctx, .size = sizeof(art_st) };
+    if(prefix && offset)
+        offset = art_image_lookup(art, art_path_new(prefix), &depth);
 
-    assert_magic(art);
+    return_error_if_fail(offset, E_ART_NOT_FOUND, -1);
 
-    art_traverse((art_ct)art, art->root, NO_PREFIX, TRAV_PRE, WITHOUT_KEY, FORWARD, art_traverse_memsize, &state);
+    if(key && !(state.path = str_prepare_bc(0, 10)))
+        return error_wrap(), -1;
 
-    return state.size;
+    if(key)
+        str_mark_volatile(state.path);
+
+    rc = error_pass_int(art_image_traverse_node(art, offset, &state));
+
+    if(key)
+        str_unref(state.path);
+
+    return rc;
 }
 
-str_ct art_node_key(art_node_const_ct node)
+/// Complete prefix to longest unambiguous key in frozen ART.
+///
+/// \param art      frozen ART
+/// \param prefix   prefix to complete, may be NULL
+///
+/// \returns                        completed prefix
+/// \retval NULL/E_ART_EMPTY        ART is empty
+/// \retval NULL/E_ART_NOT_FOUND    \p prefix not found
+/// \retval NULL/E_GENERIC_OOM      out of memory
+static str_ct art_image_complete(art_const_ct art, str_const_ct prefix)
 {
-    str_ct key;
+    const art_image_node_st *node;
+    const art_image_leaf_st *leaf;
+    uint64_t offset = art->image->root;
+    size_t depth = 0, len = 0;
+    str_ct lookup, path;
 
-    assert_magic_n(&node->v.leaf, NODE_MAGIC);
+    return_error_if_fail(offset, E_ART_EMPTY, NULL);
 
-    if(!(key = str_dup_b(art_node_get_path(node), node->path_len)))
+    if(prefix && !str_is_empty(prefix))
+    {
+        lookup  = art_path_new(prefix);
+        len     = str_len(lookup);
+        offset  = art_image_lookup(art, lookup, &depth);
+        return_error_if_fail(offset, E_ART_NOT_FOUND, NULL);
+    }
+
+    if(!(path = str_prepare_bc(0, 10)))
         return error_wrap(), NULL;
 
-    for(; node->parent; node = node->parent)
-        if(  !str_prepend_b(key, &node->key, 1)
-          || !str_prepend_b(key, art_node_get_path(node->parent), node->parent->path_len))
-            return error_wrap(), str_unref(key), NULL;
+    for(node = art_image_get_node(art, offset); ; node = art_image_get_node(art, offset))
+    {
+        if(node->type == IMAGE_LEAF)
+        {
+            leaf = (const art_image_leaf_st *)node;
 
-    return key;
-}
+            if(!str_append_b(path, &leaf->key[len], leaf->len - len))
+                return error_wrap(), str_unref(path), NULL;
 
-void *art_node_data(art_node_const_ct node)
-{
-    assert_magic_n(&node->v.leaf, NODE_MAGIC);
+            return path;
+        }
 
-    return node->v.leaf.data;
+        if(!str_append_b(path, &node->path[len - depth], node->path_len - (len - depth)))
+            return error_wrap(), str_unref(path), NULL;
+
+        // nodes with 1 child may happen if a merge fails
+        if(node->size != 1)
+            return path;
+
+        len     = depth = depth + node->path_len + 1;
+        offset  = art_image_get_children(node)[0];
+
+        if(!str_append_set(path, 1, node->path[node->path_len]))
+            return error_wrap(), str_unref(path), NULL;
+    }
 }
 
-void art_node_set(art_node_ct node, const void *data)
+/// ART image dtor state
+typedef struct art_image_dtor_state
 {
-    assert_magic_n(&node->v.leaf, NODE_MAGIC);
+    art_dtor_cb dtor;   ///< node dtor
+    void        *ctx;   ///< node dtor context
+} art_image_dtor_st;
 
-    node->v.leaf.data = (void *)data;
+/// ART traverse callback for destroying data of image leaf nodes.
+///
+/// \implements art_traverse_cb
+///
+/// \retval 0   always success
+static int art_traverse_image_dtor(art_ct art, art_node_ct node, str_ct path, void *ctx)
+{
+    art_image_dtor_st *state = ctx;
+
+    state->dtor(art, art_node_data(node), state->ctx);
+
+    return 0;
 }
 
-art_node_ct art_get(art_const_ct art, str_const_ct key)
+/// Unmap ART image.
+///
+/// \param image    mapped image
+/// \param len      image length
+static void art_image_unmap(const art_image_st *image, size_t len)
 {
-    art_node_ct node;
-    str_ct path;
+#if OS_UNIX
+    munmap((void *)image, len);
+#else
+    (void)len;
+    free((void *)image);
+#endif
+}
 
-    assert_magic(art);
+/// Map ART image file.
+///
+/// \param file     image file
+///
+/// \returns                        mapped image
+/// \retval NULL/E_ART_FILE         failed to open \p file
+/// \retval NULL/E_ART_IMAGE        \p file is no ART image of this platform
+/// \retval NULL/E_GENERIC_SYSTEM   failed to map \p file
+/// \retval NULL/E_GENERIC_OOM      out of memory
+static const art_image_st *art_image_map(str_const_ct file)
+{
+    art_image_st *image;
+    size_t len;
+#if OS_UNIX
+    struct stat st;
+    int fd;
 
-    path = art_path_new(key);
+    if((fd = open(str_c(file), O_RDONLY)) < 0)
+        return error_pack_last_errno(E_ART_FILE, open), NULL;
 
-    if(  !(node = art_lookup(art, art->root, path, NULL, NULL))
-      || node->type != LEAF
-      || !str_is_empty(path))
-        return error_set(E_ART_NOT_FOUND), NULL;
+    if(fstat(fd, &st))
+        return error_wrap_last_errno(fstat), close(fd), NULL;
 
-    return node;
+    if((len = st.st_size) < sizeof(art_image_st))
+        return error_set(E_ART_IMAGE), close(fd), NULL;
+
+    image = mmap(NULL, len, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if(image == MAP_FAILED)
+        return error_wrap_last_errno(mmap), NULL;
+
+#else // if OS_UNIX
+    FILE *fp;
+    long size;
+
+    if(!(fp = fopen(str_c(file), "rb")))
+        return error_pack_last_errno(E_ART_FILE, fopen), NULL;
+
+    if(fseek(fp, 0, SEEK_END) || (size = ftell(fp)) < 0 || fseek(fp, 0, SEEK_SET))
+        return error_wrap_last_errno(fseek), fclose(fp), NULL;
+
+    if((len = size) < sizeof(art_image_st))
+        return error_set(E_ART_IMAGE), fclose(fp), NULL;
+
+    if(!(image = malloc(len)))
+        return error_wrap_last_errno(malloc), fclose(fp), NULL;
+
+    if(fread(image, len, 1, fp) != 1)
+        return error_wrap_last_errno(fread), free(image), fclose(fp), NULL;
+
+    fclose(fp);
+#endif // if OS_UNIX
+
+    if(  memcmp(image->magic, IMAGE_MAGIC, sizeof(image->magic))
+      || image->version != IMAGE_VERSION
+      || image->ptr_size != sizeof(void *)
+      || image->len != len
+      || image->root >= len)
+        return error_set(E_ART_IMAGE), art_image_unmap(image, len), NULL;
+
+    return image;
 }
 
-void *art_get_data(art_const_ct art, str_const_ct key)
+art_ct art_open_mmap(str_const_ct file)
 {
-    art_node_ct node;
+    const art_image_st *image;
+    art_ct art;
 
-    if(!(node = art_get(art, key)))
+    assert(file);
+
+    if(!(image = art_image_map(file)))
         return error_pass(), NULL;
 
-    return node->v.leaf.data;
+    if(!(art = calloc(1, sizeof(art_st))))
+        return error_wrap_last_errno(calloc), art_image_unmap(image, image->len), NULL;
+
+    init_magic(art);
+
+    art->ordered    = true;
+    art->image      = image;
+    art->size       = image->size;
+
+    return art;
 }
 
-/// Create new ART node.
-///
-/// \param type     node type
-/// \param key      node key
-/// \param parent   parent node
-/// \param path     node path to set, may be NULL
-///
-/// \returns                    new ART node
-/// \retval NULL/E_GENERIC_OOM  out of memory
-static art_node_ct art_node_new(art_node_id type, unsigned char key, art_node_ct parent, str_const_ct path)
+art_ct art_new(art_mode_id mode)
 {
-    art_node_ct node;
+    art_ct art;
 
-    if(!(node = calloc(1, art_node_size(type))))
+    if(!(art = calloc(1, sizeof(art_st))))
         return error_wrap_last_errno(calloc), NULL;
 
-    if(path)
+    init_magic(art);
+
+    art->ordered    = !(mode & ART_MODE_UNORDERED);
+    art->optimistic = !!(mode & (ART_MODE_OPTIMISTIC | ART_MODE_CONCURRENT));
+    art->slab       = !!(mode & ART_MODE_SLAB);
+
+    if((mode & ART_MODE_CONCURRENT) && !(art->sync = calloc(1, sizeof(art_sync_st))))
+        return error_wrap_last_errno(calloc), free(art), NULL;
+
+    return art;
+}
+
+static int art_node_remove(art_ct art, art_node_ct node, str_const_ct prefix, art_dtor_cb dtor, const void *ctx);
+
+/// Destroy and remove all nodes from ART.
+///
+/// In slab mode without destructor and without heap allocated paths and keys
+/// all slabs are released without traversing the nodes.
+///
+/// \param art      ART
+/// \param dtor     callback to destroy node data, may be NULL
+/// \param ctx      \p dtor context
+static void art_remove_all(art_ct art, art_dtor_cb dtor, const void *ctx)
+{
+    art_slab_st *slab, *next;
+
+    if(art->image)
     {
-        if(str_len(path) <= sizeof(unsigned char *))
-            memcpy(&node->path, str_bc(path), str_len(path));
-        else if(!(node->path = memdup(str_bc(path), str_len(path))))
-            return error_wrap_last_errno(memdup), NULL;
+        if(dtor)
+            art_image_traverse(art, NO_PREFIX, WITHOUT_KEY, FORWARD, art_traverse_image_dtor, &(art_image_dtor_st){ .dtor = dtor, .ctx = (void *)ctx });
+
+        art_image_unmap(art->image, art->image->len);
+        art->image  = NULL;
+        art->size   = 0;
+
+        return;
     }
 
-    switch(type)
+    if(art->slab && !art->sync && !dtor && !art->heap)
     {
-    case NODE64:
-        memset(node->v.n64.key, 0xff, sizeof(node->v.n64.key));
-        break;
+        art->root = NULL;
+        art->size = 0;
+    }
+    else
+    {
+        art_node_remove(art, art->root, NO_PREFIX, dtor, ctx);
+    }
 
-    case NODE128:
-        memset(node->v.n128.key, 0xff, sizeof(node->v.n128.key));
-        break;
+    // readers may still access retired nodes inside the slabs
+    if(art->sync && art->sync->retired)
+        art_sync_reclaim(art);
 
-    default:
-        break;
+    for(slab = art->slabs; slab; slab = next)
+    {
+        next = slab->next;
+        free(slab);
     }
 
-    node->type      = type;
-    node->path_len  = path ? str_len(path) : 0;
-    node->key       = key;
-    node->parent    = parent;
-
-    return node;
+    art->slabs      = NULL;
+    art->slab_mem   = 0;
+    memset(art->pool, 0, sizeof(art->pool));
 }
 
-/// Create new ART leaf node.
-///
-/// \param art      ART node belongs to
-/// \param path     node path to set, may be NULL
-/// \param data     node data to set
-///
-/// \returns                    new ART leaf node
-/// \retval NULL/E_GENERIC_OOM  out of memory
-static art_node_ct art_node_new_leaf(art_ct art, str_const_ct path, const void *data)
+void art_free(art_ct art)
 {
-    art_node_ct node;
+    assert_magic(art);
 
-    if(!(node = art_node_new(LEAF, '\0', NULL, path)))
-        return error_pass(), NULL;
+    art_remove_all(art, NULL, NULL);
+    free(art->sync);
+    free(art);
+}
 
-    init_magic_n(&node->v.leaf, NODE_MAGIC);
-    DEBUG(node->v.leaf.art  = art);
-    node->v.leaf.data       = (void *)data;
+void art_free_f(art_ct art, art_dtor_cb dtor, const void *ctx)
+{
+    assert_magic(art);
 
-    return node;
+    art_remove_all(art, dtor, ctx);
+    free(art->sync);
+    free(art);
 }
 
-/// Copy list node to another list node.
-///
-/// \param node2        destination node
-/// \param keys2        destination keys
-/// \param children2    destination children
-/// \param node1        source node
-/// \param keys1        source keys
-/// \param children1    source children
-static inline void art_node_copy_list(art_node_ct node2, unsigned char *keys2, art_node_ct *children2, art_node_ct node1, unsigned char *keys1, art_node_ct *children1)
+art_ct art_free_if_empty(art_ct art)
 {
-    size_t n;
+    return art_free_if_empty_f(art, NULL, NULL);
+}
 
-    memcpy(keys2, keys1, node1->size);
-    memcpy(children2, children1, node1->size * sizeof(art_node_ct));
+art_ct art_free_if_empty_f(art_ct art, art_dtor_cb dtor, const void *ctx)
+{
+    assert_magic(art);
 
-    for(n = 0; n < node1->size; n++)
-        children1[n]->parent = node2;
+    if(art->size)
+        return art;
+
+    art_free_f(art, dtor, ctx);
+
+    return NULL;
 }
 
-/// Copy node32 to node64.
-///
-/// \param n64      destination node
-/// \param n32      source node
-static inline void art_node32_to_node64(art_node_ct n64, art_node_ct n32)
+void art_clear(art_ct art)
 {
-    size_t n;
-
-    for(n = 0; n < n32->size; n++)
-    {
-        n64->v.n64.key[n32->v.n32.key[n]]   = n;
-        n64->v.n64.child[n]                 = n32->v.n32.child[n];
-        n64->v.n64.child[n]->parent         = n64;
-    }
+    art_clear_f(art, NULL, NULL);
 }
 
-/// Copy node64 to node128.
-///
-/// \param n128     destination node
-/// \param n64      source node
-static inline void art_node64_to_node128(art_node_ct n128, art_node_ct n64)
+void art_clear_f(art_ct art, art_dtor_cb dtor, const void *ctx)
 {
-    size_t n;
+    assert_magic(art);
 
-    memcpy(n128->v.n128.key, n64->v.n64.key, 256);
-    memcpy(n128->v.n128.child, n64->v.n64.child, n64->size * sizeof(art_node_ct));
+    art_write_begin(art);
+    art_remove_all(art, dtor, ctx);
+    art_write_end(art);
+}
 
-    for(n = 0; n < n64->size; n++)
-        n64->v.n64.child[n]->parent = n128;
+bool art_is_empty(art_const_ct art)
+{
+    try_magic(art);
+
+    return !art || !art->size;
 }
 
-/// Copy node128 to node256.
-///
-/// \param n256     destination node
-/// \param n128     source node
-static inline void art_node128_to_node256(art_node_ct n256, art_node_ct n128)
+size_t art_size(art_const_ct art)
 {
-    size_t n;
+    try_magic(art);
 
-    for(n = 0; n < 256; n++)
-        if(n128->v.n128.key[n] != 0xff)
-        {
-            n256->v.n256.child[n]           = n128->v.n128.child[n128->v.n128.key[n]];
-            n256->v.n256.child[n]->parent   = n256;
-        }
+    return art ? art->size : 0;
 }
 
-/// Grow ART node to next bigger size.
+/// Get ART node size.
 ///
-/// \param slot     slot of node to grow
+/// \param type     node type
 ///
-/// \returns                    new node
-/// \retval NULL/E_GENERIC_OOM  out of memory
-static art_node_ct art_node_grow(art_node_ct *slot)
+/// \returns        ART node size in bytes.
+static size_t art_node_size(art_node_id type)
 {
-    art_node_ct node1 = *slot, node2;
-
-    if(!(node2 = art_node_new(node1->type + 1, node1->key, node1->parent, NULL)))
-        return error_pass(), NULL;
+    size_t size = sizeof(art_node_st) - sizeof(art_value_un);
 
-    switch(node1->type)
+    switch(type)
     {
+    case LEAF:
+        return size + sizeof(art_leaf_st);
+
     case NODE4:
-        art_node_copy_list(node2, node2->v.n8.key, node2->v.n8.child,
-            node1, node1->v.n4.key, node1->v.n4.child);
-        break;
+        return size + sizeof(art_node4_st);
 
     case NODE8:
-        art_node_copy_list(node2, node2->v.n16.key, node2->v.n16.child,
-            node1, node1->v.n8.key, node1->v.n8.child);
-        break;
+        return size + sizeof(art_node8_st);
 
     case NODE16:
-        art_node_copy_list(node2, node2->v.n32.key, node2->v.n32.child,
-            node1, node1->v.n16.key, node1->v.n16.child);
-        break;
+        return size + sizeof(art_node16_st);
 
     case NODE32:
-        art_node32_to_node64(node2, node1);
-        break;
+        return size + sizeof(art_node32_st);
 
     case NODE64:
-        art_node64_to_node128(node2, node1);
-        break;
+        return size + sizeof(art_node64_st);
 
     case NODE128:
-        art_node128_to_node256(node2, node1);
-        break;
+        return size + sizeof(art_node128_st);
+
+    case NODE256:
+        return size + sizeof(art_node256_st);
 
     default:
         abort();
     }
+}
 
-    node2->size     = node1->size;
-    node2->path     = node1->path;
-    node2->path_len = node1->path_len;
-
-    *slot = node2;
-    free(node1);
-
-    return node2;
-}
-
-/// Insert child node into list parent.
-///
-/// \param parent   parent to insert child into
-/// \param keys     parent keys
-/// \param children parent children
-/// \param key      key to insert into
-/// \param child    child node to insert
-/// \param index    position to insert at
-static inline void art_node_list_insert(art_node_ct parent, unsigned char *keys, art_node_ct *children, unsigned char key, art_node_ct child, int index)
+/// ART memsize state
+typedef struct art_memsize_state
 {
-    memmove(&keys[index + 1], &keys[index], parent->size - index);
-    memmove(&children[index + 1], &children[index], (parent->size - index) * sizeof(art_node_ct));
-
-    keys[index]     = key;
-    children[index] = child;
-}
+    art_size_cb nsize;  ///< node data size callback
+    void        *ctx;   ///< node data size callback context
+    size_t      size;   ///< size accumulator
+} art_memsize_st;
 
-#if SIMD64 || SIMD128 || SIMD256
-/// Append child node to list parent.
+/// ART traverse callback for accumulating allocated ART size.
 ///
-/// \param parent   parent to append child to
-/// \param keys     parent keys
-/// \param children parent children
-/// \param key      key to append with
-/// \param child    child node to append
-static inline void art_node_list_append(art_node_ct parent, unsigned char *keys, art_node_ct *children, unsigned char key, art_node_ct child)
-{
-    keys[parent->size]      = key;
-    children[parent->size]  = child;
-}
-#endif
-
-/// Insert child node into index parent.
+/// \implements art_traverse_cb
 ///
-/// \param parent   parent to insert child into
-/// \param keys     parent keys
-/// \param children parent children
-/// \param key      key to insert into
-/// \param child    child node to insert
-static inline void art_node_insert_index(art_node_ct parent, unsigned char *keys, art_node_ct *children, unsigned char key, art_node_ct child)
+/// \retval 0   always success
+static int art_traverse_memsize(art_ct art, art_node_ct node, str_ct path, void *ctx)
 {
-    keys[key]               = parent->size;
-    children[parent->size]  = child;
-}
+    art_memsize_st *state = ctx;
 
-/// Insert child node into node4.
-///
-/// \param parent   parent to insert child into
-/// \param key      key to insert into
-/// \param child    child node to insert
-static inline void art_node4_insert(art_node_ct parent, unsigned char key, art_node_ct child)
-{
-    size_t k;
+    // image nodes are accounted by the image length
+    if(art->image)
+    {
+        state->size += state->nsize(art, art_node_data(node), state->ctx);
 
-    for(k = 0; k < parent->size; k++)
-        if(key < parent->v.n4.key[k])
-            break;
+        return 0;
+    }
 
-    art_node_list_insert(parent, parent->v.n4.key, parent->v.n4.child, key, child, k);
-}
+    if(!art->slab)
+        state->size += art_node_size(node->type);
 
-/// Insert child node into node4.
-///
-/// \param parent   parent to insert child into
-/// \param key      key to insert into
-/// \param child    child node to insert
-/// \param ordered  if true insert keeping ascending order
-static inline void art_node8_insert(art_node_ct parent, unsigned char key, art_node_ct child, bool ordered)
-{
-#if SIMD64
+    if(node->path_len > PATH_INLINE)
+        state->size += node->path_len;
 
-    if(!ordered)
-        art_node_list_append(parent, parent->v.n8.key, parent->v.n8.child, key, child);
-    else
-#endif
-    art_node_list_insert(parent, parent->v.n8.key, parent->v.n8.child, key, child,
-        -art_node_find_child(parent->v.n8.key, parent->size, key) - 1);
-}
+    if(node->type == LEAF && node->v.leaf.key)
+        state->size += sizeof(art_key_st) + node->v.leaf.key->len;
 
-/// Insert child node into node16.
-///
-/// \param parent   parent to insert child into
-/// \param key      key to insert into
-/// \param child    child node to insert
-/// \param ordered  if true insert keeping ascending order
-static inline void art_node16_insert(art_node_ct parent, unsigned char key, art_node_ct child, bool ordered)
-{
-#if SIMD128
+    if(node->type == LEAF && state->nsize)
+        state->size += state->nsize(art, node->v.leaf.data, state->ctx);
 
-    if(!ordered)
-        art_node_list_append(parent, parent->v.n16.key, parent->v.n16.child, key, child);
-    else
-#endif
-    art_node_list_insert(parent, parent->v.n16.key, parent->v.n16.child, key, child,
-        -art_node_find_child(parent->v.n16.key, parent->size, key) - 1);
+    return 0;
 }
 
-/// Insert child node into node32.
-///
-/// \param parent   parent to insert child into
-/// \param key      key to insert into
-/// \param child    child node to insert
-/// \param ordered  if true insert keeping ascending order
-static inline void art_node32_insert(art_node_ct parent, unsigned char key, art_node_ct child, bool ordered)
+size_t art_memsize(art_const_ct art)
 {
-#if SIMD256
-
-    if(!ordered)
-        art_node_list_append(parent, parent->v.n32.key, parent->v.n32.child, key, child);
-    else
-#endif
-    art_node_list_insert(parent, parent->v.n32.key, parent->v.n32.child, key, child,
-        -art_node_find_child(parent->v.n32.key, parent->size, key) - 1);
+    return art_memsize_f(art, NULL, NULL);
 }
 
-/// Insert child node into parent node.
-///
-/// \param parent   parent node to insert child into
-/// \param key      key to insert info
-/// \param child    child node to insert
-/// \param ordered  if true insert keeping ascending order
-///
-/// \returns        \p child
-static art_node_ct art_node_insert(art_node_ct parent, unsigned char key, art_node_ct child, bool ordered)
+size_t art_memsize_f(art_const_ct art, art_size_cb size, const void *ctx)
 {
-    switch(parent->type)
-    {
-    case NODE4:
-        art_node4_insert(parent, key, child);
-        break;
-
-    case NODE8:
-        art_node8_insert(parent, key, child, ordered);
-        break;
+    art_memsize_st state = { .nsize = size, .ctx = (void *)ctx, .size = sizeof(art_st) };
 
-    case NODE16:
-        art_node16_insert(parent, key, child, ordered);
-        break;
+    assert_magic(art);
 
-    case NODE32:
-        art_node32_insert(parent, key, child, ordered);
-        break;
+    state.size += art->slab_mem;
 
-    case NODE64:
-        art_node_insert_index(parent, parent->v.n64.key, parent->v.n64.child, key, child);
-        break;
+    if(art->sync)
+        state.size += sizeof(art_sync_st);
 
-    case NODE128:
-        art_node_insert_index(parent, parent->v.n128.key, parent->v.n128.child, key, child);
-        break;
+    if(art->image)
+    {
+        state.size += art->image->len;
 
-    case NODE256:
-        parent->v.n256.child[key] = child;
-        break;
+        if(size)
+            art_image_traverse((art_ct)art, NO_PREFIX, WITHOUT_KEY, FORWARD, art_traverse_memsize, &state);
 
-    default:
-        abort();
+        return state.size;
     }
 
-    parent->size++;
-    child->key      = key;
-    child->parent   = parent;
+    art_write_begin(art);
+    art_traverse((art_ct)art, art->root, NO_PREFIX, TRAV_PRE, WITHOUT_KEY, FORWARD, art_traverse_memsize, &state);
+    art_write_end((art_ct)art);
 
-    return child;
+    return state.size;
 }
 
-/// Split node path and insert new node.
+/// ART traverse callback for collecting ART stats.
 ///
-/// \param art      ART
-/// \param slot     slot of node to split
-/// \param prefix   number of bytes to cut from child and assign to new parent
+/// \implements art_traverse_cb
 ///
-/// \returns                    new parent node
-/// \retval NULL/E_GENERIC_OOM  out of memory
-static art_node_ct art_node_split(art_ct art, art_node_ct *slot, size_t prefix)
+/// \retval 0   always success
+static int art_traverse_stats(art_ct art, art_node_ct node, str_ct path, void *ctx)
 {
-    art_node_ct child = *slot, inode;
-    unsigned char *path = art_node_get_path(child);
+    art_stats_st *stats = ctx;
+    art_node_const_ct parent;
+    size_t depth;
 
-    assert(prefix + 1 <= child->path_len);
+    // art_stats_node_id follows art_node_id
+    stats->nodes[node->type]++;
+    stats->memsize[node->type] += art_node_size(node->type);
+    stats->path_bytes += node->path_len;
 
-    if(!(inode = art_node_new(NODE4, child->key, child->parent, tstr_new_bs(path, prefix))))
-        return error_pass(), NULL;
+    if(node->path_len > PATH_INLINE)
+        stats->path_heap++;
 
-    *slot = inode;
+    if(node->type != LEAF)
+    {
+        stats->fill[node->type] += node->size; // normalized by art_stats
 
-    art_node_insert(inode, path[prefix], child, art->ordered);
-    art_node_drop_path(child, prefix + 1);
+        return 0;
+    }
 
-    return inode;
-}
+    for(depth = 0, parent = node->parent; parent; parent = parent->parent, depth++);
 
-/// Free ART node
-///
-/// \param node     node to free
-static void art_node_free(art_node_ct node)
-{
-    if(node->path_len > sizeof(unsigned char *))
-        free(node->path);
+    stats->depth[MIN(depth, ART_STATS_DEPTH - 1U)]++;
+    stats->depth_max = MAX(stats->depth_max, depth);
+    stats->depth_avg += depth;
 
-    free(node);
+    return 0;
 }
 
-art_node_ct art_insert(art_ct art, str_const_ct key, const void *data)
+int art_stats(art_const_ct art, art_stats_st *stats)
 {
-    art_node_ct leaf, node, *node_slot;
-    unsigned char leaf_key;
-    str_ct path;
-    size_t prefix_len;
+    art_node_id type;
 
     assert_magic(art);
+    assert(stats);
+    return_error_if_fail(!art->image, E_ART_FROZEN, -1);
 
-    path = art_path_new(key);
-    return_error_if_pass(str_is_empty(path), E_ART_INVALID_KEY, NULL);
+    memset(stats, 0, sizeof(art_stats_st));
 
-    if(!art->root)
-    {
-        if(!(leaf = art_node_new_leaf(art, path, data)))
-            return error_pass(), NULL;
+    art_write_begin(art);
 
-        art->root = leaf;
-        art->size++;
+    if(art->root)
+        art_traverse((art_ct)art, art->root, NO_PREFIX, TRAV_PRE, WITHOUT_KEY, FORWARD, art_traverse_stats, stats);
 
-        return leaf;
-    }
+    art_write_end((art_ct)art);
 
-    node = art_lookup(art, art->root, path, &prefix_len, &node_slot);
+    for(type = NODE4; type <= NODE256; type++)
+        if(stats->nodes[type])
+            stats->fill[type] /= (double)stats->nodes[type] * art_node_capacity(type);
 
-    if(  str_is_empty(path)
-      || (prefix_len == node->path_len && node->type == LEAF))
-        return error_set(E_ART_EXISTS), NULL;
+    if(stats->nodes[LEAF])
+        stats->depth_avg /= stats->nodes[LEAF];
 
-    leaf_key = str_first_u(path);
-    str_cut_head(path, 1);
+    return 0;
+}
 
-    if(!(leaf = art_node_new_leaf(art, path, data)))
-        return error_pass(), NULL;
+str_ct art_node_key(art_node_const_ct node)
+{
+    const art_image_leaf_st *leaf;
+    str_ct key;
 
-    if(prefix_len < node->path_len)
+    if(node->type == IMAGE_LEAF)
     {
-        if(!(node = art_node_split(art, node_slot, prefix_len)))
-            return error_pass(), art_node_free(leaf), NULL;
+        leaf = (const art_image_leaf_st *)node;
+
+        if(!(key = str_dup_b(leaf->key, leaf->len)))
+            return error_wrap(), NULL;
+
+        return key;
     }
-    else
+
+    assert_magic_n(&node->v.leaf, NODE_MAGIC);
+
+    if(node->v.leaf.key)
     {
-        if(  node->size == art_node_capacity(node->type)
-          && !(node = art_node_grow(node_slot)))
-            return error_pass(), art_node_free(leaf), NULL;
+        if(!(key = str_dup_b(node->v.leaf.key->data, node->v.leaf.key->len)))
+            return error_wrap(), NULL;
+
+        return key;
     }
 
-    art->size++;
+    if(!(key = str_dup_b(art_node_get_path(node), node->path_len)))
+        return error_wrap(), NULL;
+
+    for(; node->parent; node = node->parent)
+        if(  !str_prepend_b(key, &node->key, 1)
+          || !str_prepend_b(key, art_node_get_path(node->parent), node->parent->path_len))
+            return error_wrap(), str_unref(key), NULL;
 
-    return art_node_insert(node, leaf_key, leaf, art->ordered);
+    return key;
 }
 
-/// Remove child node from list node while keeping order.
-///
-/// \param parent   parent to remove child from
-/// \param keys     parent keys
-/// \param children parent children
-/// \param index    position of key to remove
-static inline void art_node_remove_child_sorted(art_node_ct parent, unsigned char *keys, art_node_ct *children, size_t index)
+void *art_node_data(art_node_const_ct node)
 {
-    if(index + 1 < parent->size)
-    {
-        memmove(&keys[index], &keys[index + 1], parent->size - index - 1);
-        memmove(&children[index], &children[index + 1], (parent->size - index - 1) * sizeof(art_node_ct));
-    }
+    if(node->type == IMAGE_LEAF)
+        return (void *)(uintptr_t)((const art_image_leaf_st *)node)->data;
+
+    assert_magic_n(&node->v.leaf, NODE_MAGIC);
+
+    return node->v.leaf.data;
 }
 
-#if SIMD64 || SIMD128 || SIMD256
-/// Remove child node from list node without keeping order.
-///
-/// \param parent   parent to remove child from
-/// \param keys     parent keys
-/// \param children parent children
-/// \param index    position of key to remove
-static inline void art_node_remove_child_unsorted(art_node_ct parent, unsigned char *keys, art_node_ct *children, size_t index)
+void art_node_set(art_node_ct node, const void *data)
 {
-    if(index + 1 < parent->size)
+    assert(node->type != IMAGE_LEAF);
+    assert_magic_n(&node->v.leaf, NODE_MAGIC);
+
+    node->v.leaf.data = (void *)data;
+}
+
+/// Get leaf node in concurrent mode.
+///
+/// \param      art      ART
+/// \param      key      node key
+/// \param[out] data     node data, read inside the read section, may be NULL
+///
+/// \returns                        ART leaf node
+/// \retval NULL/E_ART_NOT_FOUND    node not found
+static art_node_ct art_get_concurrent(art_const_ct art, str_const_ct key, void **data)
+{
+    atomic_size_t *reader;
+    art_node_ct node;
+
+    reader = art_read_begin(art);
+
+    if((node = art_lookup_concurrent(art, art_path_new(key))) && data)
+        *data = node->v.leaf.data;
+
+    art_read_end(reader);
+
+    return_error_if_fail(node, E_ART_NOT_FOUND, NULL);
+
+    return node;
+}
+
+art_node_ct art_get(art_const_ct art, str_const_ct key)
+{
+    art_node_ct node;
+    str_ct path;
+
+    assert_magic(art);
+
+    if(art->sync)
+        return error_pass_ptr(art_get_concurrent(art, key, NULL));
+
+    if(art->image)
+        return error_pass_ptr(art_image_get(art, key));
+
+    path = art_path_new(key);
+
+    if(art->optimistic)
     {
-        keys[index]     = keys[parent->size - 1];
-        children[index] = children[parent->size - 1];
+        if(!(node = art_lookup_optimistic(art, path)))
+            return error_set(E_ART_NOT_FOUND), NULL;
+    }
+    else if(  !(node = art_lookup(art, art->root, path, NULL, NULL))
+           || node->type != LEAF
+           || !str_is_empty(path))
+    {
+        return error_set(E_ART_NOT_FOUND), NULL;
     }
+
+    return node;
 }
-#endif
 
-/// Remove child node from index node.
-///
-/// \param parent   parent to remove child from
-/// \param keys     parent keys
-/// \param children parent children
-/// \param key      key to remove
-static inline void art_node_remove_child_index(art_node_ct parent, unsigned char *keys, art_node_ct *children, unsigned char key)
+void *art_get_data(art_const_ct art, str_const_ct key)
 {
-    art_node_ct last;
-    size_t i;
+    art_node_ct node;
+    void *data;
 
-    if(parent->size > 1)
+    assert_magic(art);
+
+    if(art->sync)
     {
-        last = children[parent->size - 1];
+        if(!art_get_concurrent(art, key, &data))
+            return error_pass(), NULL;
 
-        for(i = 0; i < 256; i++)
-            if(keys[i] != 0xff && children[keys[i]] == last)
-            {
-                keys[i]             = keys[key];
-                children[keys[i]]   = last;
-                break;
-            }
+        return data;
     }
 
-    keys[key] = 0xff;
+    if(!(node = art_get(art, key)))
+        return error_pass(), NULL;
+
+    return art_node_data(node);
 }
 
-/// Remove child node from node4.
+/// ART batch lookup state
+typedef struct art_batch
+{
+    const unsigned char *key;   ///< key to lookup
+    size_t              len;    ///< key length
+    size_t              depth;  ///< number of matched key bytes
+    art_node_ct         node;   ///< next node to visit, NULL if done
+} art_batch_st;
+
+/// Prefetch ART node.
 ///
-/// \param parent   parent to remove child from
-/// \param key      key to remove
-static inline void art_node4_remove_child(art_node_ct parent, unsigned char key)
+/// Fetches the node header, path and the start of the node value.
+///
+/// \param node     node to prefetch
+static inline void art_node_prefetch(art_node_const_ct node)
 {
-    size_t i;
+    __builtin_prefetch(node);
+    __builtin_prefetch((const unsigned char *)node + 64);
+}
 
-    for(i = 0; i < parent->size; i++)
-        if(parent->v.n4.key[i] == key)
+/// Descend one level in batch lookup.
+///
+/// \param art      ART
+/// \param batch    batch lookup state
+///
+/// \returns        matching leaf node if lookup is done
+/// \retval NULL    lookup is not done or no leaf node matches
+static art_node_ct art_batch_step(art_const_ct art, art_batch_st *batch)
+{
+    art_node_ct node = batch->node, *child;
+    size_t path_len = node->path_len;
+
+    batch->node = NULL;
+
+    if(batch->depth + path_len > batch->len)
+        return NULL;
+
+    if(art->optimistic)
+    {
+        if(memcmp(node->path.data, &batch->key[batch->depth], path_len <= PATH_INLINE ? path_len : PATH_PREFIX))
+            return NULL;
+    }
+    else if(memcmp(art_node_get_path(node), &batch->key[batch->depth], path_len))
+    {
+        return NULL;
+    }
+
+    batch->depth += path_len;
+
+    if(node->type == LEAF)
+    {
+        if(!art->optimistic)
+            return batch->depth == batch->len ? node : NULL;
+
+        return node->v.leaf.key->len == batch->len
+            && !memcmp(node->v.leaf.key->data, batch->key, batch->len) ? node : NULL;
+    }
+
+    if(batch->depth == batch->len || !(child = art_node_get_child(node, batch->key[batch->depth])))
+        return NULL;
+
+    batch->depth++;
+    batch->node = *child;
+    art_node_prefetch(batch->node);
+
+    return NULL;
+}
+
+size_t art_get_batch(art_const_ct art, const str_const_ct *keys, size_t n, art_node_ct *nodes)
+{
+    art_batch_st batch[BATCH_SIZE];
+    size_t found = 0, size, active, i, k;
+
+    assert_magic(art);
+    assert(keys || !n);
+    assert(nodes || !n);
+
+    if(art->sync || art->image)
+    {
+        for(k = 0; k < n; k++)
+            if((nodes[k] = art_get(art, keys[k])))
+                found++;
+
+        return found;
+    }
+
+    if(art->root)
+        art_node_prefetch(art->root);
+
+    for(k = 0; k < n; k += size)
+    {
+        size = MIN((size_t)BATCH_SIZE, n - k);
+
+        for(i = 0; i < size; i++)
         {
-            art_node_remove_child_sorted(parent, parent->v.n4.key, parent->v.n4.child, i);
-            return;
+            batch[i].key    = str_buc(keys[k + i]);
+            batch[i].len    = str_len(keys[k + i]) + (str_is_binary(keys[k + i]) ? 0 : 1);
+            batch[i].depth  = 0;
+            batch[i].node   = art->root;
+            nodes[k + i]    = NULL;
         }
+
+        for(active = size; active;)
+            for(active = 0, i = 0; i < size; i++)
+                if(batch[i].node)
+                {
+                    if((nodes[k + i] = art_batch_step(art, &batch[i])))
+                        found++;
+
+                    if(batch[i].node)
+                        active++;
+                }
+    }
+
+    return found;
 }
 
-/// Remove child node from node8.
+/// Allocate ART node memory.
 ///
-/// \param parent   parent to remove child from
-/// \param key      key to remove
-/// \param ordered  if true remove keeping ascending order
-static inline void art_node8_remove_child(art_node_ct parent, unsigned char key, bool ordered)
+/// In slab mode nodes are taken from the free list of their type
+/// or carved out of the current slab of their type.
+///
+/// \param art      ART
+/// \param type     node type
+///
+/// \returns                    zeroed node memory
+/// \retval NULL/E_GENERIC_OOM  out of memory
+static art_node_ct art_node_alloc(art_ct art, art_node_id type)
 {
-#if SIMD64
+    size_t size = art_node_size(type), count;
+    art_pool_st *pool = &art->pool[type];
+    art_slab_st *slab;
+    art_node_ct node;
 
-    if(ordered)
-        art_node_remove_child_sorted(parent, parent->v.n8.key, parent->v.n8.child,
-            simd64_index8(parent->v.n8.key, parent->size, key));
+    if(!art->slab)
+    {
+        if(!(node = calloc(1, size)))
+            return error_wrap_last_errno(calloc), NULL;
+
+        return node;
+    }
+
+    if((node = pool->free))
+    {
+        pool->free = node->parent;
+    }
     else
-        art_node_remove_child_unsorted(parent, parent->v.n8.key, parent->v.n8.child,
-            simd64_index8(parent->v.n8.key, parent->size, key));
+    {
+        if(pool->next == pool->end)
+        {
+            count = MAX(1U, SLAB_SIZE / size);
 
-#else
-    art_node_remove_child_sorted(parent, parent->v.n8.key, parent->v.n8.child,
-        art_node_find_child(parent->v.n8.key, parent->size, key));
-#endif
+            if(!(slab = malloc(sizeof(art_slab_st) + count * size)))
+                return error_wrap_last_errno(malloc), NULL;
+
+            slab->next      = art->slabs;
+            art->slabs      = slab;
+            art->slab_mem  += sizeof(art_slab_st) + count * size;
+            pool->next      = slab->mem;
+            pool->end       = slab->mem + count * size;
+        }
+
+        node        = (art_node_ct)pool->next;
+        pool->next += size;
+    }
+
+    memset(node, 0, size);
+
+    return node;
 }
 
-/// Remove child node from node16.
+/// Recycle ART node memory.
 ///
-/// \param parent   parent to remove child from
-/// \param key      key to remove
-/// \param ordered  if true remove keeping ascending order
-static inline void art_node16_remove_child(art_node_ct parent, unsigned char key, bool ordered)
+/// In slab mode nodes are put on the free list of their type.
+///
+/// \param art      ART
+/// \param node     node to recycle
+static void art_node_recycle(art_ct art, art_node_ct node)
 {
-#if SIMD128
+    art_pool_st *pool;
 
-    if(ordered)
-        art_node_remove_child_sorted(parent, parent->v.n16.key, parent->v.n16.child,
-            simd128_index8(parent->v.n16.key, parent->size, key));
-    else
-        art_node_remove_child_unsorted(parent, parent->v.n16.key, parent->v.n16.child,
-            simd128_index8(parent->v.n16.key, parent->size, key));
+    if(!art->slab)
+    {
+        free(node);
+        return;
+    }
 
-#else
-    art_node_remove_child_sorted(parent, parent->v.n16.key, parent->v.n16.child,
-        art_node_find_child(parent->v.n16.key, parent->size, key));
-#endif
+    pool            = &art->pool[node->type];
+    node->parent    = pool->free;
+    pool->free      = node;
 }
 
-/// Remove child node from node32.
+/// Release ART node memory.
 ///
-/// \param parent   parent to remove child from
-/// \param key      key to remove
-/// \param ordered  if true remove keeping ascending order
-static inline void art_node32_remove_child(art_node_ct parent, unsigned char key, bool ordered)
+/// In concurrent mode the node is kept locked to mark it obsolete
+/// and retired until no reader can access it anymore.
+///
+/// \param art      ART
+/// \param node     node to release
+static void art_node_release(art_ct art, art_node_ct node)
 {
-#if SIMD256
+    if(!art->sync)
+    {
+        art_node_recycle(art, node);
+        return;
+    }
 
-    if(ordered)
-        art_node_remove_child_sorted(parent, parent->v.n32.key, parent->v.n32.child,
-            simd256_index8(parent->v.n32.key, parent->size, key));
-    else
-        art_node_remove_child_unsorted(parent, parent->v.n32.key, parent->v.n32.child,
-            simd256_index8(parent->v.n32.key, parent->size, key));
+    if(!(atomic_load_explicit(&node->version, memory_order_relaxed) & VERSION_LOCKED))
+        art_version_lock(&node->version);
 
-#else
-    art_node_remove_child_sorted(parent, parent->v.n32.key, parent->v.n32.child,
-        art_node_find_child(parent->v.n32.key, parent->size, key));
-#endif
+    node->parent        = art->sync->retired;
+    art->sync->retired  = node;
+    art->sync->retired_count++;
 }
 
-/// Remove child node from parent node.
+/// Free retired nodes in concurrent mode.
 ///
-/// \param parent   parent to remove child from
-/// \param key      key to remove
-/// \param ordered  if true remove keeping ascending order
-static void art_node_remove_child(art_node_ct parent, unsigned char key, bool ordered)
+/// Start a new reader epoch and wait for all readers of the previous epoch,
+/// which may still access retired nodes, to finish.
+///
+/// \param art      ART
+static void art_sync_reclaim(art_ct art)
 {
-    switch(parent->type)
+    art_node_ct node, next;
+    unsigned int epoch;
+    size_t s;
+
+    epoch = atomic_fetch_add(&art->sync->epoch, 1);
+
+    for(s = 0; s < SYNC_STRIPES; s++)
+        while(atomic_load_explicit(&art->sync->readers[epoch & 1][s].count, memory_order_acquire))
+            sched_yield();
+
+    for(node = art->sync->retired; node; node = next)
     {
-    case NODE4:
-        art_node4_remove_child(parent, key);
-        break;
+        next = node->parent;
 
-    case NODE8:
-        art_node8_remove_child(parent, key, ordered);
-        break;
+        if(node->type == LEAF)
+            free(node->v.leaf.key);
 
-    case NODE16:
-        art_node16_remove_child(parent, key, ordered);
-        break;
+        art_node_recycle(art, node);
+    }
 
-    case NODE32:
-        art_node32_remove_child(parent, key, ordered);
-        break;
+    art->sync->retired          = NULL;
+    art->sync->retired_count    = 0;
+}
 
+/// Create new ART node.
+///
+/// \param art      ART
+/// \param type     node type
+/// \param key      node key
+/// \param parent   parent node
+/// \param path     node path to set, may be NULL
+///
+/// \returns                    new ART node
+/// \retval NULL/E_GENERIC_OOM  out of memory
+static art_node_ct art_node_new(art_ct art, art_node_id type, unsigned char key, art_node_ct parent, str_const_ct path)
+{
+    art_node_ct node;
+
+    if(!(node = art_node_alloc(art, type)))
+        return error_pass(), NULL;
+
+    if(path)
+    {
+        if(str_len(path) <= PATH_INLINE)
+        {
+            memcpy(node->path.data, str_bc(path), str_len(path));
+        }
+        else
+        {
+            if(!(node->path.heap.data = memdup(str_bc(path), str_len(path))))
+                return error_wrap_last_errno(memdup), art_node_release(art, node), NULL;
+
+            memcpy(node->path.heap.prefix, str_bc(path), PATH_PREFIX);
+            art->heap++;
+        }
+    }
+
+    switch(type)
+    {
+#if !NODE64_LIST
     case NODE64:
-        art_node_remove_child_index(parent, parent->v.n64.key, parent->v.n64.child, key);
+        memset(node->v.n64.key, 0xff, sizeof(node->v.n64.key));
         break;
+#endif
+
+    case NODE128:
+        memset(node->v.n128.key, 0xff, sizeof(node->v.n128.key));
+        break;
+
+    default:
+        break;
+    }
+
+    node->type      = type;
+    node->path_len  = path ? str_len(path) : 0;
+    node->key       = key;
+    node->parent    = parent;
+
+    return node;
+}
+
+/// Free ART node
+///
+/// \param art      ART
+/// \param node     node to free
+static void art_node_free(art_ct art, art_node_ct node)
+{
+    if(node->path_len > PATH_INLINE)
+    {
+        free(node->path.heap.data);
+        art->heap--;
+    }
+
+    if(node->type == LEAF && node->v.leaf.key)
+    {
+        // readers may still compare the key, freed on reclaim
+        if(!art->sync)
+            free(node->v.leaf.key);
+
+        art->heap--;
+    }
+
+    art_node_release(art, node);
+}
+
+/// Create new ART leaf node.
+///
+/// \param art      ART node belongs to
+/// \param path     node path to set, may be NULL
+/// \param key      full node key, stored in optimistic mode
+/// \param data     node data to set
+///
+/// \returns                    new ART leaf node
+/// \retval NULL/E_GENERIC_OOM  out of memory
+static art_node_ct art_node_new_leaf(art_ct art, str_const_ct path, str_const_ct key, const void *data)
+{
+    art_node_ct node;
+
+    if(!(node = art_node_new(art, LEAF, '\0', NULL, path)))
+        return error_pass(), NULL;
+
+    if(art->optimistic)
+    {
+        if(!(node->v.leaf.key = malloc(sizeof(art_key_st) + str_len(key))))
+            return error_wrap_last_errno(malloc), art_node_free(art, node), NULL;
+
+        node->v.leaf.key->len = str_len(key);
+        memcpy(node->v.leaf.key->data, str_bc(key), str_len(key));
+
+        art->heap++;
+    }
+
+    init_magic_n(&node->v.leaf, NODE_MAGIC);
+    DEBUG(node->v.leaf.art  = art);
+    node->v.leaf.data       = (void *)data;
+
+    return node;
+}
+
+/// Copy list node to another list node.
+///
+/// \param node2        destination node
+/// \param keys2        destination keys
+/// \param children2    destination children
+/// \param node1        source node
+/// \param keys1        source keys
+/// \param children1    source children
+static inline void art_node_copy_list(art_node_ct node2, unsigned char *keys2, art_node_ct *children2, art_node_ct node1, unsigned char *keys1, art_node_ct *children1)
+{
+    size_t n;
+
+    memcpy(keys2, keys1, node1->size);
+    memcpy(children2, children1, node1->size * sizeof(art_node_ct));
+
+    for(n = 0; n < node1->size; n++)
+        children1[n]->parent = node2;
+}
+
+/// Copy node32 to node64.
+///
+/// \param n64      destination node
+/// \param n32      source node
+static inline void art_node32_to_node64(art_node_ct n64, art_node_ct n32)
+{
+#if NODE64_LIST
+    art_node_copy_list(n64, n64->v.n64.key, n64->v.n64.child,
+        n32, n32->v.n32.key, n32->v.n32.child);
+#else
+    size_t n;
+
+    for(n = 0; n < n32->size; n++)
+    {
+        n64->v.n64.key[n32->v.n32.key[n]]   = n;
+        n64->v.n64.child[n]                 = n32->v.n32.child[n];
+        n64->v.n64.child[n]->parent         = n64;
+    }
+#endif
+}
+
+/// Copy node64 to node128.
+///
+/// \param n128     destination node
+/// \param n64      source node
+static inline void art_node64_to_node128(art_node_ct n128, art_node_ct n64)
+{
+    size_t n;
+
+#if NODE64_LIST
+    for(n = 0; n < n64->size; n++)
+        n128->v.n128.key[n64->v.n64.key[n]] = n;
+#else
+    memcpy(n128->v.n128.key, n64->v.n64.key, 256);
+#endif
+    memcpy(n128->v.n128.child, n64->v.n64.child, n64->size * sizeof(art_node_ct));
+
+    for(n = 0; n < n64->size; n++)
+        n64->v.n64.child[n]->parent = n128;
+}
+
+/// Copy node128 to node256.
+///
+/// \param n256     destination node
+/// \param n128     source node
+static inline void art_node128_to_node256(art_node_ct n256, art_node_ct n128)
+{
+    size_t n;
+
+    for(n = 0; n < 256; n++)
+        if(n128->v.n128.key[n] != 0xff)
+        {
+            n256->v.n256.child[n]           = n128->v.n128.child[n128->v.n128.key[n]];
+            n256->v.n256.child[n]->parent   = n256;
+        }
+}
+
+/// Grow ART node to next bigger size.
+///
+/// \param art      ART
+/// \param slot     slot of node to grow
+///
+/// \returns                    new node
+/// \retval NULL/E_GENERIC_OOM  out of memory
+static art_node_ct art_node_grow(art_ct art, art_node_ct *slot)
+{
+    art_node_ct node1 = *slot, owner = node1->parent, node2;
+
+    if(!(node2 = art_node_new(art, node1->type + 1, node1->key, node1->parent, NULL)))
+        return error_pass(), NULL;
+
+    switch(node1->type)
+    {
+    case NODE4:
+        art_node_copy_list(node2, node2->v.n8.key, node2->v.n8.child,
+            node1, node1->v.n4.key, node1->v.n4.child);
+        break;
+
+    case NODE8:
+        art_node_copy_list(node2, node2->v.n16.key, node2->v.n16.child,
+            node1, node1->v.n8.key, node1->v.n8.child);
+        break;
+
+    case NODE16:
+        art_node_copy_list(node2, node2->v.n32.key, node2->v.n32.child,
+            node1, node1->v.n16.key, node1->v.n16.child);
+        break;
+
+    case NODE32:
+        art_node32_to_node64(node2, node1);
+        break;
+
+    case NODE64:
+        art_node64_to_node128(node2, node1);
+        break;
+
+    case NODE128:
+        art_node128_to_node256(node2, node1);
+        break;
+
+    default:
+        abort();
+    }
+
+    node2->size     = node1->size;
+    node2->path     = node1->path;
+    node2->path_len = node1->path_len;
+
+    art_node_lock(art, owner);
+    art_node_lock(art, node1);
+
+    *slot = node2;
+
+    art_node_unlock(art, owner);
+    art_node_release(art, node1);
+
+    return node2;
+}
+
+/// Insert child node into list parent.
+///
+/// \param parent   parent to insert child into
+/// \param keys     parent keys
+/// \param children parent children
+/// \param key      key to insert into
+/// \param child    child node to insert
+/// \param index    position to insert at
+static inline void art_node_list_insert(art_node_ct parent, unsigned char *keys, art_node_ct *children, unsigned char key, art_node_ct child, int index)
+{
+    memmove(&keys[index + 1], &keys[index], parent->size - index);
+    memmove(&children[index + 1], &children[index], (parent->size - index) * sizeof(art_node_ct));
+
+    keys[index]     = key;
+    children[index] = child;
+}
+
+#if SIMD64 || SIMD128 || SIMD256
+/// Append child node to list parent.
+///
+/// \param parent   parent to append child to
+/// \param keys     parent keys
+/// \param children parent children
+/// \param key      key to append with
+/// \param child    child node to append
+static inline void art_node_list_append(art_node_ct parent, unsigned char *keys, art_node_ct *children, unsigned char key, art_node_ct child)
+{
+    keys[parent->size]      = key;
+    children[parent->size]  = child;
+}
+#endif
+
+/// Insert child node into index parent.
+///
+/// \param parent   parent to insert child into
+/// \param keys     parent keys
+/// \param children parent children
+/// \param key      key to insert into
+/// \param child    child node to insert
+static inline void art_node_insert_index(art_node_ct parent, unsigned char *keys, art_node_ct *children, unsigned char key, art_node_ct child)
+{
+    keys[key]               = parent->size;
+    children[parent->size]  = child;
+}
+
+/// Insert child node into node4.
+///
+/// \param parent   parent to insert child into
+/// \param key      key to insert into
+/// \param child    child node to insert
+static inline void art_node4_insert(art_node_ct parent, unsigned char key, art_node_ct child)
+{
+    size_t k;
+
+    for(k = 0; k < parent->size; k++)
+        if(key < parent->v.n4.key[k])
+            break;
+
+    art_node_list_insert(parent, parent->v.n4.key, parent->v.n4.child, key, child, k);
+}
+
+/// Insert child node into node4.
+///
+/// \param parent   parent to insert child into
+/// \param key      key to insert into
+/// \param child    child node to insert
+/// \param ordered  if true insert keeping ascending order
+static inline void art_node8_insert(art_node_ct parent, unsigned char key, art_node_ct child, bool ordered)
+{
+#if SIMD64
+
+    if(!ordered)
+        art_node_list_append(parent, parent->v.n8.key, parent->v.n8.child, key, child);
+    else
+#endif
+    art_node_list_insert(parent, parent->v.n8.key, parent->v.n8.child, key, child,
+        -art_node_find_child(parent->v.n8.key, parent->size, key) - 1);
+}
+
+/// Insert child node into node16.
+///
+/// \param parent   parent to insert child into
+/// \param key      key to insert into
+/// \param child    child node to insert
+/// \param ordered  if true insert keeping ascending order
+static inline void art_node16_insert(art_node_ct parent, unsigned char key, art_node_ct child, bool ordered)
+{
+#if SIMD128
+
+    if(!ordered)
+        art_node_list_append(parent, parent->v.n16.key, parent->v.n16.child, key, child);
+    else
+#endif
+    art_node_list_insert(parent, parent->v.n16.key, parent->v.n16.child, key, child,
+        -art_node_find_child(parent->v.n16.key, parent->size, key) - 1);
+}
+
+/// Insert child node into node32.
+///
+/// \param parent   parent to insert child into
+/// \param key      key to insert into
+/// \param child    child node to insert
+/// \param ordered  if true insert keeping ascending order
+static inline void art_node32_insert(art_node_ct parent, unsigned char key, art_node_ct child, bool ordered)
+{
+#if SIMD256
+
+    if(!ordered)
+        art_node_list_append(parent, parent->v.n32.key, parent->v.n32.child, key, child);
+    else
+#endif
+    art_node_list_insert(parent, parent->v.n32.key, parent->v.n32.child, key, child,
+        -art_node_find_child(parent->v.n32.key, parent->size, key) - 1);
+}
+
+#if NODE64_LIST
+/// Insert child node into node64.
+///
+/// \param parent   parent to insert child into
+/// \param key      key to insert into
+/// \param child    child node to insert
+/// \param ordered  if true insert keeping ascending order
+static inline void art_node64_insert(art_node_ct parent, unsigned char key, art_node_ct child, bool ordered)
+{
+    if(!ordered)
+        art_node_list_append(parent, parent->v.n64.key, parent->v.n64.child, key, child);
+    else
+        art_node_list_insert(parent, parent->v.n64.key, parent->v.n64.child, key, child,
+            -art_node_find_child(parent->v.n64.key, parent->size, key) - 1);
+}
+#endif
+
+/// Insert child node into parent node.
+///
+/// \param parent   parent node to insert child into
+/// \param key      key to insert info
+/// \param child    child node to insert
+/// \param ordered  if true insert keeping ascending order
+///
+/// \returns        \p child
+static art_node_ct art_node_insert(art_node_ct parent, unsigned char key, art_node_ct child, bool ordered)
+{
+    switch(parent->type)
+    {
+    case NODE4:
+        art_node4_insert(parent, key, child);
+        break;
+
+    case NODE8:
+        art_node8_insert(parent, key, child, ordered);
+        break;
+
+    case NODE16:
+        art_node16_insert(parent, key, child, ordered);
+        break;
+
+    case NODE32:
+        art_node32_insert(parent, key, child, ordered);
+        break;
+
+    case NODE64:
+#if NODE64_LIST
+        art_node64_insert(parent, key, child, ordered);
+#else
+        art_node_insert_index(parent, parent->v.n64.key, parent->v.n64.child, key, child);
+#endif
+        break;
+
+    case NODE128:
+        art_node_insert_index(parent, parent->v.n128.key, parent->v.n128.child, key, child);
+        break;
+
+    case NODE256:
+        parent->v.n256.child[key] = child;
+        break;
+
+    default:
+        abort();
+    }
+
+    parent->size++;
+    child->key      = key;
+    child->parent   = parent;
+
+    return child;
+}
+
+/// Split node path and insert new node.
+///
+/// \param art      ART
+/// \param slot     slot of node to split
+/// \param prefix   number of bytes to cut from child and assign to new parent
+///
+/// \returns                    new parent node
+/// \retval NULL/E_GENERIC_OOM  out of memory
+static art_node_ct art_node_split(art_ct art, art_node_ct *slot, size_t prefix)
+{
+    art_node_ct child = *slot, owner = child->parent, inode;
+    unsigned char *path = art_node_get_path(child);
+
+    assert(prefix + 1 <= child->path_len);
+
+    if(!(inode = art_node_new(art, NODE4, child->key, child->parent, tstr_new_bs(path, prefix))))
+        return error_pass(), NULL;
+
+    art_node_lock(art, owner);
+    art_node_lock(art, child);
+
+    *slot = inode;
+
+    art_node_insert(inode, path[prefix], child, art->ordered);
+    art_node_drop_path(art, child, prefix + 1);
+
+    art_node_unlock(art, child);
+    art_node_unlock(art, owner);
+
+    return inode;
+}
+
+static art_node_ct art_insert_node(art_ct art, str_const_ct key, const void *data);
+
+art_node_ct art_set(art_ct art, str_const_ct key, const void *data)
+{
+    art_node_ct node;
+
+    assert_magic(art);
+    return_error_if_pass(art->image, E_ART_FROZEN, NULL);
+
+    art_write_begin(art);
+
+    // writer lock excludes modifications, no need for concurrent lookup
+    if(art->sync)
+        node = art_lookup_optimistic(art, art_path_new(key));
+    else
+        node = art_get(art, key);
+
+    if(node)
+        node->v.leaf.data = (void *)data;
+    else
+        node = error_pass_ptr(art_insert_node(art, key, data));
+
+    art_write_end(art);
+
+    return node;
+}
+
+art_node_ct art_insert(art_ct art, str_const_ct key, const void *data)
+{
+    art_node_ct node;
+
+    assert_magic(art);
+    return_error_if_pass(art->image, E_ART_FROZEN, NULL);
+
+    art_write_begin(art);
+    node = error_pass_ptr(art_insert_node(art, key, data));
+    art_write_end(art);
+
+    return node;
+}
+
+/// Insert new leaf node into ART.
+///
+/// \param art      ART
+/// \param key      node key
+/// \param data     node data
+///
+/// \returns                        new ART leaf node
+/// \retval NULL/E_ART_INVALID_KEY  \p key is empty
+/// \retval NULL/E_ART_EXISTS       node with \p key already exists
+/// \retval NULL/E_GENERIC_OOM      out of memory
+static art_node_ct art_insert_node(art_ct art, str_const_ct key, const void *data)
+{
+    art_node_ct leaf, node, *node_slot;
+    unsigned char leaf_key;
+    str_ct path, full;
+    size_t prefix_len;
+
+    path = art_path_new(key);
+    full = art_path_new(key);
+    return_error_if_pass(str_is_empty(path), E_ART_INVALID_KEY, NULL);
+
+    if(!art->root)
+    {
+        if(!(leaf = art_node_new_leaf(art, path, full, data)))
+            return error_pass(), NULL;
+
+        art_node_lock(art, NULL);
+        art->root = leaf;
+        art_node_unlock(art, NULL);
+        art->size++;
+
+        return leaf;
+    }
+
+    node = art_lookup(art, art->root, path, &prefix_len, &node_slot);
+
+    if(  str_is_empty(path)
+      || (prefix_len == node->path_len && node->type == LEAF))
+        return error_set(E_ART_EXISTS), NULL;
+
+    leaf_key = str_first_u(path);
+    str_cut_head(path, 1);
+
+    if(!(leaf = art_node_new_leaf(art, path, full, data)))
+        return error_pass(), NULL;
+
+    if(prefix_len < node->path_len)
+    {
+        if(!(node = art_node_split(art, node_slot, prefix_len)))
+            return error_pass(), art_node_free(art, leaf), NULL;
+    }
+    else
+    {
+        if(  node->size == art_node_capacity(node->type)
+          && !(node = art_node_grow(art, node_slot)))
+            return error_pass(), art_node_free(art, leaf), NULL;
+    }
+
+    art_node_lock(art, node);
+    art_node_insert(node, leaf_key, leaf, art->ordered);
+    art_node_unlock(art, node);
+    art->size++;
+
+    return leaf;
+}
+
+/// ART bulk load item
+typedef struct art_bulk_item
+{
+    const unsigned char *key;   ///< node key including terminator
+    size_t              len;    ///< node key length
+    const void          *data;  ///< node data
+} art_bulk_st;
+
+/// Compare bulk load items by key.
+///
+/// \implements qsort compare callback
+///
+/// \param a        first item
+/// \param b        second item
+///
+/// \retval <0      key of \p a is smaller than key of \p b
+/// \retval 0       keys are equal
+/// \retval >0      key of \p a is greater than key of \p b
+static int art_bulk_compare(const void *a, const void *b)
+{
+    const art_bulk_st *item1 = a, *item2 = b;
+    int rc;
+
+    if((rc = memcmp(item1->key, item2->key, MIN(item1->len, item2->len))))
+        return rc;
+
+    return (item1->len > item2->len) - (item1->len < item2->len);
+}
+
+/// Get number of bulk load item groups with different key byte at position.
+///
+/// \param items    sorted items
+/// \param n        number of items
+/// \param pos      key position
+///
+/// \returns        number of groups
+static size_t art_bulk_groups(const art_bulk_st *items, size_t n, size_t pos)
+{
+    size_t i, groups;
+
+    for(i = 1, groups = 1; i < n; i++)
+        if(items[i].key[pos] != items[i - 1].key[pos])
+            groups++;
+
+    return groups;
+}
+
+/// Build ART subtree from sorted bulk load items.
+///
+/// Each inner node is created at its final type.
+/// On error the partially built subtree is returned nonetheless.
+///
+/// \param      art      ART
+/// \param      items    sorted items
+/// \param      n        number of items, at least 1
+/// \param      depth    number of key bytes consumed by ancestors
+/// \param[out] node     subtree root, NULL if nothing was built
+///
+/// \retval 0                   success
+/// \retval -1/E_ART_EXISTS     key is duplicate or prefix of another key
+/// \retval -1/E_GENERIC_OOM    out of memory
+static int art_bulk_build(art_ct art, const art_bulk_st *items, size_t n, size_t depth, art_node_ct *node)
+{
+    const art_bulk_st *first = &items[0], *last = &items[n - 1];
+    art_node_id type;
+    art_node_ct child;
+    size_t prefix, groups, i, j;
+    unsigned char key;
+    int rc;
+
+    *node = NULL;
+
+    if(n == 1)
+    {
+        if(!(*node = art_node_new_leaf(art,
+            tstr_new_bs(&first->key[depth], first->len - depth),
+            tstr_new_bs(first->key, first->len), first->data)))
+            return error_pass(), -1;
+
+        art->size++;
+
+        return 0;
+    }
+
+    // items are sorted, common prefix of first and last item is common to all
+    for(prefix = 0; depth + prefix < MIN(first->len, last->len); prefix++)
+        if(first->key[depth + prefix] != last->key[depth + prefix])
+            break;
+
+    // a key ending here sorts first and is part of the following keys
+    return_error_if_pass(depth + prefix == first->len, E_ART_EXISTS, -1);
+
+    groups = art_bulk_groups(items, n, depth + prefix);
+
+    for(type = NODE4; (size_t)art_node_capacity(type) < groups; type++);
+
+    if(!(*node = art_node_new(art, type, '\0', NULL, tstr_new_bs(&first->key[depth], prefix))))
+        return error_pass(), -1;
+
+    for(i = 0; i < n; i = j)
+    {
+        key = items[i].key[depth + prefix];
+
+        for(j = i + 1; j < n && items[j].key[depth + prefix] == key; j++);
+
+        rc = art_bulk_build(art, &items[i], j - i, depth + prefix + 1, &child);
+
+        if(child)
+            art_node_insert(*node, key, child, art->ordered);
+
+        if(rc)
+            return error_pass(), -1;
+    }
+
+    return 0;
+}
+
+int art_bulk_load(art_ct art, const str_ct *keys, const void *const *values, size_t n)
+{
+    art_bulk_st *items;
+    art_node_ct root;
+    bool sorted = true;
+    size_t i;
+    int rc;
+
+    assert_magic(art);
+    assert(keys || !n);
+    return_error_if_pass(art->image, E_ART_FROZEN, -1);
+
+    if(!n)
+        return 0;
+
+    art_write_begin(art);
+
+    if(art->root)
+    {
+        for(i = 0; i < n; i++)
+            if(!art_insert_node(art, keys[i], values ? values[i] : NULL))
+                return error_pass(), art_write_end(art), -1;
+
+        art_write_end(art);
+
+        return 0;
+    }
+
+    if(!(items = malloc(n * sizeof(art_bulk_st))))
+        return error_wrap_last_errno(malloc), art_write_end(art), -1;
+
+    for(i = 0; i < n; i++)
+    {
+        items[i].key    = str_buc(keys[i]);
+        items[i].len    = str_len(keys[i]) + (str_is_binary(keys[i]) ? 0 : 1);
+        items[i].data   = values ? values[i] : NULL;
+
+        if(!items[i].len)
+            return error_set(E_ART_INVALID_KEY), free(items), art_write_end(art), -1;
+
+        if(sorted && i && art_bulk_compare(&items[i - 1], &items[i]) > 0)
+            sorted = false;
+    }
+
+    if(!sorted)
+        qsort(items, n, sizeof(art_bulk_st), art_bulk_compare);
+
+    if((rc = art_bulk_build(art, items, n, 0, &root)))
+    {
+        error_pass();
+
+        if(root)
+            art_node_remove(art, root, NO_PREFIX, NULL, NULL);
+    }
+    else
+    {
+        art_node_lock(art, NULL);
+        art->root = root;
+        art_node_unlock(art, NULL);
+    }
+
+    art_write_end(art);
+    free(items);
+
+    return rc;
+}
+
+/// Remove child node from list node while keeping order.
+///
+/// \param parent   parent to remove child from
+/// \param keys     parent keys
+/// \param children parent children
+/// \param index    position of key to remove
+static inline void art_node_remove_child_sorted(art_node_ct parent, unsigned char *keys, art_node_ct *children, size_t index)
+{
+    if(index + 1 < parent->size)
+    {
+        memmove(&keys[index], &keys[index + 1], parent->size - index - 1);
+        memmove(&children[index], &children[index + 1], (parent->size - index - 1) * sizeof(art_node_ct));
+    }
+}
+
+#if SIMD64 || SIMD128 || SIMD256
+/// Remove child node from list node without keeping order.
+///
+/// \param parent   parent to remove child from
+/// \param keys     parent keys
+/// \param children parent children
+/// \param index    position of key to remove
+static inline void art_node_remove_child_unsorted(art_node_ct parent, unsigned char *keys, art_node_ct *children, size_t index)
+{
+    if(index + 1 < parent->size)
+    {
+        keys[index]     = keys[parent->size - 1];
+        children[index] = children[parent->size - 1];
+    }
+}
+#endif
+
+/// Remove child node from index node.
+///
+/// \param parent   parent to remove child from
+/// \param keys     parent keys
+/// \param children parent children
+/// \param key      key to remove
+static inline void art_node_remove_child_index(art_node_ct parent, unsigned char *keys, art_node_ct *children, unsigned char key)
+{
+    art_node_ct last;
+    size_t i;
+
+    if(parent->size > 1)
+    {
+        last = children[parent->size - 1];
+
+        for(i = 0; i < 256; i++)
+            if(keys[i] != 0xff && children[keys[i]] == last)
+            {
+                keys[i]             = keys[key];
+                children[keys[i]]   = last;
+                break;
+            }
+    }
+
+    keys[key] = 0xff;
+}
+
+/// Remove child node from node4.
+///
+/// \param parent   parent to remove child from
+/// \param key      key to remove
+static inline void art_node4_remove_child(art_node_ct parent, unsigned char key)
+{
+    size_t i;
+
+    for(i = 0; i < parent->size; i++)
+        if(parent->v.n4.key[i] == key)
+        {
+            art_node_remove_child_sorted(parent, parent->v.n4.key, parent->v.n4.child, i);
+            return;
+        }
+}
+
+/// Remove child node from node8.
+///
+/// \param parent   parent to remove child from
+/// \param key      key to remove
+/// \param ordered  if true remove keeping ascending order
+static inline void art_node8_remove_child(art_node_ct parent, unsigned char key, bool ordered)
+{
+#if SIMD64
+
+    if(ordered)
+        art_node_remove_child_sorted(parent, parent->v.n8.key, parent->v.n8.child,
+            simd64_index8(parent->v.n8.key, parent->size, key));
+    else
+        art_node_remove_child_unsorted(parent, parent->v.n8.key, parent->v.n8.child,
+            simd64_index8(parent->v.n8.key, parent->size, key));
+
+#else
+    art_node_remove_child_sorted(parent, parent->v.n8.key, parent->v.n8.child,
+        art_node_find_child(parent->v.n8.key, parent->size, key));
+#endif
+}
+
+/// Remove child node from node16.
+///
+/// \param parent   parent to remove child from
+/// \param key      key to remove
+/// \param ordered  if true remove keeping ascending order
+static inline void art_node16_remove_child(art_node_ct parent, unsigned char key, bool ordered)
+{
+#if SIMD128
+
+    if(ordered)
+        art_node_remove_child_sorted(parent, parent->v.n16.key, parent->v.n16.child,
+            simd128_index8(parent->v.n16.key, parent->size, key));
+    else
+        art_node_remove_child_unsorted(parent, parent->v.n16.key, parent->v.n16.child,
+            simd128_index8(parent->v.n16.key, parent->size, key));
+
+#else
+    art_node_remove_child_sorted(parent, parent->v.n16.key, parent->v.n16.child,
+        art_node_find_child(parent->v.n16.key, parent->size, key));
+#endif
+}
+
+/// Remove child node from node32.
+///
+/// \param parent   parent to remove child from
+/// \param key      key to remove
+/// \param ordered  if true remove keeping ascending order
+static inline void art_node32_remove_child(art_node_ct parent, unsigned char key, bool ordered)
+{
+#if SIMD256
+
+    if(ordered)
+        art_node_remove_child_sorted(parent, parent->v.n32.key, parent->v.n32.child,
+            simd256_index8(parent->v.n32.key, parent->size, key));
+    else
+        art_node_remove_child_unsorted(parent, parent->v.n32.key, parent->v.n32.child,
+            simd256_index8(parent->v.n32.key, parent->size, key));
+
+#else
+    art_node_remove_child_sorted(parent, parent->v.n32.key, parent->v.n32.child,
+        art_node_find_child(parent->v.n32.key, parent->size, key));
+#endif
+}
+
+#if NODE64_LIST
+/// Remove child node from node64.
+///
+/// \param parent   parent to remove child from
+/// \param key      key to remove
+/// \param ordered  if true remove keeping ascending order
+static inline void art_node64_remove_child(art_node_ct parent, unsigned char key, bool ordered)
+{
+    if(ordered)
+        art_node_remove_child_sorted(parent, parent->v.n64.key, parent->v.n64.child,
+            simd512_index8(parent->v.n64.key, parent->size, key));
+    else
+        art_node_remove_child_unsorted(parent, parent->v.n64.key, parent->v.n64.child,
+            simd512_index8(parent->v.n64.key, parent->size, key));
+}
+#endif
+
+/// Remove child node from parent node.
+///
+/// \param parent   parent to remove child from
+/// \param key      key to remove
+/// \param ordered  if true remove keeping ascending order
+static void art_node_remove_child(art_node_ct parent, unsigned char key, bool ordered)
+{
+    switch(parent->type)
+    {
+    case NODE4:
+        art_node4_remove_child(parent, key);
+        break;
+
+    case NODE8:
+        art_node8_remove_child(parent, key, ordered);
+        break;
+
+    case NODE16:
+        art_node16_remove_child(parent, key, ordered);
+        break;
+
+    case NODE32:
+        art_node32_remove_child(parent, key, ordered);
+        break;
+
+    case NODE64:
+#if NODE64_LIST
+        art_node64_remove_child(parent, key, ordered);
+#else
+        art_node_remove_child_index(parent, parent->v.n64.key, parent->v.n64.child, key);
+#endif
+        break;
+
+    case NODE128:
+        art_node_remove_child_index(parent, parent->v.n128.key, parent->v.n128.child, key);
+        break;
+
+    case NODE256:
+        parent->v.n256.child[key] = NULL;
+        break;
+
+    default:
+        abort();
+    }
+
+    parent->size--;
+}
+
+/// Copy node64 to node32.
+///
+/// \param n32      destination node
+/// \param n64      source node
+static inline void art_node64_to_node32(art_node_ct n32, art_node_ct n64)
+{
+#if NODE64_LIST
+    art_node_copy_list(n32, n32->v.n32.key, n32->v.n32.child,
+        n64, n64->v.n64.key, n64->v.n64.child);
+#else
+    size_t n, s;
+
+    for(n = 0, s = 0; n < 256 && s < n64->size; n++)
+        if(n64->v.n64.key[n] != 0xff)
+        {
+            n32->v.n32.key[s]           = n;
+            n32->v.n32.child[s]         = n64->v.n64.child[n64->v.n64.key[n]];
+            n32->v.n32.child[s]->parent = n32;
+            s++;
+        }
+#endif
+}
+
+/// Copy node128 to node64.
+///
+/// \param n64      destination node
+/// \param n128     source node
+static inline void art_node128_to_node64(art_node_ct n64, art_node_ct n128)
+{
+    size_t n;
+#if NODE64_LIST
+    size_t s;
+
+    for(n = 0, s = 0; n < 256 && s < n128->size; n++)
+        if(n128->v.n128.key[n] != 0xff)
+        {
+            n64->v.n64.key[s]           = n;
+            n64->v.n64.child[s]         = n128->v.n128.child[n128->v.n128.key[n]];
+            n64->v.n64.child[s]->parent = n64;
+            s++;
+        }
+#else
+    memcpy(n64->v.n64.key, n128->v.n128.key, 256);
+    memcpy(n64->v.n64.child, n128->v.n128.child, n128->size * sizeof(art_node_ct));
+
+    for(n = 0; n < n128->size; n++)
+        n128->v.n128.child[n]->parent = n64;
+#endif
+}
+
+/// Copy node256 to node128.
+///
+/// \param n128     destination node
+/// \param n256     source node
+static inline void art_node256_to_node128(art_node_ct n128, art_node_ct n256)
+{
+    size_t n, s;
+
+    for(n = 0, s = 0; n < 256 && s < n256->size; n++)
+        if(n256->v.n256.child[n])
+        {
+            n128->v.n128.key[n]             = s;
+            n128->v.n128.child[s]           = n256->v.n256.child[n];
+            n128->v.n128.child[s]->parent   = n128;
+            s++;
+        }
+}
+
+/// Shrink ART node to next smaller size.
+///
+/// \param art      ART
+/// \param node1    node to shrink
+///
+/// \returns                    new node
+/// \retval NULL/E_GENERIC_OOM  out of memory
+static art_node_ct art_node_shrink(art_ct art, art_node_ct node1)
+{
+    art_node_ct owner = node1->parent, node2;
+
+    if(!(node2 = art_node_new(art, node1->type - 1, node1->key, node1->parent, NULL)))
+        return error_pass(), NULL;
+
+    switch(node1->type)
+    {
+    case NODE8:
+        art_node_copy_list(node2, node2->v.n4.key, node2->v.n4.child,
+            node1, node1->v.n8.key, node1->v.n8.child);
+        break;
+
+    case NODE16:
+        art_node_copy_list(node2, node2->v.n8.key, node2->v.n8.child,
+            node1, node1->v.n16.key, node1->v.n16.child);
+        break;
+
+    case NODE32:
+        art_node_copy_list(node2, node2->v.n16.key, node2->v.n16.child,
+            node1, node1->v.n32.key, node1->v.n32.child);
+        break;
+
+    case NODE64:
+        art_node64_to_node32(node2, node1);
+        break;
+
+    case NODE128:
+        art_node128_to_node64(node2, node1);
+        break;
+
+    case NODE256:
+        art_node256_to_node128(node2, node1);
+        break;
+
+    default:
+        abort();
+    }
+
+    node2->size     = node1->size;
+    node2->path     = node1->path;
+    node2->path_len = node1->path_len;
+
+    art_node_lock(art, owner);
+    art_node_lock(art, node1);
+
+    if(node1 == art->root)
+        art->root = node2;
+    else
+        *art_node_get_child(node1->parent, node1->key) = node2;
+
+    art_node_unlock(art, owner);
+    art_node_release(art, node1);
+
+    return node2;
+}
+
+/// Get first child node of parent node.
+///
+/// \param parent   parent to get child from
+///
+/// \returns        first direct child node
+/// \retval NULL    \p parent has no children
+static art_node_ct art_node_get_first_child(art_node_ct parent)
+{
+    size_t i;
+
+    switch(parent->type)
+    {
+    case NODE4:
+        return parent->size ? parent->v.n4.child[0] : NULL;
+
+    case NODE8:
+        return parent->size ? parent->v.n8.child[0] : NULL;
+
+    case NODE16:
+        return parent->size ? parent->v.n16.child[0] : NULL;
+
+    case NODE32:
+        return parent->size ? parent->v.n32.child[0] : NULL;
+
+    case NODE64:
+#if NODE64_LIST
+        return parent->size ? parent->v.n64.child[0] : NULL;
+#else
+        for(i = 0; i < 256; i++)
+            if(parent->v.n64.key[i] != 0xff)
+                return parent->v.n64.child[parent->v.n64.key[i]];
+
+        return NULL;
+#endif
+
+    case NODE128:
+        for(i = 0; i < 256; i++)
+            if(parent->v.n128.key[i] != 0xff)
+                return parent->v.n128.child[parent->v.n128.key[i]];
+
+        return NULL;
+
+    case NODE256:
+        for(i = 0; i < 256; i++)
+            if(parent->v.n256.child[i])
+                return parent->v.n256.child[i];
+
+        return NULL;
+
+    default:
+        abort();
+    }
+}
+
+/// Merge node with its only child.
+///
+/// \param art      ART
+/// \param node     node to merge
+///
+/// \returns                    child node
+/// \retval NULL/E_GENERIC_OOM  out of memory
+static art_node_ct art_node_merge(art_ct art, art_node_ct node)
+{
+    art_node_ct owner = node->parent, child;
+
+    // node should be NODE4, but if shrink failed we may have any other type
+    child = art_node_get_first_child(node);
+
+    art_node_lock(art, owner);
+    art_node_lock(art, node);
+    art_node_lock(art, child);
+
+    if(art_node_prepend_path(art, child, art_node_get_path(node), node->path_len, child->key))
+    {
+        art_node_unlock(art, child);
+        art_node_unlock(art, node);
+        art_node_unlock(art, owner);
+
+        return error_pass(), NULL;
+    }
+
+    child->parent   = node->parent;
+    child->key      = node->key;
+
+    if(node == art->root)
+        art->root = child;
+    else
+        *art_node_get_child(node->parent, node->key) = child;
+
+    art_node_unlock(art, child);
+    art_node_unlock(art, owner);
+    art_node_free(art, node);
+
+    return child;
+}
+
+/// Destroy and free ART node.
+///
+/// \param art      ART
+/// \param node     node to free
+/// \param dtor     callback to destroy leaf node data, may be NULL
+/// \param ctx      \p dtor context
+static void art_node_free_f(art_ct art, art_node_ct node, art_dtor_cb dtor, const void *ctx)
+{
+    if(node->type == LEAF)
+    {
+        if(dtor)
+            dtor(art, node->v.leaf.data, (void *)ctx);
+
+        art->size--;
+    }
+
+    art_node_free(art, node);
+}
+
+/// ART remove state
+typedef struct art_remove_state
+{
+    art_dtor_cb dtor;   ///< node dtor
+    void        *ctx;   ///< node dtor context
+    art_node_ct last;   ///< last node marked for removal
+} art_remove_st;
+
+/// ART traverse callback for removing nodes.
+///
+/// \implements art_traverse_cb
+///
+/// \retval 0   always success
+static int art_traverse_remove(art_ct art, art_node_ct node, str_ct path, void *ctx)
+{
+    art_remove_st *state = ctx;
+
+    if(state->last)
+        art_node_free_f(art, state->last, state->dtor, state->ctx);
+
+    state->last = node;
+
+    return 0;
+}
+
+/// Destroy and remove node and all subnodes from ART.
+///
+/// \param art      ART
+/// \param node     node to start with
+/// \param prefix   prefix of nodes to remove, may be NULL
+/// \param dtor     callback to destroy node data, may be NULL
+/// \param ctx      \p dtor context
+///
+/// \retval 0                   success
+/// \retval -1/E_ART_NOT_FOUND  \p prefix not found
+static int art_node_remove(art_ct art, art_node_ct node, str_const_ct prefix, art_dtor_cb dtor, const void *ctx)
+{
+    art_remove_st state = { .dtor = dtor, .ctx = (void *)ctx };
+    art_node_ct child, parent;
+    unsigned char key;
+
+    if(art_traverse(art, node, prefix, TRAV_POST, WITHOUT_KEY, FORWARD, art_traverse_remove, &state))
+        return error_pass(), -1;
+
+    child = state.last;
+
+    while(1)
+    {
+        parent  = child->parent;
+        key     = child->key;
+
+        art_node_free_f(art, child, dtor, ctx);
+
+        if(!parent)
+        {
+            art_node_lock(art, NULL);
+            art->root = NULL;
+            art_node_unlock(art, NULL);
+            break;
+        }
+        else
+        {
+            art_node_lock(art, parent);
+            art_node_remove_child(parent, key, art->ordered);
+            art_node_unlock(art, parent);
+
+            if(parent->size == 0) // failed merge
+            {
+                child = parent;
+            }
+            else if(parent->size == 1)
+            {
+                art_node_merge(art, parent);
+                break;
+            }
+            else
+            {
+                if(parent->type > NODE4 && parent->size <= art_node_capacity(parent->type) / 4)
+                    art_node_shrink(art, parent);
+
+                break;
+            }
+        }
+    }
+
+    return 0;
+}
+
+void art_remove(art_ct art, art_node_ct node)
+{
+    assert_magic(art);
+    assert(!art->image);
+    assert_magic_n(&node->v.leaf, NODE_MAGIC);
+    assert(art == node->v.leaf.art);
+
+    art_write_begin(art);
+    art_node_remove(art, node, NO_PREFIX, NULL, NULL);
+    art_write_end(art);
+}
+
+int art_remove_p(art_ct art, str_const_ct prefix)
+{
+    return error_pass_int(art_remove_pf(art, prefix, NULL, NULL));
+}
+
+int art_remove_pf(art_ct art, str_const_ct prefix, art_dtor_cb dtor, const void *ctx)
+{
+    int rc;
+
+    assert_magic(art);
+    return_error_if_pass(art->image, E_ART_FROZEN, -1);
+
+    art_write_begin(art);
+    rc = error_pass_int(art_node_remove(art, art->root, prefix, dtor, ctx));
+    art_write_end(art);
+
+    return rc;
+}
+
+/// ART find state
+typedef struct art_find_state
+{
+    art_pred_cb pred;   ///< predicate callback
+    void        *ctx;   ///< predicate callback context
+    art_node_ct node;   ///< matched node
+} art_find_st;
+
+/// ART traverse callback for finding leaf node.
+///
+/// \implements art_traverse_cb
+///
+/// \retval 0   node does not match
+/// \retval 1   node does match
+static int art_traverse_find(art_ct art, art_node_ct node, str_ct path, void *ctx)
+{
+    art_find_st *state = ctx;
+
+    if(!state->pred(art, path, art_node_data(node), state->ctx))
+        return 0;
+
+    state->node = node;
+
+    return 1;
+}
+
+/// Find first leaf node matching predicate.
+///
+/// \param art      ART
+/// \param prefix   prefix of nodes to search, may be NULL
+/// \param key      if true reconstruct node path
+/// \param reverse  if true reverse traverse direction
+/// \param pred     predicate to apply
+/// \param ctx      \p pred context
+/// \param[out] data    data of matched node, may be NULL
+///
+/// \returns                        ART leaf node
+/// \retval NULL/E_ART_NOT_FOUND    \p prefix not found or \p pred did not match any node
+static art_node_ct art_find_generic(art_const_ct art, str_const_ct prefix, bool key, bool reverse, art_pred_cb pred, const void *ctx, void **data)
+{
+    art_find_st state = { .pred = pred, .ctx = (void *)ctx };
+    atomic_size_t *reader;
+    int rc;
+
+    assert_magic(art);
+    assert(pred);
+
+    if(art->sync)
+    {
+        reader = art_read_begin(art);
+
+        if((rc = art_traverse_concurrent((art_ct)art, prefix, key, reverse, art_traverse_find, &state)) == 1 && data)
+            *data = state.node->v.leaf.data;
+
+        art_read_end(reader);
+    }
+    else if(art->image)
+    {
+        if((rc = art_image_traverse((art_ct)art, prefix, key, reverse, art_traverse_find, &state)) == 1 && data)
+            *data = art_node_data(state.node);
+    }
+    else
+    {
+        if((rc = art_traverse((art_ct)art, art->root, prefix, TRAV_LEAF, key, reverse, art_traverse_find, &state)) == 1 && data)
+            *data = state.node->v.leaf.data;
+    }
+
+    if(rc < 0)
+        return error_pass(), NULL;
+
+    return_error_if_fail(rc == 1, E_ART_NOT_FOUND, NULL);
+
+    return state.node;
+}
+
+art_node_ct art_find(art_const_ct art, art_pred_cb pred, const void *ctx)
+{
+    return error_pass_ptr(art_find_generic(art, NO_PREFIX, WITHOUT_KEY, FORWARD, pred, ctx, NULL));
+}
+
+void *art_find_data(art_const_ct art, art_pred_cb pred, const void *ctx)
+{
+    void *data;
+
+    if(!art_find_generic(art, NO_PREFIX, WITHOUT_KEY, FORWARD, pred, ctx, &data))
+        return error_pass(), NULL;
+
+    return data;
+}
+
+art_node_ct art_find_k(art_const_ct art, art_pred_cb pred, const void *ctx)
+{
+    return error_pass_ptr(art_find_generic(art, NO_PREFIX, WITH_KEY, FORWARD, pred, ctx, NULL));
+}
+
+void *art_find_data_k(art_const_ct art, art_pred_cb pred, const void *ctx)
+{
+    void *data;
+
+    if(!art_find_generic(art, NO_PREFIX, WITH_KEY, FORWARD, pred, ctx, &data))
+        return error_pass(), NULL;
+
+    return data;
+}
+
+art_node_ct art_find_r(art_const_ct art, art_pred_cb pred, const void *ctx)
+{
+    return error_pass_ptr(art_find_generic(art, NO_PREFIX, WITHOUT_KEY, BACKWARD, pred, ctx, NULL));
+}
+
+void *art_find_data_r(art_const_ct art, art_pred_cb pred, const void *ctx)
+{
+    void *data;
+
+    if(!art_find_generic(art, NO_PREFIX, WITHOUT_KEY, BACKWARD, pred, ctx, &data))
+        return error_pass(), NULL;
+
+    return data;
+}
+
+art_node_ct art_find_rk(art_const_ct art, art_pred_cb pred, const void *ctx)
+{
+    return error_pass_ptr(art_find_generic(art, NO_PREFIX, WITH_KEY, BACKWARD, pred, ctx, NULL));
+}
+
+void *art_find_data_rk(art_const_ct art, art_pred_cb pred, const void *ctx)
+{
+    void *data;
+
+    if(!art_find_generic(art, NO_PREFIX, WITH_KEY, BACKWARD, pred, ctx, &data))
+        return error_pass(), NULL;
+
+    return data;
+}
+
+art_node_ct art_find_p(art_const_ct art, str_const_ct prefix, art_pred_cb pred, const void *ctx)
+{
+    return error_pass_ptr(art_find_generic(art, prefix, WITHOUT_KEY, FORWARD, pred, ctx, NULL));
+}
+
+void *art_find_data_p(art_const_ct art, str_const_ct prefix, art_pred_cb pred, const void *ctx)
+{
+    void *data;
+
+    if(!art_find_generic(art, prefix, WITHOUT_KEY, FORWARD, pred, ctx, &data))
+        return error_pass(), NULL;
+
+    return data;
+}
+
+art_node_ct art_find_pk(art_const_ct art, str_const_ct prefix, art_pred_cb pred, const void *ctx)
+{
+    return error_pass_ptr(art_find_generic(art, prefix, WITH_KEY, FORWARD, pred, ctx, NULL));
+}
+
+void *art_find_data_pk(art_const_ct art, str_const_ct prefix, art_pred_cb pred, const void *ctx)
+{
+    void *data;
+
+    if(!art_find_generic(art, prefix, WITH_KEY, FORWARD, pred, ctx, &data))
+        return error_pass(), NULL;
+
+    return data;
+}
+
+art_node_ct art_find_pr(art_const_ct art, str_const_ct prefix, art_pred_cb pred, const void *ctx)
+{
+    return error_pass_ptr(art_find_generic(art, prefix, WITHOUT_KEY, BACKWARD, pred, ctx, NULL));
+}
+
+void *art_find_data_pr(art_const_ct art, str_const_ct prefix, art_pred_cb pred, const void *ctx)
+{
+    void *data;
+
+    if(!art_find_generic(art, prefix, WITHOUT_KEY, BACKWARD, pred, ctx, &data))
+        return error_pass(), NULL;
+
+    return data;
+}
+
+art_node_ct art_find_prk(art_const_ct art, str_const_ct prefix, art_pred_cb pred, const void *ctx)
+{
+    return error_pass_ptr(art_find_generic(art, prefix, WITH_KEY, BACKWARD, pred, ctx, NULL));
+}
+
+void *art_find_data_prk(art_const_ct art, str_const_ct prefix, art_pred_cb pred, const void *ctx)
+{
+    void *data;
+
+    if(!art_find_generic(art, prefix, WITH_KEY, BACKWARD, pred, ctx, &data))
+        return error_pass(), NULL;
+
+    return data;
+}
+
+/// ART fold state
+typedef struct art_fold_state
+{
+    art_fold_cb fold;   ///< fold callback
+    void        *ctx;   ///< fold callback context
+} art_fold_st;
+
+/// ART traverse callback for folding leaf nodes.
+///
+/// \implements art_traverse_cb
+///
+/// \retval >=0                 fold rc
+/// \retval <0/E_ART_CALLBACK   fold error
+static int art_traverse_fold(art_ct art, art_node_ct node, str_ct path, void *ctx)
+{
+    art_fold_st *state = ctx;
+
+    return error_pack_int(E_ART_CALLBACK,
+        state->fold(art, path, art_node_data(node), state->ctx));
+}
+
+/// Fold over all leaf nodes.
+///
+/// \param art      ART
+/// \param prefix   prefix of nodes to search, may be NULL
+/// \param key      if true reconstruct node path
+/// \param reverse  if true reverse traverse direction
+/// \param fold     callback to invoke on each leaf node
+/// \param ctx      \p fold context
+///
+/// \retval 0                   success
+/// \retval -1/E_ART_NOT_FOUND  \p prefix not found
+/// \retval <0/E_ART_CALLBACK   \p fold error
+/// \retval >0                  \p fold rc
+static int art_fold_generic(art_ct art, str_const_ct prefix, bool key, bool reverse, art_fold_cb fold, const void *ctx)
+{
+    art_fold_st state = { .fold = fold, .ctx = (void *)ctx };
+    int rc;
+
+    assert_magic(art);
+    assert(fold);
+
+    if(art->image)
+        return error_pass_int(art_image_traverse(art, prefix, key, reverse, art_traverse_fold, &state));
+
+    art_write_begin(art);
+    rc = error_pass_int(art_traverse(art, art->root, prefix, TRAV_LEAF, key, reverse, art_traverse_fold, &state));
+    art_write_end(art);
+
+    return rc;
+}
+
+int art_fold(art_ct art, art_fold_cb fold, const void *ctx)
+{
+    return error_pass_int(art_fold_generic(art, NO_PREFIX, WITHOUT_KEY, FORWARD, fold, ctx));
+}
+
+int art_fold_k(art_ct art, art_fold_cb fold, const void *ctx)
+{
+    return error_pass_int(art_fold_generic(art, NO_PREFIX, WITH_KEY, FORWARD, fold, ctx));
+}
+
+int art_fold_r(art_ct art, art_fold_cb fold, const void *ctx)
+{
+    return error_pass_int(art_fold_generic(art, NO_PREFIX, WITHOUT_KEY, BACKWARD, fold, ctx));
+}
+
+int art_fold_rk(art_ct art, art_fold_cb fold, const void *ctx)
+{
+    return error_pass_int(art_fold_generic(art, NULL, WITH_KEY, BACKWARD, fold, ctx));
+}
+
+int art_fold_p(art_ct art, str_const_ct prefix, art_fold_cb fold, const void *ctx)
+{
+    return error_pass_int(art_fold_generic(art, prefix, WITHOUT_KEY, FORWARD, fold, ctx));
+}
+
+int art_fold_pk(art_ct art, str_const_ct prefix, art_fold_cb fold, const void *ctx)
+{
+    return error_pass_int(art_fold_generic(art, prefix, WITH_KEY, FORWARD, fold, ctx));
+}
+
+int art_fold_pr(art_ct art, str_const_ct prefix, art_fold_cb fold, const void *ctx)
+{
+    return error_pass_int(art_fold_generic(art, prefix, WITHOUT_KEY, BACKWARD, fold, ctx));
+}
+
+int art_fold_prk(art_ct art, str_const_ct prefix, art_fold_cb fold, const void *ctx)
+{
+    return error_pass_int(art_fold_generic(art, prefix, WITH_KEY, BACKWARD, fold, ctx));
+}
+
+/// Complete prefix to longest unambiguous key.
+///
+/// \param art      ART
+/// \param prefix   prefix to complete, may be NULL
+///
+/// \returns                        completed prefix
+/// \retval NULL/E_ART_EMPTY        ART is empty
+/// \retval NULL/E_ART_NOT_FOUND    \p prefix not found
+/// \retval NULL/E_GENERIC_OOM      out of memory
+static str_ct art_complete_prefix(art_const_ct art, str_const_ct prefix)
+{
+    art_node_ct node;
+    str_ct lookup, path;
+    size_t node_prefix = 0;
+
+    return_error_if_fail(art->size, E_ART_EMPTY, NULL);
+
+    if(prefix && !str_is_empty(prefix))
+    {
+        lookup  = art_path_new(prefix);
+        node    = art_lookup(art, art->root, lookup, &node_prefix, NULL);
+        return_error_if_fail(str_is_empty(lookup), E_ART_NOT_FOUND, NULL);
+    }
+    else
+    {
+        node = art->root;
+    }
 
-    case NODE128:
-        art_node_remove_child_index(parent, parent->v.n128.key, parent->v.n128.child, key);
-        break;
+    if(!(path = str_dup_b(art_node_get_path(node) + node_prefix, node->path_len - node_prefix)))
+        return error_wrap(), NULL;
 
-    case NODE256:
-        parent->v.n256.child[key] = NULL;
-        break;
+    // nodes with 1 child may happen if a merge fails
+    while(node->size == 1)
+    {
+        node = art_node_get_first_child(node);
 
-    default:
-        abort();
+        if(  !str_append_set(path, 1, node->key)
+          || !str_append_b(path, art_node_get_path(node), node->path_len))
+            return error_wrap(), str_unref(path), NULL;
     }
 
-    parent->size--;
+    return path;
 }
 
-/// Copy node64 to node32.
-///
-/// \param n32      destination node
-/// \param n64      source node
-static inline void art_node64_to_node32(art_node_ct n32, art_node_ct n64)
+str_ct art_complete(art_const_ct art, str_const_ct prefix)
 {
-    size_t n, s;
+    str_ct path;
 
-    for(n = 0, s = 0; n < 256 && s < n64->size; n++)
-        if(n64->v.n64.key[n] != 0xff)
-        {
-            n32->v.n32.key[s]           = n;
-            n32->v.n32.child[s]         = n64->v.n64.child[n64->v.n64.key[n]];
-            n32->v.n32.child[s]->parent = n32;
-            s++;
-        }
-}
+    assert_magic(art);
 
-/// Copy node128 to node64.
-///
-/// \param n64      destination node
-/// \param n128     source node
-static inline void art_node128_to_node64(art_node_ct n64, art_node_ct n128)
-{
-    size_t n;
+    if(art->image)
+        return error_pass_ptr(art_image_complete(art, prefix));
 
-    memcpy(n64->v.n64.key, n128->v.n128.key, 256);
-    memcpy(n64->v.n64.child, n128->v.n128.child, n128->size * sizeof(art_node_ct));
+    art_write_begin(art);
+    path = error_pass_ptr(art_complete_prefix(art, prefix));
+    art_write_end((art_ct)art);
 
-    for(n = 0; n < n128->size; n++)
-        n128->v.n128.child[n]->parent = n64;
+    return path;
 }
 
-/// Copy node256 to node128.
+/// ART iterator stack entry
+typedef struct art_iter_entry
+{
+    art_node_ct node;   ///< inner node on path to current node
+    size_t      len;    ///< key length up to and including node path
+    int         key;    ///< key of child on path to current node
+} art_iter_entry_st;
+
+/// ART iterator
+typedef struct art_iter
+{
+    DEBUG_MAGIC
+
+    art_const_ct        art;    ///< ART
+    str_ct              lo;     ///< lower range bound, inclusive, may be NULL
+    str_ct              hi;     ///< upper range bound, exclusive, may be NULL
+    str_ct              key;    ///< key of current node
+    art_node_ct         node;   ///< current node, NULL if not positioned
+    art_iter_entry_st   *stack; ///< inner nodes on path to current node
+    size_t              depth;  ///< number of stack entries
+    size_t              cap;    ///< stack capacity
+} art_iter_st;
+
+/// Compare keys bytewise.
 ///
-/// \param n128     destination node
-/// \param n256     source node
-static inline void art_node256_to_node128(art_node_ct n128, art_node_ct n256)
+/// \param key1     first key
+/// \param key2     second key
+///
+/// \retval <0      \p key1 is smaller than \p key2
+/// \retval 0       keys are equal
+/// \retval >0      \p key1 is greater than \p key2
+static int art_iter_compare(str_const_ct key1, str_const_ct key2)
 {
-    size_t n, s;
+    size_t len1 = str_len(key1), len2 = str_len(key2);
+    int rc;
 
-    for(n = 0, s = 0; n < 256 && s < n256->size; n++)
-        if(n256->v.n256.child[n])
-        {
-            n128->v.n128.key[n]             = s;
-            n128->v.n128.child[s]           = n256->v.n256.child[n];
-            n128->v.n128.child[s]->parent   = n128;
-            s++;
-        }
+    if((rc = memcmp(str_buc(key1), str_buc(key2), MIN(len1, len2))))
+        return rc;
+
+    return (len1 > len2) - (len1 < len2);
 }
 
-/// Shrink ART node to next smaller size.
+/// Get next child key of inner node.
 ///
-/// \param art      ART
-/// \param node1    node to shrink
+/// Children of list nodes are searched completely
+/// to support the unordered sort mode.
 ///
-/// \returns                    new node
-/// \retval NULL/E_GENERIC_OOM  out of memory
-static art_node_ct art_node_shrink(art_ct art, art_node_ct node1)
+/// \param node     inner node
+/// \param key      key to start after, -1 or 256 to start at the beginning
+/// \param reverse  if true get next smaller key else next greater key
+///
+/// \returns        next child key
+/// \retval -1      no more children
+static int art_node_next_key(art_node_const_ct node, int key, bool reverse)
 {
-    art_node_ct node2;
-
-    if(!(node2 = art_node_new(node1->type - 1, node1->key, node1->parent, NULL)))
-        return error_pass(), NULL;
+    const unsigned char *keys;
+    int next = -1, step = reverse ? -1 : 1;
+    size_t i;
 
-    switch(node1->type)
+    switch(node->type)
     {
+    case NODE4:
+        keys = node->v.n4.key;
+        break;
+
     case NODE8:
-        art_node_copy_list(node2, node2->v.n4.key, node2->v.n4.child,
-            node1, node1->v.n8.key, node1->v.n8.child);
+        keys = node->v.n8.key;
         break;
 
     case NODE16:
-        art_node_copy_list(node2, node2->v.n8.key, node2->v.n8.child,
-            node1, node1->v.n16.key, node1->v.n16.child);
+        keys = node->v.n16.key;
         break;
 
     case NODE32:
-        art_node_copy_list(node2, node2->v.n16.key, node2->v.n16.child,
-            node1, node1->v.n32.key, node1->v.n32.child);
+        keys = node->v.n32.key;
         break;
 
     case NODE64:
-        art_node64_to_node32(node2, node1);
+#if NODE64_LIST
+        keys = node->v.n64.key;
         break;
+#else
+        for(key += step; key >= 0 && key < 256; key += step)
+            if(node->v.n64.key[key] != 0xff)
+                return key;
+
+        return -1;
+#endif
 
     case NODE128:
-        art_node128_to_node64(node2, node1);
-        break;
+        for(key += step; key >= 0 && key < 256; key += step)
+            if(node->v.n128.key[key] != 0xff)
+                return key;
+
+        return -1;
 
     case NODE256:
-        art_node256_to_node128(node2, node1);
-        break;
+        for(key += step; key >= 0 && key < 256; key += step)
+            if(node->v.n256.child[key])
+                return key;
+
+        return -1;
 
     default:
         abort();
     }
 
-    node2->size     = node1->size;
-    node2->path     = node1->path;
-    node2->path_len = node1->path_len;
-
-    if(node1 == art->root)
-        art->root = node2;
-    else
-        *art_node_get_child(node1->parent, node1->key) = node2;
-
-    free(node1);
+    for(i = 0; i < node->size; i++)
+        if(reverse ? keys[i] < key && keys[i] > next : keys[i] > key && (next < 0 || keys[i] < next))
+            next = keys[i];
 
-    return node2;
+    return next;
 }
 
-/// ART traverse callback for getting first child node.
-///
-/// \implements art_traverse_cb
+/// Reset iterator to not positioned.
 ///
-/// \retval 1   always stop on first node
-static int art_traverse_first(art_ct art, art_node_ct node, str_ct path, void *ctx)
+/// \param iter     iterator
+static void art_iter_reset(art_iter_ct iter)
 {
-    art_node_ct *child = ctx;
+    iter->node  = NULL;
+    iter->depth = 0;
 
-    *child = node;
-
-    return 1;
+    str_clear(iter->key);
 }
 
-/// Get first child node of parent node.
+/// Push inner node onto iterator stack and append child key.
 ///
-/// \param parent   parent to get child from
+/// \param iter     iterator
+/// \param node     inner node
+/// \param key      key of child on path to current node
 ///
-/// \returns        first child node
-static art_node_ct art_node_get_first_child(art_node_ct parent)
+/// \retval 0                   success
+/// \retval -1/E_GENERIC_OOM    out of memory
+static int art_iter_push(art_iter_ct iter, art_node_ct node, int key)
 {
-    art_node_ct child = NULL;
+    art_iter_entry_st *stack;
+    size_t cap;
+
+    if(iter->depth == iter->cap)
+    {
+        cap = MAX((size_t)ITER_STACK, iter->cap * 2);
 
-    art_traverse(NULL, parent, NO_PREFIX, TRAV_POST, WITHOUT_KEY, FORWARD, art_traverse_first, &child);
+        if(!(stack = realloc(iter->stack, cap * sizeof(art_iter_entry_st))))
+            return error_wrap_last_errno(realloc), -1;
 
-    return child;
+        iter->stack = stack;
+        iter->cap   = cap;
+    }
+
+    iter->stack[iter->depth].node   = node;
+    iter->stack[iter->depth].len    = str_len(iter->key);
+    iter->stack[iter->depth].key    = key;
+    iter->depth++;
+
+    if(!str_append_set(iter->key, 1, key))
+        return error_wrap(), -1;
+
+    return 0;
 }
 
-/// Merge node with its only child.
+/// Descend to first or last leaf node of subtree.
 ///
-/// \param art      ART
-/// \param node     node to merge
+/// \param iter     iterator
+/// \param node     subtree root, its path is not yet part of the iterator key
+/// \param reverse  if true descend to last leaf node else first leaf node
 ///
-/// \returns                    child node
+/// \returns                    ART leaf node
 /// \retval NULL/E_GENERIC_OOM  out of memory
-static art_node_ct art_node_merge(art_ct art, art_node_ct node)
+static art_node_ct art_iter_descend(art_iter_ct iter, art_node_ct node, bool reverse)
 {
-    art_node_ct child;
-
-    // node should be NODE4, but if shrink failed we may have any other type
-    child = art_node_get_first_child(node);
+    int key;
 
-    if(art_node_prepend_path(child, art_node_get_path(node), node->path_len, child->key))
-        return error_pass(), NULL;
+    while(1)
+    {
+        if(!str_append_b(iter->key, art_node_get_path(node), node->path_len))
+            return error_wrap(), NULL;
 
-    child->parent   = node->parent;
-    child->key      = node->key;
+        if(node->type == LEAF)
+            return iter->node = node;
 
-    if(node == art->root)
-        art->root = child;
-    else
-        *art_node_get_child(node->parent, node->key) = child;
+        key = art_node_next_key(node, reverse ? 256 : -1, reverse);
 
-    art_node_free(node);
+        if(art_iter_push(iter, node, key))
+            return error_pass(), NULL;
 
-    return child;
+        node = *art_node_get_child(node, key);
+    }
 }
 
-/// Destroy and free ART node.
+/// Move iterator to next leaf node after the current subtree.
 ///
-/// \param art      ART
-/// \param node     node to free
-/// \param dtor     callback to destroy leaf node data, may be NULL
-/// \param ctx      \p dtor context
-static void art_node_free_f(art_ct art, art_node_ct node, art_dtor_cb dtor, const void *ctx)
+/// \param iter     iterator
+/// \param reverse  if true move to previous leaf node else next leaf node
+///
+/// \returns                        ART leaf node
+/// \retval NULL/E_ART_NOT_FOUND    no more leaf nodes
+/// \retval NULL/E_GENERIC_OOM      out of memory
+static art_node_ct art_iter_step(art_iter_ct iter, bool reverse)
 {
-    if(node->type == LEAF)
-    {
-        if(dtor)
-            dtor(art, node->v.leaf.data, (void *)ctx);
-
-        art->size--;
-    }
+    art_iter_entry_st *entry;
+    int key;
 
-    art_node_free(node);
-}
+    for(; iter->depth; iter->depth--)
+    {
+        entry = &iter->stack[iter->depth - 1];
+        str_cut_tail(iter->key, str_len(iter->key) - entry->len);
 
-/// ART remove state
-typedef struct art_remove_state
-{
-    art_dtor_cb dtor;   ///< node dtor
-    void        *ctx;   ///< node dtor context
-    art_node_ct last;   ///< last node marked for removal
-} art_remove_st;
+        if((key = art_node_next_key(entry->node, entry->key, reverse)) < 0)
+            continue;
 
-/// ART traverse callback for removing nodes.
-///
-/// \implements art_traverse_cb
-///
-/// \retval 0   always success
-static int art_traverse_remove(art_ct art, art_node_ct node, str_ct path, void *ctx)
-{
-    art_remove_st *state = ctx;
+        entry->key = key;
 
-    if(state->last)
-        art_node_free_f(art, state->last, state->dtor, state->ctx);
+        if(!str_append_set(iter->key, 1, key))
+            return error_wrap(), NULL;
 
-    state->last = node;
+        return error_pass_ptr(art_iter_descend(iter, *art_node_get_child(entry->node, key), reverse));
+    }
 
-    return 0;
+    return error_set(E_ART_NOT_FOUND), NULL;
 }
 
-/// Destroy and remove node and all subnodes from ART.
+/// Move iterator to first leaf node not less than key
+/// or last leaf node not greater than key.
 ///
-/// \param art      ART
-/// \param node     node to start with
-/// \param prefix   prefix of nodes to remove, may be NULL
-/// \param dtor     callback to destroy node data, may be NULL
-/// \param ctx      \p dtor context
+/// \param iter     iterator
+/// \param key      key to seek
+/// \param reverse  if true seek last node not greater than \p key
+///                 else first node not less than \p key
 ///
-/// \retval 0                   success
-/// \retval -1/E_ART_NOT_FOUND  \p prefix not found
-static int art_node_remove(art_ct art, art_node_ct node, str_const_ct prefix, art_dtor_cb dtor, const void *ctx)
+/// \returns                        ART leaf node
+/// \retval NULL/E_ART_NOT_FOUND    no such leaf node
+/// \retval NULL/E_GENERIC_OOM      out of memory
+static art_node_ct art_iter_seek_key(art_iter_ct iter, str_const_ct key, bool reverse)
 {
-    art_remove_st state = { .dtor = dtor, .ctx = (void *)ctx };
-    art_node_ct child, parent;
-    unsigned char key;
+    const unsigned char *bytes = str_buc(key);
+    size_t len = str_len(key), depth = 0, cmp_len;
+    art_node_ct node, *child;
+    int cmp, next;
 
-    if(art_traverse(art, node, prefix, TRAV_POST, WITHOUT_KEY, FORWARD, art_traverse_remove, &state))
-        return error_pass(), -1;
+    art_iter_reset(iter);
 
-    child = state.last;
+    if(!(node = iter->art->root))
+        return error_set(E_ART_NOT_FOUND), NULL;
 
     while(1)
     {
-        parent  = child->parent;
-        key     = child->key;
-
-        art_node_free_f(art, child, dtor, ctx);
+        cmp_len = MIN(node->path_len, len - depth);
 
-        if(!parent)
+        // subtree is completely smaller or greater than key
+        if((cmp = memcmp(art_node_get_path(node), &bytes[depth], cmp_len)))
         {
-            art->root = NULL;
-            break;
+            if((cmp < 0) != reverse)
+                return error_pass_ptr(art_iter_step(iter, reverse));
+            else
+                return error_pass_ptr(art_iter_descend(iter, node, reverse));
         }
-        else
-        {
-            art_node_remove_child(parent, key, art->ordered);
 
-            if(parent->size == 0) // failed merge
-            {
-                child = parent;
-            }
-            else if(parent->size == 1)
-            {
-                art_node_merge(art, parent);
-                break;
-            }
+        depth += cmp_len;
+
+        // key is prefix of node, subtree is greater than key
+        if(cmp_len < node->path_len || (depth == len && node->type != LEAF))
+        {
+            if(reverse)
+                return error_pass_ptr(art_iter_step(iter, reverse));
             else
-            {
-                if(parent->type > NODE4 && parent->size <= art_node_capacity(parent->type) / 4)
-                    art_node_shrink(art, parent);
+                return error_pass_ptr(art_iter_descend(iter, node, reverse));
+        }
 
-                break;
-            }
+        if(node->type == LEAF)
+        {
+            // leaf is key or leaf is prefix of key and therefore smaller
+            if(depth == len || reverse)
+                return error_pass_ptr(art_iter_descend(iter, node, reverse));
+            else
+                return error_pass_ptr(art_iter_step(iter, reverse));
         }
-    }
 
-    return 0;
-}
+        if(!str_append_b(iter->key, art_node_get_path(node), node->path_len))
+            return error_wrap(), NULL;
 
-void art_remove(art_ct art, art_node_ct node)
-{
-    assert_magic(art);
-    assert_magic_n(&node->v.leaf, NODE_MAGIC);
-    assert(art == node->v.leaf.art);
+        if((child = art_node_get_child(node, bytes[depth])) && *child)
+        {
+            if(art_iter_push(iter, node, bytes[depth]))
+                return error_pass(), NULL;
 
-    art_node_remove(art, node, NO_PREFIX, NULL, NULL);
-}
+            node = *child;
+            depth++;
+
+            continue;
+        }
+
+        if((next = art_node_next_key(node, bytes[depth], reverse)) < 0)
+            return error_pass_ptr(art_iter_step(iter, reverse));
 
-int art_remove_p(art_ct art, str_const_ct prefix)
-{
-    assert_magic(art);
+        if(art_iter_push(iter, node, next))
+            return error_pass(), NULL;
 
-    return error_pass_int(art_node_remove(art, art->root, prefix, NULL, NULL));
+        return error_pass_ptr(art_iter_descend(iter, *art_node_get_child(node, next), reverse));
+    }
 }
 
-int art_remove_pf(art_ct art, str_const_ct prefix, art_dtor_cb dtor, const void *ctx)
+/// Move iterator to first or last leaf node.
+///
+/// \param iter     iterator
+/// \param reverse  if true move to last leaf node else first leaf node
+///
+/// \returns                        ART leaf node
+/// \retval NULL/E_ART_NOT_FOUND    ART is empty
+/// \retval NULL/E_GENERIC_OOM      out of memory
+static art_node_ct art_iter_first(art_iter_ct iter, bool reverse)
 {
-    assert_magic(art);
+    art_iter_reset(iter);
 
-    return error_pass_int(art_node_remove(art, art->root, prefix, dtor, ctx));
-}
+    return_error_if_fail(iter->art->root, E_ART_NOT_FOUND, NULL);
 
-/// ART find state
-typedef struct art_find_state
-{
-    art_pred_cb pred;   ///< predicate callback
-    void        *ctx;   ///< predicate callback context
-    art_node_ct node;   ///< matched node
-} art_find_st;
+    return error_pass_ptr(art_iter_descend(iter, iter->art->root, reverse));
+}
 
-/// ART traverse callback for finding leaf node.
+/// Check that iterator node is inside range.
 ///
-/// \implements art_traverse_cb
+/// If not, reset iterator.
 ///
-/// \retval 0   node does not match
-/// \retval 1   node does match
-static int art_traverse_find(art_ct art, art_node_ct node, str_ct path, void *ctx)
+/// \param iter     iterator
+/// \param node     node iterator was moved to, NULL on error
+/// \param reverse  if true check lower range bound else upper range bound
+///
+/// \returns                        \p node
+/// \retval NULL/E_ART_NOT_FOUND    \p node is outside of range
+static art_node_ct art_iter_check(art_iter_ct iter, art_node_ct node, bool reverse)
 {
-    art_find_st *state = ctx;
-
-    if(!state->pred(art, path, node->v.leaf.data, state->ctx))
-        return 0;
+    if(!node)
+        return error_pass(), art_iter_reset(iter), NULL;
 
-    state->node = node;
+    if(  (!reverse && iter->hi && art_iter_compare(iter->key, iter->hi) >= 0)
+      || (reverse && iter->lo && art_iter_compare(iter->key, iter->lo) < 0))
+        return error_set(E_ART_NOT_FOUND), art_iter_reset(iter), NULL;
 
-    return 1;
+    return node;
 }
 
-/// Find first leaf node matching predicate.
-///
-/// \param art      ART
-/// \param prefix   prefix of nodes to search, may be NULL
-/// \param key      if true reconstruct node path
-/// \param reverse  if true reverse traverse direction
-/// \param pred     predicate to apply
-/// \param ctx      \p pred context
-///
-/// \returns                        ART leaf node
-/// \retval NULL/E_ART_NOT_FOUND    \p prefix not found or \p pred did not match any node
-static art_node_ct art_find_generic(art_const_ct art, str_const_ct prefix, bool key, bool reverse, art_pred_cb pred, const void *ctx)
+art_iter_ct art_iter_new(art_const_ct art, str_const_ct lo, str_const_ct hi)
 {
-    art_find_st state = { .pred = pred, .ctx = (void *)ctx };
-    int rc;
+    art_iter_ct iter;
+    str_ct path;
 
     assert_magic(art);
-    assert(pred);
+    return_error_if_pass(art->image, E_ART_FROZEN, NULL);
 
-    if((rc = art_traverse((art_ct)art, art->root, prefix, TRAV_LEAF, key, reverse, art_traverse_find, &state)) < 0)
-        return error_pass(), NULL;
+    if(!(iter = calloc(1, sizeof(art_iter_st))))
+        return error_wrap_last_errno(calloc), NULL;
 
-    return_error_if_fail(rc == 1, E_ART_NOT_FOUND, NULL);
+    init_magic_n(iter, ITER_MAGIC);
+    iter->art = art;
 
-    return state.node;
-}
+    if(!(iter->key = str_prepare_bc(0, 10)))
+        return error_wrap(), art_iter_free(iter), NULL;
 
-art_node_ct art_find(art_const_ct art, art_pred_cb pred, const void *ctx)
-{
-    return error_pass_ptr(art_find_generic(art, NO_PREFIX, WITHOUT_KEY, FORWARD, pred, ctx));
-}
+    str_mark_volatile(iter->key);
 
-void *art_find_data(art_const_ct art, art_pred_cb pred, const void *ctx)
-{
-    art_node_ct node;
+    if(lo)
+    {
+        path = art_path_new(lo);
 
-    if(!(node = art_find(art, pred, ctx)))
-        return error_pass(), NULL;
+        if(!(iter->lo = str_dup_b(str_bc(path), str_len(path))))
+            return error_wrap(), art_iter_free(iter), NULL;
+    }
 
-    return node->v.leaf.data;
-}
+    if(hi)
+    {
+        path = art_path_new(hi);
 
-art_node_ct art_find_k(art_const_ct art, art_pred_cb pred, const void *ctx)
-{
-    return error_pass_ptr(art_find_generic(art, NO_PREFIX, WITH_KEY, FORWARD, pred, ctx));
+        if(!(iter->hi = str_dup_b(str_bc(path), str_len(path))))
+            return error_wrap(), art_iter_free(iter), NULL;
+    }
+
+    return iter;
 }
 
-void *art_find_data_k(art_const_ct art, art_pred_cb pred, const void *ctx)
+void art_iter_free(art_iter_ct iter)
 {
-    art_node_ct node;
+    assert_magic_n(iter, ITER_MAGIC);
 
-    if(!(node = art_find_k(art, pred, ctx)))
-        return error_pass(), NULL;
+    if(iter->key)
+        str_unref(iter->key);
 
-    return node->v.leaf.data;
-}
+    if(iter->lo)
+        str_unref(iter->lo);
 
-art_node_ct art_find_r(art_const_ct art, art_pred_cb pred, const void *ctx)
-{
-    return error_pass_ptr(art_find_generic(art, NO_PREFIX, WITHOUT_KEY, BACKWARD, pred, ctx));
+    if(iter->hi)
+        str_unref(iter->hi);
+
+    free(iter->stack);
+    free(iter);
 }
 
-void *art_find_data_r(art_const_ct art, art_pred_cb pred, const void *ctx)
+art_node_ct art_iter_seek(art_iter_ct iter, str_const_ct key)
 {
     art_node_ct node;
 
-    if(!(node = art_find_r(art, pred, ctx)))
-        return error_pass(), NULL;
-
-    return node->v.leaf.data;
-}
+    assert_magic_n(iter, ITER_MAGIC);
 
-art_node_ct art_find_rk(art_const_ct art, art_pred_cb pred, const void *ctx)
-{
-    return error_pass_ptr(art_find_generic(art, NO_PREFIX, WITH_KEY, BACKWARD, pred, ctx));
-}
+    if(key)
+        key = art_path_new(key);
 
-void *art_find_data_rk(art_const_ct art, art_pred_cb pred, const void *ctx)
-{
-    art_node_ct node;
+    if(iter->lo && (!key || art_iter_compare(key, iter->lo) < 0))
+        key = iter->lo;
 
-    if(!(node = art_find_rk(art, pred, ctx)))
-        return error_pass(), NULL;
+    if(key)
+        node = art_iter_seek_key(iter, key, FORWARD);
+    else
+        node = art_iter_first(iter, FORWARD);
 
-    return node->v.leaf.data;
+    return error_pass_ptr(art_iter_check(iter, node, FORWARD));
 }
 
-art_node_ct art_find_p(art_const_ct art, str_const_ct prefix, art_pred_cb pred, const void *ctx)
+art_node_ct art_iter_next(art_iter_ct iter)
 {
-    return error_pass_ptr(art_find_generic(art, prefix, WITHOUT_KEY, FORWARD, pred, ctx));
+    assert_magic_n(iter, ITER_MAGIC);
+
+    if(!iter->node)
+        return error_pass_ptr(art_iter_seek(iter, NULL));
+
+    return error_pass_ptr(art_iter_check(iter, art_iter_step(iter, FORWARD), FORWARD));
 }
 
-void *art_find_data_p(art_const_ct art, str_const_ct prefix, art_pred_cb pred, const void *ctx)
+art_node_ct art_iter_prev(art_iter_ct iter)
 {
     art_node_ct node;
 
-    if(!(node = art_find_p(art, prefix, pred, ctx)))
-        return error_pass(), NULL;
+    assert_magic_n(iter, ITER_MAGIC);
 
-    return node->v.leaf.data;
-}
+    if(iter->node)
+        node = art_iter_step(iter, BACKWARD);
+    else if(!iter->hi)
+        node = art_iter_first(iter, BACKWARD);
+    else if((node = art_iter_seek_key(iter, iter->hi, BACKWARD)) && !art_iter_compare(iter->key, iter->hi))
+        node = art_iter_step(iter, BACKWARD);
 
-art_node_ct art_find_pk(art_const_ct art, str_const_ct prefix, art_pred_cb pred, const void *ctx)
-{
-    return error_pass_ptr(art_find_generic(art, prefix, WITH_KEY, FORWARD, pred, ctx));
+    return error_pass_ptr(art_iter_check(iter, node, BACKWARD));
 }
 
-void *art_find_data_pk(art_const_ct art, str_const_ct prefix, art_pred_cb pred, const void *ctx)
+str_const_ct art_iter_key(art_iter_const_ct iter)
 {
-    art_node_ct node;
-
-    if(!(node = art_find_pk(art, prefix, pred, ctx)))
-        return error_pass(), NULL;
+    assert_magic_n(iter, ITER_MAGIC);
+    return_error_if_fail(iter->node, E_ART_NOT_FOUND, NULL);
 
-    return node->v.leaf.data;
+    return iter->key;
 }
 
-art_node_ct art_find_pr(art_const_ct art, str_const_ct prefix, art_pred_cb pred, const void *ctx)
+/// ART freeze state
+typedef struct art_freeze_state
 {
-    return error_pass_ptr(art_find_generic(art, prefix, WITHOUT_KEY, BACKWARD, pred, ctx));
-}
+    FILE        *fp;    ///< image file
+    uint64_t    pos;    ///< image length written so far
+    str_ct      path;   ///< key of current node
+} art_freeze_st;
 
-void *art_find_data_pr(art_const_ct art, str_const_ct prefix, art_pred_cb pred, const void *ctx)
+/// Append to ART image.
+///
+/// \param state    freeze state
+/// \param data     data to append
+/// \param len      length of \p data
+///
+/// \retval 0                       success
+/// \retval -1/E_GENERIC_SYSTEM     write error
+static int art_freeze_write(art_freeze_st *state, const void *data, size_t len)
 {
-    art_node_ct node;
+    if(len && fwrite(data, len, 1, state->fp) != 1)
+        return error_wrap_last_errno(fwrite), -1;
 
-    if(!(node = art_find_pr(art, prefix, pred, ctx)))
-        return error_pass(), NULL;
+    state->pos += len;
 
-    return node->v.leaf.data;
+    return 0;
 }
 
-art_node_ct art_find_prk(art_const_ct art, str_const_ct prefix, art_pred_cb pred, const void *ctx)
+/// Pad ART image to IMAGE_ALIGN.
+///
+/// \param state    freeze state
+///
+/// \retval 0                       success
+/// \retval -1/E_GENERIC_SYSTEM     write error
+static int art_freeze_align(art_freeze_st *state)
 {
-    return error_pass_ptr(art_find_generic(art, prefix, WITH_KEY, BACKWARD, pred, ctx));
+    static const unsigned char zero[IMAGE_ALIGN];
+
+    return error_pass_int(art_freeze_write(state, zero, IMAGE_PAD(state->pos) - state->pos));
 }
 
-void *art_find_data_prk(art_const_ct art, str_const_ct prefix, art_pred_cb pred, const void *ctx)
+/// Append ART image leaf node.
+///
+/// \param state    freeze state, path holds full node key
+/// \param node     leaf node
+///
+/// \returns                        image node offset
+/// \retval 0/E_GENERIC_SYSTEM      write error
+static uint64_t art_freeze_leaf(art_freeze_st *state, art_node_const_ct node)
 {
-    art_node_ct node;
+    art_image_leaf_st leaf = { .type = IMAGE_LEAF };
+    uint64_t offset = state->pos;
 
-    if(!(node = art_find_prk(art, prefix, pred, ctx)))
-        return error_pass(), NULL;
+    leaf.len    = str_len(state->path);
+    leaf.data   = (uintptr_t)node->v.leaf.data;
 
-    return node->v.leaf.data;
-}
+    if(  art_freeze_write(state, &leaf, sizeof(art_image_leaf_st))
+      || art_freeze_write(state, str_buc(state->path), leaf.len)
+      || art_freeze_align(state))
+        return error_pass(), 0;
 
-/// ART fold state
-typedef struct art_fold_state
-{
-    art_fold_cb fold;   ///< fold callback
-    void        *ctx;   ///< fold callback context
-} art_fold_st;
+    return offset;
+}
 
-/// ART traverse callback for folding leaf nodes.
+/// Append ART image subtree.
 ///
-/// \implements art_traverse_cb
+/// Children are appended before their parent to know their offsets.
 ///
-/// \retval >=0                 fold rc
-/// \retval <0/E_ART_CALLBACK   fold error
-static int art_traverse_fold(art_ct art, art_node_ct node, str_ct path, void *ctx)
+/// \param state    freeze state
+/// \param node     subtree root
+///
+/// \returns                        image node offset
+/// \retval 0/E_GENERIC_SYSTEM      write error
+/// \retval 0/E_GENERIC_OOM         out of memory
+static uint64_t art_freeze_node(art_freeze_st *state, art_node_const_ct node)
 {
-    art_fold_st *state = ctx;
+    art_image_node_st inner = { .path_len = node->path_len };
+    unsigned char keys[256], index[256];
+    uint64_t *children, offset = 0, none = 0;
+    size_t len = str_len(state->path), size, i;
+    int key;
 
-    return error_pack_int(E_ART_CALLBACK,
-        state->fold(art, path, node->v.leaf.data, state->ctx));
+    if(!str_append_b(state->path, art_node_get_path(node), node->path_len))
+        return error_wrap(), 0;
+
+    if(node->type == LEAF)
+    {
+        if(!(offset = art_freeze_leaf(state, node)))
+            return error_pass(), 0;
+
+        str_cut_tail(state->path, node->path_len);
+
+        return offset;
+    }
+
+    if(!(children = malloc(node->size * sizeof(uint64_t))))
+        return error_wrap_last_errno(malloc), 0;
+
+    for(size = 0, key = -1; (key = art_node_next_key(node, key, FORWARD)) >= 0; size++)
+    {
+        keys[size] = key;
+
+        if(!str_append_set(state->path, 1, key))
+        {
+            error_wrap();
+            goto error;
+        }
+
+        if(!(children[size] = art_freeze_node(state, *art_node_get_child((art_node_ct)node, key))))
+            goto error;
+
+        str_cut_tail(state->path, 1);
+    }
+
+    inner.size  = size;
+    inner.type  = size <= IMAGE_LIST_MAX ? IMAGE_LIST : size <= IMAGE_INDEX_MAX ? IMAGE_INDEX : IMAGE_FULL;
+    offset      = state->pos;
+
+    if(  art_freeze_write(state, &inner, sizeof(art_image_node_st))
+      || art_freeze_write(state, art_node_get_path(node), node->path_len))
+        goto error;
+
+    switch(inner.type)
+    {
+    case IMAGE_LIST:
+
+        if(  art_freeze_write(state, keys, size)
+          || art_freeze_align(state)
+          || art_freeze_write(state, children, size * sizeof(uint64_t)))
+            goto error;
+
+        break;
+
+    case IMAGE_INDEX:
+        memset(index, 0xff, sizeof(index));
+
+        for(i = 0; i < size; i++)
+            index[keys[i]] = i;
+
+        if(  art_freeze_write(state, index, sizeof(index))
+          || art_freeze_align(state)
+          || art_freeze_write(state, children, size * sizeof(uint64_t)))
+            goto error;
+
+        break;
+
+    case IMAGE_FULL:
+
+        if(art_freeze_align(state))
+            goto error;
+
+        for(i = 0, key = 0; key < 256; key++)
+            if(art_freeze_write(state, i < size && keys[i] == key ? &children[i++] : &none, sizeof(uint64_t)))
+                goto error;
+
+        break;
+
+    default:
+        abort();
+    }
+
+    free(children);
+    str_cut_tail(state->path, str_len(state->path) - len);
+
+    return offset;
+
+error:
+    free(children);
+
+    return error_pass(), 0;
 }
 
-/// Fold over all leaf nodes.
+/// Write ART image of tree.
 ///
 /// \param art      ART
-/// \param prefix   prefix of nodes to search, may be NULL
-/// \param key      if true reconstruct node path
-/// \param reverse  if true reverse traverse direction
-/// \param fold     callback to invoke on each leaf node
-/// \param ctx      \p fold context
+/// \param state    freeze state
 ///
-/// \retval 0                   success
-/// \retval -1/E_ART_NOT_FOUND  \p prefix not found
-/// \retval <0/E_ART_CALLBACK   \p fold error
-/// \retval >0                  \p fold rc
-static int art_fold_generic(art_ct art, str_const_ct prefix, bool key, bool reverse, art_fold_cb fold, const void *ctx)
+/// \retval 0                       success
+/// \retval -1/E_GENERIC_SYSTEM     write error
+/// \retval -1/E_GENERIC_OOM        out of memory
+static int art_freeze_tree(art_const_ct art, art_freeze_st *state)
 {
-    art_fold_st state = { .fold = fold, .ctx = (void *)ctx };
+    art_image_st image = { .magic = IMAGE_MAGIC, .version = IMAGE_VERSION, .ptr_size = sizeof(void *) };
 
-    assert_magic(art);
-    assert(fold);
-
-    return error_pass_int(art_traverse(art, art->root, prefix, TRAV_LEAF, key, reverse, art_traverse_fold, &state));
-}
+    if(art_freeze_write(state, &image, sizeof(art_image_st)))
+        return error_pass(), -1;
 
-int art_fold(art_ct art, art_fold_cb fold, const void *ctx)
-{
-    return error_pass_int(art_fold_generic(art, NO_PREFIX, WITHOUT_KEY, FORWARD, fold, ctx));
-}
+    if(art->root)
+    {
+        if(!(state->path = str_prepare_bc(0, 10)))
+            return error_wrap(), -1;
 
-int art_fold_k(art_ct art, art_fold_cb fold, const void *ctx)
-{
-    return error_pass_int(art_fold_generic(art, NO_PREFIX, WITH_KEY, FORWARD, fold, ctx));
-}
+        str_mark_volatile(state->path);
 
-int art_fold_r(art_ct art, art_fold_cb fold, const void *ctx)
-{
-    return error_pass_int(art_fold_generic(art, NO_PREFIX, WITHOUT_KEY, BACKWARD, fold, ctx));
-}
+        image.root = art_freeze_node(state, art->root);
+        str_unref(state->path);
 
-int art_fold_rk(art_ct art, art_fold_cb fold, const void *ctx)
-{
-    return error_pass_int(art_fold_generic(art, NULL, WITH_KEY, BACKWARD, fold, ctx));
-}
+        if(!image.root)
+            return error_pass(), -1;
+    }
 
-int art_fold_p(art_ct art, str_const_ct prefix, art_fold_cb fold, const void *ctx)
-{
-    return error_pass_int(art_fold_generic(art, prefix, WITHOUT_KEY, FORWARD, fold, ctx));
-}
+    image.size  = art->size;
+    image.len   = state->pos;
 
-int art_fold_pk(art_ct art, str_const_ct prefix, art_fold_cb fold, const void *ctx)
-{
-    return error_pass_int(art_fold_generic(art, prefix, WITH_KEY, FORWARD, fold, ctx));
-}
+    if(fseek(state->fp, 0, SEEK_SET))
+        return error_wrap_last_errno(fseek), -1;
 
-int art_fold_pr(art_ct art, str_const_ct prefix, art_fold_cb fold, const void *ctx)
-{
-    return error_pass_int(art_fold_generic(art, prefix, WITHOUT_KEY, BACKWARD, fold, ctx));
-}
+    if(fwrite(&image, sizeof(art_image_st), 1, state->fp) != 1)
+        return error_wrap_last_errno(fwrite), -1;
 
-int art_fold_prk(art_ct art, str_const_ct prefix, art_fold_cb fold, const void *ctx)
-{
-    return error_pass_int(art_fold_generic(art, prefix, WITH_KEY, BACKWARD, fold, ctx));
+    return 0;
 }
 
-str_ct art_complete(art_const_ct art, str_const_ct prefix)
+int art_freeze(art_const_ct art, str_const_ct file)
 {
-    art_node_ct node;
-    str_ct lookup, path;
-    size_t node_prefix = 0;
+    art_freeze_st state = { 0 };
+    int rc;
 
     assert_magic(art);
+    assert(file);
 
-    return_error_if_fail(art->size, E_ART_EMPTY, NULL);
+    if(!(state.fp = fopen(str_c(file), "wb")))
+        return error_pack_last_errno(E_ART_FILE, fopen), -1;
 
-    if(prefix && !str_is_empty(prefix))
+    if(art->image)
     {
-        lookup  = art_path_new(prefix);
-        node    = art_lookup(art, art->root, lookup, &node_prefix, NULL);
-        return_error_if_fail(str_is_empty(lookup), E_ART_NOT_FOUND, NULL);
+        rc = error_pass_int(art_freeze_write(&state, art->image, art->image->len));
     }
     else
     {
-        node = art->root;
+        art_write_begin((art_ct)art);
+        rc = error_pass_int(art_freeze_tree(art, &state));
+        art_write_end((art_ct)art);
     }
 
-    if(!(path = str_dup_b(art_node_get_path(node) + node_prefix, node->path_len - node_prefix)))
-        return error_wrap(), NULL;
-
-    // nodes with 1 child may happen if a merge fails
-    while(node->size == 1)
+    if(fclose(state.fp) && !rc)
     {
-        node = art_node_get_first_child(node);
-
-        if(  !str_append_set(path, 1, node->key)
-          || !str_append_b(path, art_node_get_path(node), node->path_len))
-            return error_wrap(), str_unref(path), NULL;
+        error_wrap_last_errno(fclose);
+        rc = -1;
     }
 
-    return path;
+    if(rc)
+        remove(str_c(file));
+
+    return rc;
 }
@@ -0,0 +1,966 @@
+/*
+ * Copyright (c) 2026 Martin Rödel a.k.a. Yomin Nimoy
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/// \file
+
+#include <ytil/con/deque.h>
+#include <ytil/def.h>
+#include <ytil/def/magic.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+#define MAGIC define_magic("DEQ")   ///< deque magic
+
+#define DEFAULT_CHUNK_BYTES 4096    ///< default chunk size in bytes
+#define MIN_CHUNK_ELEMS     8U      ///< minimum number of elements per chunk
+#define MIN_CHUNKS          8U      ///< minimum chunk table capacity
+
+/// get chunk at index
+#define CHUNK(k) (&deque->chunks[deque->first + (k)])
+
+/// get pointer to element in chunk slot
+#define SLOT(chunk, s) ((chunk)->data + (s) * deque->esize)
+
+
+/// deque chunk
+typedef struct deque_chunk
+{
+    char    *data;      ///< chunk memory
+    size_t  offset;     ///< slot of first element
+    size_t  count;      ///< number of elements
+} deque_chunk_st;
+
+/// deque
+typedef struct deque
+{
+    DEBUG_MAGIC
+
+    size_t          size;       ///< number of elements
+    size_t          esize;      ///< element size
+    size_t          csize;      ///< number of elements per chunk, power of 2
+    size_t          cshift;     ///< log2 of csize
+    deque_chunk_st  *chunks;    ///< chunk table
+    size_t          first;      ///< index of first chunk in table
+    size_t          nchunks;    ///< number of chunks
+    size_t          cap;        ///< chunk table capacity
+    char            *spare;     ///< released chunk memory kept for reuse
+    bool            sparse;     ///< chunks are not packed, locate elements by scan
+} deque_st;
+
+/// deque error type definition
+ERROR_DEFINE_LIST(DEQUE,
+    ERROR_INFO(E_DEQUE_CALLBACK,        "Callback error."),
+    ERROR_INFO(E_DEQUE_EMPTY,           "Deque is empty."),
+    ERROR_INFO(E_DEQUE_OUT_OF_BOUNDS,   "Out of bounds access.")
+);
+
+/// default error type for deque module
+#define ERROR_TYPE_DEFAULT ERROR_TYPE_DEQUE
+
+
+deque_ct deque_new(size_t elemsize)
+{
+    assert(elemsize);
+
+    return error_pass_ptr(deque_new_c(DEFAULT_CHUNK_BYTES / elemsize, elemsize));
+}
+
+deque_ct deque_new_c(size_t chunksize, size_t elemsize)
+{
+    deque_ct deque;
+
+    assert(elemsize);
+
+    if(!(deque = calloc(1, sizeof(deque_st))))
+        return error_wrap_last_errno(calloc), NULL;
+
+    init_magic(deque);
+    deque->esize = elemsize;
+
+    for(deque->cshift = 0; ((size_t)1 << deque->cshift) < MAX(chunksize, MIN_CHUNK_ELEMS); deque->cshift++);
+
+    deque->csize = (size_t)1 << deque->cshift;
+
+    return deque;
+}
+
+void deque_free(deque_ct deque)
+{
+    deque_free_f(deque, NULL, NULL);
+}
+
+void deque_free_f(deque_ct deque, deque_dtor_cb dtor, const void *ctx)
+{
+    deque_clear_f(deque, dtor, ctx);
+
+    free(deque->spare);
+    free(deque->chunks);
+    free(deque);
+}
+
+/// Allocate chunk memory.
+///
+/// \param deque    deque
+///
+/// \returns                    chunk memory
+/// \retval NULL/E_GENERIC_OOM  out of memory
+static char *deque_chunk_alloc(deque_ct deque)
+{
+    char *data;
+
+    if((data = deque->spare))
+    {
+        deque->spare = NULL;
+
+        return data;
+    }
+
+    if(!(data = malloc(deque->csize * deque->esize)))
+        return error_wrap_last_errno(malloc), NULL;
+
+    return data;
+}
+
+/// Release chunk memory, keep one chunk for reuse.
+///
+/// \param deque    deque
+/// \param data     chunk memory
+static void deque_chunk_release(deque_ct deque, char *data)
+{
+    if(deque->spare)
+        free(data);
+    else
+        deque->spare = data;
+}
+
+void deque_clear(deque_ct deque)
+{
+    deque_clear_f(deque, NULL, NULL);
+}
+
+void deque_clear_f(deque_ct deque, deque_dtor_cb dtor, const void *ctx)
+{
+    deque_chunk_st *chunk;
+    size_t k, s;
+
+    assert_magic(deque);
+
+    for(k = 0; k < deque->nchunks; k++)
+    {
+        chunk = CHUNK(k);
+
+        if(dtor)
+            for(s = chunk->offset; s < chunk->offset + chunk->count; s++)
+                dtor(deque, SLOT(chunk, s), (void *)ctx);
+
+        deque_chunk_release(deque, chunk->data);
+    }
+
+    deque->size     = 0;
+    deque->nchunks  = 0;
+    deque->first    = deque->cap / 2;
+    deque->sparse   = false;
+}
+
+bool deque_is_empty(deque_const_ct deque)
+{
+    assert_magic(deque);
+
+    return !deque->size;
+}
+
+size_t deque_size(deque_const_ct deque)
+{
+    assert_magic(deque);
+
+    return deque->size;
+}
+
+size_t deque_elemsize(deque_const_ct deque)
+{
+    assert_magic(deque);
+
+    return deque->esize;
+}
+
+size_t deque_chunksize(deque_const_ct deque)
+{
+    assert_magic(deque);
+
+    return deque->csize;
+}
+
+size_t deque_memsize(deque_const_ct deque)
+{
+    return deque_memsize_f(deque, NULL, NULL);
+}
+
+size_t deque_memsize_f(deque_const_ct deque, deque_size_cb size, const void *ctx)
+{
+    deque_chunk_st *chunk;
+    size_t memsize, k, s;
+
+    assert_magic(deque);
+
+    memsize = sizeof(deque_st)
+        + deque->cap * sizeof(deque_chunk_st)
+        + (deque->nchunks + !!deque->spare) * deque->csize * deque->esize;
+
+    if(size)
+        for(k = 0; k < deque->nchunks; k++)
+        {
+            chunk = CHUNK(k);
+
+            for(s = chunk->offset; s < chunk->offset + chunk->count; s++)
+                memsize += size(deque, SLOT(chunk, s), (void *)ctx);
+        }
+
+    return memsize;
+}
+
+/// Locate element.
+///
+/// If the chunks are packed, the element is located by division.
+/// Else the chunk sizes are summed up starting from the nearer end.
+///
+/// \param      deque   deque
+/// \param      index   element index, must be in bounds
+/// \param[out] slot    element slot in chunk
+///
+/// \returns            chunk containing element
+static deque_chunk_st *deque_locate(deque_const_ct deque, size_t index, size_t *slot)
+{
+    deque_chunk_st *chunk;
+
+    if(!deque->sparse)
+    {
+        index += CHUNK(0)->offset;
+        *slot = index & (deque->csize - 1);
+
+        return CHUNK(index >> deque->cshift);
+    }
+
+    if(index < deque->size / 2)
+    {
+        for(chunk = CHUNK(0); index >= chunk->count; chunk++)
+            index -= chunk->count;
+
+        *slot = chunk->offset + index;
+    }
+    else
+    {
+        index = deque->size - index;
+
+        for(chunk = CHUNK(deque->nchunks - 1); index > chunk->count; chunk--)
+            index -= chunk->count;
+
+        *slot = chunk->offset + chunk->count - index;
+    }
+
+    return chunk;
+}
+
+/// Get element at position.
+///
+/// \param deque    deque
+/// \param pos      position of element, negative value counts from last element
+///
+/// \returns                            pointer to element
+/// \retval NULL/E_DEQUE_OUT_OF_BOUNDS  \p pos is out of bounds
+static void *deque_at_pos(deque_const_ct deque, ssize_t pos)
+{
+    deque_chunk_st *chunk;
+    size_t slot;
+
+    if(pos < 0)
+        pos += deque->size;
+
+    return_error_if_fail(pos >= 0 && (size_t)pos < deque->size, E_DEQUE_OUT_OF_BOUNDS, NULL);
+
+    chunk = deque_locate(deque, pos, &slot);
+
+    return SLOT(chunk, slot);
+}
+
+void *deque_at(deque_const_ct deque, ssize_t pos)
+{
+    assert_magic(deque);
+
+    return error_pass_ptr(deque_at_pos(deque, pos));
+}
+
+void *deque_at_p(deque_const_ct deque, ssize_t pos)
+{
+    void **elem;
+
+    assert_magic(deque);
+    assert(deque->esize == sizeof(void *));
+
+    if(!(elem = deque_at_pos(deque, pos)))
+        return error_pass(), NULL;
+
+    return *elem;
+}
+
+void *deque_first(deque_const_ct deque)
+{
+    assert_magic(deque);
+    return_error_if_fail(deque->size, E_DEQUE_EMPTY, NULL);
+
+    return SLOT(CHUNK(0), CHUNK(0)->offset);
+}
+
+void *deque_last(deque_const_ct deque)
+{
+    deque_chunk_st *chunk;
+
+    assert_magic(deque);
+    return_error_if_fail(deque->size, E_DEQUE_EMPTY, NULL);
+
+    chunk = CHUNK(deque->nchunks - 1);
+
+    return SLOT(chunk, chunk->offset + chunk->count - 1);
+}
+
+int deque_get(deque_const_ct deque, void *dst, ssize_t pos)
+{
+    void *elem;
+
+    assert_magic(deque);
+
+    if(!(elem = deque_at_pos(deque, pos)))
+        return error_pass(), -1;
+
+    if(dst)
+        memcpy(dst, elem, deque->esize);
+
+    return 0;
+}
+
+/// Make room for one chunk at front or back of chunk table.
+///
+/// If the table is at most half full, the chunks are centered,
+/// else the table is doubled.
+///
+/// \param deque    deque
+/// \param front    make room at front, else at back
+///
+/// \retval 0                   success
+/// \retval -1/E_GENERIC_OOM    out of memory
+static int deque_table_reserve(deque_ct deque, bool front)
+{
+    deque_chunk_st *chunks;
+    size_t cap, first;
+
+    if(front ? deque->first > 0 : deque->first + deque->nchunks < deque->cap)
+        return 0;
+
+    if(deque->cap && deque->nchunks * 2 <= deque->cap)
+    {
+        first = (deque->cap - deque->nchunks) / 2;
+        memmove(&deque->chunks[first], CHUNK(0), deque->nchunks * sizeof(deque_chunk_st));
+        deque->first = first;
+
+        return 0;
+    }
+
+    cap     = MAX(deque->cap * 2, MIN_CHUNKS);
+    first   = (cap - deque->nchunks) / 2;
+
+    if(!(chunks = malloc(cap * sizeof(deque_chunk_st))))
+        return error_wrap_last_errno(malloc), -1;
+
+    if(deque->nchunks)
+        memcpy(&chunks[first], CHUNK(0), deque->nchunks * sizeof(deque_chunk_st));
+
+    free(deque->chunks);
+    deque->chunks   = chunks;
+    deque->cap      = cap;
+    deque->first    = first;
+
+    return 0;
+}
+
+/// Insert new chunk into chunk table.
+///
+/// The chunks before or after the new chunk are moved,
+/// whichever are fewer.
+///
+/// \param deque    deque
+/// \param k        index of new chunk
+/// \param offset   slot of first element
+///
+/// \returns                    new empty chunk
+/// \retval NULL/E_GENERIC_OOM  out of memory
+static deque_chunk_st *deque_chunk_insert(deque_ct deque, size_t k, size_t offset)
+{
+    deque_chunk_st *chunk;
+    bool front = k < deque->nchunks / 2;
+    char *data;
+
+    if(!(data = deque_chunk_alloc(deque)))
+        return error_pass(), NULL;
+
+    if(deque_table_reserve(deque, front))
+        return error_pass(), deque_chunk_release(deque, data), NULL;
+
+    if(front)
+    {
+        memmove(&deque->chunks[deque->first - 1], CHUNK(0), k * sizeof(deque_chunk_st));
+        deque->first--;
+    }
+    else
+    {
+        memmove(CHUNK(k + 1), CHUNK(k), (deque->nchunks - k) * sizeof(deque_chunk_st));
+    }
+
+    deque->nchunks++;
+
+    chunk           = CHUNK(k);
+    chunk->data     = data;
+    chunk->offset   = offset;
+    chunk->count    = 0;
+
+    return chunk;
+}
+
+/// Remove chunk from chunk table.
+///
+/// \param deque    deque
+/// \param k        index of chunk to remove
+static void deque_chunk_remove(deque_ct deque, size_t k)
+{
+    deque_chunk_release(deque, CHUNK(k)->data);
+
+    if(k < deque->nchunks / 2)
+    {
+        memmove(CHUNK(1), CHUNK(0), k * sizeof(deque_chunk_st));
+        deque->first++;
+    }
+    else
+    {
+        memmove(CHUNK(k), CHUNK(k + 1), (deque->nchunks - k - 1) * sizeof(deque_chunk_st));
+    }
+
+    deque->nchunks--;
+
+    if(!deque->nchunks)
+        deque->first = deque->cap / 2;
+}
+
+/// Merge chunk with its successor if both are at most half full together.
+///
+/// \param deque    deque
+/// \param k        index of chunk to merge successor into
+static void deque_chunk_merge(deque_ct deque, size_t k)
+{
+    deque_chunk_st *chunk = CHUNK(k), *next = CHUNK(k + 1);
+
+    if(chunk->count + next->count > deque->csize / 2)
+        return;
+
+    if(chunk->offset + chunk->count + next->count > deque->csize)
+    {
+        memmove(chunk->data, SLOT(chunk, chunk->offset), chunk->count * deque->esize);
+        chunk->offset = 0;
+    }
+
+    memcpy(SLOT(chunk, chunk->offset + chunk->count), SLOT(next, next->offset), next->count * deque->esize);
+    chunk->count += next->count;
+
+    deque_chunk_remove(deque, k + 1);
+}
+
+/// Push element onto end of deque.
+///
+/// \param deque    deque
+/// \param elem     pointer to element, may be NULL
+///
+/// \returns                    pointer to new element
+/// \retval NULL/E_GENERIC_OOM  out of memory
+static void *deque_push_back_elem(deque_ct deque, const void *elem)
+{
+    deque_chunk_st *chunk = deque->nchunks ? CHUNK(deque->nchunks - 1) : NULL;
+    void *dst;
+
+    if(!chunk || chunk->offset + chunk->count == deque->csize)
+    {
+        if(!(chunk = deque_chunk_insert(deque, deque->nchunks, 0)))
+            return error_pass(), NULL;
+    }
+
+    dst = SLOT(chunk, chunk->offset + chunk->count);
+    chunk->count++;
+    deque->size++;
+
+    if(elem)
+        memcpy(dst, elem, deque->esize);
+    else
+        memset(dst, 0, deque->esize);
+
+    return dst;
+}
+
+/// Push element onto front of deque.
+///
+/// \param deque    deque
+/// \param elem     pointer to element, may be NULL
+///
+/// \returns                    pointer to new element
+/// \retval NULL/E_GENERIC_OOM  out of memory
+static void *deque_push_front_elem(deque_ct deque, const void *elem)
+{
+    deque_chunk_st *chunk = deque->nchunks ? CHUNK(0) : NULL;
+    void *dst;
+
+    if(!chunk || !chunk->offset)
+    {
+        if(!(chunk = deque_chunk_insert(deque, 0, deque->csize)))
+            return error_pass(), NULL;
+    }
+
+    chunk->offset--;
+    chunk->count++;
+    deque->size++;
+    dst = SLOT(chunk, chunk->offset);
+
+    if(elem)
+        memcpy(dst, elem, deque->esize);
+    else
+        memset(dst, 0, deque->esize);
+
+    return dst;
+}
+
+void *deque_push(deque_ct deque)
+{
+    assert_magic(deque);
+
+    return error_pass_ptr(deque_push_back_elem(deque, NULL));
+}
+
+void *deque_push_e(deque_ct deque, const void *elem)
+{
+    assert_magic(deque);
+
+    return error_pass_ptr(deque_push_back_elem(deque, elem));
+}
+
+void *deque_push_p(deque_ct deque, const void *ptr)
+{
+    assert_magic(deque);
+    assert(deque->esize == sizeof(void *));
+
+    return error_pass_ptr(deque_push_back_elem(deque, &ptr));
+}
+
+void *deque_push_front(deque_ct deque)
+{
+    assert_magic(deque);
+
+    return error_pass_ptr(deque_push_front_elem(deque, NULL));
+}
+
+void *deque_push_front_e(deque_ct deque, const void *elem)
+{
+    assert_magic(deque);
+
+    return error_pass_ptr(deque_push_front_elem(deque, elem));
+}
+
+void *deque_push_front_p(deque_ct deque, const void *ptr)
+{
+    assert_magic(deque);
+    assert(deque->esize == sizeof(void *));
+
+    return error_pass_ptr(deque_push_front_elem(deque, &ptr));
+}
+
+/// Insert element at position.
+///
+/// If the target chunk is full, its upper half is split off into a new chunk.
+/// Within the chunk the elements on the shorter side are moved.
+///
+/// \param deque    deque
+/// \param pos      position to insert at, negative value counts from last element
+/// \param elem     pointer to element, may be NULL
+///
+/// \returns                            pointer to new element
+/// \retval NULL/E_DEQUE_OUT_OF_BOUNDS  \p pos is out of bounds
+/// \retval NULL/E_GENERIC_OOM          out of memory
+static void *deque_insert_elem(deque_ct deque, ssize_t pos, const void *elem)
+{
+    deque_chunk_st *chunk, *next;
+    size_t k, slot, start, end, half;
+    void *dst;
+
+    if(pos < 0)
+        pos += deque->size;
+
+    return_error_if_fail(pos >= 0 && (size_t)pos <= deque->size, E_DEQUE_OUT_OF_BOUNDS, NULL);
+
+    if(!pos)
+        return error_pass_ptr(deque_push_front_elem(deque, elem));
+
+    if((size_t)pos == deque->size)
+        return error_pass_ptr(deque_push_back_elem(deque, elem));
+
+    chunk   = deque_locate(deque, pos, &slot);
+    k       = chunk - CHUNK(0);
+
+    if(chunk->count == deque->csize)
+    {
+        if(!(next = deque_chunk_insert(deque, k + 1, 0)))
+            return error_pass(), NULL;
+
+        chunk           = CHUNK(k);
+        half            = deque->csize / 2;
+        next->count     = deque->csize - half;
+        chunk->count    = half;
+        memcpy(next->data, SLOT(chunk, half), next->count * deque->esize);
+
+        if(slot > half)
+        {
+            chunk   = next;
+            slot    -= half;
+        }
+    }
+
+    start   = chunk->offset;
+    end     = start + chunk->count;
+
+    if(start && (end == deque->csize || slot - start < end - slot))
+    {
+        memmove(SLOT(chunk, start - 1), SLOT(chunk, start), (slot - start) * deque->esize);
+        chunk->offset--;
+        slot--;
+    }
+    else
+    {
+        memmove(SLOT(chunk, slot + 1), SLOT(chunk, slot), (end - slot) * deque->esize);
+    }
+
+    chunk->count++;
+    deque->size++;
+    deque->sparse = true;
+    dst = SLOT(chunk, slot);
+
+    if(elem)
+        memcpy(dst, elem, deque->esize);
+    else
+        memset(dst, 0, deque->esize);
+
+    return dst;
+}
+
+void *deque_insert(deque_ct deque, ssize_t pos)
+{
+    assert_magic(deque);
+
+    return error_pass_ptr(deque_insert_elem(deque, pos, NULL));
+}
+
+void *deque_insert_e(deque_ct deque, ssize_t pos, const void *elem)
+{
+    assert_magic(deque);
+
+    return error_pass_ptr(deque_insert_elem(deque, pos, elem));
+}
+
+void *deque_insert_p(deque_ct deque, ssize_t pos, const void *ptr)
+{
+    assert_magic(deque);
+    assert(deque->esize == sizeof(void *));
+
+    return error_pass_ptr(deque_insert_elem(deque, pos, &ptr));
+}
+
+/// Get, destroy and remove element at chunk slot.
+///
+/// \param deque    deque
+/// \param k        chunk index
+/// \param slot     element slot in chunk
+/// \param dst      pointer to element to fill, may be NULL
+/// \param dtor     callback to destroy element, may be NULL
+/// \param ctx      \p dtor context
+static void deque_remove_slot(deque_ct deque, size_t k, size_t slot, void *dst, deque_dtor_cb dtor, const void *ctx)
+{
+    deque_chunk_st *chunk = CHUNK(k);
+    size_t start = chunk->offset, end = start + chunk->count;
+
+    if(dst)
+        memcpy(dst, SLOT(chunk, slot), deque->esize);
+
+    if(dtor)
+        dtor(deque, SLOT(chunk, slot), (void *)ctx);
+
+    if(slot - start < end - 1 - slot)
+    {
+        memmove(SLOT(chunk, start + 1), SLOT(chunk, start), (slot - start) * deque->esize);
+        chunk->offset++;
+    }
+    else
+    {
+        memmove(SLOT(chunk, slot), SLOT(chunk, slot + 1), (end - 1 - slot) * deque->esize);
+    }
+
+    chunk->count--;
+    deque->size--;
+
+    if(!chunk->count)
+        deque_chunk_remove(deque, k);
+
+    if(!deque->size)
+        deque->sparse = false;
+}
+
+/// Get, destroy and remove last element.
+///
+/// \param deque    deque
+/// \param dst      pointer to element to fill, may be NULL
+/// \param dtor     callback to destroy element, may be NULL
+/// \param ctx      \p dtor context
+///
+/// \retval 0                   success
+/// \retval -1/E_DEQUE_EMPTY    deque is empty
+static int deque_pop_back_elem(deque_ct deque, void *dst, deque_dtor_cb dtor, const void *ctx)
+{
+    deque_chunk_st *chunk;
+
+    return_error_if_fail(deque->size, E_DEQUE_EMPTY, -1);
+
+    chunk = CHUNK(deque->nchunks - 1);
+    deque_remove_slot(deque, deque->nchunks - 1, chunk->offset + chunk->count - 1, dst, dtor, ctx);
+
+    return 0;
+}
+
+/// Get, destroy and remove first element.
+///
+/// \param deque    deque
+/// \param dst      pointer to element to fill, may be NULL
+/// \param dtor     callback to destroy element, may be NULL
+/// \param ctx      \p dtor context
+///
+/// \retval 0                   success
+/// \retval -1/E_DEQUE_EMPTY    deque is empty
+static int deque_pop_front_elem(deque_ct deque, void *dst, deque_dtor_cb dtor, const void *ctx)
+{
+    return_error_if_fail(deque->size, E_DEQUE_EMPTY, -1);
+
+    deque_remove_slot(deque, 0, CHUNK(0)->offset, dst, dtor, ctx);
+
+    return 0;
+}
+
+int deque_pop(deque_ct deque)
+{
+    assert_magic(deque);
+
+    return error_pass_int(deque_pop_back_elem(deque, NULL, NULL, NULL));
+}
+
+int deque_pop_e(deque_ct deque, void *dst)
+{
+    assert_magic(deque);
+
+    return error_pass_int(deque_pop_back_elem(deque, dst, NULL, NULL));
+}
+
+void *deque_pop_p(deque_ct deque)
+{
+    void *p;
+
+    assert_magic(deque);
+    assert(deque->esize == sizeof(void *));
+
+    if(deque_pop_back_elem(deque, &p, NULL, NULL))
+        return error_pass(), NULL;
+
+    return p;
+}
+
+int deque_pop_f(deque_ct deque, deque_dtor_cb dtor, const void *ctx)
+{
+    assert_magic(deque);
+
+    return error_pass_int(deque_pop_back_elem(deque, NULL, dtor, ctx));
+}
+
+int deque_pop_front(deque_ct deque)
+{
+    assert_magic(deque);
+
+    return error_pass_int(deque_pop_front_elem(deque, NULL, NULL, NULL));
+}
+
+int deque_pop_front_e(deque_ct deque, void *dst)
+{
+    assert_magic(deque);
+
+    return error_pass_int(deque_pop_front_elem(deque, dst, NULL, NULL));
+}
+
+void *deque_pop_front_p(deque_ct deque)
+{
+    void *p;
+
+    assert_magic(deque);
+    assert(deque->esize == sizeof(void *));
+
+    if(deque_pop_front_elem(deque, &p, NULL, NULL))
+        return error_pass(), NULL;
+
+    return p;
+}
+
+int deque_pop_front_f(deque_ct deque, deque_dtor_cb dtor, const void *ctx)
+{
+    assert_magic(deque);
+
+    return error_pass_int(deque_pop_front_elem(deque, NULL, dtor, ctx));
+}
+
+/// Get, destroy and remove element at position.
+///
+/// Removing an element in the middle merges the chunk with its neighbours
+/// if they are at most half full together.
+///
+/// \param deque    deque
+/// \param pos      position of element, negative value counts from last element
+/// \param dst      pointer to element to fill, may be NULL
+/// \param dtor     callback to destroy element, may be NULL
+/// \param ctx      \p dtor context
+///
+/// \retval 0                           success
+/// \retval -1/E_DEQUE_OUT_OF_BOUNDS    \p pos is out of bounds
+static int deque_remove_elem(deque_ct deque, ssize_t pos, void *dst, deque_dtor_cb dtor, const void *ctx)
+{
+    deque_chunk_st *chunk;
+    size_t k, slot, nchunks;
+
+    if(pos < 0)
+        pos += deque->size;
+
+    return_error_if_fail(pos >= 0 && (size_t)pos < deque->size, E_DEQUE_OUT_OF_BOUNDS, -1);
+
+    if(!pos)
+        return deque_pop_front_elem(deque, dst, dtor, ctx);
+
+    if((size_t)pos == deque->size - 1)
+        return deque_pop_back_elem(deque, dst, dtor, ctx);
+
+    chunk   = deque_locate(deque, pos, &slot);
+    k       = chunk - CHUNK(0);
+    nchunks = deque->nchunks;
+
+    deque_remove_slot(deque, k, slot, dst, dtor, ctx);
+    deque->sparse = true;
+
+    if(deque->nchunks < nchunks)
+        return 0;
+
+    if(k + 1 < deque->nchunks)
+        deque_chunk_merge(deque, k);
+
+    if(k)
+        deque_chunk_merge(deque, k - 1);
+
+    return 0;
+}
+
+int deque_remove_at(deque_ct deque, ssize_t pos)
+{
+    assert_magic(deque);
+
+    return error_pass_int(deque_remove_elem(deque, pos, NULL, NULL, NULL));
+}
+
+int deque_remove_at_e(deque_ct deque, void *dst, ssize_t pos)
+{
+    assert_magic(deque);
+
+    return error_pass_int(deque_remove_elem(deque, pos, dst, NULL, NULL));
+}
+
+void *deque_remove_at_p(deque_ct deque, ssize_t pos)
+{
+    void *p;
+
+    assert_magic(deque);
+    assert(deque->esize == sizeof(void *));
+
+    if(deque_remove_elem(deque, pos, &p, NULL, NULL))
+        return error_pass(), NULL;
+
+    return p;
+}
+
+int deque_remove_at_f(deque_ct deque, ssize_t pos, deque_dtor_cb dtor, const void *ctx)
+{
+    assert_magic(deque);
+
+    return error_pass_int(deque_remove_elem(deque, pos, NULL, dtor, ctx));
+}
+
+int deque_fold(deque_const_ct deque, deque_fold_cb fold, const void *ctx)
+{
+    deque_chunk_st *chunk;
+    size_t k, s, i = 0;
+    int rc;
+
+    assert_magic(deque);
+    assert(fold);
+
+    for(k = 0; k < deque->nchunks; k++)
+    {
+        chunk = CHUNK(k);
+
+        for(s = chunk->offset; s < chunk->offset + chunk->count; s++, i++)
+            if((rc = fold(deque, i, SLOT(chunk, s), (void *)ctx)))
+                return error_pack_int(E_DEQUE_CALLBACK, rc);
+    }
+
+    return 0;
+}
+
+int deque_fold_r(deque_const_ct deque, deque_fold_cb fold, const void *ctx)
+{
+    deque_chunk_st *chunk;
+    size_t k, s, i = deque->size;
+    int rc;
+
+    assert_magic(deque);
+    assert(fold);
+
+    for(k = deque->nchunks; k--;)
+    {
+        chunk = CHUNK(k);
+
+        for(s = chunk->offset + chunk->count; s-- > chunk->offset;)
+            if((rc = fold(deque, --i, SLOT(chunk, s), (void *)ctx)))
+                return error_pack_int(E_DEQUE_CALLBACK, rc);
+    }
+
+    return 0;
+}
@@ -71,8 +71,11 @@ typedef struct list
 {
     DEBUG_MAGIC
 
-    size_t          size;   ///< number of list nodes
-    list_node_st    head;   ///< head node of circular list
+    size_t          size;       ///< number of list nodes
+    list_node_st    head;       ///< head node of circular list
+    list_node_ct    pool;       ///< released nodes, linked via next
+    size_t          pool_size;  ///< number of released nodes
+    size_t          pool_max;   ///< maximum number of released nodes to keep
 } list_st;
 
 /// list error type definition
@@ -109,6 +112,7 @@ void list_free(list_ct list)
 void list_free_f(list_ct list, list_dtor_cb dtor, const void *ctx)
 {
     list_clear_f(list, dtor, ctx);
+    list_set_pool(list, 0);
 
     free(list);
 }
@@ -130,6 +134,62 @@ list_ct list_free_if_empty_f(list_ct list, list_dtor_cb dtor, const void *ctx)
     return NULL;
 }
 
+/// Release node into pool or free it if pool is full.
+///
+/// \param list     parent list
+/// \param node     node to release
+static void list_node_release(list_ct list, list_node_ct node)
+{
+    if(list->pool_size >= list->pool_max)
+    {
+        free(node);
+
+        return;
+    }
+
+    init_magic_n(node, 0);
+    node->next = list->pool;
+    list->pool = node;
+    list->pool_size++;
+}
+
+void list_set_pool(list_ct list, size_t max)
+{
+    list_node_ct node;
+
+    assert_magic(list);
+
+    list->pool_max = max;
+
+    for(; list->pool_size > max; list->pool_size--)
+    {
+        node        = list->pool;
+        list->pool  = node->next;
+        free(node);
+    }
+}
+
+int list_reserve(list_ct list, size_t n)
+{
+    list_node_ct node;
+
+    assert_magic(list);
+
+    list->pool_max = MAX(list->pool_max, n);
+
+    while(list->pool_size < n)
+    {
+        if(!(node = calloc(1, sizeof(list_node_st))))
+            return error_wrap_last_errno(calloc), -1;
+
+        node->next = list->pool;
+        list->pool = node;
+        list->pool_size++;
+    }
+
+    return 0;
+}
+
 void list_clear(list_ct list)
 {
     list_clear_f(list, NULL, NULL);
@@ -146,7 +206,7 @@ void list_clear_f(list_ct list, list_dtor_cb dtor, const void *ctx)
         if(dtor)
             dtor(list, node->data, (void *)ctx);
 
-        free(node);
+        list_node_release(list, node);
     }
 
     list->size      = 0;
@@ -155,6 +215,8 @@ void list_clear_f(list_ct list, list_dtor_cb dtor, const void *ctx)
 
 /// Create new list node.
 ///
+/// Take node from pool if available.
+///
 /// \param list     parent list
 /// \param data     data to set node with
 ///
@@ -164,7 +226,12 @@ static list_node_ct list_node_new(list_ct list, const void *data)
 {
     list_node_ct node;
 
-    if(!(node = calloc(1, sizeof(list_node_st))))
+    if((node = list->pool))
+    {
+        list->pool = node->next;
+        list->pool_size--;
+    }
+    else if(!(node = calloc(1, sizeof(list_node_st))))
         return error_wrap_last_errno(calloc), NULL;
 
     init_magic_n(node, NODE_MAGIC);
@@ -252,7 +319,7 @@ size_t list_memsize_f(list_const_ct list, list_size_cb size, const void *ctx)
 
     assert_magic(list);
 
-    bytes = sizeof(list_st) + list->size * sizeof(list_node_st);
+    bytes = sizeof(list_st) + (list->size + list->pool_size) * sizeof(list_node_st);
 
     if(size)
     {
@@ -481,7 +548,7 @@ static void list_remove_node(list_ct list, list_node_ct node, list_dtor_cb dtor,
     node->next->prev    = node->prev;
     node->prev->next    = node->next;
 
-    free(node);
+    list_node_release(list, node);
 
     list->size--;
 }
@@ -625,6 +692,102 @@ void list_swap(list_node_const_ct cnode1, list_node_const_ct cnode2)
     node2->next = tmp;
 }
 
+/// Move node between two adjacent nodes.
+///
+/// \param dst      destination list
+/// \param pre      predecessor in \p dst
+/// \param src      source list
+/// \param node     node in \p src to move
+static void list_move_node(list_ct dst, list_node_ct pre, list_ct src, list_node_ct node)
+{
+    if(pre == node || pre == node->prev)
+        return;
+
+    node->next->prev    = node->prev;
+    node->prev->next    = node->next;
+
+    node->prev          = pre;
+    node->next          = pre->next;
+    pre->next->prev     = node;
+    pre->next           = node;
+
+    src->size--;
+    dst->size++;
+    DEBUG(node->list = dst);
+}
+
+void list_move_before(list_ct dst, list_node_const_ct suc, list_ct src, list_node_ct node)
+{
+    assert_magic(dst);
+    assert_magic(src);
+    assert_magic_n(node, NODE_MAGIC);
+    assert(src == node->list);
+
+    if(!suc)
+        suc = &dst->head;
+    else
+    {
+        assert_magic_n(suc, NODE_MAGIC);
+        assert(dst == suc->list);
+    }
+
+    if(suc != node)
+        list_move_node(dst, suc->prev, src, node);
+}
+
+void list_move_after(list_ct dst, list_node_const_ct pre, list_ct src, list_node_ct node)
+{
+    assert_magic(dst);
+    assert_magic(src);
+    assert_magic_n(node, NODE_MAGIC);
+    assert(src == node->list);
+
+    if(!pre)
+        pre = &dst->head;
+    else
+    {
+        assert_magic_n(pre, NODE_MAGIC);
+        assert(dst == pre->list);
+    }
+
+    list_move_node(dst, (list_node_ct)pre, src, node);
+}
+
+void list_splice(list_ct dst, list_node_const_ct cpre, list_ct src)
+{
+    list_node_ct pre = (list_node_ct)cpre, first, last;
+
+    assert_magic(dst);
+    assert_magic(src);
+    assert(dst != src);
+
+    if(!pre)
+        pre = &dst->head;
+    else
+    {
+        assert_magic_n(pre, NODE_MAGIC);
+        assert(dst == pre->list);
+    }
+
+    if(!src->size)
+        return;
+
+    first   = src->head.next;
+    last    = src->head.prev;
+
+    DEBUG(for(list_node_ct node = first; node != &src->head; node = node->next)
+        node->list = dst);
+
+    first->prev         = pre;
+    last->next          = pre->next;
+    pre->next->prev     = last;
+    pre->next           = first;
+
+    dst->size           += src->size;
+    src->size           = 0;
+    src->head.next      = src->head.prev = &src->head;
+}
+
 int list_fold(list_const_ct list, list_fold_cb fold, const void *ctx)
 {
     list_node_ct node, next;
@@ -654,3 +817,93 @@ int list_fold_r(list_const_ct list, list_fold_cb fold, const void *ctx)
 
     return 0;
 }
+
+void list_link_init(list_link_st *head)
+{
+    assert(head);
+
+    head->prev = head->next = head;
+}
+
+bool list_link_is_empty(const list_link_st *head)
+{
+    assert(head);
+
+    return head->next == head;
+}
+
+bool list_link_is_linked(const list_link_st *link)
+{
+    assert(link);
+
+    return link->next && link->next != link;
+}
+
+size_t list_link_size(const list_link_st *head)
+{
+    list_link_st *link;
+    size_t size = 0;
+
+    assert(head);
+
+    list_link_foreach(head, link)
+        size++;
+
+    return size;
+}
+
+/// Link node between two adjacent links.
+///
+/// \param pre      predecessor
+/// \param link     link to insert
+/// \param suc      successor
+static inline void list_link_insert(list_link_st *pre, list_link_st *link, list_link_st *suc)
+{
+    link->prev  = pre;
+    link->next  = suc;
+    pre->next   = link;
+    suc->prev   = link;
+}
+
+void list_link_insert_before(list_link_st *suc, list_link_st *link)
+{
+    assert(suc && link);
+
+    list_link_insert(suc->prev, link, suc);
+}
+
+void list_link_insert_after(list_link_st *pre, list_link_st *link)
+{
+    assert(pre && link);
+
+    list_link_insert(pre, link, pre->next);
+}
+
+void list_link_remove(list_link_st *link)
+{
+    assert(link && list_link_is_linked(link));
+
+    link->prev->next    = link->next;
+    link->next->prev    = link->prev;
+    link->prev          = link->next = link;
+}
+
+void list_link_move_before(list_link_st *suc, list_link_st *link)
+{
+    assert(suc && link && suc != link);
+
+    link->prev->next    = link->next;
+    link->next->prev    = link->prev;
+
+    list_link_insert(suc->prev, link, suc);
+}
+
+void list_link_move_after(list_link_st *pre, list_link_st *link)
+{
+    assert(pre && link && pre != link);
+
+    link->prev->next    = link->next;
+    link->next->prev    = link->prev;
+
+    list_link_insert(pre, link, pre->next);
+}
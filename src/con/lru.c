@@ -0,0 +1,313 @@
+/*
+ * Copyright (c) 2026 Martin Rödel a.k.a. Yomin Nimoy
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/// \file
+
+#include <ytil/con/lru.h>
+#include <ytil/con/art.h>
+#include <ytil/con/list.h>
+#include <ytil/def.h>
+#include <ytil/def/magic.h>
+#include <stdlib.h>
+
+
+#define MAGIC define_magic("LRU") ///< LRU magic
+
+
+/// LRU entry
+typedef struct lru_entry
+{
+    list_link_st    link;   ///< link into list of use, most recent first
+    art_node_ct     node;   ///< index node
+    void            *data;  ///< entry data
+} lru_entry_st;
+
+/// LRU cache
+typedef struct lru
+{
+    DEBUG_MAGIC
+
+    art_ct          art;        ///< index from key to entry
+    list_link_st    entries;    ///< entries, most recently used first
+    size_t          size;       ///< number of entries
+    size_t          capacity;   ///< maximum number of entries
+} lru_st;
+
+/// LRU error type definition
+ERROR_DEFINE_LIST(LRU,
+    ERROR_INFO(E_LRU_INVALID_KEY,   "Invalid key."),
+    ERROR_INFO(E_LRU_NOT_FOUND,     "Entry not found.")
+);
+
+/// default error type for LRU module
+#define ERROR_TYPE_DEFAULT ERROR_TYPE_LRU
+
+
+lru_ct lru_new(size_t capacity)
+{
+    lru_ct lru;
+
+    assert(capacity);
+
+    if(!(lru = calloc(1, sizeof(lru_st))))
+        return error_wrap_last_errno(calloc), NULL;
+
+    if(!(lru->art = art_new(ART_MODE_UNORDERED)))
+        return error_wrap(), free(lru), NULL;
+
+    init_magic(lru);
+    list_link_init(&lru->entries);
+    lru->capacity = capacity;
+
+    return lru;
+}
+
+void lru_free(lru_ct lru)
+{
+    lru_free_f(lru, NULL, NULL);
+}
+
+void lru_free_f(lru_ct lru, lru_dtor_cb dtor, const void *ctx)
+{
+    lru_clear_f(lru, dtor, ctx);
+    art_free(lru->art);
+    free(lru);
+}
+
+void lru_clear(lru_ct lru)
+{
+    lru_clear_f(lru, NULL, NULL);
+}
+
+void lru_clear_f(lru_ct lru, lru_dtor_cb dtor, const void *ctx)
+{
+    list_link_st *link, *next;
+    lru_entry_st *entry;
+
+    assert_magic(lru);
+
+    for(link = lru->entries.next; link != &lru->entries; link = next)
+    {
+        next    = link->next;
+        entry   = list_link_entry(link, lru_entry_st, link);
+
+        if(dtor)
+            dtor(lru, entry->data, (void *)ctx);
+
+        free(entry);
+    }
+
+    art_clear(lru->art);
+    list_link_init(&lru->entries);
+    lru->size = 0;
+}
+
+bool lru_is_empty(lru_const_ct lru)
+{
+    assert_magic(lru);
+
+    return !lru->size;
+}
+
+size_t lru_size(lru_const_ct lru)
+{
+    assert_magic(lru);
+
+    return lru->size;
+}
+
+size_t lru_capacity(lru_const_ct lru)
+{
+    assert_magic(lru);
+
+    return lru->capacity;
+}
+
+/// Get entry.
+///
+/// \param lru      LRU cache
+/// \param key      entry key
+///
+/// \returns                        entry
+/// \retval NULL/E_LRU_NOT_FOUND    entry not found
+static lru_entry_st *lru_get_entry(lru_const_ct lru, str_const_ct key)
+{
+    art_node_ct node;
+
+    if(!(node = art_get(lru->art, key)))
+        return error_pack(E_LRU_NOT_FOUND), NULL;
+
+    return art_node_data(node);
+}
+
+void *lru_get(lru_ct lru, str_const_ct key)
+{
+    lru_entry_st *entry;
+
+    assert_magic(lru);
+
+    if(!(entry = lru_get_entry(lru, key)))
+        return error_pass(), NULL;
+
+    if(lru->entries.next != &entry->link)
+        list_link_move_after(&lru->entries, &entry->link);
+
+    return entry->data;
+}
+
+void *lru_peek(lru_const_ct lru, str_const_ct key)
+{
+    lru_entry_st *entry;
+
+    assert_magic(lru);
+
+    if(!(entry = lru_get_entry(lru, key)))
+        return error_pass(), NULL;
+
+    return entry->data;
+}
+
+bool lru_contains(lru_const_ct lru, str_const_ct key)
+{
+    assert_magic(lru);
+
+    return art_get(lru->art, key) != NULL;
+}
+
+/// Destroy and remove entry.
+///
+/// \param lru      LRU cache
+/// \param entry    entry to remove
+/// \param dtor     callback to destroy entry data, may be NULL
+/// \param ctx      \p dtor context
+static void lru_remove_entry(lru_ct lru, lru_entry_st *entry, lru_dtor_cb dtor, const void *ctx)
+{
+    if(dtor)
+        dtor(lru, entry->data, (void *)ctx);
+
+    art_remove(lru->art, entry->node);
+    list_link_remove(&entry->link);
+    free(entry);
+    lru->size--;
+}
+
+int lru_put(lru_ct lru, str_const_ct key, const void *data)
+{
+    return error_pass_int(lru_put_f(lru, key, data, NULL, NULL));
+}
+
+int lru_put_f(lru_ct lru, str_const_ct key, const void *data, lru_dtor_cb dtor, const void *ctx)
+{
+    lru_entry_st *entry;
+    art_node_ct node;
+
+    assert_magic(lru);
+    return_error_if_pass(str_is_empty(key), E_LRU_INVALID_KEY, -1);
+
+    if((node = art_get(lru->art, key)))
+    {
+        entry = art_node_data(node);
+
+        if(dtor)
+            dtor(lru, entry->data, (void *)ctx);
+
+        entry->data = (void *)data;
+        list_link_move_after(&lru->entries, &entry->link);
+
+        return 0;
+    }
+
+    if(lru->size < lru->capacity)
+    {
+        if(!(entry = calloc(1, sizeof(lru_entry_st))))
+            return error_wrap_last_errno(calloc), -1;
+
+        if(!(node = art_insert(lru->art, key, entry)))
+            return error_wrap(), free(entry), -1;
+
+        list_link_insert_after(&lru->entries, &entry->link);
+        lru->size++;
+    }
+    else
+    {
+        // insert first to keep the cache untouched on failure
+        if(!(node = art_insert(lru->art, key, NULL)))
+            return error_wrap(), -1;
+
+        // reuse the least recently used entry
+        entry = list_link_entry(lru->entries.prev, lru_entry_st, link);
+
+        if(dtor)
+            dtor(lru, entry->data, (void *)ctx);
+
+        art_remove(lru->art, entry->node);
+        art_node_set(node, entry);
+        list_link_move_after(&lru->entries, &entry->link);
+    }
+
+    entry->node = node;
+    entry->data = (void *)data;
+
+    return 0;
+}
+
+int lru_remove(lru_ct lru, str_const_ct key)
+{
+    return error_pass_int(lru_remove_f(lru, key, NULL, NULL));
+}
+
+int lru_remove_f(lru_ct lru, str_const_ct key, lru_dtor_cb dtor, const void *ctx)
+{
+    lru_entry_st *entry;
+
+    assert_magic(lru);
+
+    if(!(entry = lru_get_entry(lru, key)))
+        return error_pass(), -1;
+
+    lru_remove_entry(lru, entry, dtor, ctx);
+
+    return 0;
+}
+
+void *lru_oldest(lru_const_ct lru)
+{
+    assert_magic(lru);
+    return_error_if_pass(!lru->size, E_LRU_NOT_FOUND, NULL);
+
+    return list_link_entry(lru->entries.prev, lru_entry_st, link)->data;
+}
+
+int lru_evict(lru_ct lru)
+{
+    return error_pass_int(lru_evict_f(lru, NULL, NULL));
+}
+
+int lru_evict_f(lru_ct lru, lru_dtor_cb dtor, const void *ctx)
+{
+    assert_magic(lru);
+    return_error_if_pass(!lru->size, E_LRU_NOT_FOUND, -1);
+
+    lru_remove_entry(lru, list_link_entry(lru->entries.prev, lru_entry_st, link), dtor, ctx);
+
+    return 0;
+}
@@ -0,0 +1,528 @@
+/*
+ * Copyright (c) 2026 Martin Rödel a.k.a. Yomin Nimoy
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/// \file
+
+#include <ytil/con/map.h>
+#include <ytil/def.h>
+#include <ytil/def/bits.h>
+#include <ytil/def/magic.h>
+#include <ytil/def/simd.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+
+#define MAGIC define_magic("MAP")   ///< map magic
+
+#define GROUP       16      ///< number of slots per control group
+#define CTRL_EMPTY  -128    ///< control byte of empty slot
+#define CTRL_DEL    -2      ///< control byte of deleted slot
+
+/// hash bits stored in control byte
+#define H2(hash) ((int8_t)((hash) & 0x7f))
+
+/// hash bits selecting first probed group
+#define H1(hash) ((hash) >> 7)
+
+/// maximum number of nodes for slot capacity, load factor 7/8
+#define MAX_LOAD(cap) ((cap) - (cap) / 8)
+
+
+/// map node
+typedef struct map_node
+{
+    uint64_t    hash;   ///< key hash
+    str_ct      key;    ///< node key
+    void        *data;  ///< node data
+} map_node_st;
+
+/// map
+typedef struct map
+{
+    DEBUG_MAGIC
+
+    int8_t      *ctrl;      ///< control bytes, one per slot
+    map_node_st *slots;     ///< slots
+    size_t      cap;        ///< number of slots, power of 2 multiple of GROUP
+    size_t      size;       ///< number of nodes
+    size_t      growth;     ///< number of empty slots to fill before rehash
+} map_st;
+
+/// map error type definition
+ERROR_DEFINE_LIST(MAP,
+    ERROR_INFO(E_MAP_CALLBACK,  "Callback error."),
+    ERROR_INFO(E_MAP_EXISTS,    "Node already exists."),
+    ERROR_INFO(E_MAP_NOT_FOUND, "Node not found.")
+);
+
+/// default error type for map module
+#define ERROR_TYPE_DEFAULT ERROR_TYPE_MAP
+
+
+/// Get mask of control bytes in group matching value.
+///
+/// \param group    control group
+/// \param value    control value to match
+///
+/// \returns        bit mask, bit i set if control byte i matches \p value
+static inline unsigned int map_group_match(const int8_t *group, int8_t value)
+{
+#if SIMD
+    return simd128_mask8(group, value);
+#else
+    unsigned int mask = 0, i;
+
+    for(i = 0; i < GROUP; i++)
+        mask |= (unsigned int)(group[i] == value) << i;
+
+    return mask;
+#endif
+}
+
+/// Check if node key equals key.
+///
+/// \param node     node
+/// \param key      key
+/// \param len      key length
+/// \param hash     key hash
+///
+/// \retval true    keys are equal
+/// \retval false   keys differ
+static inline bool map_node_is_key(const map_node_st *node, const void *key, size_t len, uint64_t hash)
+{
+    return node->hash == hash
+        && str_len(node->key) == len
+        && !memcmp(str_bc(node->key), key, len);
+}
+
+map_ct map_new(void)
+{
+    map_ct map;
+
+    if(!(map = calloc(1, sizeof(map_st))))
+        return error_wrap_last_errno(calloc), NULL;
+
+    init_magic(map);
+
+    return map;
+}
+
+void map_free(map_ct map)
+{
+    map_free_f(map, NULL, NULL);
+}
+
+void map_free_f(map_ct map, map_dtor_cb dtor, const void *ctx)
+{
+    map_clear_f(map, dtor, ctx);
+
+    free(map->ctrl);
+    free(map);
+}
+
+map_ct map_free_if_empty(map_ct map)
+{
+    assert_magic(map);
+
+    if(map->size)
+        return map;
+
+    map_free(map);
+
+    return NULL;
+}
+
+void map_clear(map_ct map)
+{
+    map_clear_f(map, NULL, NULL);
+}
+
+void map_clear_f(map_ct map, map_dtor_cb dtor, const void *ctx)
+{
+    size_t s;
+
+    assert_magic(map);
+
+    for(s = 0; s < map->cap && map->size; s++)
+    {
+        if(map->ctrl[s] < 0)
+            continue;
+
+        if(dtor)
+            dtor(map, map->slots[s].data, (void *)ctx);
+
+        str_unref(map->slots[s].key);
+        map->size--;
+    }
+
+    if(map->cap)
+        memset(map->ctrl, CTRL_EMPTY, map->cap);
+
+    map->growth = MAX_LOAD(map->cap);
+}
+
+bool map_is_empty(map_const_ct map)
+{
+    assert_magic(map);
+
+    return !map->size;
+}
+
+size_t map_size(map_const_ct map)
+{
+    assert_magic(map);
+
+    return map->size;
+}
+
+size_t map_capacity(map_const_ct map)
+{
+    assert_magic(map);
+
+    return map->cap;
+}
+
+size_t map_memsize(map_const_ct map)
+{
+    return map_memsize_f(map, NULL, NULL);
+}
+
+size_t map_memsize_f(map_const_ct map, map_size_cb size, const void *ctx)
+{
+    size_t memsize, s;
+
+    assert_magic(map);
+
+    memsize = sizeof(map_st) + map->cap * (sizeof(int8_t) + sizeof(map_node_st));
+
+    for(s = 0; s < map->cap; s++)
+    {
+        if(map->ctrl[s] < 0)
+            continue;
+
+        memsize += str_memsize(map->slots[s].key);
+
+        if(size)
+            memsize += size(map, map->slots[s].data, (void *)ctx);
+    }
+
+    return memsize;
+}
+
+/// Find slot for new node.
+///
+/// \param map      map
+/// \param hash     key hash
+///
+/// \returns        index of first empty or deleted slot in probe sequence
+static size_t map_find_free(map_const_ct map, uint64_t hash)
+{
+    size_t gmask = map->cap / GROUP - 1, g = H1(hash) & gmask, step = 0;
+    unsigned int mask;
+
+    while(true)
+    {
+        if((mask = map_group_match(&map->ctrl[g * GROUP], CTRL_EMPTY)
+                 | map_group_match(&map->ctrl[g * GROUP], CTRL_DEL)))
+            return g * GROUP + CTZ(mask);
+
+        g = (g + ++step) & gmask;
+    }
+}
+
+/// Resize slot table and reinsert all nodes.
+///
+/// \param map      map
+/// \param cap      new number of slots
+///
+/// \retval 0                   success
+/// \retval -1/E_GENERIC_OOM    out of memory
+static int map_rehash(map_ct map, size_t cap)
+{
+    int8_t *ctrl = map->ctrl;
+    map_node_st *slots = map->slots;
+    size_t ocap = map->cap, s, n;
+
+    if(!(map->ctrl = malloc(cap * (sizeof(int8_t) + sizeof(map_node_st)))))
+        return error_wrap_last_errno(malloc), map->ctrl = ctrl, -1;
+
+    map->slots  = (map_node_st *)&map->ctrl[cap];
+    map->cap    = cap;
+    map->growth = MAX_LOAD(cap) - map->size;
+    memset(map->ctrl, CTRL_EMPTY, cap);
+
+    for(s = 0; s < ocap; s++)
+    {
+        if(ctrl[s] < 0)
+            continue;
+
+        n               = map_find_free(map, slots[s].hash);
+        map->ctrl[n]    = ctrl[s];
+        map->slots[n]   = slots[s];
+    }
+
+    free(ctrl);
+
+    return 0;
+}
+
+int map_reserve(map_ct map, size_t n)
+{
+    size_t cap;
+
+    assert_magic(map);
+
+    for(cap = MAX(map->cap, (size_t)GROUP); MAX_LOAD(cap) < n; cap *= 2);
+
+    if(cap == map->cap)
+        return 0;
+
+    return error_pass_int(map_rehash(map, cap));
+}
+
+str_const_ct map_node_key(map_node_const_ct node)
+{
+    assert(node);
+
+    return node->key;
+}
+
+void *map_node_data(map_node_const_ct node)
+{
+    assert(node);
+
+    return node->data;
+}
+
+void map_node_set(map_node_ct node, const void *data)
+{
+    assert(node);
+
+    node->data = (void *)data;
+}
+
+/// Find node.
+///
+/// \param map      map
+/// \param key      node key
+/// \param hash     key hash
+///
+/// \returns        node
+/// \retval NULL    node not found
+static map_node_st *map_find(map_const_ct map, str_const_ct key, uint64_t hash)
+{
+    const void *bytes = str_bc(key);
+    size_t len = str_len(key), gmask, g, step = 0;
+    const int8_t *group;
+    map_node_st *node;
+    unsigned int mask;
+
+    if(!map->size)
+        return NULL;
+
+    gmask   = map->cap / GROUP - 1;
+    g       = H1(hash) & gmask;
+
+    while(true)
+    {
+        group = &map->ctrl[g * GROUP];
+
+        for(mask = map_group_match(group, H2(hash)); mask; mask &= mask - 1)
+        {
+            node = &map->slots[g * GROUP + CTZ(mask)];
+
+            if(map_node_is_key(node, bytes, len, hash))
+                return node;
+        }
+
+        if(map_group_match(group, CTRL_EMPTY))
+            return NULL;
+
+        g = (g + ++step) & gmask;
+    }
+}
+
+map_node_ct map_get(map_const_ct map, str_const_ct key)
+{
+    map_node_ct node;
+
+    assert_magic(map);
+
+    if(!(node = map_find(map, key, str_hash(key))))
+        return error_set(E_MAP_NOT_FOUND), NULL;
+
+    return node;
+}
+
+void *map_get_data(map_const_ct map, str_const_ct key)
+{
+    map_node_ct node;
+
+    assert_magic(map);
+
+    if(!(node = map_find(map, key, str_hash(key))))
+        return error_set(E_MAP_NOT_FOUND), NULL;
+
+    return node->data;
+}
+
+/// Insert new node.
+///
+/// \param map      map
+/// \param key      node key, must not exist
+/// \param hash     key hash
+/// \param data     node data
+///
+/// \returns                    new node
+/// \retval NULL/E_GENERIC_OOM  out of memory
+static map_node_ct map_insert_node(map_ct map, str_const_ct key, uint64_t hash, const void *data)
+{
+    map_node_ct node;
+    str_ct dup;
+    size_t s;
+
+    if(!(dup = str_dup(key)))
+        return error_wrap(), NULL;
+
+    s = map->cap ? map_find_free(map, hash) : 0;
+
+    if(!map->cap || (!map->growth && map->ctrl[s] == CTRL_EMPTY))
+    {
+        // rehash in place if at least half of the load is deleted slots
+        if(map_rehash(map, map->cap && map->size < MAX_LOAD(map->cap) / 2 ? map->cap : MAX(map->cap * 2, (size_t)GROUP)))
+            return error_pass(), str_unref(dup), NULL;
+
+        s = map_find_free(map, hash);
+    }
+
+    if(map->ctrl[s] == CTRL_EMPTY)
+        map->growth--;
+
+    map->ctrl[s]    = H2(hash);
+    node            = &map->slots[s];
+    node->hash      = hash;
+    node->key       = dup;
+    node->data      = (void *)data;
+    map->size++;
+
+    return node;
+}
+
+map_node_ct map_set(map_ct map, str_const_ct key, const void *data)
+{
+    map_node_ct node;
+    uint64_t hash;
+
+    assert_magic(map);
+
+    hash = str_hash(key);
+
+    if((node = map_find(map, key, hash)))
+    {
+        node->data = (void *)data;
+
+        return node;
+    }
+
+    return error_pass_ptr(map_insert_node(map, key, hash, data));
+}
+
+map_node_ct map_insert(map_ct map, str_const_ct key, const void *data)
+{
+    uint64_t hash;
+
+    assert_magic(map);
+
+    hash = str_hash(key);
+
+    return_error_if_pass(map_find(map, key, hash), E_MAP_EXISTS, NULL);
+
+    return error_pass_ptr(map_insert_node(map, key, hash, data));
+}
+
+void map_remove(map_ct map, map_node_ct node)
+{
+    size_t s;
+
+    assert_magic(map);
+    assert(node >= map->slots && node < map->slots + map->cap);
+
+    s = node - map->slots;
+    assert(map->ctrl[s] >= 0);
+
+    str_unref(node->key);
+    map->size--;
+
+    // a group holding an empty slot was never full, no probe sequence passes it
+    if(map_group_match(&map->ctrl[s / GROUP * GROUP], CTRL_EMPTY))
+    {
+        map->ctrl[s] = CTRL_EMPTY;
+        map->growth++;
+    }
+    else
+    {
+        map->ctrl[s] = CTRL_DEL;
+    }
+}
+
+int map_remove_k(map_ct map, str_const_ct key)
+{
+    return error_pass_int(map_remove_kf(map, key, NULL, NULL));
+}
+
+int map_remove_kf(map_ct map, str_const_ct key, map_dtor_cb dtor, const void *ctx)
+{
+    map_node_ct node;
+
+    assert_magic(map);
+
+    if(!(node = map_find(map, key, str_hash(key))))
+        return error_set(E_MAP_NOT_FOUND), -1;
+
+    if(dtor)
+        dtor(map, node->data, (void *)ctx);
+
+    map_remove(map, node);
+
+    return 0;
+}
+
+int map_fold(map_const_ct map, map_fold_cb fold, const void *ctx)
+{
+    size_t s;
+    int rc;
+
+    assert_magic(map);
+    assert(fold);
+
+    for(s = 0; s < map->cap; s++)
+    {
+        if(map->ctrl[s] < 0)
+            continue;
+
+        if((rc = fold(map, map->slots[s].key, map->slots[s].data, (void *)ctx)))
+            return error_pack_int(E_MAP_CALLBACK, rc);
+    }
+
+    return 0;
+}
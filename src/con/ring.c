@@ -25,8 +25,16 @@
 #include <ytil/con/ring.h>
 #include <ytil/def.h>
 #include <ytil/def/magic.h>
+#include <ytil/def/os.h>
 #include <ytil/ext/string.h>
 #include <stdlib.h>
+#include <stdatomic.h>
+#include <sched.h>
+
+#if OS_LINUX
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
 
 
 /// Get pointer to ring element.
@@ -38,10 +46,12 @@
 
 /// Get real position from OOB position.
 ///
+/// Power of 2 capacities use a mask instead of a modulo.
+///
 /// \param p    OOB position
 ///
 /// \returns    element position
-#define POS(p)  ((p) % ring->cap)
+#define POS(p)  (ring->mask ? (p) & ring->mask : (p) % ring->cap)
 
 /// Get tail ring element.
 ///
@@ -58,37 +68,69 @@
 /// \param p    position
 ///
 /// \returns    element position +1
-#define NEXT(p) POS((p) +1)
+#define NEXT(p) ((p) +1 == ring->cap ? 0 : (p) +1)
 
 /// Get previous ring element position.
 ///
 /// \param p    position
 ///
 /// \returns    element position -1
-#define PREV(p) POS((p) + ring->cap -1)
+#define PREV(p) ((p) ? (p) -1 : ring->cap -1)
 
 
 #define MAGIC       define_magic("RIN")     ///< ring magic
 #define DEFAULT_CAP 10                      ///< default capacity
+#define SYNC_LINE   64                      ///< cache line size to pad concurrent indices to
+#define SYNC_SPIN   64                      ///< number of spins before yielding on commit
+
+
+/// ring index pair in concurrent mode
+///
+/// Positions are not wrapped, the element position is POS(position).
+/// Each index pair is aligned to its own cache line.
+typedef struct ring_index
+{
+    _Alignas(SYNC_LINE)
+    atomic_size_t   reserve;    ///< next position to reserve, mpmc only
+    atomic_size_t   commit;     ///< next position to commit
+    size_t          cache;      ///< last seen opposite commit, spsc only
+} ring_index_st;
 
+/// ring concurrency state
+///
+/// Producers put elements at prod.commit and consumers get elements
+/// from cons.commit. In spsc mode each side owns its index exclusively.
+/// In mpmc mode threads reserve a range of positions by advancing the
+/// reserve index, copy the elements and then wait for preceding
+/// threads to commit before advancing the commit index.
+typedef struct ring_sync
+{
+    ring_index_st   prod;   ///< producer indices
+    ring_index_st   cons;   ///< consumer indices
+    bool            mpmc;   ///< multi producer multi consumer mode
+} ring_sync_st;
 
 /// ring
 typedef struct ring
 {
     DEBUG_MAGIC
 
-    char    *mem;       ///< ring memory
-    size_t  esize;      ///< element size
-    size_t  cap;        ///< number of allocated elements
-    size_t  tail;       ///< position of tail element
-    size_t  size;       ///< number of elements
+    char            *mem;       ///< ring memory
+    size_t          esize;      ///< element size
+    size_t          cap;        ///< number of allocated elements
+    size_t          mask;       ///< capacity -1 if capacity is a power of 2, else 0
+    size_t          tail;       ///< position of tail element
+    size_t          size;       ///< number of elements
+    ring_sync_st    *sync;      ///< concurrency state, concurrent mode only
+    bool            mirror;     ///< memory is mapped twice back to back
 } ring_st;
 
 /// ring error type definition
 ERROR_DEFINE_LIST(RING,
     ERROR_INFO(E_RING_CALLBACK,     "Callback error."),
     ERROR_INFO(E_RING_EMPTY,        "Ring is empty."),
-    ERROR_INFO(E_RING_FULL,         "Ring is full.")
+    ERROR_INFO(E_RING_FULL,         "Ring is full."),
+    ERROR_INFO(E_RING_UNSUPPORTED,  "Operation not supported on this platform.")
 );
 
 /// default error type for ring module
@@ -112,8 +154,124 @@ ring_ct ring_new_c(size_t capacity, size_t elemsize)
     init_magic(ring);
     ring->esize = elemsize;
     ring->cap   = capacity ? capacity : DEFAULT_CAP;
+    ring->mask  = ring->cap & (ring->cap - 1) ? 0 : ring->cap - 1;
+
+    return ring;
+}
+
+ring_ct ring_new_pow2(size_t capacity, size_t elemsize)
+{
+    size_t cap;
+
+    for(cap = 1; cap < (capacity ? capacity : DEFAULT_CAP); cap <<= 1);
+
+    return error_pass_ptr(ring_new_c(cap, elemsize));
+}
+
+/// Create new concurrent ring.
+///
+/// \param capacity     ring size in number of elements
+/// \param elemsize     element size
+/// \param mpmc         multi producer multi consumer mode
+///
+/// \returns                    new ring
+/// \retval NULL/E_GENERIC_OOM  out of memory
+static ring_ct ring_new_sync(size_t capacity, size_t elemsize, bool mpmc)
+{
+    ring_ct ring;
+
+    if(!(ring = ring_new_pow2(capacity, elemsize)))
+        return error_pass(), NULL;
+
+    if(!(ring->mem = calloc(ring->cap, ring->esize)))
+        return error_wrap_last_errno(calloc), free(ring), NULL;
+
+    // calloc does not align to cache lines
+    if(!(ring->sync = aligned_alloc(SYNC_LINE, sizeof(ring_sync_st))))
+        return error_wrap_last_errno(aligned_alloc), free(ring->mem), free(ring), NULL;
+
+    memset(ring->sync, 0, sizeof(ring_sync_st));
+    ring->sync->mpmc = mpmc;
+
+    return ring;
+}
+
+#if OS_LINUX
+
+/// Map memory twice back to back.
+///
+/// \param bytes    number of bytes to map, multiple of page size
+///
+/// \returns                        mapping of 2 * \p bytes
+/// \retval NULL/E_GENERIC_OOM      out of memory
+/// \retval NULL/E_GENERIC_SYSTEM   system error
+static char *ring_mirror_map(size_t bytes)
+{
+    char *mem;
+    int fd;
+
+    if((fd = memfd_create("ring", MFD_CLOEXEC)) < 0)
+        return error_wrap_last_errno(memfd_create), NULL;
+
+    if(ftruncate(fd, bytes))
+        return error_wrap_last_errno(ftruncate), close(fd), NULL;
+
+    // reserve address range for both mappings
+    if((mem = mmap(NULL, 2 * bytes, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0)) == MAP_FAILED)
+        return error_wrap_last_errno(mmap), close(fd), NULL;
+
+    if(mmap(mem, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED
+    || mmap(mem + bytes, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED)
+        return error_wrap_last_errno(mmap), munmap(mem, 2 * bytes), close(fd), NULL;
+
+    close(fd);
+
+    return mem;
+}
+
+#endif // if OS_LINUX
+
+ring_ct ring_new_mirror(size_t capacity, size_t elemsize)
+{
+#if OS_LINUX
+    size_t page, unit, gcd, rem;
+    ring_ct ring;
+
+    assert(elemsize);
+
+    page = sysconf(_SC_PAGESIZE);
+
+    // capacity must span whole pages
+    for(gcd = page, rem = elemsize; rem; unit = gcd % rem, gcd = rem, rem = unit);
+
+    unit        = page / gcd;
+    capacity    = capacity ? capacity : DEFAULT_CAP;
+    capacity    = (capacity + unit - 1) / unit * unit;
+
+    if(!(ring = ring_new_c(capacity, elemsize)))
+        return error_pass(), NULL;
+
+    if(!(ring->mem = ring_mirror_map(ring->cap * ring->esize)))
+        return error_pass(), free(ring), NULL;
+
+    ring->mirror = true;
 
     return ring;
+#else
+    assert(elemsize);
+
+    return error_set(E_RING_UNSUPPORTED), NULL;
+#endif
+}
+
+ring_ct ring_new_spsc(size_t capacity, size_t elemsize)
+{
+    return error_pass_ptr(ring_new_sync(capacity, elemsize, false));
+}
+
+ring_ct ring_new_mpmc(size_t capacity, size_t elemsize)
+{
+    return error_pass_ptr(ring_new_sync(capacity, elemsize, true));
 }
 
 void ring_free(ring_ct ring)
@@ -125,9 +283,17 @@ void ring_free_f(ring_ct ring, ring_dtor_cb dtor, const void *ctx)
 {
     ring_clear_f(ring, dtor, ctx);
 
+#if OS_LINUX
+    if(ring->mirror)
+        munmap(ring->mem, 2 * ring->cap * ring->esize);
+    else
+#endif
     if(ring->mem)
         free(ring->mem);
 
+    if(ring->sync)
+        free(ring->sync);
+
     free(ring);
 }
 
@@ -140,7 +306,7 @@ ring_ct ring_free_if_empty_f(ring_ct ring, ring_dtor_cb dtor, const void *ctx)
 {
     assert_magic(ring);
 
-    if(ring->size)
+    if(ring_size(ring))
         return ring;
 
     ring_free_f(ring, dtor, ctx);
@@ -160,6 +326,23 @@ void ring_clear_f(ring_ct ring, ring_dtor_cb dtor, const void *ctx)
     assert_magic(ring);
     return_if_fail(ring->mem);
 
+    if(ring->sync)
+    {
+        tail = atomic_load(&ring->sync->cons.commit);
+        size = atomic_load(&ring->sync->prod.commit);
+
+        if(dtor)
+        {
+            for(; tail != size; tail++)
+                dtor(ring, ELEM(POS(tail)), (void *)ctx);
+        }
+
+        atomic_store(&ring->sync->cons.reserve, size);
+        atomic_store(&ring->sync->cons.commit, size);
+
+        return;
+    }
+
     if(dtor)
     {
         for(tail = ring->tail, size = ring->size; size; tail = NEXT(tail), size--)
@@ -180,8 +363,14 @@ ring_ct ring_clone_f(ring_const_ct ring, ring_clone_cb clone, ring_dtor_cb dtor,
     size_t tail, size;
 
     assert_magic(ring);
+    assert(!ring->sync);
+
+    if(ring->mirror)
+        ring2 = ring_new_mirror(ring->cap, ring->esize);
+    else
+        ring2 = ring_new_c(ring->cap, ring->esize);
 
-    if(!(ring2 = ring_new_c(ring->cap, ring->esize)))
+    if(!ring2)
         return error_pass(), NULL;
 
     return_value_if_fail(ring->mem, ring2);
@@ -189,7 +378,7 @@ ring_ct ring_clone_f(ring_const_ct ring, ring_clone_cb clone, ring_dtor_cb dtor,
     ring2->tail = ring->tail;
     ring2->size = ring->size;
 
-    if(!clone)
+    if(!clone && !ring2->mirror)
     {
         if(!(ring2->mem = memdup(ring->mem, ring->cap * ring->esize)))
             return error_wrap_last_errno(memdup), free(ring2), NULL;
@@ -197,7 +386,14 @@ ring_ct ring_clone_f(ring_const_ct ring, ring_clone_cb clone, ring_dtor_cb dtor,
         return ring2;
     }
 
-    if(!(ring2->mem = calloc(ring->cap, ring->esize)))
+    if(!clone)
+    {
+        memcpy(ring2->mem, ring->mem, ring->cap * ring->esize);
+
+        return ring2;
+    }
+
+    if(!ring2->mem && !(ring2->mem = calloc(ring->cap, ring->esize)))
         return error_wrap_last_errno(calloc), free(ring2), NULL;
 
     for(tail = ring->tail, size = ring->size; size; tail = NEXT(tail), size--)
@@ -209,18 +405,36 @@ ring_ct ring_clone_f(ring_const_ct ring, ring_clone_cb clone, ring_dtor_cb dtor,
     return ring2;
 }
 
+/// Get number of elements in concurrent ring.
+///
+/// \param ring     concurrent ring
+///
+/// \returns        number of committed elements at some point during the call
+static size_t ring_sync_size(ring_const_ct ring)
+{
+    size_t tail, head;
+
+    tail = atomic_load_explicit(&ring->sync->cons.commit, memory_order_acquire);
+    head = atomic_load_explicit(&ring->sync->prod.commit, memory_order_acquire);
+
+    return MIN(head - tail, ring->cap);
+}
+
 bool ring_is_empty(ring_const_ct ring)
 {
     try_magic(ring);
 
-    return !ring || !ring->size;
+    return !ring_size(ring);
 }
 
 size_t ring_size(ring_const_ct ring)
 {
     try_magic(ring);
 
-    return ring ? ring->size : 0;
+    if(!ring)
+        return 0;
+
+    return ring->sync ? ring_sync_size(ring) : ring->size;
 }
 
 size_t ring_elemsize(ring_const_ct ring)
@@ -250,38 +464,275 @@ size_t ring_memsize_f(ring_const_ct ring, ring_size_cb sizef, const void *ctx)
 
     bytes = sizeof(ring_st) + ring->cap * ring->esize;
 
+    if(ring->sync)
+        bytes += sizeof(ring_sync_st);
+
+    if(ring->mem && sizef && ring->sync)
+    {
+        tail = POS(atomic_load(&ring->sync->cons.commit));
+        size = ring_sync_size(ring);
+    }
+    else
+    {
+        tail = ring->tail;
+        size = ring->size;
+    }
+
     if(ring->mem && sizef)
     {
-        for(tail = ring->tail, size = ring->size; size; tail = NEXT(tail), size--)
+
+        for(; size; tail = NEXT(tail), size--)
             bytes += sizef(ring, ELEM(tail), (void *)ctx);
     }
 
     return bytes;
 }
 
+/// Copy elements into ring memory.
+///
+/// \param ring     ring
+/// \param pos      element position to start at
+/// \param elems    array of elements, NULL to zero elements
+/// \param n        number of elements, at most capacity
+static void ring_copy_in(ring_ct ring, size_t pos, const void *elems, size_t n)
+{
+    size_t n1 = MIN(n, ring->cap - pos);
+
+    if(elems)
+    {
+        memcpy(ELEM(pos), elems, n1 * ring->esize);
+        memcpy(ring->mem, (const char *)elems + n1 * ring->esize, (n - n1) * ring->esize);
+    }
+    else
+    {
+        memset(ELEM(pos), 0, n1 * ring->esize);
+        memset(ring->mem, 0, (n - n1) * ring->esize);
+    }
+}
+
+/// Copy elements out of ring memory.
+///
+/// \param      ring    ring
+/// \param      pos     element position to start at
+/// \param[out] dst     array of elements to fill, may be NULL
+/// \param      n       number of elements, at most capacity
+static void ring_copy_out(ring_const_ct ring, size_t pos, void *dst, size_t n)
+{
+    size_t n1 = MIN(n, ring->cap - pos);
+
+    if(!dst)
+        return;
+
+    memcpy(dst, ELEM(pos), n1 * ring->esize);
+    memcpy((char *)dst + n1 * ring->esize, ring->mem, (n - n1) * ring->esize);
+}
+
+/// Wait until preceding threads committed up to position.
+///
+/// \param commit   commit index
+/// \param pos      position to wait for
+static void ring_sync_wait(atomic_size_t *commit, size_t pos)
+{
+    size_t spin;
+
+    for(spin = 0; atomic_load_explicit(commit, memory_order_acquire) != pos; spin++)
+        if(spin >= SYNC_SPIN)
+            sched_yield();
+}
+
+/// Reserve positions in mpmc mode.
+///
+/// \param      ring    concurrent ring
+/// \param      index   own indices
+/// \param      other   opposite commit index
+/// \param      prod    reserve producer positions
+/// \param      n       number of positions to reserve
+/// \param[out] pos     first reserved position
+///
+/// \returns            number of reserved positions
+static size_t ring_sync_reserve(ring_const_ct ring, ring_index_st *index, atomic_size_t *other, bool prod, size_t n, size_t *pos)
+{
+    size_t start, end, avail;
+
+    start = atomic_load_explicit(&index->reserve, memory_order_relaxed);
+
+    while(true)
+    {
+        end = atomic_load_explicit(other, memory_order_acquire);
+
+        // outdated start may lag behind consumers
+        if(prod && start - end > ring->cap)
+        {
+            start = atomic_load_explicit(&index->reserve, memory_order_relaxed);
+            continue;
+        }
+
+        avail = prod ? ring->cap - (start - end) : end - start;
+
+        if(!(avail = MIN(n, avail)))
+            return 0;
+
+        if(atomic_compare_exchange_weak_explicit(&index->reserve,
+            &start, start + avail, memory_order_relaxed, memory_order_relaxed))
+            break;
+    }
+
+    *pos = start;
+
+    return avail;
+}
+
+/// Put elements into concurrent ring.
+///
+/// \param      ring    concurrent ring
+/// \param      elems   array of elements, NULL to put empty elements
+/// \param      n       number of elements
+/// \param[out] pos     element position of first put element
+///
+/// \returns            number of elements put
+static size_t ring_sync_put(ring_ct ring, const void *elems, size_t n, size_t *pos)
+{
+    ring_index_st *prod = &ring->sync->prod;
+    size_t head;
+
+    if(!ring->sync->mpmc)
+    {
+        head = atomic_load_explicit(&prod->commit, memory_order_relaxed);
+
+        if(ring->cap - (head - prod->cache) < n)
+            prod->cache = atomic_load_explicit(&ring->sync->cons.commit, memory_order_acquire);
+
+        if(!(n = MIN(n, ring->cap - (head - prod->cache))))
+            return 0;
+
+        ring_copy_in(ring, *pos = POS(head), elems, n);
+        atomic_store_explicit(&prod->commit, head + n, memory_order_release);
+
+        return n;
+    }
+
+    if(!(n = ring_sync_reserve(ring, prod, &ring->sync->cons.commit, true, n, &head)))
+        return 0;
+
+    ring_copy_in(ring, *pos = POS(head), elems, n);
+    ring_sync_wait(&prod->commit, head);
+    atomic_store_explicit(&prod->commit, head + n, memory_order_release);
+
+    return n;
+}
+
+/// Get elements from concurrent ring.
+///
+/// \param      ring    concurrent ring
+/// \param[out] dst     array of elements to fill, may be NULL
+/// \param      n       number of elements
+///
+/// \returns            number of elements removed
+static size_t ring_sync_get(ring_ct ring, void *dst, size_t n)
+{
+    ring_index_st *cons = &ring->sync->cons;
+    size_t tail;
+
+    if(!ring->sync->mpmc)
+    {
+        tail = atomic_load_explicit(&cons->commit, memory_order_relaxed);
+
+        if(cons->cache - tail < n)
+            cons->cache = atomic_load_explicit(&ring->sync->prod.commit, memory_order_acquire);
+
+        if(!(n = MIN(n, cons->cache - tail)))
+            return 0;
+
+        ring_copy_out(ring, POS(tail), dst, n);
+        atomic_store_explicit(&cons->commit, tail + n, memory_order_release);
+
+        return n;
+    }
+
+    if(!(n = ring_sync_reserve(ring, cons, &ring->sync->prod.commit, false, n, &tail)))
+        return 0;
+
+    ring_copy_out(ring, POS(tail), dst, n);
+    ring_sync_wait(&cons->commit, tail);
+    atomic_store_explicit(&cons->commit, tail + n, memory_order_release);
+
+    return n;
+}
+
+/// Put element into ring if not full.
+///
+/// \param ring     ring, not concurrent
+/// \param elem     pointer to element, NULL to put empty element
+///
+/// \returns                    pointer to new element
+/// \retval NULL/E_RING_FULL    ring is full
+/// \retval NULL/E_GENERIC_OOM  out of memory
+static void *ring_put_generic(ring_ct ring, const void *elem)
+{
+    return_error_if_fail(ring->size < ring->cap, E_RING_FULL, NULL);
+
+    return error_pass_ptr(ring_put_overwrite_e(ring, elem, NULL, NULL));
+}
+
 void *ring_put(ring_ct ring)
 {
     assert_magic(ring);
-    return_error_if_fail(ring->size < ring->cap, E_RING_FULL, NULL);
+    assert(!ring->sync);
 
-    return error_pass_ptr(ring_put_overwrite_e(ring, NULL, NULL, NULL));
+    return error_pass_ptr(ring_put_generic(ring, NULL));
 }
 
 void *ring_put_e(ring_ct ring, const void *elem)
 {
+    size_t pos;
+
     assert_magic(ring);
-    return_error_if_fail(ring->size < ring->cap, E_RING_FULL, NULL);
 
-    return error_pass_ptr(ring_put_overwrite_e(ring, elem, NULL, NULL));
+    if(ring->sync)
+    {
+        // the put element may already be consumed, do not return it
+        assert(elem);
+        return_error_if_fail(ring_sync_put(ring, elem, 1, &pos), E_RING_FULL, NULL);
+
+        return (void *)elem;
+    }
+
+    return error_pass_ptr(ring_put_generic(ring, elem));
 }
 
 void *ring_put_p(ring_ct ring, const void *ptr)
 {
     assert_magic(ring);
+    assert(!ring->sync);
     assert(ring->esize == sizeof(void *));
-    return_error_if_fail(ring->size < ring->cap, E_RING_FULL, NULL);
 
-    return error_pass_ptr(ring_put_overwrite_e(ring, &ptr, NULL, NULL));
+    return error_pass_ptr(ring_put_generic(ring, &ptr));
+}
+
+size_t ring_put_n(ring_ct ring, const void *elems, size_t n)
+{
+    size_t pos;
+
+    assert_magic(ring);
+
+    if(ring->sync)
+    {
+        return_error_if_fail(!n || (n = ring_sync_put(ring, elems, n, &pos)), E_RING_FULL, 0);
+
+        return n;
+    }
+
+    return_error_if_fail(!n || ring->size < ring->cap, E_RING_FULL, 0);
+
+    if(!ring->mem && !(ring->mem = calloc(ring->cap, ring->esize)))
+        return error_wrap_last_errno(calloc), 0;
+
+    n = MIN(n, ring->cap - ring->size);
+
+    ring_copy_in(ring, POS(ring->tail + ring->size), elems, n);
+    ring->size += n;
+
+    return n;
 }
 
 void *ring_put_overwrite(ring_ct ring, ring_dtor_cb dtor, const void *ctx)
@@ -294,6 +745,7 @@ void *ring_put_overwrite_e(ring_ct ring, const void *elem, ring_dtor_cb dtor, co
     void *head;
 
     assert_magic(ring);
+    assert(!ring->sync);
 
     if(!ring->mem && !(ring->mem = calloc(ring->cap, ring->esize)))
         return error_wrap_last_errno(calloc), NULL;
@@ -329,6 +781,7 @@ void *ring_put_overwrite_p(ring_ct ring, const void *ptr, ring_dtor_cb dtor, con
 void *ring_peek(ring_const_ct ring)
 {
     assert_magic(ring);
+    assert(!ring->sync);
     return_error_if_fail(ring->size, E_RING_EMPTY, NULL);
 
     return TAIL();
@@ -337,6 +790,7 @@ void *ring_peek(ring_const_ct ring)
 void *ring_peek_p(ring_const_ct ring)
 {
     assert_magic(ring);
+    assert(!ring->sync);
     assert(ring->esize == sizeof(void *));
     return_error_if_fail(ring->size, E_RING_EMPTY, NULL);
 
@@ -351,6 +805,7 @@ int ring_drop(ring_ct ring)
 int ring_drop_f(ring_ct ring, ring_dtor_cb dtor, const void *ctx)
 {
     assert_magic(ring);
+    assert(!ring->sync);
     return_error_if_fail(ring->size, E_RING_EMPTY, -1);
 
     if(dtor)
@@ -365,6 +820,14 @@ int ring_drop_f(ring_ct ring, ring_dtor_cb dtor, const void *ctx)
 int ring_get(ring_ct ring, void *elem)
 {
     assert_magic(ring);
+
+    if(ring->sync)
+    {
+        return_error_if_fail(ring_sync_get(ring, elem, 1), E_RING_EMPTY, -1);
+
+        return 0;
+    }
+
     return_error_if_fail(ring->size, E_RING_EMPTY, -1);
 
     if(elem)
@@ -382,6 +845,14 @@ void *ring_get_p(ring_ct ring)
 
     assert_magic(ring);
     assert(ring->esize == sizeof(void *));
+
+    if(ring->sync)
+    {
+        return_error_if_fail(ring_sync_get(ring, &e, 1), E_RING_EMPTY, NULL);
+
+        return e;
+    }
+
     return_error_if_fail(ring->size, E_RING_EMPTY, NULL);
 
     e = *(void **)TAIL();
@@ -392,9 +863,85 @@ void *ring_get_p(ring_ct ring)
     return e;
 }
 
+void *ring_peek_span(ring_const_ct ring, size_t *n)
+{
+    assert_magic(ring);
+    assert(!ring->sync);
+    assert(n);
+    return_error_if_fail(ring->size, E_RING_EMPTY, NULL);
+
+    *n = ring->mirror ? ring->size : MIN(ring->size, ring->cap - ring->tail);
+
+    return TAIL();
+}
+
+void *ring_reserve_span(ring_ct ring, size_t *n)
+{
+    size_t head;
+
+    assert_magic(ring);
+    assert(!ring->sync);
+    assert(n);
+    return_error_if_fail(ring->size < ring->cap, E_RING_FULL, NULL);
+
+    if(!ring->mem && !(ring->mem = calloc(ring->cap, ring->esize)))
+        return error_wrap_last_errno(calloc), NULL;
+
+    head    = POS(ring->tail + ring->size);
+    *n      = ring->mirror ? ring->cap - ring->size : MIN(ring->cap - ring->size, ring->cap - head);
+
+    return ELEM(head);
+}
+
+void ring_commit_span(ring_ct ring, size_t n)
+{
+    assert_magic(ring);
+    assert(!ring->sync);
+    assert(n <= ring->cap - ring->size);
+
+    ring->size += n;
+}
+
+size_t ring_peek_n(ring_const_ct ring, void *dst, size_t n)
+{
+    assert_magic(ring);
+    assert(!ring->sync);
+    assert(dst);
+    return_error_if_fail(!n || ring->size, E_RING_EMPTY, 0);
+
+    n = MIN(n, ring->size);
+
+    ring_copy_out(ring, ring->tail, dst, n);
+
+    return n;
+}
+
+size_t ring_get_n(ring_ct ring, void *dst, size_t n)
+{
+    assert_magic(ring);
+
+    if(ring->sync)
+    {
+        return_error_if_fail(!n || (n = ring_sync_get(ring, dst, n)), E_RING_EMPTY, 0);
+
+        return n;
+    }
+
+    return_error_if_fail(!n || ring->size, E_RING_EMPTY, 0);
+
+    n = MIN(n, ring->size);
+
+    ring_copy_out(ring, ring->tail, dst, n);
+    ring->tail  = POS(ring->tail + n);
+    ring->size -= n;
+
+    return n;
+}
+
 void *ring_peek_head(ring_const_ct ring)
 {
     assert_magic(ring);
+    assert(!ring->sync);
     return_error_if_fail(ring->size, E_RING_EMPTY, NULL);
 
     return HEAD();
@@ -403,6 +950,7 @@ void *ring_peek_head(ring_const_ct ring)
 void *ring_peek_head_p(ring_const_ct ring)
 {
     assert_magic(ring);
+    assert(!ring->sync);
     assert(ring->esize == sizeof(void *));
     return_error_if_fail(ring->size, E_RING_EMPTY, NULL);
 
@@ -417,6 +965,7 @@ int ring_drop_head(ring_ct ring)
 int ring_drop_head_f(ring_ct ring, ring_dtor_cb dtor, const void *ctx)
 {
     assert_magic(ring);
+    assert(!ring->sync);
     return_error_if_fail(ring->size, E_RING_EMPTY, -1);
 
     if(dtor)
@@ -430,6 +979,7 @@ int ring_drop_head_f(ring_ct ring, ring_dtor_cb dtor, const void *ctx)
 int ring_get_head(ring_ct ring, void *elem)
 {
     assert_magic(ring);
+    assert(!ring->sync);
     return_error_if_fail(ring->size, E_RING_EMPTY, -1);
 
     if(elem)
@@ -445,6 +995,7 @@ void *ring_get_head_p(ring_ct ring)
     void *e;
 
     assert_magic(ring);
+    assert(!ring->sync);
     assert(ring->esize == sizeof(void *));
     return_error_if_fail(ring->size, E_RING_EMPTY, NULL);
 
@@ -461,6 +1012,7 @@ int ring_fold(ring_ct ring, ring_fold_cb fold, const void *ctx)
     int rc;
 
     assert_magic(ring);
+    assert(!ring->sync);
     assert(fold);
 
     for(tail = ring->tail, size = ring->size; size; tail = NEXT(tail), size--)
@@ -478,6 +1030,7 @@ int ring_fold_r(ring_ct ring, ring_fold_cb fold, const void *ctx)
     int rc;
 
     assert_magic(ring);
+    assert(!ring->sync);
     assert(fold);
 
     for(head = POS(ring->tail + ring->size -1), size = ring->size; size; head = PREV(head), size--)
@@ -25,8 +25,15 @@
 #include <ytil/con/vec.h>
 #include <ytil/def.h>
 #include <ytil/def/magic.h>
+#include <ytil/def/os.h>
 #include <ytil/ext/stdlib.h>
 #include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+
+#if OS_LINUX
+    #include <sys/mman.h>
+#endif
 
 
 /// offset of first vector element
@@ -51,6 +58,16 @@
 #define DEFAULT_CAP     10                      ///< default capacity
 #define RESIZE_FACTOR   2                       ///< resize factor
 
+#define SORT_INSERTION  24          ///< max partition size to sort by insertion sort
+#define SORT_NINTHER    128         ///< min partition size to choose pivot by ninther
+#define SORT_PARTIAL    8           ///< max number of moves of partial insertion sort
+#define SORT_STACK      64          ///< size of quicksort partition stack
+#define SORT_SWAP       64          ///< max number of bytes to swap at once
+#define SORT_PARALLEL   (1 << 20)   ///< min number of elements to sort in parallel
+
+/// size of vector head in inline buffers, keeps inline elements aligned
+#define INLINE_HEAD     ((sizeof(vec_st) + _Alignof(max_align_t) - 1) & ~(_Alignof(max_align_t) - 1))
+
 
 /// vector
 typedef struct vector
@@ -62,12 +79,23 @@ typedef struct vector
     size_t  esize;      ///< element size
     size_t  cap;        ///< number of allocated elements
     size_t  min_cap;    ///< minimum number of allocated elements
+    char    *buf;       ///< inline buffer, NULL if vector is allocated
+    size_t  buf_cap;    ///< capacity of inline buffer
+
+    vec_sort_cb sort;       ///< sorted set comparator, NULL if not in sorted set mode
+    void        *sort_ctx;  ///< sorted set comparator context
+
+    vec_growth_id   growth;     ///< growth policy
+    size_t          growth_arg; ///< growth factor or step
+    size_t          map_min;    ///< min memory size to map, 0 to never map
+    size_t          map_size;   ///< size of mapped memory, 0 if memory is not mapped
 } vec_st;
 
 /// vector error type definition
 ERROR_DEFINE_LIST(VEC,
     ERROR_INFO(E_VEC_CALLBACK,      "Callback error."),
     ERROR_INFO(E_VEC_EMPTY,         "Vector is empty."),
+    ERROR_INFO(E_VEC_EXISTS,        "Element already exists."),
     ERROR_INFO(E_VEC_NO_BUFFER,     "No buffer available."),
     ERROR_INFO(E_VEC_NOT_FOUND,     "Element not found."),
     ERROR_INFO(E_VEC_OUT_OF_BOUNDS, "Out of bounds access.")
@@ -99,8 +127,113 @@ static inline void vec_set_buf(vec_ct vec, char *mem, size_t capacity, size_t si
     }
 }
 
+/// Check if vector memory is inline buffer.
+///
+/// \param vec      vector
+///
+/// \retval true    vector memory is inline buffer
+/// \retval false   vector memory is allocated or missing
+static inline bool vec_is_inline(vec_const_ct vec)
+{
+    return vec->buf && vec->mem == vec->buf + OFFSET;
+}
+
+/// Allocate vector memory.
+///
+/// Memory of at least vec_st.map_min bytes is mapped on Linux.
+///
+/// \param      vec         vector
+/// \param      bytes       number of bytes to allocate
+/// \param[out] map_size    size of mapped memory, 0 if not mapped
+///
+/// \returns                    zeroed memory
+/// \retval NULL/E_GENERIC_OOM  out of memory
+static char *vec_mem_alloc(vec_const_ct vec, size_t bytes, size_t *map_size)
+{
+    char *mem;
+
+#if OS_LINUX
+    if(vec->map_min && bytes >= vec->map_min)
+    {
+        if((mem = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0)) == MAP_FAILED)
+            return error_wrap_last_errno(mmap), NULL;
+
+        madvise(mem, bytes, MADV_HUGEPAGE); // advisory only
+
+        *map_size = bytes;
+
+        return mem;
+    }
+#endif
+
+    if(!(mem = calloc(1, bytes)))
+        return error_wrap_last_errno(calloc), NULL;
+
+    *map_size = 0;
+
+    return mem;
+}
+
+/// Free allocated vector memory.
+///
+/// \param vec      vector
+static void vec_mem_free(vec_ct vec)
+{
+    if(!vec->mem || vec_is_inline(vec))
+        return;
+
+#if OS_LINUX
+    if(vec->map_size)
+    {
+        munmap(vec->mem - OFFSET, vec->map_size);
+        vec->map_size = 0;
+
+        return;
+    }
+#endif
+
+    free(vec->mem - OFFSET);
+}
+
+/// Resize allocated vector memory of same kind.
+///
+/// Mapped memory is remapped, heap memory is reallocated.
+///
+/// \param vec      vector with allocated memory
+/// \param bytes    number of bytes to allocate
+///
+/// \returns                    resized memory
+/// \retval NULL/E_GENERIC_OOM  out of memory
+static char *vec_mem_realloc(vec_ct vec, size_t bytes)
+{
+    char *mem = vec->mem - OFFSET;
+
+#if OS_LINUX
+    if(vec->map_size)
+    {
+        if((mem = mremap(mem, vec->map_size, bytes, MREMAP_MAYMOVE)) == MAP_FAILED)
+            return error_wrap_last_errno(mremap), NULL;
+
+        madvise(mem, bytes, MADV_HUGEPAGE);
+
+        vec->map_size = bytes;
+
+        return mem;
+    }
+#endif
+
+    if(!(mem = realloc(mem, bytes)))
+        return error_wrap_last_errno(realloc), NULL;
+
+    return mem;
+}
+
 /// Resize vector buffer.
 ///
+/// Inline vectors spill to the heap if \p capacity exceeds the inline buffer
+/// and move back if it fits again. Memory crossing vec_st.map_min
+/// moves between heap and mapping.
+///
 /// \param vec          vector
 /// \param capacity     capacity to set
 ///
@@ -108,33 +241,92 @@ static inline void vec_set_buf(vec_ct vec, char *mem, size_t capacity, size_t si
 /// \retval -1/E_GENERIC_OOM    out of memory
 static int vec_resize(vec_ct vec, size_t capacity)
 {
+    size_t bytes = OFFSET + capacity * vec->esize, map_size;
     char *mem;
+#if OS_LINUX
+    bool map = vec->map_min && bytes >= vec->map_min;
+#else
+    bool map = false;
+#endif
 
-    if(!vec->mem)
+    if(vec->buf && capacity <= vec->buf_cap)
     {
-        if(!(mem = calloc(1, OFFSET + capacity * vec->esize)))
-            return error_wrap_last_errno(calloc), -1;
+        if(vec->mem && !vec_is_inline(vec))
+        {
+            memcpy(vec->buf + OFFSET, vec->mem, vec->size * vec->esize);
+            vec_mem_free(vec);
+        }
 
-        vec_set_buf(vec, mem, capacity, 0);
+        vec_set_buf(vec, vec->buf, vec->buf_cap, vec->mem ? vec->size : 0);
     }
-    else
+    else if(!vec->mem || vec_is_inline(vec) || map != !!vec->map_size)
     {
-        mem = vec->mem - OFFSET;
+        if(!(mem = vec_mem_alloc(vec, bytes, &map_size)))
+        {
+            if(vec->mem && capacity <= vec->cap)
+                return error_clear(), 0;
 
-        if(!(mem = realloc(mem, OFFSET + capacity * vec->esize)))
+            return error_pass(), -1;
+        }
+
+        if(vec->mem)
         {
-            if(capacity > vec->cap)
-                return error_wrap_last_errno(realloc), -1;
-            else
-                return 0;
+            memcpy(mem + OFFSET, vec->mem, vec->size * vec->esize);
+            vec_mem_free(vec);
+            vec_set_buf(vec, mem, capacity, vec->size);
         }
+        else
+            vec_set_buf(vec, mem, capacity, 0);
 
-        vec_set_buf(vec, mem, capacity, vec->size);
+        vec->map_size = map_size;
+    }
+    else if(!(mem = vec_mem_realloc(vec, bytes)))
+    {
+        if(capacity > vec->cap)
+            return error_pass(), -1;
+
+        return error_clear(), 0;
     }
+    else
+        vec_set_buf(vec, mem, capacity, vec->size);
 
     return 0;
 }
 
+/// Get capacity to grow to.
+///
+/// \param vec      vector
+/// \param n        number of elements to fit
+///
+/// \returns        new capacity
+/// \retval 0       capacity overflow
+static size_t vec_grow_capacity(vec_const_ct vec, size_t n)
+{
+    size_t need = MAX(vec->min_cap, vec->size + n), cap;
+
+    switch(vec->growth)
+    {
+    case VEC_GROWTH_FACTOR:
+        return MAX(need, vec->cap * vec->growth_arg);
+
+    case VEC_GROWTH_STEP:
+        if(need <= (cap = MAX(vec->cap, vec->min_cap)))
+            return cap;
+
+        return cap + (need - cap + vec->growth_arg - 1) / vec->growth_arg * vec->growth_arg;
+
+    case VEC_GROWTH_POW2:
+        if(need > SIZE_MAX / 2 + 1)
+            return 0;
+
+        for(cap = 1; cap < need; cap <<= 1);
+        return cap;
+
+    default:
+        abort();
+    }
+}
+
 /// Grow vector capacity if less than n elements available.
 ///
 /// \param vec      vector
@@ -144,11 +336,16 @@ static int vec_resize(vec_ct vec, size_t capacity)
 /// \retval -1/E_GENERIC_OOM    out of memory
 static inline int vec_grow(vec_ct vec, size_t n)
 {
-    if(vec->size + n > vec->cap
-    && vec_resize(vec, MAX3(vec->min_cap, vec->cap + n, vec->cap * RESIZE_FACTOR)))
-    {
+    size_t cap;
+
+    if(vec->size + n <= vec->cap)
+        return 0;
+
+    if(!(cap = vec_grow_capacity(vec, n)))
+        return error_set_s(GENERIC, E_GENERIC_OOM), -1;
+
+    if(vec_resize(vec, cap))
         return error_pass(), -1;
-    }
 
     return 0;
 }
@@ -158,8 +355,29 @@ static inline int vec_grow(vec_ct vec, size_t n)
 /// \param vec      vector
 static inline void vec_shrink(vec_ct vec)
 {
-    if(vec->cap > vec->min_cap && vec->size <= vec->cap / (RESIZE_FACTOR * 2))
-        vec_resize(vec, MAX(vec->cap / RESIZE_FACTOR, vec->min_cap));
+    if(vec->cap <= vec->min_cap)
+        return;
+
+    switch(vec->growth)
+    {
+    case VEC_GROWTH_FACTOR:
+        if(vec->size <= vec->cap / (vec->growth_arg * 2))
+            vec_resize(vec, MAX(vec->cap / vec->growth_arg, vec->min_cap));
+        break;
+
+    case VEC_GROWTH_STEP:
+        if(vec->size + 2 * vec->growth_arg <= vec->cap)
+            vec_resize(vec, MAX(vec->cap - vec->growth_arg, vec->min_cap));
+        break;
+
+    case VEC_GROWTH_POW2:
+        if(vec->size <= vec->cap / 4)
+            vec_resize(vec, MAX(vec->cap / 2, vec->min_cap));
+        break;
+
+    default:
+        abort();
+    }
 }
 
 /// Check if element is within vector memory and aligned on element size.
@@ -198,6 +416,33 @@ vec_ct vec_new_c(size_t capacity, size_t elemsize)
     init_magic(vec);
     vec->esize      = elemsize;
     vec->min_cap    = capacity ? capacity : DEFAULT_CAP;
+    vec->growth_arg = RESIZE_FACTOR;
+
+    return vec;
+}
+
+size_t vec_inline_size(size_t capacity, size_t elemsize)
+{
+    return INLINE_HEAD + DEBUG_RELEASE(elemsize, 0) + capacity * elemsize;
+}
+
+vec_ct vec_init_inline(void *buf, size_t capacity, size_t elemsize)
+{
+    vec_ct vec = buf;
+
+    assert(buf);
+    assert(capacity);
+    assert(elemsize);
+
+    memset(vec, 0, sizeof(vec_st));
+    init_magic(vec);
+    vec->esize      = elemsize;
+    vec->min_cap    = capacity;
+    vec->growth_arg = RESIZE_FACTOR;
+    vec->buf        = (char *)buf + INLINE_HEAD;
+    vec->buf_cap    = capacity;
+
+    vec_set_buf(vec, vec->buf, capacity, 0);
 
     return vec;
 }
@@ -221,10 +466,11 @@ void vec_free_f(vec_ct vec, vec_dtor_cb dtor, const void *ctx)
                 dtor(vec, ELEM(i), (void *)ctx);
         }
 
-        free(vec->mem - OFFSET);
+        vec_mem_free(vec);
     }
 
-    free(vec);
+    if(!vec->buf)
+        free(vec);
 }
 
 vec_ct vec_free_if_empty(vec_ct vec)
@@ -246,7 +492,7 @@ vec_ct vec_free_if_empty_f(vec_ct vec, vec_dtor_cb dtor, const void *ctx)
 
 void vec_clear(vec_ct vec)
 {
-    vec_clear_f(NULL, NULL, vec);
+    vec_clear_f(vec, NULL, NULL);
 }
 
 void vec_clear_f(vec_ct vec, vec_dtor_cb dtor, const void *ctx)
@@ -282,25 +528,29 @@ vec_ct vec_clone_f(vec_const_ct vec, vec_clone_cb clone, vec_dtor_cb dtor, const
         return error_wrap_last_errno(calloc), NULL;
 
     init_magic(nvec);
-    nvec->esize     = vec->esize;
-    nvec->min_cap   = vec->min_cap;
+    nvec->esize         = vec->esize;
+    nvec->min_cap       = vec->min_cap;
+    nvec->growth        = vec->growth;
+    nvec->growth_arg    = vec->growth_arg;
+    nvec->map_min       = vec->map_min;
 
-    return_value_if_fail(vec->mem, nvec);
-
-    if(!clone)
+    if(vec->mem)
     {
-        if(!vec_push_en(nvec, vec->size, vec->mem))
+        if(!vec_push_n(nvec, vec->size))
             return error_pass(), free(nvec), NULL;
 
-        return nvec;
+        if(!clone)
+            memcpy(nvec->mem, vec->mem, vec->size * vec->esize);
+        else
+        {
+            for(i = 0; i < vec->size; i++)
+                if(clone(vec, nvec->mem + i * nvec->esize, ELEM(i), (void *)ctx))
+                    return error_pack(E_VEC_CALLBACK), vec_free_f(nvec, dtor, ctx), NULL;
+        }
     }
 
-    if(!vec_push_n(nvec, vec->size))
-        return error_pass(), free(nvec), NULL;
-
-    for(i = 0; i < vec->size; i++)
-        if(clone(vec, nvec->mem + i * nvec->esize, ELEM(i), (void *)ctx))
-            return error_pack(E_VEC_CALLBACK), vec_free_f(nvec, dtor, ctx), NULL;
+    nvec->sort      = vec->sort;
+    nvec->sort_ctx  = vec->sort_ctx;
 
     return nvec;
 }
@@ -340,6 +590,44 @@ size_t vec_min_capacity(vec_const_ct vec)
     return vec->min_cap;
 }
 
+void vec_set_growth(vec_ct vec, vec_growth_id growth, size_t arg)
+{
+    assert_magic(vec);
+
+    switch(growth)
+    {
+    case VEC_GROWTH_FACTOR:
+        assert(arg > 1);
+        break;
+
+    case VEC_GROWTH_STEP:
+        assert(arg);
+        break;
+
+    case VEC_GROWTH_POW2:
+        break;
+
+    default:
+        abort();
+    }
+
+    vec->growth     = growth;
+    vec->growth_arg = arg;
+}
+
+int vec_set_mmap(vec_ct vec, size_t threshold)
+{
+    assert_magic(vec);
+
+    vec->map_min = threshold;
+
+    // move memory to or from mapping
+    if(vec->mem && !vec_is_inline(vec) && vec_resize(vec, vec->cap))
+        return error_pass(), -1;
+
+    return 0;
+}
+
 size_t vec_memsize(vec_const_ct vec)
 {
     return vec_memsize_f(vec, NULL, NULL);
@@ -353,6 +641,10 @@ size_t vec_memsize_f(vec_const_ct vec, vec_size_cb size, const void *ctx)
 
     bytes = sizeof(vec_st) + OFFSET + vec->cap * vec->esize;
 
+    // spilled inline vectors still hold their inline buffer
+    if(vec->buf && !vec_is_inline(vec))
+        bytes += OFFSET + vec->buf_cap * vec->esize;
+
     if(vec->mem && size)
     {
         for(i = 0; i < vec->size; i++)
@@ -495,6 +787,7 @@ void *vec_push_p(vec_ct vec, const void *ptr)
 void *vec_push_en(vec_ct vec, size_t n, const void *elems)
 {
     assert_magic(vec);
+    assert(!vec->sort);
 
     if(vec_grow(vec, n))
         return error_pass(), NULL;
@@ -538,6 +831,7 @@ void *vec_push_av(vec_ct vec, size_t n, va_list ap)
     size_t i;
 
     assert_magic(vec);
+    assert(!vec->sort);
 
     if(vec_grow(vec, n))
         return error_pass(), NULL;
@@ -556,6 +850,7 @@ void *vec_push_apv(vec_ct vec, size_t n, va_list ap)
 
     assert_magic(vec);
     assert(vec->esize == sizeof(void *));
+    assert(!vec->sort);
 
     if(vec_grow(vec, n))
         return error_pass(), NULL;
@@ -568,25 +863,19 @@ void *vec_push_apv(vec_ct vec, size_t n, va_list ap)
     return ELEM(vec->size - n);
 }
 
-/// Insert n element(s).
+/// Insert n element(s) at valid position.
 ///
 /// \param vec      vector
-/// \param pos      insert position, negative value counts from last element
+/// \param pos      insert position
 /// \param n        number of elements to insert
 /// \param elems    element(s) to insert, may be NULL
 ///
-/// \returns                            pointer to first new element
-/// \retval NULL/E_VEC_OUT_OF_BOUNDS    \p pos is out of bounds
-/// \retval NULL/E_GENERIC_OOM          out of memory
-static void *vec_insert_generic(vec_ct vec, ssize_t pos, size_t n, const void *elems)
+/// \returns                    pointer to first new element
+/// \retval NULL/E_GENERIC_OOM  out of memory
+static void *vec_insert_at(vec_ct vec, size_t pos, size_t n, const void *elems)
 {
     size_t size;
 
-    if(pos < 0)
-        pos += vec->size;
-
-    return_error_if_fail(pos >= 0 && (size_t)pos <= vec->size, E_VEC_OUT_OF_BOUNDS, NULL);
-
     if(!n)
         return ELEM(pos);
 
@@ -606,6 +895,28 @@ static void *vec_insert_generic(vec_ct vec, ssize_t pos, size_t n, const void *e
     return ELEM(pos);
 }
 
+/// Insert n element(s).
+///
+/// \param vec      vector
+/// \param pos      insert position, negative value counts from last element
+/// \param n        number of elements to insert
+/// \param elems    element(s) to insert, may be NULL
+///
+/// \returns                            pointer to first new element
+/// \retval NULL/E_VEC_OUT_OF_BOUNDS    \p pos is out of bounds
+/// \retval NULL/E_GENERIC_OOM          out of memory
+static void *vec_insert_generic(vec_ct vec, ssize_t pos, size_t n, const void *elems)
+{
+    assert(!vec->sort);
+
+    if(pos < 0)
+        pos += vec->size;
+
+    return_error_if_fail(pos >= 0 && (size_t)pos <= vec->size, E_VEC_OUT_OF_BOUNDS, NULL);
+
+    return error_pass_ptr(vec_insert_at(vec, pos, n, elems));
+}
+
 void *vec_insert(vec_ct vec, ssize_t pos)
 {
     assert_magic(vec);
@@ -762,6 +1073,7 @@ int vec_set(vec_ct vec, ssize_t pos, const void *elem)
 int vec_set_f(vec_ct vec, ssize_t pos, const void *elem, vec_dtor_cb dtor, const void *ctx)
 {
     assert_magic(vec);
+    assert(!vec->sort);
 
     if(pos < 0)
         pos += vec->size;
@@ -1266,6 +1578,7 @@ int vec_swap(vec_ct vec, ssize_t pos1, ssize_t pos2)
     void *elem;
 
     assert_magic(vec);
+    assert(!vec->sort);
 
     if(pos1 < 0)
         pos1 += vec->size;
@@ -1289,11 +1602,24 @@ int vec_swap(vec_ct vec, ssize_t pos1, ssize_t pos2)
 
 int vec_get_buffer(vec_ct vec, void **buf, size_t *size, size_t *capacity)
 {
+    char *mem;
+
     assert_magic(vec);
     assert(buf);
 
     return_error_if_fail(vec->mem, E_VEC_NO_BUFFER, -1);
 
+    // hand out heap copy of inline buffer or mapped memory
+    if(vec_is_inline(vec) || vec->map_size)
+    {
+        if(!(mem = malloc(OFFSET + vec->cap * vec->esize)))
+            return error_wrap_last_errno(malloc), -1;
+
+        memcpy(mem + OFFSET, vec->mem, vec->size * vec->esize);
+        vec_mem_free(vec);
+        vec->mem = mem + OFFSET;
+    }
+
     if(size)
         *size = vec->size;
 
@@ -1402,11 +1728,792 @@ int vec_fold_r(vec_const_ct vec, vec_fold_cb fold, const void *ctx)
     return 0;
 }
 
+/// Force inlining of sort helpers to propagate constant element sizes.
+#define SORT_INLINE static inline __attribute__((always_inline))
+
+/// Swap two elements.
+///
+/// \param a        first element
+/// \param b        second element
+/// \param esize    element size
+SORT_INLINE void vec_sort_swap(char *a, char *b, size_t esize)
+{
+    char tmp[SORT_SWAP];
+    size_t n;
+
+    for(; esize; a += n, b += n, esize -= n)
+    {
+        n = MIN(esize, sizeof(tmp));
+        memcpy(tmp, a, n);
+        memcpy(a, b, n);
+        memcpy(b, tmp, n);
+    }
+}
+
+/// Sort three elements, leaving their median in \p b.
+///
+/// \param a        first element
+/// \param b        second element
+/// \param c        third element
+/// \param esize    element size
+/// \param cmp      callback to compare two elements
+/// \param ctx      \p cmp context
+SORT_INLINE void vec_sort3(char *a, char *b, char *c, size_t esize, vec_sort_cb cmp, void *ctx)
+{
+    if(cmp(b, a, ctx) < 0)
+        vec_sort_swap(a, b, esize);
+
+    if(cmp(c, b, ctx) < 0)
+    {
+        vec_sort_swap(b, c, esize);
+
+        if(cmp(b, a, ctx) < 0)
+            vec_sort_swap(a, b, esize);
+    }
+}
+
+/// Sort elements by insertion sort.
+///
+/// \param lo       first element
+/// \param hi       end of elements
+/// \param esize    element size
+/// \param limit    max number of moves, 0 for no limit
+/// \param cmp      callback to compare two elements
+/// \param ctx      \p cmp context
+///
+/// \retval true    elements sorted
+/// \retval false   \p limit exceeded, elements are partially sorted
+SORT_INLINE bool vec_sort_insertion(char *lo, char *hi, size_t esize, size_t limit, vec_sort_cb cmp, void *ctx)
+{
+    size_t moves = 0;
+    char *i, *j;
+
+    for(i = lo + esize; i < hi; i += esize)
+    {
+        for(j = i; j > lo && cmp(j - esize, j, ctx) > 0; j -= esize)
+            vec_sort_swap(j - esize, j, esize);
+
+        moves += (i - j) / esize;
+
+        if(limit && moves > limit)
+            return false;
+    }
+
+    return true;
+}
+
+/// Restore heap property below root element.
+///
+/// \param base     first element
+/// \param root     position of root element
+/// \param n        number of elements in heap
+/// \param esize    element size
+/// \param cmp      callback to compare two elements
+/// \param ctx      \p cmp context
+SORT_INLINE void vec_sort_sift(char *base, size_t root, size_t n, size_t esize, vec_sort_cb cmp, void *ctx)
+{
+    size_t child;
+
+    for(; (child = 2 * root + 1) < n; root = child)
+    {
+        if(child + 1 < n && cmp(base + child * esize, base + (child + 1) * esize, ctx) < 0)
+            child++;
+
+        if(cmp(base + root * esize, base + child * esize, ctx) >= 0)
+            return;
+
+        vec_sort_swap(base + root * esize, base + child * esize, esize);
+    }
+}
+
+/// Sort elements by heapsort.
+///
+/// \param base     first element
+/// \param n        number of elements
+/// \param esize    element size
+/// \param cmp      callback to compare two elements
+/// \param ctx      \p cmp context
+SORT_INLINE void vec_sort_heap(char *base, size_t n, size_t esize, vec_sort_cb cmp, void *ctx)
+{
+    size_t i;
+
+    for(i = n / 2; i-- > 0;)
+        vec_sort_sift(base, i, n, esize, cmp, ctx);
+
+    for(i = n; i-- > 1;)
+    {
+        vec_sort_swap(base, base + i * esize, esize);
+        vec_sort_sift(base, 0, i, esize, cmp, ctx);
+    }
+}
+
+/// Partition elements around pivot in first element.
+///
+/// \param      lo          first element, pivot
+/// \param      hi          end of elements
+/// \param      esize       element size
+/// \param[out] partitioned true if elements were already partitioned
+/// \param      cmp         callback to compare two elements
+/// \param      ctx         \p cmp context
+///
+/// \returns    final pivot position
+SORT_INLINE char *vec_sort_partition(char *lo, char *hi, size_t esize, bool *partitioned, vec_sort_cb cmp, void *ctx)
+{
+    char *i = lo, *j = hi;
+
+    *partitioned = true;
+
+    // stop on equal elements to split runs of duplicates evenly
+    while(true)
+    {
+        do
+            i += esize;
+        while(i < hi && cmp(i, lo, ctx) < 0);
+
+        do
+            j -= esize;
+        while(cmp(j, lo, ctx) > 0);
+
+        if(i >= j)
+            break;
+
+        vec_sort_swap(i, j, esize);
+        *partitioned = false;
+    }
+
+    vec_sort_swap(lo, j, esize);
+
+    return j;
+}
+
+/// Sort elements by pattern-defeating quicksort.
+///
+/// Quicksort with median of three or ninther pivot.
+/// Partitions already in order are finished by a bounded insertion sort,
+/// unbalanced partitions get their patterns broken up
+/// and fall back to heapsort if this happens too often.
+///
+/// \param base     first element
+/// \param n        number of elements
+/// \param esize    element size
+/// \param cmp      callback to compare two elements
+/// \param ctx      \p cmp context
+SORT_INLINE void vec_sort_pdq(char *base, size_t n, size_t esize, vec_sort_cb cmp, void *ctx)
+{
+    struct { char *lo, *hi; int bad; } stack[SORT_STACK];
+    char *lo = base, *hi = base + n * esize, *mid, *pivot;
+    size_t top = 0, size, left, right;
+    bool partitioned;
+    int bad;
+
+    for(bad = 0; n; n >>= 1, bad++);
+
+    while(true)
+    {
+        size = (hi - lo) / esize;
+
+        if(size <= SORT_INSERTION)
+            vec_sort_insertion(lo, hi, esize, 0, cmp, ctx);
+        else if(!bad)
+            vec_sort_heap(lo, size, esize, cmp, ctx);
+        else
+        {
+            mid = lo + size / 2 * esize;
+
+            if(size < SORT_NINTHER)
+                vec_sort3(lo, mid, hi - esize, esize, cmp, ctx);
+            else
+            {
+                vec_sort3(lo, mid, hi - esize, esize, cmp, ctx);
+                vec_sort3(lo + esize, mid - esize, hi - 2 * esize, esize, cmp, ctx);
+                vec_sort3(lo + 2 * esize, mid + esize, hi - 3 * esize, esize, cmp, ctx);
+                vec_sort3(mid - esize, mid, mid + esize, esize, cmp, ctx);
+            }
+
+            vec_sort_swap(lo, mid, esize);
+
+            pivot   = vec_sort_partition(lo, hi, esize, &partitioned, cmp, ctx);
+            left    = (pivot - lo) / esize;
+            right   = size - left - 1;
+
+            if(left < size / 8 || right < size / 8)
+            {
+                bad--;
+
+                if(left >= SORT_INSERTION)
+                {
+                    vec_sort_swap(lo, lo + left / 4 * esize, esize);
+                    vec_sort_swap(pivot - esize, pivot - left / 4 * esize, esize);
+                }
+
+                if(right >= SORT_INSERTION)
+                {
+                    vec_sort_swap(pivot + esize, pivot + (1 + right / 4) * esize, esize);
+                    vec_sort_swap(hi - esize, hi - right / 4 * esize, esize);
+                }
+            }
+            else if(partitioned
+            && vec_sort_insertion(lo, pivot, esize, SORT_PARTIAL, cmp, ctx)
+            && vec_sort_insertion(pivot + esize, hi, esize, SORT_PARTIAL, cmp, ctx))
+            {
+                left = right = 0;
+            }
+
+            // continue with smaller partition, bounds stack by log2(n)
+            if(left && right)
+            {
+                assert(top < SORT_STACK);
+
+                if(left < right)
+                {
+                    stack[top].lo   = pivot + esize;
+                    stack[top].hi   = hi;
+                    hi              = pivot;
+                }
+                else
+                {
+                    stack[top].lo   = lo;
+                    stack[top].hi   = pivot;
+                    lo              = pivot + esize;
+                }
+
+                stack[top++].bad = bad;
+                continue;
+            }
+            else if(left)
+            {
+                hi = pivot;
+                continue;
+            }
+            else if(right)
+            {
+                lo = pivot + esize;
+                continue;
+            }
+        }
+
+        if(!top)
+            return;
+
+        top--;
+        lo  = stack[top].lo;
+        hi  = stack[top].hi;
+        bad = stack[top].bad;
+    }
+}
+
+/// Sort 4 byte elements.
+///
+/// \see vec_sort_pdq
+static void vec_sort_pdq4(char *base, size_t n, vec_sort_cb cmp, void *ctx)
+{
+    vec_sort_pdq(base, n, 4, cmp, ctx);
+}
+
+/// Sort 8 byte elements.
+///
+/// \see vec_sort_pdq
+static void vec_sort_pdq8(char *base, size_t n, vec_sort_cb cmp, void *ctx)
+{
+    vec_sort_pdq(base, n, 8, cmp, ctx);
+}
+
+/// Sort 16 byte elements.
+///
+/// \see vec_sort_pdq
+static void vec_sort_pdq16(char *base, size_t n, vec_sort_cb cmp, void *ctx)
+{
+    vec_sort_pdq(base, n, 16, cmp, ctx);
+}
+
+/// Sort elements of any size.
+///
+/// \see vec_sort_pdq
+static void vec_sort_pdqn(char *base, size_t n, size_t esize, vec_sort_cb cmp, void *ctx)
+{
+    vec_sort_pdq(base, n, esize, cmp, ctx);
+}
+
+/// Sort elements, dispatch on element size.
+///
+/// \param base     first element
+/// \param n        number of elements
+/// \param esize    element size
+/// \param cmp      callback to compare two elements
+/// \param ctx      \p cmp context
+static void vec_sort_mem(char *base, size_t n, size_t esize, vec_sort_cb cmp, void *ctx)
+{
+    switch(esize)
+    {
+    case 4:     vec_sort_pdq4(base, n, cmp, ctx); break;
+    case 8:     vec_sort_pdq8(base, n, cmp, ctx); break;
+    case 16:    vec_sort_pdq16(base, n, cmp, ctx); break;
+    default:    vec_sort_pdqn(base, n, esize, cmp, ctx); break;
+    }
+}
+
 void vec_sort(vec_ct vec, vec_sort_cb sort, const void *ctx)
 {
     assert_magic(vec);
     assert(sort);
+    assert(!vec->sort);
 
     if(vec->mem)
-        qsort_r(vec->mem, vec->size, vec->esize, sort, (void *)ctx);
+        vec_sort_mem(vec->mem, vec->size, vec->esize, sort, (void *)ctx);
+}
+
+/// Get radix sort key of integer element.
+///
+/// \param elem     element
+/// \param esize    element size, 4 or 8
+/// \param flip     sign bit to flip for signed elements
+///
+/// \returns        unsigned key
+SORT_INLINE uint64_t vec_sort_radix_key(const char *elem, size_t esize, uint64_t flip)
+{
+    uint32_t u32;
+    uint64_t u64;
+
+    if(esize == 4)
+        return memcpy(&u32, elem, 4), u32 ^ flip;
+    else
+        return memcpy(&u64, elem, 8), u64 ^ flip;
+}
+
+/// Sort integer elements by LSD radix sort.
+///
+/// Byte digits, histograms of all digits are counted in a single pass,
+/// digits shared by all elements are skipped.
+///
+/// \param base     first element
+/// \param tmp      buffer of \p n elements
+/// \param n        number of elements
+/// \param esize    element size, 4 or 8
+/// \param sign     if true elements are signed
+SORT_INLINE void vec_sort_radix(char *base, char *tmp, size_t n, size_t esize, bool sign)
+{
+    size_t count[8][256] = {{ 0 }}, pos[256], i, d, digit;
+    uint64_t key, flip = sign ? (uint64_t)1 << (esize * 8 - 1) : 0;
+    char *src = base, *dst = tmp, *swap;
+
+    for(i = 0; i < n; i++)
+        for(key = vec_sort_radix_key(&base[i * esize], esize, flip), d = 0; d < esize; d++)
+            count[d][(key >> (d * 8)) & 0xff]++;
+
+    for(d = 0; d < esize; d++)
+    {
+        if(count[d][(vec_sort_radix_key(base, esize, flip) >> (d * 8)) & 0xff] == n)
+            continue;
+
+        for(digit = 0, i = 0; digit < 256; i += count[d][digit], digit++)
+            pos[digit] = i;
+
+        for(i = 0; i < n; i++)
+        {
+            key = vec_sort_radix_key(&src[i * esize], esize, flip);
+            memcpy(&dst[pos[(key >> (d * 8)) & 0xff]++ * esize], &src[i * esize], esize);
+        }
+
+        swap    = src;
+        src     = dst;
+        dst     = swap;
+    }
+
+    if(src != base)
+        memcpy(base, src, n * esize);
+}
+
+/// Sort integer vector by radix sort.
+///
+/// \param vec      vector of 4 or 8 byte integers in host byte order
+/// \param sign     if true elements are signed
+///
+/// \retval 0                   success
+/// \retval -1/E_GENERIC_OOM    out of memory
+static int vec_sort_int(vec_ct vec, bool sign)
+{
+    char *tmp;
+
+    if(vec->size < 2)
+        return 0;
+
+    if(!(tmp = malloc(vec->size * vec->esize)))
+        return error_wrap_last_errno(malloc), -1;
+
+    if(vec->esize == 4)
+        vec_sort_radix(vec->mem, tmp, vec->size, 4, sign);
+    else
+        vec_sort_radix(vec->mem, tmp, vec->size, 8, sign);
+
+    free(tmp);
+
+    return 0;
+}
+
+int vec_sort_u32(vec_ct vec)
+{
+    assert_magic(vec);
+    assert(vec->esize == sizeof(uint32_t));
+    assert(!vec->sort);
+
+    return error_pass_int(vec_sort_int(vec, false));
+}
+
+int vec_sort_u64(vec_ct vec)
+{
+    assert_magic(vec);
+    assert(vec->esize == sizeof(uint64_t));
+    assert(!vec->sort);
+
+    return error_pass_int(vec_sort_int(vec, false));
+}
+
+int vec_sort_i32(vec_ct vec)
+{
+    assert_magic(vec);
+    assert(vec->esize == sizeof(int32_t));
+    assert(!vec->sort);
+
+    return error_pass_int(vec_sort_int(vec, true));
+}
+
+int vec_sort_i64(vec_ct vec)
+{
+    assert_magic(vec);
+    assert(vec->esize == sizeof(int64_t));
+    assert(!vec->sort);
+
+    return error_pass_int(vec_sort_int(vec, true));
+}
+
+/// vector parallel sort task
+typedef struct vec_sort_task
+{
+    pthread_t   thread;     ///< worker thread
+    bool        started;    ///< worker thread started
+    char        *src;       ///< source elements
+    char        *dst;       ///< merge destination, NULL to sort source
+    size_t      lo;         ///< position of first element
+    size_t      mid;        ///< position of second run to merge
+    size_t      hi;         ///< end position of elements
+    size_t      esize;      ///< element size
+    vec_sort_cb cmp;        ///< callback to compare two elements
+    void        *ctx;       ///< \p cmp context
+} vec_sort_task_st;
+
+/// Sort chunk or merge two sorted runs.
+///
+/// \param vtask    vec_sort_task_st
+///
+/// \returns        NULL
+static void *vec_sort_task(void *vtask)
+{
+    vec_sort_task_st *task = vtask;
+    size_t esize = task->esize;
+    char *l, *r, *lend, *rend, *dst;
+
+    if(!task->dst)
+    {
+        vec_sort_mem(task->src + task->lo * esize, task->hi - task->lo, esize, task->cmp, task->ctx);
+
+        return NULL;
+    }
+
+    l       = task->src + task->lo * esize;
+    lend    = r = task->src + task->mid * esize;
+    rend    = task->src + task->hi * esize;
+    dst     = task->dst + task->lo * esize;
+
+    for(; l < lend && r < rend; dst += esize)
+    {
+        if(task->cmp(r, l, task->ctx) < 0)
+            memcpy(dst, r, esize), r += esize;
+        else
+            memcpy(dst, l, esize), l += esize;
+    }
+
+    memcpy(dst, l, lend - l);
+    memcpy(dst + (lend - l), r, rend - r);
+
+    return NULL;
+}
+
+/// Run sort tasks, first task in calling thread.
+///
+/// Tasks whose thread could not be started are run in the calling thread.
+///
+/// \param tasks    tasks to run
+/// \param n        number of tasks
+static void vec_sort_run_tasks(vec_sort_task_st *tasks, size_t n)
+{
+    size_t t;
+
+    for(t = 1; t < n; t++)
+        tasks[t].started = !pthread_create(&tasks[t].thread, NULL, vec_sort_task, &tasks[t]);
+
+    vec_sort_task(&tasks[0]);
+
+    for(t = 1; t < n; t++)
+    {
+        if(tasks[t].started)
+            pthread_join(tasks[t].thread, NULL);
+        else
+            vec_sort_task(&tasks[t]);
+    }
+}
+
+int vec_sort_parallel(vec_ct vec, vec_sort_cb sort, const void *ctx, size_t threads)
+{
+    vec_sort_task_st *tasks;
+    size_t chunks, width, t, n;
+    char *src, *dst, *tmp, *mem;
+
+    assert_magic(vec);
+    assert(sort);
+    assert(!vec->sort);
+
+    if(vec->size < SORT_PARALLEL || threads < 2)
+        return vec_sort(vec, sort, ctx), 0;
+
+    chunks = MIN(threads, vec->size / SORT_INSERTION);
+
+    if(!(tasks = calloc(chunks, sizeof(vec_sort_task_st))))
+        return error_wrap_last_errno(calloc), -1;
+
+    if(!(mem = malloc(vec->size * vec->esize)))
+        return error_wrap_last_errno(malloc), free(tasks), -1;
+
+    for(t = 0; t < chunks; t++)
+    {
+        tasks[t].src    = vec->mem;
+        tasks[t].lo     = vec->size * t / chunks;
+        tasks[t].hi     = vec->size * (t + 1) / chunks;
+        tasks[t].esize  = vec->esize;
+        tasks[t].cmp    = sort;
+        tasks[t].ctx    = (void *)ctx;
+    }
+
+    vec_sort_run_tasks(tasks, chunks);
+
+    // merge runs of width chunks pairwise, alternating buffers
+    for(src = vec->mem, dst = mem, width = 1; width < chunks; width *= 2)
+    {
+        for(t = 0, n = 0; t < chunks; t += 2 * width, n++)
+        {
+            tasks[n].src    = src;
+            tasks[n].dst    = dst;
+            tasks[n].lo     = vec->size * t / chunks;
+            tasks[n].mid    = vec->size * MIN(t + width, chunks) / chunks;
+            tasks[n].hi     = vec->size * MIN(t + 2 * width, chunks) / chunks;
+        }
+
+        vec_sort_run_tasks(tasks, n);
+
+        tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+
+    if(src != vec->mem)
+        memcpy(vec->mem, src, vec->size * vec->esize);
+
+    free(mem);
+    free(tasks);
+
+    return 0;
+}
+
+size_t vec_set_sorted(vec_ct vec, vec_sort_cb sort, const void *ctx)
+{
+    return vec_set_sorted_f(vec, sort, ctx, NULL, NULL);
+}
+
+size_t vec_set_sorted_f(vec_ct vec, vec_sort_cb sort, const void *sort_ctx, vec_dtor_cb dtor, const void *dtor_ctx)
+{
+    size_t i, n;
+
+    assert_magic(vec);
+
+    vec->sort       = NULL;
+    vec->sort_ctx   = NULL;
+
+    if(!sort)
+        return 0;
+
+    if(vec->mem)
+        vec_sort(vec, sort, sort_ctx);
+
+    // remove duplicates, keep first after unstable sort
+    for(i = 1, n = vec->size ? 1 : 0; i < vec->size; i++)
+    {
+        if(!sort(ELEM(n - 1), ELEM(i), (void *)sort_ctx))
+        {
+            if(dtor)
+                dtor(vec, ELEM(i), (void *)dtor_ctx);
+        }
+        else if(n++ != i)
+            memcpy(ELEM(n - 1), ELEM(i), vec->esize);
+    }
+
+    i               = vec->size - n;
+    vec->size       = n;
+    vec->sort       = sort;
+    vec->sort_ctx   = (void *)sort_ctx;
+
+    vec_shrink(vec);
+
+    return i;
+}
+
+bool vec_is_sorted(vec_const_ct vec)
+{
+    assert_magic(vec);
+
+    return vec->sort;
+}
+
+/// Get position of first element not less or greater than key.
+///
+/// \param vec      vector
+/// \param key      key to compare elements with
+/// \param upper    if true find first element greater than \p key
+/// \param sort     callback to compare \p key with element
+/// \param ctx      \p sort context
+///
+/// \returns        position of element, vector size if none
+static size_t vec_bound(vec_const_ct vec, const void *key, bool upper, vec_sort_cb sort, void *ctx)
+{
+    size_t lo = 0, hi = vec->size, mid;
+    int rc;
+
+    while(lo < hi)
+    {
+        mid = lo + (hi - lo) / 2;
+        rc  = sort(key, ELEM(mid), ctx);
+
+        if(rc > 0 || (upper && !rc))
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    return lo;
+}
+
+/// Resolve comparator of sorted vector.
+///
+/// \param vec      vector
+/// \param sort     comparator, NULL to use sorted set comparator
+/// \param ctx      \p sort context
+#define vec_sort_resolve(vec, sort, ctx) do { \
+    if(!(sort)) \
+    { \
+        assert((vec)->sort); \
+        (sort)  = (vec)->sort; \
+        (ctx)   = (vec)->sort_ctx; \
+    } \
+} while(0)
+
+size_t vec_lower_bound(vec_const_ct vec, const void *key, vec_sort_cb sort, const void *ctx)
+{
+    assert_magic(vec);
+    assert(key);
+    vec_sort_resolve(vec, sort, ctx);
+
+    return vec_bound(vec, key, false, sort, (void *)ctx);
+}
+
+size_t vec_upper_bound(vec_const_ct vec, const void *key, vec_sort_cb sort, const void *ctx)
+{
+    assert_magic(vec);
+    assert(key);
+    vec_sort_resolve(vec, sort, ctx);
+
+    return vec_bound(vec, key, true, sort, (void *)ctx);
+}
+
+void *vec_bsearch(vec_const_ct vec, const void *key, vec_sort_cb sort, const void *ctx)
+{
+    size_t pos;
+
+    assert_magic(vec);
+    assert(key);
+    vec_sort_resolve(vec, sort, ctx);
+
+    pos = vec_bound(vec, key, false, sort, (void *)ctx);
+
+    return_error_if_fail(pos < vec->size && !sort(key, ELEM(pos), (void *)ctx), E_VEC_NOT_FOUND, NULL);
+
+    return ELEM(pos);
+}
+
+void *vec_insert_sorted(vec_ct vec, const void *elem, vec_sort_cb sort, const void *ctx)
+{
+    size_t pos;
+
+    assert_magic(vec);
+    assert(elem);
+    vec_sort_resolve(vec, sort, ctx);
+
+    pos = vec_bound(vec, elem, true, sort, (void *)ctx);
+
+    // equal element would be right before upper bound
+    return_error_if_fail(!vec->sort || !pos || sort(elem, ELEM(pos - 1), (void *)ctx), E_VEC_EXISTS, NULL);
+
+    return error_pass_ptr(vec_insert_at(vec, pos, 1, elem));
+}
+
+int vec_merge_sorted(vec_ct vec, vec_const_ct src, vec_sort_cb sort, const void *ctx)
+{
+    size_t i, j, k, n;
+    const char *selem;
+    int rc;
+
+    assert_magic(vec);
+    assert_magic(src);
+    assert(vec != src);
+    assert(vec->esize == src->esize);
+    vec_sort_resolve(vec, sort, ctx);
+
+    n = src->size;
+
+    // sorted sets skip source elements already present or repeated
+    for(i = 0, j = 0; vec->sort && j < src->size; j++)
+    {
+        selem = src->mem + j * src->esize;
+
+        if(j && !sort(selem - src->esize, selem, (void *)ctx))
+        {
+            n--;
+            continue;
+        }
+
+        for(; i < vec->size && sort(ELEM(i), selem, (void *)ctx) < 0; i++);
+
+        if(i < vec->size && !sort(ELEM(i), selem, (void *)ctx))
+            n--;
+    }
+
+    if(!n)
+        return 0;
+
+    if(vec_grow(vec, n))
+        return error_pass(), -1;
+
+    // merge from the back, equal source elements go after vector elements
+    for(i = vec->size, j = src->size, k = vec->size + n; j; j--)
+    {
+        selem   = src->mem + (j - 1) * src->esize;
+        rc      = i ? sort(ELEM(i - 1), selem, (void *)ctx) : -1;
+
+        for(; rc > 0; rc = i ? sort(ELEM(i - 1), selem, (void *)ctx) : -1)
+            memcpy(ELEM(--k), ELEM(--i), vec->esize);
+
+        if(!vec->sort || (rc && (j < 2 || sort(selem - src->esize, selem, (void *)ctx))))
+            memcpy(ELEM(--k), selem, vec->esize);
+    }
+
+    vec->size += n;
+
+    return 0;
 }
@@ -21,10 +21,12 @@
  */
 
 #include <ytil/ext/string.h>
+#include <ytil/def/simd.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <assert.h>
 #include <errno.h>
+#include <stdint.h>
 
 
 #ifdef _WIN32
@@ -543,10 +545,166 @@ size_t memcaseprefix(const void *vmem1, const void *vmem2, size_t size)
     return plen;
 }
 
+/// Needles up to this length are searched with the SIMD first/last byte
+/// filter only, longer needles switch to Two-Way once the filter degrades.
+#define MEMMEM_FILTER_MAX   32
+
+#if SIMD512
+    #define MEMMEM_BLOCK    64
+    #define memmem_mask8    simd512_mask8
+    typedef uint64_t memmem_mask_t;
+#elif SIMD256
+    #define MEMMEM_BLOCK    32
+    #define memmem_mask8    simd256_mask8
+    typedef uint32_t memmem_mask_t;
+#elif SIMD128
+    #define MEMMEM_BLOCK    16
+    #define memmem_mask8    simd128_mask8
+    typedef unsigned int memmem_mask_t;
+#endif
+
+/*
+ * BITOP and memmem_twoway are derived from the Two-Way memmem of musl libc,
+ * licensed under the following terms:
+ *
+ * Copyright (c) 2005-2020 Rich Felker, et al.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define BITOP(set, b, op) \
+    ((set)[(size_t)(b) / (8*sizeof(*(set)))] op (size_t)1 << ((size_t)(b) % (8*sizeof(*(set)))))
+
+// Two-Way string matching (Crochemore-Perrin) with a bad char shift on the
+// last needle byte, linear time and constant space for any needle,
+// haystack must be at least as long as needle
+static void *memmem_twoway(const unsigned char *haystack, size_t ssize, const unsigned char *needle, size_t nsize)
+{
+    const unsigned char *end = haystack + ssize;
+    size_t byteset[32/sizeof(size_t)] = { 0 };
+    size_t shift[256];
+    size_t i, ip, jp, k, p, ms, p0, mem, mem0;
+    
+    for(i=0; i < nsize; i++)
+    {
+        BITOP(byteset, needle[i], |=);
+        shift[needle[i]] = i+1;
+    }
+    
+    // maximal suffix for <
+    for(ip = -1, jp = 0, k = p = 1; jp+k < nsize;)
+    {
+        if(needle[ip+k] == needle[jp+k])
+        {
+            if(k == p)
+                jp += p, k = 1;
+            else
+                k++;
+        }
+        else if(needle[ip+k] > needle[jp+k])
+            jp += k, k = 1, p = jp - ip;
+        else
+            ip = jp++, k = p = 1;
+    }
+    
+    ms = ip;
+    p0 = p;
+    
+    // maximal suffix for >
+    for(ip = -1, jp = 0, k = p = 1; jp+k < nsize;)
+    {
+        if(needle[ip+k] == needle[jp+k])
+        {
+            if(k == p)
+                jp += p, k = 1;
+            else
+                k++;
+        }
+        else if(needle[ip+k] < needle[jp+k])
+            jp += k, k = 1, p = jp - ip;
+        else
+            ip = jp++, k = p = 1;
+    }
+    
+    if(ip+1 > ms+1)
+        ms = ip;
+    else
+        p = p0;
+    
+    // periodic needle remembers the already matched prefix
+    if(memcmp(needle, needle+p, ms+1))
+    {
+        mem0 = 0;
+        p = (ms > nsize-ms-1 ? ms : nsize-ms-1) + 1;
+    }
+    else
+        mem0 = nsize - p;
+    
+    for(mem = 0; (size_t)(end - haystack) >= nsize;)
+    {
+        if(!BITOP(byteset, haystack[nsize-1], &))
+        {
+            haystack += nsize;
+            mem = 0;
+            continue;
+        }
+        
+        if((k = nsize - shift[haystack[nsize-1]]))
+        {
+            haystack += k < mem ? mem : k;
+            mem = 0;
+            continue;
+        }
+        
+        // right half
+        for(k = ms+1 > mem ? ms+1 : mem; k < nsize && needle[k] == haystack[k]; k++);
+        
+        if(k < nsize)
+        {
+            haystack += k - ms;
+            mem = 0;
+            continue;
+        }
+        
+        // left half
+        for(k = ms+1; k > mem && needle[k-1] == haystack[k-1]; k--);
+        
+        if(k <= mem)
+            return (void *)haystack;
+        
+        haystack += p;
+        mem = mem0;
+    }
+    
+    return NULL;
+}
+
 void *memmem(const void *vhaystack, size_t ssize, const void *vneedle, size_t nsize)
 {
-    const char *ptr, *haystack = vhaystack, *needle = vneedle;
-    const char *last = haystack + ssize - nsize + 1;
+    const unsigned char *ptr, *haystack = vhaystack, *needle = vneedle;
+    const unsigned char *last;
+#ifdef MEMMEM_BLOCK
+    memmem_mask_t mask;
+    size_t pos, checks;
+    int bit;
+#endif
     
     if(!nsize)
         return (void*)haystack;
@@ -554,6 +712,38 @@ void *memmem(const void *vhaystack, size_t ssize, const void *vneedle, size_t ns
     if(ssize < nsize)
         return NULL;
     
+    if(nsize == 1)
+        return memchr(haystack, needle[0], ssize);
+    
+    last = haystack + ssize - nsize + 1;
+    
+#ifdef MEMMEM_BLOCK
+    // compare block of first and last needle bytes at once,
+    // only verify candidates where both match
+    for(pos=0, checks=0; pos + MEMMEM_BLOCK <= (size_t)(last - haystack); pos += MEMMEM_BLOCK)
+    {
+        mask = memmem_mask8(&haystack[pos], needle[0])
+             & memmem_mask8(&haystack[pos + nsize - 1], needle[nsize-1]);
+        
+        for(; mask; mask &= mask - 1)
+        {
+            bit = CTZ(mask);
+            
+            if(!memcmp(&haystack[pos + bit + 1], needle + 1, nsize - 2))
+                return (void*)&haystack[pos + bit];
+            
+            // too many false positives, keep verification linear
+            if(nsize > MEMMEM_FILTER_MAX && ++checks * nsize > 2*pos + 4096)
+                return memmem_twoway(&haystack[pos + bit + 1], ssize - pos - bit - 1, needle, nsize);
+        }
+    }
+    
+    haystack += pos;
+#else
+    if(nsize > MEMMEM_FILTER_MAX)
+        return memmem_twoway(haystack, ssize, needle, nsize);
+#endif
+    
     for(; (ptr = memchr(haystack, needle[0], last-haystack)); haystack = ptr+1)
         if(!memcmp(ptr, needle, nsize))
             return (void*)ptr;
@@ -561,6 +751,46 @@ void *memmem(const void *vhaystack, size_t ssize, const void *vneedle, size_t ns
     return NULL;
 }
 
+void *memrmem(const void *vhaystack, size_t ssize, const void *vneedle, size_t nsize)
+{
+    const unsigned char *haystack = vhaystack, *needle = vneedle;
+    size_t pos;
+#ifdef MEMMEM_BLOCK
+    memmem_mask_t mask;
+    int bit;
+#endif
+    
+    if(!nsize)
+        return (void*)(haystack + ssize);
+    
+    if(ssize < nsize)
+        return NULL;
+    
+    pos = ssize - nsize + 1; // number of candidate positions
+    
+#ifdef MEMMEM_BLOCK
+    for(; pos >= MEMMEM_BLOCK; pos -= MEMMEM_BLOCK)
+    {
+        mask = memmem_mask8(&haystack[pos - MEMMEM_BLOCK], needle[0])
+             & memmem_mask8(&haystack[pos - MEMMEM_BLOCK + nsize - 1], needle[nsize-1]);
+        
+        for(; mask; mask &= ~((memmem_mask_t)1 << bit))
+        {
+            bit = sizeof(memmem_mask_t)*8 - 1 - CLZ(mask);
+            
+            if(!memcmp(&haystack[pos - MEMMEM_BLOCK + bit], needle, nsize))
+                return (void*)&haystack[pos - MEMMEM_BLOCK + bit];
+        }
+    }
+#endif
+    
+    for(; pos; pos--)
+        if(haystack[pos-1] == needle[0] && !memcmp(&haystack[pos-1], needle, nsize))
+            return (void*)&haystack[pos-1];
+    
+    return NULL;
+}
+
 int memcasecmp(const void *vmem1, const void *vmem2, size_t size)
 {
     const unsigned char *mem1 = vmem1, *mem2 = vmem2, *mend = mem1 + size;
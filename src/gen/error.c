@@ -55,11 +55,11 @@ typedef struct error_stack
     size_t          clean;                      ///< number of entries which need cleanup
 } error_stack_st;
 
-/// error state
-static error_stack_st errors;
+/// error state, per thread
+static _Thread_local error_stack_st errors;
 
-static char error_name_buf[50];     ///< error name buffer
-static char error_desc_buf[200];    ///< error description buffer
+static _Thread_local char error_name_buf[50];   ///< error name buffer
+static _Thread_local char error_desc_buf[200];  ///< error description buffer
 
 
 const char *error_type_name(const error_type_st *type)
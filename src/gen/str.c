@@ -27,8 +27,11 @@
 #include <ytil/ext/string.h>
 #include <ytil/con/vec.h>
 #include <stdint.h>
+#include <stdatomic.h>
+#include <sched.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <assert.h>
 
 
 #define MAGIC define_magic("STR")
@@ -44,6 +47,7 @@ typedef enum str_flags
     , FLAG_CONST        = BV(4) // data is const i.e. not to be modified
     , FLAG_VOLATILE     = BV(5) // data is volatile i.e. is modified by other ref holders
     , FLAG_BINARY       = BV(6) // data my contain control chars and/or no null terminator
+    , FLAG_INTERN       = BV(7) // str is owned by the intern table and immortal
 } str_flag_fs;
 
 typedef enum str_type
@@ -63,6 +67,40 @@ typedef struct str
     uint8_t flags, type;
 } str_st;
 
+typedef enum str_split_mode
+{
+      SPLIT_CHAR    // split at char
+    , SPLIT_SET     // split at any char of set
+    , SPLIT_SUB     // split at sub str
+} str_split_id;
+
+static_assert(sizeof(str_st) <= STR_HEAD_SIZE, "STR_HEAD_SIZE too small");
+
+#define INTERN_SHARDS   64  // number of intern table shards, power of 2
+#define INTERN_SLOTS    64  // initial number of slots per shard, power of 2
+
+typedef struct str_intern_entry
+{
+    uint64_t hash;
+    str_st str;
+    unsigned char data[];
+} str_intern_entry_st;
+
+typedef struct str_intern_table
+{
+    struct str_intern_table *prev;  // replaced table, kept for concurrent readers
+    size_t mask, size;
+    _Atomic(str_intern_entry_st*) slots[];
+} str_intern_table_st;
+
+typedef struct str_intern_shard
+{
+    atomic_flag lock;   // writer lock
+    _Atomic(str_intern_table_st*) table;
+} str_intern_shard_st;
+
+static str_intern_shard_st intern_shards[INTERN_SHARDS];
+
 typedef enum str_cat_mode
 {
       CAT_STR
@@ -84,11 +122,13 @@ ERROR_DEFINE_LIST(STR,
       ERROR_INFO(E_STR_BINARY, "Operation not supported on binary data str.")
     , ERROR_INFO(E_STR_CONST, "Operation not supported on constant str.")
     , ERROR_INFO(E_STR_EMPTY, "Operation not supported on empty str.")
+    , ERROR_INFO(E_STR_END, "End of str reached.")
     , ERROR_INFO(E_STR_INVALID_CSTR, "Invalid str data.")
     , ERROR_INFO(E_STR_INVALID_CALLBACK, "Invalid callback.")
     , ERROR_INFO(E_STR_INVALID_DATA, "Invalid binary data.")
     , ERROR_INFO(E_STR_INVALID_FORMAT, "Invalid format.")
     , ERROR_INFO(E_STR_INVALID_LENGTH, "Invalid str length.")
+    , ERROR_INFO(E_STR_NOT_FOUND, "Sub str not found.")
     , ERROR_INFO(E_STR_OUT_OF_BOUNDS, "Out of bounds access.")
     , ERROR_INFO(E_STR_UNREFERENCED, "Operation not supported on unreferenced str.")
     , ERROR_INFO(E_STR_VOLATILE, "Operation not supported on volatile str.")
@@ -335,6 +375,13 @@ bool str_is_volatile(str_const_ct str)
     return _str_get_flags(str, FLAG_VOLATILE);
 }
 
+bool str_is_interned(str_const_ct str)
+{
+    assert_str(str);
+    
+    return _str_get_flags(str, FLAG_INTERN);
+}
+
 bool str_is_binary(str_const_ct str)
 {
     assert_str(str);
@@ -533,6 +580,9 @@ str_ct str_ref(str_const_ct str)
     
     assert_str(str);
     
+    if(_str_get_flags(str, FLAG_INTERN))
+        return vstr;
+    
     if(!_str_is_transient(str))
         return ++vstr->ref, vstr;
     
@@ -592,6 +642,10 @@ str_ct str_unref(str_const_ct str)
     str_ct vstr = (str_ct)str;
     
     assert_str(vstr);
+    
+    if(_str_get_flags(vstr, FLAG_INTERN))
+        return vstr;
+    
     return_error_if_fail(vstr->ref, E_STR_UNREFERENCED, NULL);
     
     if(--vstr->ref)
@@ -1906,10 +1960,34 @@ str_ct str_replace_c(str_ct str, const char *sub, const char *nsub)
     return error_pass_ptr(str_replace_cn(str, sub, strlen(sub), nsub, strlen(nsub)));
 }
 
+/// Collect positions of all non-overlapping occurences of sub in str.
+///
+/// \param str         str
+/// \param sub         sub data to find, non-empty
+/// \param sublen      length of sub
+/// \param positions   vec of size_t to append positions to
+///
+/// \retval true       success
+/// \retval false      vec error
+static bool _str_find_all(str_const_ct str, const void *sub, size_t sublen, vec_ct positions)
+{
+    const unsigned char *ptr, *end = str->data + _str_get_len(str);
+    size_t pos;
+    
+    for(ptr = str->data; (ptr = memmem(ptr, end - ptr, sub, sublen)); ptr += sublen)
+    {
+        pos = ptr - str->data;
+        
+        if(!vec_push_e(positions, &pos))
+            return error_wrap(), false;
+    }
+    
+    return true;
+}
+
 str_ct str_replace_cn(str_ct str, const char *sub, size_t sublen, const char *nsub, size_t nsublen)
 {
     vec_ct positions;
-    unsigned char *ptr;
     size_t len, pos, ins, data, i, size;
     
     assert_str(str);
@@ -1918,18 +1996,10 @@ str_ct str_replace_cn(str_ct str, const char *sub, size_t sublen, const char *ns
     if(!_str_get_len(str) || !sublen)
         return str;
     
-    if(!(positions = vec_new_c(2, sizeof(size_t))))
-        return error_wrap(), NULL;
+    positions = vec_new_inline(8, sizeof(size_t));
     
-    for(ptr = str->data, len = str->len;
-        len && (ptr = memmem(ptr, len, sub, sublen));
-        ptr += sublen, len -= sublen)
-    {
-        pos = ptr - str->data;
-        
-        if(!vec_push_e(positions, &pos))
-            return error_wrap(), vec_free(positions), NULL;
-    }
+    if(!_str_find_all(str, sub, sublen, positions))
+        return error_pass(), vec_free(positions), NULL;
     
     if(vec_is_empty(positions))
         return vec_free(positions), str;
@@ -1998,6 +2068,217 @@ str_ct str_replace_b(str_ct str, const void *sub, size_t sublen, const void *nsu
     return str;
 }
 
+static ssize_t _str_find(str_const_ct str, const void *sub, size_t len, bool reverse)
+{
+    const unsigned char *ptr;
+    size_t slen = _str_get_len(str);
+    
+    if(reverse)
+        ptr = memrmem(str->data, slen, sub, len);
+    else
+        ptr = memmem(str->data, slen, sub, len);
+    
+    if(!ptr)
+        return error_set(E_STR_NOT_FOUND), -1;
+    
+    return ptr - str->data;
+}
+
+ssize_t str_find(str_const_ct str, str_const_ct sub)
+{
+    assert_str(str);
+    assert_str(sub);
+    
+    return error_pass_int(_str_find(str, sub->data, _str_get_len(sub), false));
+}
+
+ssize_t str_find_c(str_const_ct str, const char *sub)
+{
+    return_error_if_fail(sub, E_STR_INVALID_CSTR, -1);
+    
+    return error_pass_int(str_find_cn(str, sub, strlen(sub)));
+}
+
+ssize_t str_find_cn(str_const_ct str, const char *sub, size_t len)
+{
+    assert_str(str);
+    return_error_if_fail(sub, E_STR_INVALID_CSTR, -1);
+    
+    return error_pass_int(_str_find(str, sub, len, false));
+}
+
+ssize_t str_find_b(str_const_ct str, const void *sub, size_t len)
+{
+    assert_str(str);
+    return_error_if_fail(sub, E_STR_INVALID_DATA, -1);
+    
+    return error_pass_int(_str_find(str, sub, len, false));
+}
+
+ssize_t str_rfind(str_const_ct str, str_const_ct sub)
+{
+    assert_str(str);
+    assert_str(sub);
+    
+    return error_pass_int(_str_find(str, sub->data, _str_get_len(sub), true));
+}
+
+ssize_t str_rfind_c(str_const_ct str, const char *sub)
+{
+    return_error_if_fail(sub, E_STR_INVALID_CSTR, -1);
+    
+    return error_pass_int(str_rfind_cn(str, sub, strlen(sub)));
+}
+
+ssize_t str_rfind_cn(str_const_ct str, const char *sub, size_t len)
+{
+    assert_str(str);
+    return_error_if_fail(sub, E_STR_INVALID_CSTR, -1);
+    
+    return error_pass_int(_str_find(str, sub, len, true));
+}
+
+ssize_t str_rfind_b(str_const_ct str, const void *sub, size_t len)
+{
+    assert_str(str);
+    return_error_if_fail(sub, E_STR_INVALID_DATA, -1);
+    
+    return error_pass_int(_str_find(str, sub, len, true));
+}
+
+vec_ct str_find_all(str_const_ct str, str_const_ct sub)
+{
+    assert_str(sub);
+    
+    return error_pass_ptr(str_find_all_b(str, sub->data, _str_get_len(sub)));
+}
+
+vec_ct str_find_all_c(str_const_ct str, const char *sub)
+{
+    return_error_if_fail(sub, E_STR_INVALID_CSTR, NULL);
+    
+    return error_pass_ptr(str_find_all_b(str, sub, strlen(sub)));
+}
+
+vec_ct str_find_all_cn(str_const_ct str, const char *sub, size_t len)
+{
+    return_error_if_fail(sub, E_STR_INVALID_CSTR, NULL);
+    
+    return error_pass_ptr(str_find_all_b(str, sub, len));
+}
+
+vec_ct str_find_all_b(str_const_ct str, const void *sub, size_t len)
+{
+    vec_ct positions;
+    
+    assert_str(str);
+    return_error_if_fail(sub, E_STR_INVALID_DATA, NULL);
+    return_error_if_fail(len, E_STR_EMPTY, NULL);
+    
+    if(!(positions = vec_new(sizeof(size_t))))
+        return error_wrap(), NULL;
+    
+    if(!_str_find_all(str, sub, len, positions))
+        return error_pass(), vec_free(positions), NULL;
+    
+    return positions;
+}
+
+static str_split_st *_str_split_init(str_split_st *split, str_const_ct str, str_split_id mode)
+{
+    str_ct vstr = (str_ct)str;
+    
+    assert(split);
+    assert_str(vstr);
+    
+    split->str = vstr;
+    split->mode = mode;
+    split->pos = 0;
+    split->done = false;
+    
+    // transient str cannot be referenced without allocation,
+    // interned str is immortal and may be shared between threads
+    if((split->ref = !_str_is_transient(vstr) && !_str_get_flags(vstr, FLAG_INTERN)))
+        vstr->ref++;
+    
+    return split;
+}
+
+str_split_st *str_split_init(str_split_st *split, str_const_ct str, char c)
+{
+    split->c = (unsigned char)c;
+    
+    return _str_split_init(split, str, SPLIT_CHAR);
+}
+
+str_split_st *str_split_init_set(str_split_st *split, str_const_ct str, const char *set)
+{
+    return_error_if_fail(set, E_STR_INVALID_CSTR, NULL);
+    
+    split->delim = set;
+    split->dlen = strlen(set);
+    
+    return _str_split_init(split, str, SPLIT_SET);
+}
+
+str_split_st *str_split_init_sub(str_split_st *split, str_const_ct str, const void *sub, size_t len)
+{
+    return_error_if_fail(sub, E_STR_INVALID_DATA, NULL);
+    return_error_if_fail(len, E_STR_EMPTY, NULL);
+    
+    split->delim = sub;
+    split->dlen = len;
+    
+    return _str_split_init(split, str, SPLIT_SUB);
+}
+
+str_ct str_split_next(str_split_st *split)
+{
+    const unsigned char *start, *end, *ptr;
+    size_t dlen;
+    
+    assert(split);
+    return_error_if_pass(split->done, E_STR_END, NULL);
+    
+    start = split->str->data + split->pos;
+    end = split->str->data + _str_get_len(split->str);
+    assert(start <= end);
+    
+    switch(split->mode)
+    {
+    case SPLIT_CHAR:
+        ptr = memchr(start, split->c, end - start);
+        dlen = 1;
+        break;
+    case SPLIT_SET:
+        ptr = mempbrk(start, end - start, split->delim, split->dlen);
+        dlen = 1;
+        break;
+    case SPLIT_SUB:
+        ptr = memmem(start, end - start, split->delim, split->dlen);
+        dlen = split->dlen;
+        break;
+    default:
+        abort();
+    }
+    
+    if(ptr)
+        split->pos = ptr + dlen - split->str->data;
+    else
+        ptr = end, split->done = true;
+    
+    return _str_init((str_ct)split->field.mem, FLAG_TRANSIENT|FLAG_CONST|FLAG_BINARY, 0,
+        DATA_TRANSIENT, (unsigned char*)start, ptr - start, ptr - start);
+}
+
+void str_split_free(str_split_st *split)
+{
+    assert(split);
+    
+    if(split->ref)
+        str_unref(split->str);
+}
+
 str_ct str_substr(str_const_ct str, ssize_t pos, size_t len)
 {
     assert_str(str);
@@ -2455,3 +2736,266 @@ int str_casecmp_nb(str_const_ct str, const void *mem, size_t n)
 {
     return str_casecmp_n(str, tstr_new_bs(mem, n), n);
 }
+
+// multiply and fold upper and lower half of 128 bit product
+static inline uint64_t _str_hash_mix(uint64_t a, uint64_t b)
+{
+#ifdef __SIZEOF_INT128__
+    __uint128_t r = (__uint128_t)a * b;
+    
+    return (uint64_t)r ^ (uint64_t)(r >> 64);
+#else
+    uint64_t r = a * (b | 1);
+    
+    return r ^ (r >> 32) ^ b;
+#endif
+}
+
+static inline uint64_t _str_hash_read64(const unsigned char *p)
+{
+    uint64_t v;
+    
+    memcpy(&v, p, sizeof(v));
+    
+    return v;
+}
+
+static inline uint64_t _str_hash_read32(const unsigned char *p)
+{
+    uint32_t v;
+    
+    memcpy(&v, p, sizeof(v));
+    
+    return v;
+}
+
+uint64_t str_hash_b(const void *data, size_t len)
+{
+    static const uint64_t s0 = 0xa0761d6478bd642f, s1 = 0xe7037ed1a0b428db;
+    static const uint64_t s2 = 0x8ebc6af09c88c6e3, s3 = 0x589965cc75374cc3;
+    const unsigned char *p = data;
+    uint64_t h = s0 ^ len, h1, h2, a, b;
+    size_t rest = len;
+    
+    assert(data || !len);
+    
+    // three independent lanes keep the multiplier busy on long data
+    if(rest > 48)
+    {
+        for(h1 = h2 = h; rest > 48; rest -= 48, p += 48)
+        {
+            h  = _str_hash_mix(_str_hash_read64(p) ^ s1, _str_hash_read64(p + 8) ^ h);
+            h1 = _str_hash_mix(_str_hash_read64(p + 16) ^ s2, _str_hash_read64(p + 24) ^ h1);
+            h2 = _str_hash_mix(_str_hash_read64(p + 32) ^ s3, _str_hash_read64(p + 40) ^ h2);
+        }
+        
+        h ^= h1 ^ h2;
+    }
+    
+    for(; rest > 16; rest -= 16, p += 16)
+        h = _str_hash_mix(_str_hash_read64(p) ^ s1, _str_hash_read64(p + 8) ^ h);
+    
+    if(rest > 8)
+    {
+        a = _str_hash_read64(p);
+        b = _str_hash_read64(p + rest - 8);
+    }
+    else if(rest >= 4)
+    {
+        a = _str_hash_read32(p);
+        b = _str_hash_read32(p + rest - 4);
+    }
+    else if(rest)
+    {
+        a = (uint64_t)p[0] << 16 | (uint64_t)p[rest >> 1] << 8 | p[rest - 1];
+        b = 0;
+    }
+    else
+        a = b = 0;
+    
+    return _str_hash_mix(s1 ^ len, _str_hash_mix(a ^ s1, b ^ h ^ s2));
+}
+
+uint64_t str_hash(str_const_ct str)
+{
+    assert_str(str);
+    
+    // interned strs keep their hash in the intern entry
+    if(_str_get_flags(str, FLAG_INTERN))
+        return ((const str_intern_entry_st *)((const char *)str - offsetof(str_intern_entry_st, str)))->hash;
+    
+    return str_hash_b(str->data, _str_get_len(str));
+}
+
+static str_intern_entry_st *_str_intern_lookup(str_intern_table_st *table, uint64_t hash, const void *data, size_t len)
+{
+    str_intern_entry_st *entry;
+    size_t slot;
+    
+    for(slot = hash & table->mask;
+        (entry = atomic_load_explicit(&table->slots[slot], memory_order_acquire));
+        slot = (slot + 1) & table->mask)
+    {
+        if(entry->hash == hash && entry->str.len == len && !memcmp(entry->data, data, len))
+            return entry;
+    }
+    
+    return NULL;
+}
+
+static void _str_intern_link(str_intern_table_st *table, str_intern_entry_st *entry)
+{
+    size_t slot;
+    
+    for(slot = entry->hash & table->mask;
+        atomic_load_explicit(&table->slots[slot], memory_order_relaxed);
+        slot = (slot + 1) & table->mask);
+    
+    atomic_store_explicit(&table->slots[slot], entry, memory_order_release);
+    table->size++;
+}
+
+static str_intern_table_st *_str_intern_grow(str_intern_shard_st *shard, str_intern_table_st *table)
+{
+    str_intern_table_st *ntable;
+    str_intern_entry_st *entry;
+    size_t slots, slot;
+    
+    slots = table ? 2*(table->mask + 1) : INTERN_SLOTS;
+    
+    if(!(ntable = calloc(1, sizeof(str_intern_table_st) + slots*sizeof(ntable->slots[0]))))
+        return error_wrap_last_errno(calloc), NULL;
+    
+    ntable->prev = table;
+    ntable->mask = slots - 1;
+    
+    for(slot = 0; table && slot <= table->mask; slot++)
+        if((entry = atomic_load_explicit(&table->slots[slot], memory_order_relaxed)))
+            _str_intern_link(ntable, entry);
+    
+    // readers still probing the old table fall back to the locked path
+    atomic_store_explicit(&shard->table, ntable, memory_order_release);
+    
+    return ntable;
+}
+
+static str_ct _str_intern(const void *data, size_t len, uint64_t hash)
+{
+    str_intern_shard_st *shard;
+    str_intern_table_st *table;
+    str_intern_entry_st *entry;
+    
+    shard = &intern_shards[hash >> 58 & (INTERN_SHARDS - 1)];
+    
+    if((table = atomic_load_explicit(&shard->table, memory_order_acquire))
+    && (entry = _str_intern_lookup(table, hash, data, len)))
+        return &entry->str;
+    
+    while(atomic_flag_test_and_set_explicit(&shard->lock, memory_order_acquire))
+        sched_yield();
+    
+    table = atomic_load_explicit(&shard->table, memory_order_relaxed);
+    
+    if(table && (entry = _str_intern_lookup(table, hash, data, len)))
+        goto unlock;
+    
+    if((!table || (table->size + 1)*4 > (table->mask + 1)*3)
+    && !(table = _str_intern_grow(shard, table)))
+        goto error;
+    
+    if(!(entry = malloc(sizeof(str_intern_entry_st) + len + 1)))
+    {
+        error_wrap_last_errno(malloc);
+        goto error;
+    }
+    
+    memcpy(entry->data, data, len);
+    entry->data[len] = '\0';
+    
+    _str_init(&entry->str, memchr(data, '\0', len) ? FLAG_CONST|FLAG_BINARY : FLAG_CONST,
+        1, DATA_STATIC, entry->data, len, 0);
+    _str_set_flags(&entry->str, FLAG_INTERN);
+    entry->hash = hash;
+    
+    _str_intern_link(table, entry);
+    
+unlock:
+    atomic_flag_clear_explicit(&shard->lock, memory_order_release);
+    
+    return &entry->str;
+    
+error:
+    atomic_flag_clear_explicit(&shard->lock, memory_order_release);
+    
+    return NULL;
+}
+
+str_ct str_intern(str_const_ct str)
+{
+    assert_str(str);
+    
+    if(_str_get_flags(str, FLAG_INTERN))
+        return (str_ct)str;
+    
+    return error_pass_ptr(_str_intern(str->data, _str_get_len(str), str_hash(str)));
+}
+
+str_ct str_intern_c(const char *cstr)
+{
+    return_error_if_fail(cstr, E_STR_INVALID_CSTR, NULL);
+    
+    return error_pass_ptr(_str_intern(cstr, strlen(cstr), str_hash_b(cstr, strlen(cstr))));
+}
+
+str_ct str_intern_cn(const char *cstr, size_t len)
+{
+    return_error_if_fail(cstr, E_STR_INVALID_CSTR, NULL);
+    
+    return error_pass_ptr(_str_intern(cstr, len, str_hash_b(cstr, len)));
+}
+
+str_ct str_intern_b(const void *data, size_t len)
+{
+    return_error_if_fail(data, E_STR_INVALID_DATA, NULL);
+    
+    return error_pass_ptr(_str_intern(data, len, str_hash_b(data, len)));
+}
+
+size_t str_intern_count(void)
+{
+    str_intern_table_st *table;
+    size_t s, count;
+    
+    for(s = 0, count = 0; s < INTERN_SHARDS; s++)
+    {
+        while(atomic_flag_test_and_set_explicit(&intern_shards[s].lock, memory_order_acquire))
+            sched_yield();
+        
+        if((table = atomic_load_explicit(&intern_shards[s].table, memory_order_relaxed)))
+            count += table->size;
+        
+        atomic_flag_clear_explicit(&intern_shards[s].lock, memory_order_release);
+    }
+    
+    return count;
+}
+
+void str_intern_free(void)
+{
+    str_intern_table_st *table, *prev;
+    size_t s, slot;
+    
+    for(s = 0; s < INTERN_SHARDS; s++)
+    {
+        table = atomic_exchange(&intern_shards[s].table, NULL);
+        
+        for(slot = 0; table && slot <= table->mask; slot++)
+            free(atomic_load_explicit(&table->slots[slot], memory_order_relaxed));
+        
+        for(; table; table = prev)
+        {
+            prev = table->prev;
+            free(table);
+        }
+    }
+}
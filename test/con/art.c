@@ -24,6 +24,21 @@
 #include <ytil/test/run.h>
 #include <ytil/test/test.h>
 #include <ytil/con/art.h>
+#include <ytil/def.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+#define BENCH_KEYS      50000   ///< number of keys in benchmarks
+#define BENCH_ROUNDS    10      ///< number of lookups per key in benchmarks
+
+#define STRESS_KEYS     500     ///< number of stable keys in concurrency stress test
+#define STRESS_READERS  4       ///< number of reader threads in concurrency stress test
+#define STRESS_ROUNDS   4       ///< number of writer rounds in concurrency stress test
+
+#define IMAGE_FILE      "test_art.img"  ///< ART image file
 
 static const struct not_an_art
 {
@@ -33,6 +48,9 @@ static const struct not_an_art
 static art_ct art;
 static art_node_ct node;
 static str_ct key;
+static art_iter_ct iter;
+static str_ct bench_keys[BENCH_KEYS];
+static str_ct stress_keys[STRESS_KEYS];
 
 
 TEST_SETUP(art_new_empty)
@@ -55,11 +73,116 @@ TEST_SETUP(art_new4)
     test_ptr_success(art_insert_value(art, LIT("xyz"), 4));
 }
 
+TEST_SETUP(art_new_slab)
+{
+    test_ptr_success(art = art_new(ART_MODE_ORDERED | ART_MODE_SLAB));
+}
+
+TEST_SETUP(art_new_optimistic)
+{
+    test_ptr_success(art = art_new(ART_MODE_ORDERED | ART_MODE_OPTIMISTIC));
+    test_ptr_success(art_insert_value(art, LIT("http://example.com/foo/bar"), 1));
+    test_ptr_success(art_insert_value(art, LIT("http://example.com/foo/baz"), 2));
+    test_ptr_success(art_insert_value(art, LIT("http://example.com/bar"), 3));
+    test_ptr_success(art_insert_value(art, LIT("http://example.org/"), 4));
+}
+
+TEST_SETUP(art_new_concurrent)
+{
+    test_ptr_success(art = art_new(ART_MODE_ORDERED | ART_MODE_CONCURRENT));
+    test_ptr_success(art_insert_value(art, LIT("http://example.com/foo/bar"), 1));
+    test_ptr_success(art_insert_value(art, LIT("http://example.com/foo/baz"), 2));
+    test_ptr_success(art_insert_value(art, LIT("http://example.com/bar"), 3));
+    test_ptr_success(art_insert_value(art, LIT("http://example.org/"), 4));
+}
+
 TEST_TEARDOWN(art_free)
 {
     art_free(art);
 }
 
+TEST_SETUP(art_new_frozen)
+{
+    art_ct art2;
+
+    test_ptr_success(art2 = art_new(ART_MODE_UNORDERED));
+    test_ptr_success(art_insert_value(art2, LIT("xyz"), 4));
+    test_ptr_success(art_insert_value(art2, LIT("fooduh"), 3));
+    test_ptr_success(art_insert_value(art2, LIT("foobaz"), 2));
+    test_ptr_success(art_insert_value(art2, LIT("foobar"), 1));
+    test_int_success(art_freeze(art2, LIT(IMAGE_FILE)));
+    test_void(art_free(art2));
+    test_ptr_success(art = art_open_mmap(LIT(IMAGE_FILE)));
+}
+
+TEST_TEARDOWN(art_free_frozen)
+{
+    art_free(art);
+    remove(IMAGE_FILE);
+}
+
+TEST_SETUP(art_bench_new)
+{
+    size_t k;
+
+    for(k = 0; k < BENCH_KEYS; k++)
+        if(!(bench_keys[k] = str_dup_f("https://www.example.com/api/v%zu/users/%zu/items", k % 4, k * 7919)))
+            test_abort_fail_b("str_dup_f failed");
+}
+
+TEST_SETUP(art_bench_node64_new)
+{
+    size_t k;
+
+    // 37 children per node, all inner nodes are node64
+    for(k = 0; k < BENCH_KEYS; k++)
+        if(!(bench_keys[k] = str_dup_f("%c%c%c", (int)('A' + k / 37 / 37), (int)('A' + k / 37 % 37), (int)('A' + k % 37))))
+            test_abort_fail_b("str_dup_f failed");
+}
+
+TEST_SETUP(art_bench_random_new)
+{
+    uint64_t x;
+    size_t k;
+
+    // splitmix64 is a bijection, keys are unique
+    for(k = 0; k < BENCH_KEYS; k++)
+    {
+        x = (k + 1) * 0x9e3779b97f4a7c15;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111eb;
+        x ^= x >> 31;
+
+        if(!(bench_keys[k] = str_dup_b(&x, sizeof(x))))
+            test_abort_fail_b("str_dup_b failed");
+    }
+}
+
+TEST_SETUP(art_bench_sequential_new)
+{
+    unsigned char be[4];
+    size_t k;
+
+    for(k = 0; k < BENCH_KEYS; k++)
+    {
+        be[0] = k >> 24;
+        be[1] = k >> 16;
+        be[2] = k >> 8;
+        be[3] = k;
+
+        if(!(bench_keys[k] = str_dup_b(be, sizeof(be))))
+            test_abort_fail_b("str_dup_b failed");
+    }
+}
+
+TEST_TEARDOWN(art_bench_free)
+{
+    size_t k;
+
+    for(k = 0; k < BENCH_KEYS; k++)
+        str_unref(bench_keys[k]);
+}
+
 TEST_CASE_ABORT(art_is_empty_invalid_magic)
 {
     art_is_empty((art_ct)&not_an_art);
@@ -117,6 +240,15 @@ TEST_CASE_FIX(art_memsize, art_new_empty, art_free)
     test_uint_eq(art_memsize_f(art, test_art_size, NULL), size + 1);
 }
 
+TEST_CASE_FIX(art_memsize_slab, art_new_slab, art_free)
+{
+    size_t size;
+
+    test_void(size = art_memsize(art));
+    test_ptr_success(art_insert(art, LIT("foo"), NULL));
+    test_true(art_memsize(art) > size);
+}
+
 static art_ct test_art_insert(art_ct art, int size)
 {
     int k;
@@ -134,6 +266,57 @@ static art_ct test_art_insert(art_ct art, int size)
     return art;
 }
 
+TEST_CASE_ABORT(art_stats_invalid_magic)
+{
+    art_stats((art_ct)&not_an_art, NULL);
+}
+
+TEST_CASE_FIX(art_stats_empty, art_new_empty, art_free)
+{
+    art_stats_st stats;
+
+    test_int_success(art_stats(art, &stats));
+    test_uint_eq(stats.nodes[ART_STATS_LEAF], 0);
+    test_uint_eq(stats.depth_max, 0);
+}
+
+TEST_CASE_FIX(art_stats, art_new4, art_free)
+{
+    art_stats_st stats;
+
+    test_int_success(art_stats(art, &stats));
+    test_uint_eq(stats.nodes[ART_STATS_LEAF], 4);
+    test_uint_eq(stats.nodes[ART_STATS_NODE4], 3);
+    test_uint_eq(stats.nodes[ART_STATS_NODE8], 0);
+    test_true(stats.fill[ART_STATS_NODE4] == 0.5);
+    test_uint_eq(stats.path_heap, 0);
+    test_uint_eq(stats.depth[1], 1);
+    test_uint_eq(stats.depth[2], 1);
+    test_uint_eq(stats.depth[3], 2);
+    test_uint_eq(stats.depth_max, 3);
+    test_true(stats.depth_avg == 2.25);
+}
+
+TEST_CASE_FIX(art_stats256, art_new_empty, art_free)
+{
+    art_stats_st stats;
+
+    test_ptr_success(test_art_insert(art, 256));
+    test_int_success(art_stats(art, &stats));
+    test_uint_eq(stats.nodes[ART_STATS_LEAF], 256);
+    test_uint_eq(stats.nodes[ART_STATS_NODE256], 1);
+    test_true(stats.fill[ART_STATS_NODE256] == 1.0);
+    test_uint_eq(stats.depth[1], 256);
+    test_true(stats.depth_avg == 1.0);
+}
+
+TEST_CASE_FIX(art_stats_frozen, art_new_frozen, art_free_frozen)
+{
+    art_stats_st stats;
+
+    test_int_error(art_stats(art, &stats), E_ART_FROZEN);
+}
+
 TEST_CASE_ABORT(art_insert_invalid_magic)
 {
     art_insert((art_ct)&not_an_art, NULL, NULL);
@@ -293,6 +476,106 @@ TEST_CASE_FIX(art_insert_large_key_split_back, art_new_empty, art_free)
     test_ptr_success(art_get(art, BIN("foofoobarbar22")));
 }
 
+TEST_CASE_FIX(art_insert_optimistic_key, art_new_optimistic, art_free)
+{
+    test_ptr_success(node   = art_insert(art, LIT("http://example.com/foo/bat"), NULL));
+    test_ptr_success(key    = art_node_key(node));
+    test_uint_eq(str_len(key), 27);
+    test_mem_eq(str_bc(key), "http://example.com/foo/bat", 27);
+    test_void(str_unref(key));
+}
+
+TEST_CASE_ABORT(art_bulk_load_invalid_magic)
+{
+    art_bulk_load((art_ct)&not_an_art, NULL, NULL, 0);
+}
+
+TEST_CASE_FIX(art_bulk_load, art_new4, art_free)
+{
+    str_ct keys[] = { LIT("xyz"), LIT("foobaz"), LIT("foobar"), LIT("fooduh") };
+    const void *values[] = { VALUE_TO_POINTER(4), VALUE_TO_POINTER(2), VALUE_TO_POINTER(1), VALUE_TO_POINTER(3) };
+    art_ct art2;
+
+    test_ptr_success(art2 = art_new(ART_MODE_ORDERED));
+    test_int_success(art_bulk_load(art2, keys, values, 4));
+    test_uint_eq(art_size(art2), 4);
+    test_uint_eq(art_memsize(art2), art_memsize(art));
+    test_int_eq(art_get_value(art2, LIT("foobar"), int), 1);
+    test_int_eq(art_get_value(art2, LIT("foobaz"), int), 2);
+    test_int_eq(art_get_value(art2, LIT("fooduh"), int), 3);
+    test_int_eq(art_get_value(art2, LIT("xyz"), int), 4);
+    test_void(art_free(art2));
+}
+
+TEST_CASE_FIX(art_bulk_load256, art_new_empty, art_free)
+{
+    str_ct keys[256];
+    unsigned char bytes[256];
+    art_ct art2;
+    size_t k;
+
+    for(k = 0; k < 256; k++)
+    {
+        bytes[k]    = 255 - k;
+        keys[k]     = tstr_new_bs(&bytes[k], 1);
+    }
+
+    test_ptr_success(test_art_insert(art, 256));
+    test_ptr_success(art2 = art_new(ART_MODE_ORDERED));
+    test_int_success(art_bulk_load(art2, keys, NULL, 256));
+    test_uint_eq(art_size(art2), 256);
+    test_uint_eq(art_memsize(art2), art_memsize(art));
+    test_ptr_success(art_get(art2, BIN("\x80")));
+    test_void(art_free(art2));
+}
+
+TEST_CASE_FIX(art_bulk_load_optimistic, art_new_optimistic, art_free)
+{
+    str_ct keys[] = { LIT("http://example.com/foo/bat"), LIT("http://example.com/baz") };
+
+    test_void(art_clear(art));
+    test_int_success(art_bulk_load(art, keys, NULL, 2));
+    test_ptr_success(node   = art_get(art, LIT("http://example.com/foo/bat")));
+    test_ptr_success(key    = art_node_key(node));
+    test_str_eq(str_bc(key), "http://example.com/foo/bat");
+    test_void(str_unref(key));
+}
+
+TEST_CASE_FIX(art_bulk_load_invalid_key, art_new_empty, art_free)
+{
+    str_ct keys[] = { BIN("foo"), BIN("") };
+
+    test_int_error(art_bulk_load(art, keys, NULL, 2), E_ART_INVALID_KEY);
+    test_true(art_is_empty(art));
+}
+
+TEST_CASE_FIX(art_bulk_load_duplicate, art_new_empty, art_free)
+{
+    str_ct keys[] = { LIT("foo"), LIT("bar"), LIT("baz"), LIT("foo") };
+
+    test_int_error(art_bulk_load(art, keys, NULL, 4), E_ART_EXISTS);
+    test_true(art_is_empty(art));
+}
+
+TEST_CASE_FIX(art_bulk_load_prefix, art_new_empty, art_free)
+{
+    str_ct keys[] = { BIN("bar"), BIN("foobar"), BIN("foo") };
+
+    test_int_error(art_bulk_load(art, keys, NULL, 3), E_ART_EXISTS);
+    test_true(art_is_empty(art));
+}
+
+TEST_CASE_FIX(art_bulk_load_not_empty, art_new4, art_free)
+{
+    str_ct keys[] = { LIT("bar"), LIT("foo") };
+
+    test_int_success(art_bulk_load(art, keys, NULL, 2));
+    test_uint_eq(art_size(art), 6);
+    test_ptr_success(art_get(art, LIT("bar")));
+    test_int_error(art_bulk_load(art, keys, NULL, 2), E_ART_EXISTS);
+    test_uint_eq(art_size(art), 6);
+}
+
 static art_ct test_art_get(art_ct art, int size)
 {
     int k;
@@ -374,6 +657,139 @@ TEST_CASE_FIX(art_get256, art_new_empty, art_free)
     test_ptr_success(test_art_get(art, 256));
 }
 
+TEST_CASE_FIX(art_get_optimistic, art_new_optimistic, art_free)
+{
+    test_int_eq(art_get_value(art, LIT("http://example.com/foo/bar"), int), 1);
+    test_int_eq(art_get_value(art, LIT("http://example.com/foo/baz"), int), 2);
+    test_int_eq(art_get_value(art, LIT("http://example.com/bar"), int), 3);
+    test_int_eq(art_get_value(art, LIT("http://example.org/"), int), 4);
+}
+
+TEST_CASE_FIX(art_get_optimistic_not_found, art_new_optimistic, art_free)
+{
+    test_ptr_error(art_get(art, LIT("http://exAmple.com/foo/bar")), E_ART_NOT_FOUND);
+    test_ptr_error(art_get(art, LIT("http://example.com/foo/ba")), E_ART_NOT_FOUND);
+    test_ptr_error(art_get(art, LIT("http://example.com/foo/barbar")), E_ART_NOT_FOUND);
+    test_ptr_error(art_get(art, LIT("http")), E_ART_NOT_FOUND);
+}
+
+TEST_CASE_FIX(art_get_concurrent, art_new_concurrent, art_free)
+{
+    test_int_eq(art_get_value(art, LIT("http://example.com/foo/bar"), int), 1);
+    test_int_eq(art_get_value(art, LIT("http://example.com/foo/baz"), int), 2);
+    test_int_eq(art_get_value(art, LIT("http://example.com/bar"), int), 3);
+    test_int_eq(art_get_value(art, LIT("http://example.org/"), int), 4);
+    test_ptr_error(art_get(art, LIT("http://example.com/foo/barbar")), E_ART_NOT_FOUND);
+}
+
+TEST_CASE_ABORT(art_get_batch_invalid_magic)
+{
+    art_get_batch((art_ct)&not_an_art, NULL, 0, NULL);
+}
+
+TEST_CASE_FIX(art_get_batch, art_new4, art_free)
+{
+    str_const_ct keys[] = { LIT("xyz"), LIT("foo"), LIT("foobar"), BIN("foobaz"), LIT("fooduh"), LIT("foobarx"), LIT("foobaz") };
+    art_node_ct nodes[ELEMS(keys)];
+
+    test_uint_eq(art_get_batch(art, keys, ELEMS(keys), nodes), 4);
+    test_int_eq(art_node_value(nodes[0], int), 4);
+    test_ptr_eq(nodes[1], NULL);
+    test_int_eq(art_node_value(nodes[2], int), 1);
+    test_ptr_eq(nodes[3], NULL);
+    test_int_eq(art_node_value(nodes[4], int), 3);
+    test_ptr_eq(nodes[5], NULL);
+    test_int_eq(art_node_value(nodes[6], int), 2);
+}
+
+TEST_CASE_FIX(art_get_batch_optimistic, art_new_optimistic, art_free)
+{
+    str_const_ct keys[] = {
+        LIT("http://example.com/foo/bar"), LIT("http://exAmple.com/foo/bar"),
+        LIT("http://example.com/foo/ba"), LIT("http://example.org/"),
+        LIT("http://example.com/foo/barbar"), LIT("http")
+    };
+    art_node_ct nodes[ELEMS(keys)];
+
+    test_uint_eq(art_get_batch(art, keys, ELEMS(keys), nodes), 2);
+    test_int_eq(art_node_value(nodes[0], int), 1);
+    test_ptr_eq(nodes[1], NULL);
+    test_ptr_eq(nodes[2], NULL);
+    test_int_eq(art_node_value(nodes[3], int), 4);
+    test_ptr_eq(nodes[4], NULL);
+    test_ptr_eq(nodes[5], NULL);
+}
+
+TEST_CASE_FIX(art_get_batch_concurrent, art_new_concurrent, art_free)
+{
+    str_const_ct keys[] = { LIT("http://example.com/bar"), LIT("http://example.com/foo/barbar") };
+    art_node_ct nodes[ELEMS(keys)];
+
+    test_uint_eq(art_get_batch(art, keys, ELEMS(keys), nodes), 1);
+    test_int_eq(art_node_value(nodes[0], int), 3);
+    test_ptr_eq(nodes[1], NULL);
+}
+
+static bool test_art_get_batch(art_ct art, int size)
+{
+    str_ct keys[2 * size];
+    art_node_ct nodes[2 * size];
+    unsigned char c;
+    bool rc = true;
+    int k;
+
+    // every second key is missing
+    for(k = 0; k < 2 * size; k++)
+    {
+        c = k / 2;
+
+        if(!(keys[k] = k % 2 ? str_dup_b("\xff\xff", 2) : str_dup_b(&c, 1)))
+            return false;
+    }
+
+    if(art_get_batch(art, (const str_const_ct *)keys, 2 * size, nodes) != (size_t)size)
+        rc = false;
+
+    for(k = 0; k < 2 * size; k++)
+    {
+        if(k % 2 ? nodes[k] != NULL : !nodes[k] || art_node_value(nodes[k], int) != k / 2)
+            rc = false;
+
+        str_unref(keys[k]);
+    }
+
+    return rc;
+}
+
+TEST_CASE_FIX(art_get_batch256, art_new_empty, art_free)
+{
+    test_ptr_success(test_art_insert(art, 256));
+    test_true(test_art_get_batch(art, 256));
+}
+
+TEST_CASE_ABORT(art_set_invalid_magic)
+{
+    art_set((art_ct)&not_an_art, NULL, NULL);
+}
+
+TEST_CASE_FIX(art_set, art_new4, art_free)
+{
+    test_ptr_success(art_set_value(art, LIT("foobar"), 5));
+    test_ptr_success(art_set_value(art, LIT("foo"), 6));
+    test_uint_eq(art_size(art), 5);
+    test_int_eq(art_get_value(art, LIT("foobar"), int), 5);
+    test_int_eq(art_get_value(art, LIT("foo"), int), 6);
+}
+
+TEST_CASE_FIX(art_set_optimistic, art_new_optimistic, art_free)
+{
+    test_ptr_success(art_set_value(art, LIT("http://example.com/bar"), 5));
+    test_ptr_success(art_set_value(art, LIT("http://example.com/baz"), 6));
+    test_uint_eq(art_size(art), 5);
+    test_int_eq(art_get_value(art, LIT("http://example.com/bar"), int), 5);
+    test_int_eq(art_get_value(art, LIT("http://example.com/baz"), int), 6);
+}
+
 static void test_art_dtor(art_const_ct art, void *data, void *ctx)
 {
     int *count = ctx;
@@ -489,6 +905,264 @@ TEST_CASE_FIX(art_remove_merge, art_new4, art_free)
     test_void(str_unref(key));
 }
 
+TEST_CASE_FIX(art_remove_merge_inner, art_new4, art_free)
+{
+    test_int_success(art_remove_p(art, LIT("xyz")));
+    test_int_eq(art_get_value(art, LIT("foobar"), int), 1);
+    test_int_eq(art_get_value(art, LIT("foobaz"), int), 2);
+    test_int_eq(art_get_value(art, LIT("fooduh"), int), 3);
+}
+
+TEST_CASE_FIX(art_remove_optimistic, art_new_optimistic, art_free)
+{
+    test_int_success(art_remove_p(art, LIT("http://example.org/")));
+    test_int_success(art_remove_p(art, LIT("http://example.com/foo/bar")));
+    test_ptr_error(art_get(art, LIT("http://example.org/")), E_ART_NOT_FOUND);
+    test_ptr_success(node   = art_get(art, LIT("http://example.com/foo/baz")));
+    test_ptr_success(key    = art_node_key(node));
+    test_str_eq(str_bc(key), "http://example.com/foo/baz");
+    test_void(str_unref(key));
+}
+
+TEST_CASE_FIX(art_remove_concurrent, art_new_concurrent, art_free)
+{
+    test_int_success(art_remove_p(art, LIT("http://example.org/")));
+    test_int_success(art_remove_p(art, LIT("http://example.com/foo/bar")));
+    test_ptr_error(art_get(art, LIT("http://example.com/foo/bar")), E_ART_NOT_FOUND);
+    test_int_eq(art_get_value(art, LIT("http://example.com/foo/baz"), int), 2);
+    test_void(art_clear(art));
+    test_ptr_success(test_art_insert(art, 256));
+    test_rc_success(test_art_remove(art, 256), 256, -1);
+    test_uint_eq(art_size(art), 0);
+}
+
+static double test_art_bench_get(art_mode_id mode, size_t *memsize)
+{
+    clock_t start, end;
+    size_t k, r;
+
+    if(!(art = art_new(mode)))
+        return -1;
+
+    for(k = 0; k < BENCH_KEYS; k++)
+        if(!art_insert_value(art, bench_keys[k], k))
+            return art_free(art), -1;
+
+    start = clock();
+
+    for(r = 0; r < BENCH_ROUNDS; r++)
+        for(k = 0; k < BENCH_KEYS; k++)
+            if(!(node = art_get(art, bench_keys[k])) || art_node_value(node, size_t) != k)
+                return art_free(art), -1;
+
+    end         = clock();
+    *memsize    = art_memsize(art);
+
+    art_free(art);
+
+    return (double)(end - start) * 1e9 / CLOCKS_PER_SEC / (BENCH_KEYS * BENCH_ROUNDS);
+}
+
+TEST_CASE_FIX(art_bench_get, art_bench_new, art_bench_free)
+{
+    size_t memsize;
+    double ns;
+
+    test_true((ns = test_art_bench_get(ART_MODE_ORDERED, &memsize)) >= 0);
+    test_msg_info("ordered: %.1f ns/get, %zu bytes", ns, memsize);
+    test_true((ns = test_art_bench_get(ART_MODE_ORDERED | ART_MODE_OPTIMISTIC, &memsize)) >= 0);
+    test_msg_info("optimistic: %.1f ns/get, %zu bytes", ns, memsize);
+}
+
+TEST_CASE_FIX(art_bench_get_node64, art_bench_node64_new, art_bench_free)
+{
+    size_t memsize;
+    double ns;
+
+    test_true((ns = test_art_bench_get(ART_MODE_ORDERED, &memsize)) >= 0);
+    test_msg_info("ordered: %.1f ns/get, %zu bytes", ns, memsize);
+    test_true((ns = test_art_bench_get(ART_MODE_UNORDERED, &memsize)) >= 0);
+    test_msg_info("unordered: %.1f ns/get, %zu bytes", ns, memsize);
+}
+
+static double test_art_bench_get_batch(size_t batch)
+{
+    art_node_ct nodes[batch];
+    clock_t start;
+    size_t k, r, n;
+
+    start = clock();
+
+    for(r = 0; r < BENCH_ROUNDS; r++)
+        for(k = 0; k < BENCH_KEYS; k += n)
+        {
+            n = MIN(batch, BENCH_KEYS - k);
+
+            if(art_get_batch(art, (const str_const_ct *)&bench_keys[k], n, nodes) != n)
+                return -1;
+        }
+
+    return (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / (BENCH_KEYS * BENCH_ROUNDS);
+}
+
+TEST_CASE_FIX(art_bench_get_batch, art_bench_new, art_bench_free)
+{
+    double ns;
+
+    test_ptr_success(art = art_new(ART_MODE_ORDERED));
+    test_int_success(art_bulk_load(art, bench_keys, NULL, BENCH_KEYS));
+    test_true((ns = test_art_bench_get_batch(1)) >= 0);
+    test_msg_info("batch 1: %.1f ns/get", ns);
+    test_true((ns = test_art_bench_get_batch(16)) >= 0);
+    test_msg_info("batch 16: %.1f ns/get", ns);
+    test_true((ns = test_art_bench_get_batch(64)) >= 0);
+    test_msg_info("batch 64: %.1f ns/get", ns);
+
+    test_void(art_free(art));
+}
+
+static bool test_art_bench_stats(void)
+{
+    static const char *const names[] = { "leaf", "node4", "node8", "node16", "node32", "node64", "node128", "node256" };
+    art_stats_st stats;
+    char depth[256];
+    size_t k, len;
+
+    if(!(art = art_new(ART_MODE_ORDERED)))
+        return false;
+
+    if(art_bulk_load(art, bench_keys, NULL, BENCH_KEYS) || art_stats(art, &stats))
+        return art_free(art), false;
+
+    test_msg_info("%zu bytes, path %zu bytes, %zu on heap",
+        art_memsize(art), stats.path_bytes, stats.path_heap);
+    test_msg_info("%-8s %6zu nodes %9zu bytes",
+        names[ART_STATS_LEAF], stats.nodes[ART_STATS_LEAF], stats.memsize[ART_STATS_LEAF]);
+
+    for(k = ART_STATS_NODE4; k < ART_STATS_TYPES; k++)
+        if(stats.nodes[k])
+            test_msg_info("%-8s %6zu nodes %9zu bytes %5.1f%% full",
+                names[k], stats.nodes[k], stats.memsize[k], stats.fill[k] * 100);
+
+    for(k = 0, len = 0; k <= MIN(stats.depth_max, ART_STATS_DEPTH - 1U); k++)
+        len += snprintf(&depth[len], sizeof(depth) - MIN(len, sizeof(depth)), " %zu", stats.depth[k]);
+
+    test_msg_info("depth avg %.2f max %zu:%s", stats.depth_avg, stats.depth_max, depth);
+
+    art_free(art);
+
+    return true;
+}
+
+TEST_CASE_FIX(art_bench_stats_random, art_bench_random_new, art_bench_free)
+{
+    test_true(test_art_bench_stats());
+}
+
+TEST_CASE_FIX(art_bench_stats_sequential, art_bench_sequential_new, art_bench_free)
+{
+    test_true(test_art_bench_stats());
+}
+
+TEST_CASE_FIX(art_bench_stats_url, art_bench_new, art_bench_free)
+{
+    test_true(test_art_bench_stats());
+}
+
+static double test_art_bench_insert(art_mode_id mode, double *free_ns)
+{
+    clock_t start, end;
+    size_t k;
+
+    start = clock();
+
+    if(!(art = art_new(mode)))
+        return -1;
+
+    for(k = 0; k < BENCH_KEYS; k++)
+        if(!art_insert_value(art, bench_keys[k], k))
+            return art_free(art), -1;
+
+    end = clock();
+    art_free(art);
+
+    *free_ns    = (double)(clock() - end) * 1e9 / CLOCKS_PER_SEC / BENCH_KEYS;
+
+    return (double)(end - start) * 1e9 / CLOCKS_PER_SEC / BENCH_KEYS;
+}
+
+static int test_art_bench_key_cmp(const void *a, const void *b)
+{
+    return str_cmp(*(str_ct *)a, *(str_ct *)b);
+}
+
+static double test_art_bench_bulk_load(void)
+{
+    clock_t start, end;
+
+    start = clock();
+
+    if(!(art = art_new(ART_MODE_ORDERED)))
+        return -1;
+
+    if(art_bulk_load(art, bench_keys, NULL, BENCH_KEYS))
+        return art_free(art), -1;
+
+    end = clock();
+    art_free(art);
+
+    return (double)(end - start) * 1e9 / CLOCKS_PER_SEC / BENCH_KEYS;
+}
+
+TEST_CASE_FIX(art_bench_bulk_load, art_bench_new, art_bench_free)
+{
+    double ns, free_ns;
+
+    test_true((ns = test_art_bench_insert(ART_MODE_ORDERED, &free_ns)) >= 0);
+    test_msg_info("insert: %.1f ns/key", ns);
+    test_true((ns = test_art_bench_bulk_load()) >= 0);
+    test_msg_info("bulk load unsorted: %.1f ns/key", ns);
+    test_void(qsort(bench_keys, BENCH_KEYS, sizeof(str_ct), test_art_bench_key_cmp));
+    test_true((ns = test_art_bench_bulk_load()) >= 0);
+    test_msg_info("bulk load sorted: %.1f ns/key", ns);
+}
+
+TEST_CASE_FIX(art_bench_insert, art_bench_new, art_bench_free)
+{
+    double ns, free_ns;
+
+    test_true((ns = test_art_bench_insert(ART_MODE_ORDERED, &free_ns)) >= 0);
+    test_msg_info("malloc: %.1f ns/insert, %.1f ns/free", ns, free_ns);
+    test_true((ns = test_art_bench_insert(ART_MODE_ORDERED | ART_MODE_SLAB, &free_ns)) >= 0);
+    test_msg_info("slab: %.1f ns/insert, %.1f ns/free", ns, free_ns);
+}
+
+TEST_CASE_FIX(art_remove_slab, art_new_slab, art_free)
+{
+    test_ptr_success(test_art_insert(art, 256));
+    test_rc_success(test_art_remove(art, 256), 256, -1);
+    test_uint_eq(art_size(art), 0);
+    test_ptr_success(test_art_insert(art, 256));
+    test_ptr_success(test_art_get(art, 256));
+}
+
+TEST_CASE_FIX(art_clear_slab, art_new_slab, art_free)
+{
+    test_ptr_success(test_art_insert(art, 256));
+    test_void(art_clear(art));
+    test_true(art_is_empty(art));
+    test_ptr_success(test_art_insert(art, 16));
+    test_ptr_success(test_art_get(art, 16));
+}
+
+TEST_CASE_FIX(art_clear_slab_heap, art_new_slab, art_free)
+{
+    test_ptr_success(art_insert(art, LIT("http://example.com/foo/bar"), NULL));
+    test_ptr_success(art_insert(art, LIT("http://example.com/foo/baz"), NULL));
+    test_void(art_clear(art));
+    test_true(art_is_empty(art));
+}
+
 static bool test_art_pred_value(art_const_ct art, str_const_ct key, const void *data, void *ctx)
 {
     int value1 = POINTER_TO_VALUE(data, int), value2 = POINTER_TO_VALUE(ctx, int);
@@ -699,6 +1373,126 @@ TEST_CASE_FIX(art_find_prk, art_new4, art_free)
     test_int_eq(art_node_value(node, int), 1);
 }
 
+TEST_CASE_FIX(art_find_p_concurrent, art_new_concurrent, art_free)
+{
+    test_ptr_success(node   = art_find_p(art, BIN("http://example.com/foo/"), test_art_pred_value, VALUE_TO_POINTER(2)));
+    test_ptr_success(key    = art_node_key(node));
+    test_str_eq(str_bc(key), "http://example.com/foo/baz");
+    test_void(str_unref(key));
+    test_int_eq(art_find_value_pk(art, BIN("http://example.com/"), test_art_pred_key, "http://example.com/bar", int), 3);
+    test_ptr_error(art_find_p(art, BIN("http://example.com/fox/"), test_art_pred_value, VALUE_TO_POINTER(2)), E_ART_NOT_FOUND);
+    test_ptr_error(art_find_p(art, BIN("http://example.net/"), test_art_pred_value, VALUE_TO_POINTER(4)), E_ART_NOT_FOUND);
+}
+
+/// concurrency stress test state
+typedef struct test_art_stress
+{
+    atomic_bool done;       ///< writer finished
+    atomic_size_t errors;   ///< number of reader errors
+    atomic_size_t reads;    ///< number of reads
+} test_art_stress_st;
+
+static void *test_art_stress_reader(void *ctx)
+{
+    test_art_stress_st *state = ctx;
+    size_t k, reads = 0;
+
+    while(!atomic_load(&state->done))
+    {
+        for(k = 0; k < STRESS_KEYS; k++, reads++)
+        {
+            if(art_get_value(art, stress_keys[k], size_t) != k + 1)
+                atomic_fetch_add(&state->errors, 1);
+
+            if(  !(k % 50)
+              && art_find_value_p(art, stress_keys[k], test_art_pred_value, VALUE_TO_POINTER(k + 1), size_t) != k + 1)
+                atomic_fetch_add(&state->errors, 1);
+        }
+    }
+
+    atomic_fetch_add(&state->reads, reads);
+
+    return NULL;
+}
+
+static bool test_art_stress_insert(void)
+{
+    size_t k;
+
+    for(k = 0; k < STRESS_KEYS; k++)
+        if(  !(stress_keys[k] = str_dup_f("stable/%zu", k))
+          || !art_insert_value(art, stress_keys[k], k + 1))
+            return false;
+
+    return true;
+}
+
+static bool test_art_stress_write(void)
+{
+    size_t r, k;
+    str_ct key;
+    bool rc;
+
+    for(r = 0; r < STRESS_ROUNDS; r++)
+    {
+        // split, grow, shrink and merge nodes along stable keys
+        for(k = 0; k < STRESS_KEYS; k++)
+        {
+            if(!(key = str_dup_f("stable/%zu/%zu", k, r)))
+                return false;
+
+            rc = !!art_insert(art, key, NULL);
+            str_unref(key);
+
+            if(!rc)
+                return false;
+        }
+
+        for(k = 0; k < STRESS_KEYS; k++)
+        {
+            if(!(key = str_dup_f("stable/%zu/%zu", k, r)))
+                return false;
+
+            rc = !art_remove_p(art, key);
+            str_unref(key);
+
+            if(!rc)
+                return false;
+        }
+    }
+
+    return true;
+}
+
+TEST_CASE(art_concurrent_stress)
+{
+    test_art_stress_st state = { .done = false };
+    pthread_t readers[STRESS_READERS];
+    size_t k;
+    bool rc;
+
+    test_ptr_success(art = art_new(ART_MODE_UNORDERED | ART_MODE_CONCURRENT));
+    test_true(test_art_stress_insert());
+
+    for(k = 0; k < STRESS_READERS; k++)
+        test_int_eq(pthread_create(&readers[k], NULL, test_art_stress_reader, &state), 0);
+
+    rc = test_art_stress_write();
+    atomic_store(&state.done, true);
+
+    for(k = 0; k < STRESS_READERS; k++)
+        test_int_eq(pthread_join(readers[k], NULL), 0);
+
+    test_true(rc);
+    test_uint_eq(atomic_load(&state.errors), 0);
+    test_uint_eq(art_size(art), STRESS_KEYS);
+    test_msg_info("%zu reads during %d writer rounds", atomic_load(&state.reads), STRESS_ROUNDS);
+    test_void(art_free(art));
+
+    for(k = 0; k < STRESS_KEYS; k++)
+        str_unref(stress_keys[k]);
+}
+
 static int test_art_fold_value(art_const_ct art, str_const_ct key, void *data, void *ctx)
 {
     int *sum = ctx;
@@ -911,6 +1705,346 @@ TEST_CASE_FIX(art_complete_end, art_new4, art_free)
     test_void(str_unref(key));
 }
 
+TEST_CASE_ABORT(art_freeze_invalid_magic)
+{
+    art_freeze((art_ct)&not_an_art, LIT(IMAGE_FILE));
+}
+
+TEST_CASE_FIX(art_freeze_invalid_file, art_new4, art_free)
+{
+    test_int_error(art_freeze(art, LIT("nonexistent/" IMAGE_FILE)), E_ART_FILE);
+}
+
+TEST_CASE(art_open_mmap_invalid_file)
+{
+    test_ptr_error(art_open_mmap(LIT("nonexistent/" IMAGE_FILE)), E_ART_FILE);
+}
+
+TEST_CASE(art_open_mmap_invalid_image)
+{
+    FILE *fp;
+
+    test_ptr_success(fp = fopen(IMAGE_FILE, "wb"));
+    test_int_success(fputs("this is no ART image, just some text", fp));
+    test_int_success(fclose(fp));
+    test_ptr_error(art_open_mmap(LIT(IMAGE_FILE)), E_ART_IMAGE);
+    test_int_success(remove(IMAGE_FILE));
+}
+
+TEST_CASE(art_open_mmap_empty)
+{
+    test_ptr_success(art = art_new(ART_MODE_ORDERED));
+    test_int_success(art_freeze(art, LIT(IMAGE_FILE)));
+    test_void(art_free(art));
+    test_ptr_success(art = art_open_mmap(LIT(IMAGE_FILE)));
+    test_true(art_is_empty(art));
+    test_ptr_error(art_get(art, LIT("foo")), E_ART_NOT_FOUND);
+    test_ptr_error(art_find_p(art, LIT("foo"), test_art_pred_value, NULL), E_ART_NOT_FOUND);
+    test_ptr_error(art_complete(art, NULL), E_ART_EMPTY);
+    test_void(art_free(art));
+    test_int_success(remove(IMAGE_FILE));
+}
+
+TEST_CASE_FIX(art_frozen_get, art_new_frozen, art_free_frozen)
+{
+    test_uint_eq(art_size(art), 4);
+    test_int_eq(art_get_value(art, LIT("foobar"), int), 1);
+    test_int_eq(art_get_value(art, LIT("foobaz"), int), 2);
+    test_int_eq(art_get_value(art, LIT("fooduh"), int), 3);
+    test_int_eq(art_get_value(art, LIT("xyz"), int), 4);
+    test_ptr_error(art_get(art, LIT("foo")), E_ART_NOT_FOUND);
+    test_ptr_error(art_get(art, LIT("foobarx")), E_ART_NOT_FOUND);
+    test_ptr_error(art_get(art, BIN("foobar")), E_ART_NOT_FOUND);
+    test_ptr_success(node = art_get(art, LIT("fooduh")));
+    test_ptr_success(key = art_node_key(node));
+    test_str_eq(str_bc(key), "fooduh");
+    test_void(str_unref(key));
+}
+
+TEST_CASE_FIX(art_frozen_find_p, art_new_frozen, art_free_frozen)
+{
+    test_ptr_error(art_find_p(art, LIT("bar"), test_art_pred_value, VALUE_TO_POINTER(1)), E_ART_NOT_FOUND);
+    test_ptr_error(art_find_p(art, BIN("foo"), test_art_pred_value, VALUE_TO_POINTER(4)), E_ART_NOT_FOUND);
+    test_ptr_success(node = art_find_p(art, BIN("foo"), test_art_pred_value, VALUE_TO_POINTER(3)));
+    test_int_eq(art_node_value(node, int), 3);
+    test_int_eq(art_find_value_pk(art, BIN("foob"), test_art_pred_key, "foobaz", int), 2);
+}
+
+TEST_CASE_FIX(art_frozen_fold, art_new_frozen, art_free_frozen)
+{
+    int sum = 0;
+
+    test_int_success(art_fold(art, test_art_fold_value, &sum));
+    test_int_eq(sum, 1234);
+    sum = 0;
+    test_int_success(art_fold_pr(art, BIN("foo"), test_art_fold_value, &sum));
+    test_int_eq(sum, 321);
+}
+
+TEST_CASE_FIX(art_frozen_complete, art_new_frozen, art_free_frozen)
+{
+    test_ptr_error(art_complete(art, BIN("blubb")), E_ART_NOT_FOUND);
+    test_ptr_success(key = art_complete(art, BIN("fo")));
+    test_str_eq(str_bc(key), "o");
+    test_void(str_unref(key));
+    test_ptr_success(key = art_complete(art, BIN("foob")));
+    test_str_eq(str_bc(key), "a");
+    test_void(str_unref(key));
+    test_ptr_success(key = art_complete(art, BIN("x")));
+    test_str_eq(str_bc(key), "yz");
+    test_void(str_unref(key));
+    test_ptr_success(key = art_complete(art, NULL));
+    test_true(str_is_empty(key));
+    test_void(str_unref(key));
+}
+
+TEST_CASE_FIX(art_frozen_modify, art_new_frozen, art_free_frozen)
+{
+    test_ptr_error(art_insert(art, LIT("bar"), NULL), E_ART_FROZEN);
+    test_ptr_error(art_set(art, LIT("foobar"), NULL), E_ART_FROZEN);
+    test_int_error(art_remove_p(art, LIT("foo")), E_ART_FROZEN);
+    test_ptr_error(art_iter_new(art, NULL, NULL), E_ART_FROZEN);
+}
+
+TEST_CASE_FIX(art_frozen_clear, art_new_frozen, art_free_frozen)
+{
+    test_void(art_clear(art));
+    test_true(art_is_empty(art));
+    test_ptr_success(art_insert_value(art, LIT("bar"), 5));
+    test_int_eq(art_get_value(art, LIT("bar"), int), 5);
+}
+
+TEST_CASE_FIX(art_freeze_frozen, art_new_frozen, art_free_frozen)
+{
+    art_ct art2;
+
+    test_int_success(art_freeze(art, LIT(IMAGE_FILE ".2")));
+    test_ptr_success(art2 = art_open_mmap(LIT(IMAGE_FILE ".2")));
+    test_uint_eq(art_memsize(art2), art_memsize(art));
+    test_int_eq(art_get_value(art2, LIT("fooduh"), int), 3);
+    test_void(art_free(art2));
+    test_int_success(remove(IMAGE_FILE ".2"));
+}
+
+static bool test_art_frozen_get(art_ct art, int size)
+{
+    int k;
+
+    key = tstr_dup_bl("x");
+
+    for(k = 0; k < size; k++)
+    {
+        str_overwrite_f(key, 0, "%c", k);
+
+        if(art_get_value(art, key, int) != k)
+            return false;
+    }
+
+    return true;
+}
+
+TEST_CASE_FIX(art_freeze_node_types, art_new_empty, art_free)
+{
+    int size[] = { 4, 64, 256 };
+    size_t i;
+
+    for(i = 0; i < ELEMS(size); i++)
+    {
+        test_void(art_clear(art));
+        test_ptr_success(test_art_insert(art, size[i]));
+        test_int_success(art_freeze(art, LIT(IMAGE_FILE)));
+        test_void(art_free(art));
+        test_ptr_success(art = art_open_mmap(LIT(IMAGE_FILE)));
+        test_uint_eq(art_size(art), size[i]);
+        test_true(test_art_frozen_get(art, size[i]));
+        test_int_success(remove(IMAGE_FILE));
+    }
+}
+
+TEST_CASE_ABORT(art_iter_new_invalid_magic)
+{
+    art_iter_new((art_ct)&not_an_art, NULL, NULL);
+}
+
+TEST_CASE_FIX(art_iter_next_empty, art_new_empty, art_free)
+{
+    test_ptr_success(iter = art_iter_new(art, NULL, NULL));
+    test_ptr_error(art_iter_next(iter), E_ART_NOT_FOUND);
+    test_ptr_error(art_iter_prev(iter), E_ART_NOT_FOUND);
+    test_ptr_error(art_iter_key(iter), E_ART_NOT_FOUND);
+    test_void(art_iter_free(iter));
+}
+
+TEST_CASE_FIX(art_iter_next, art_new4, art_free)
+{
+    test_ptr_success(iter = art_iter_new(art, NULL, NULL));
+    test_ptr_success(node = art_iter_next(iter));
+    test_int_eq(art_node_value(node, int), 1);
+    test_str_eq(str_bc(art_iter_key(iter)), "foobar");
+    test_ptr_success(node = art_iter_next(iter));
+    test_int_eq(art_node_value(node, int), 2);
+    test_str_eq(str_bc(art_iter_key(iter)), "foobaz");
+    test_ptr_success(node = art_iter_next(iter));
+    test_int_eq(art_node_value(node, int), 3);
+    test_str_eq(str_bc(art_iter_key(iter)), "fooduh");
+    test_ptr_success(node = art_iter_next(iter));
+    test_int_eq(art_node_value(node, int), 4);
+    test_str_eq(str_bc(art_iter_key(iter)), "xyz");
+    test_ptr_error(art_iter_next(iter), E_ART_NOT_FOUND);
+    test_ptr_error(art_iter_key(iter), E_ART_NOT_FOUND);
+    test_void(art_iter_free(iter));
+}
+
+TEST_CASE_FIX(art_iter_prev, art_new4, art_free)
+{
+    test_ptr_success(iter = art_iter_new(art, NULL, NULL));
+    test_ptr_success(node = art_iter_prev(iter));
+    test_int_eq(art_node_value(node, int), 4);
+    test_ptr_success(node = art_iter_prev(iter));
+    test_int_eq(art_node_value(node, int), 3);
+    test_ptr_success(node = art_iter_prev(iter));
+    test_int_eq(art_node_value(node, int), 2);
+    test_ptr_success(node = art_iter_next(iter));
+    test_int_eq(art_node_value(node, int), 3);
+    test_ptr_success(node = art_iter_prev(iter));
+    test_ptr_success(node = art_iter_prev(iter));
+    test_int_eq(art_node_value(node, int), 1);
+    test_ptr_error(art_iter_prev(iter), E_ART_NOT_FOUND);
+    test_void(art_iter_free(iter));
+}
+
+TEST_CASE_FIX(art_iter_seek, art_new4, art_free)
+{
+    test_ptr_success(iter = art_iter_new(art, NULL, NULL));
+    test_ptr_success(node = art_iter_seek(iter, LIT("foobaz")));
+    test_int_eq(art_node_value(node, int), 2);
+    test_ptr_success(node = art_iter_seek(iter, BIN("foob")));
+    test_int_eq(art_node_value(node, int), 1);
+    test_ptr_success(node = art_iter_seek(iter, LIT("foobb")));
+    test_int_eq(art_node_value(node, int), 3);
+    test_ptr_success(node = art_iter_seek(iter, LIT("g")));
+    test_int_eq(art_node_value(node, int), 4);
+    test_ptr_error(art_iter_seek(iter, LIT("xyzz")), E_ART_NOT_FOUND);
+    test_ptr_success(node = art_iter_seek(iter, NULL));
+    test_int_eq(art_node_value(node, int), 1);
+    test_void(art_iter_free(iter));
+}
+
+TEST_CASE_FIX(art_iter_range, art_new4, art_free)
+{
+    test_ptr_success(iter = art_iter_new(art, LIT("foobaz"), LIT("xyz")));
+    test_ptr_success(node = art_iter_seek(iter, LIT("a")));
+    test_int_eq(art_node_value(node, int), 2);
+    test_ptr_success(node = art_iter_next(iter));
+    test_int_eq(art_node_value(node, int), 3);
+    test_ptr_error(art_iter_next(iter), E_ART_NOT_FOUND);
+    test_ptr_success(node = art_iter_prev(iter));
+    test_int_eq(art_node_value(node, int), 3);
+    test_ptr_success(node = art_iter_prev(iter));
+    test_int_eq(art_node_value(node, int), 2);
+    test_ptr_error(art_iter_prev(iter), E_ART_NOT_FOUND);
+    test_void(art_iter_free(iter));
+}
+
+TEST_CASE(art_iter_unordered)
+{
+    test_ptr_success(art = art_new(ART_MODE_UNORDERED));
+    test_ptr_success(art_insert_value(art, LIT("fooduh"), 3));
+    test_ptr_success(art_insert_value(art, LIT("xyz"), 4));
+    test_ptr_success(art_insert_value(art, LIT("foobaz"), 2));
+    test_ptr_success(art_insert_value(art, LIT("foobar"), 1));
+    test_ptr_success(iter = art_iter_new(art, NULL, NULL));
+    test_ptr_success(node = art_iter_next(iter));
+    test_int_eq(art_node_value(node, int), 1);
+    test_ptr_success(node = art_iter_next(iter));
+    test_int_eq(art_node_value(node, int), 2);
+    test_ptr_success(node = art_iter_next(iter));
+    test_int_eq(art_node_value(node, int), 3);
+    test_ptr_success(node = art_iter_next(iter));
+    test_int_eq(art_node_value(node, int), 4);
+    test_ptr_error(art_iter_next(iter), E_ART_NOT_FOUND);
+    test_void(art_iter_free(iter));
+    test_void(art_free(art));
+}
+
+static bool test_art_iter_walk(art_iter_ct iter, int size, bool reverse)
+{
+    int k;
+
+    for(k = 0; k < size; k++)
+    {
+        if(!(node = reverse ? art_iter_prev(iter) : art_iter_next(iter)))
+            return false;
+
+        if(art_node_value(node, int) != (reverse ? size - 1 - k : k))
+            return false;
+    }
+
+    return !(reverse ? art_iter_prev(iter) : art_iter_next(iter));
+}
+
+TEST_CASE_FIX(art_iter256, art_new_empty, art_free)
+{
+    test_ptr_success(test_art_insert(art, 256));
+    test_ptr_success(iter = art_iter_new(art, NULL, NULL));
+    test_true(test_art_iter_walk(iter, 256, false));
+    test_true(test_art_iter_walk(iter, 256, true));
+    test_void(art_iter_free(iter));
+}
+
+static bool test_art_node64(art_mode_id mode, int size)
+{
+    art_iter_ct iter;
+    int k, prev = -1, count = 0;
+    bool rc;
+
+    if(!(art = art_new(mode)))
+        return false;
+
+    key = tstr_dup_bl("x");
+
+    for(k = size - 1; k >= 0; k--)
+    {
+        str_overwrite_f(key, 0, "%c", k);
+
+        if(!art_insert_value(art, key, k))
+            return art_free(art), false;
+    }
+
+    for(k = 0; k < size; k += 3)
+    {
+        str_overwrite_f(key, 0, "%c", k);
+
+        if(art_remove_p(art, key))
+            return art_free(art), false;
+    }
+
+    if(!(iter = art_iter_new(art, NULL, NULL)))
+        return art_free(art), false;
+
+    for(rc = true; rc && (node = art_iter_next(iter)); prev = k, count++)
+        rc = (k = art_node_value(node, int)) > prev && k % 3;
+
+    art_iter_free(iter);
+    art_free(art);
+
+    return rc && count == size - (size + 2) / 3;
+}
+
+TEST_CASE(art_node64_ordered)
+{
+    test_true(test_art_node64(ART_MODE_ORDERED, 48));
+    test_true(test_art_node64(ART_MODE_ORDERED, 100));
+    test_true(test_art_node64(ART_MODE_ORDERED, 160));
+}
+
+TEST_CASE(art_node64_unordered)
+{
+    test_true(test_art_node64(ART_MODE_UNORDERED, 48));
+    test_true(test_art_node64(ART_MODE_UNORDERED, 100));
+    test_true(test_art_node64(ART_MODE_UNORDERED, 160));
+}
+
 int test_suite_con_art(void *param)
 {
     return error_pass_int(test_run_cases("art",
@@ -922,6 +2056,12 @@ int test_suite_con_art(void *param)
         test_case(art_size),
         test_case(art_memsize_invalid_magic),
         test_case(art_memsize),
+        test_case(art_memsize_slab),
+        test_case(art_stats_invalid_magic),
+        test_case(art_stats_empty),
+        test_case(art_stats),
+        test_case(art_stats256),
+        test_case(art_stats_frozen),
 
         test_case(art_insert_invalid_magic),
         test_case(art_insert_invalid_key),
@@ -944,6 +2084,16 @@ int test_suite_con_art(void *param)
         test_case(art_insert_large_key_split_front),
         test_case(art_insert_large_key_split_center),
         test_case(art_insert_large_key_split_back),
+        test_case(art_insert_optimistic_key),
+
+        test_case(art_bulk_load_invalid_magic),
+        test_case(art_bulk_load),
+        test_case(art_bulk_load256),
+        test_case(art_bulk_load_optimistic),
+        test_case(art_bulk_load_invalid_key),
+        test_case(art_bulk_load_duplicate),
+        test_case(art_bulk_load_prefix),
+        test_case(art_bulk_load_not_empty),
 
         test_case(art_get_invalid_magic),
         test_case(art_get0_not_found),
@@ -956,6 +2106,18 @@ int test_suite_con_art(void *param)
         test_case(art_get64),
         test_case(art_get128),
         test_case(art_get256),
+        test_case(art_get_optimistic),
+        test_case(art_get_optimistic_not_found),
+        test_case(art_get_concurrent),
+        test_case(art_get_batch_invalid_magic),
+        test_case(art_get_batch),
+        test_case(art_get_batch_optimistic),
+        test_case(art_get_batch_concurrent),
+        test_case(art_get_batch256),
+
+        test_case(art_set_invalid_magic),
+        test_case(art_set),
+        test_case(art_set_optimistic),
 
         test_case(art_remove_invalid_magic),
         test_case(art_remove_p_invalid_magic),
@@ -971,6 +2133,21 @@ int test_suite_con_art(void *param)
         test_case(art_remove128),
         test_case(art_remove256),
         test_case(art_remove_merge),
+        test_case(art_remove_merge_inner),
+        test_case(art_remove_optimistic),
+        test_case(art_remove_concurrent),
+        test_case(art_remove_slab),
+        test_case(art_clear_slab),
+        test_case(art_clear_slab_heap),
+
+        test_case(art_bench_get),
+        test_case(art_bench_get_node64),
+        test_case(art_bench_get_batch),
+        test_case(art_bench_insert),
+        test_case(art_bench_bulk_load),
+        test_case(art_bench_stats_random),
+        test_case(art_bench_stats_sequential),
+        test_case(art_bench_stats_url),
 
         test_case(art_find_invalid_magic),
         test_case(art_find_invalid_pred),
@@ -1009,6 +2186,8 @@ int test_suite_con_art(void *param)
         test_case(art_find_prk_prefix_not_found),
         test_case(art_find_prk_key_not_found),
         test_case(art_find_prk),
+        test_case(art_find_p_concurrent),
+        test_case(art_concurrent_stress),
 
         test_case(art_fold_invalid_magic),
         test_case(art_fold_invalid_callback),
@@ -1047,6 +2226,32 @@ int test_suite_con_art(void *param)
         test_case(art_complete_begin),
         test_case(art_complete_end),
 
+        test_case(art_freeze_invalid_magic),
+        test_case(art_freeze_invalid_file),
+        test_case(art_open_mmap_invalid_file),
+        test_case(art_open_mmap_invalid_image),
+        test_case(art_open_mmap_empty),
+        test_case(art_frozen_get),
+        test_case(art_frozen_find_p),
+        test_case(art_frozen_fold),
+        test_case(art_frozen_complete),
+        test_case(art_frozen_modify),
+        test_case(art_frozen_clear),
+        test_case(art_freeze_frozen),
+        test_case(art_freeze_node_types),
+
+        test_case(art_iter_new_invalid_magic),
+        test_case(art_iter_next_empty),
+        test_case(art_iter_next),
+        test_case(art_iter_prev),
+        test_case(art_iter_seek),
+        test_case(art_iter_range),
+        test_case(art_iter_unordered),
+        test_case(art_iter256),
+
+        test_case(art_node64_ordered),
+        test_case(art_node64_unordered),
+
         NULL
     ));
 }
@@ -28,7 +28,10 @@ int test_suite_con(void *param)
 {
     return error_pass_int(test_run_suites("con",
         test_suite(con_art),
+        test_suite(con_deque),
         test_suite(con_list),
+        test_suite(con_lru),
+        test_suite(con_map),
         test_suite(con_ring),
         test_suite(con_vec),
         NULL
@@ -26,7 +26,10 @@
 
 int test_suite_con(void *param);
 int test_suite_con_art(void *param);
+int test_suite_con_deque(void *param);
 int test_suite_con_list(void *param);
+int test_suite_con_lru(void *param);
+int test_suite_con_map(void *param);
 int test_suite_con_ring(void *param);
 int test_suite_con_vec(void *param);
 
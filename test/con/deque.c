@@ -0,0 +1,589 @@
+/*
+ * Copyright (c) 2026 Martin Rödel a.k.a. Yomin Nimoy
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "cont.h"
+#include <ytil/test/run.h>
+#include <ytil/test/test.h>
+#include <ytil/con/deque.h>
+#include <ytil/con/list.h>
+#include <ytil/con/vec.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define MODEL_OPS       20000   ///< number of random operations in model test
+#define BENCH_ELEMS     10000   ///< number of elements in benchmarks
+
+static const struct not_a_deque
+{
+    int foo;
+} not_a_deque = { 123 };
+
+static const int i[] = { 1, 2, 3, 4 };
+static deque_ct deque;
+static int count;
+static uint64_t seed = 88172645463325252ULL;
+
+
+TEST_SETUP(deque_new)
+{
+    test_ptr_success(deque = deque_new_c(8, sizeof(int)));
+    test_ptr_success(deque_push_e(deque, &i[0]));
+    test_ptr_success(deque_push_e(deque, &i[1]));
+    test_ptr_success(deque_push_e(deque, &i[2]));
+    test_ptr_success(deque_push_e(deque, &i[3]));
+}
+
+TEST_SETUP(deque_new_empty)
+{
+    test_ptr_success(deque = deque_new_c(8, sizeof(int)));
+}
+
+TEST_TEARDOWN(deque_free)
+{
+    test_void(deque_free(deque));
+}
+
+static uint64_t test_deque_rand(void)
+{
+    seed ^= seed << 13;
+    seed ^= seed >> 7;
+    seed ^= seed << 17;
+
+    return seed;
+}
+
+static void test_deque_dtor(deque_const_ct deque, void *elem, void *ctx)
+{
+    int *count = ctx;
+
+    count[0] += *(int *)elem;
+}
+
+TEST_CASE(deque_new_chunksize)
+{
+    test_ptr_success(deque = deque_new_c(100, sizeof(int)));
+    test_uint_eq(deque_chunksize(deque), 128);
+    test_uint_eq(deque_elemsize(deque), sizeof(int));
+    test_true(deque_is_empty(deque));
+    test_void(deque_free(deque));
+
+    test_ptr_success(deque = deque_new(sizeof(int)));
+    test_uint_eq(deque_chunksize(deque), 1024);
+    test_void(deque_free(deque));
+}
+
+TEST_CASE_ABORT(deque_free_invalid_magic)
+{
+    deque_free((deque_ct)&not_a_deque);
+}
+
+TEST_CASE_FIX(deque_free_f, deque_new, no_teardown)
+{
+    count = 0;
+    test_void(deque_free_f(deque, test_deque_dtor, &count));
+    test_int_eq(count, 10);
+}
+
+TEST_CASE_FIX(deque_clear_f, deque_new, deque_free)
+{
+    count = 0;
+    test_void(deque_clear_f(deque, test_deque_dtor, &count));
+    test_int_eq(count, 10);
+    test_true(deque_is_empty(deque));
+    test_ptr_success(deque_push_front_e(deque, &i[2]));
+    test_int_eq(*(int *)deque_first(deque), 3);
+}
+
+TEST_CASE_FIX(deque_memsize, deque_new, deque_free)
+{
+    test_uint_gt(deque_memsize(deque), 8 * sizeof(int));
+}
+
+TEST_CASE_FIX(deque_at_oob, deque_new, deque_free)
+{
+    test_ptr_error(deque_at(deque, 4), E_DEQUE_OUT_OF_BOUNDS);
+    test_ptr_error(deque_at(deque, -5), E_DEQUE_OUT_OF_BOUNDS);
+}
+
+TEST_CASE_FIX(deque_at, deque_new, deque_free)
+{
+    test_int_eq(*(int *)deque_at(deque, 0), 1);
+    test_int_eq(*(int *)deque_at(deque, 3), 4);
+    test_int_eq(*(int *)deque_at(deque, -1), 4);
+    test_int_eq(*(int *)deque_at(deque, -4), 1);
+}
+
+TEST_CASE_FIX(deque_first_empty, deque_new_empty, deque_free)
+{
+    test_ptr_error(deque_first(deque), E_DEQUE_EMPTY);
+    test_ptr_error(deque_last(deque), E_DEQUE_EMPTY);
+}
+
+TEST_CASE_FIX(deque_get, deque_new, deque_free)
+{
+    int value;
+
+    test_int_success(deque_get(deque, &value, 2));
+    test_int_eq(value, 3);
+    test_int_error(deque_get(deque, &value, 4), E_DEQUE_OUT_OF_BOUNDS);
+}
+
+TEST_CASE_FIX(deque_push_front, deque_new_empty, deque_free)
+{
+    int k;
+
+    for(k = 0; k < 20; k++)
+        if(!deque_push_front_e(deque, &k))
+            break;
+
+    test_int_eq(k, 20);
+    test_uint_eq(deque_size(deque), 20);
+    test_int_eq(*(int *)deque_first(deque), 19);
+    test_int_eq(*(int *)deque_last(deque), 0);
+    test_int_eq(*(int *)deque_at(deque, 7), 12);
+    test_int_eq(*(int *)deque_at(deque, 8), 11);
+}
+
+TEST_CASE_FIX(deque_push_pointer_stable, deque_new_empty, deque_free)
+{
+    int *first, k;
+
+    test_ptr_success(first = deque_push_e(deque, &i[0]));
+
+    for(k = 0; k < 50; k++)
+        if(!deque_push_e(deque, &k) || !deque_push_front_e(deque, &k))
+            break;
+
+    test_int_eq(k, 50);
+    test_ptr_eq(deque_at(deque, 50), first);
+    test_int_eq(*first, 1);
+}
+
+TEST_CASE_FIX(deque_pop_empty, deque_new_empty, deque_free)
+{
+    test_int_error(deque_pop(deque), E_DEQUE_EMPTY);
+    test_int_error(deque_pop_front(deque), E_DEQUE_EMPTY);
+}
+
+TEST_CASE_FIX(deque_pop, deque_new, deque_free)
+{
+    int value;
+
+    test_int_success(deque_pop_e(deque, &value));
+    test_int_eq(value, 4);
+    test_int_success(deque_pop_front_e(deque, &value));
+    test_int_eq(value, 1);
+    test_uint_eq(deque_size(deque), 2);
+    test_int_eq(*(int *)deque_first(deque), 2);
+    test_int_eq(*(int *)deque_last(deque), 3);
+}
+
+TEST_CASE_FIX(deque_pop_f, deque_new, deque_free)
+{
+    count = 0;
+    test_int_success(deque_pop_f(deque, test_deque_dtor, &count));
+    test_int_success(deque_pop_front_f(deque, test_deque_dtor, &count));
+    test_int_eq(count, 5);
+}
+
+TEST_CASE(deque_pointer)
+{
+    test_ptr_success(deque = deque_new(sizeof(void *)));
+    test_ptr_success(deque_push_p(deque, &i[1]));
+    test_ptr_success(deque_push_front_p(deque, &i[0]));
+    test_ptr_success(deque_insert_p(deque, 1, &i[2]));
+    test_ptr_eq(deque_at_p(deque, 1), &i[2]);
+    test_ptr_eq(deque_remove_at_p(deque, 1), &i[2]);
+    test_ptr_eq(deque_pop_front_p(deque), &i[0]);
+    test_ptr_eq(deque_pop_p(deque), &i[1]);
+    test_void(deque_free(deque));
+}
+
+TEST_CASE_FIX(deque_insert_oob, deque_new, deque_free)
+{
+    test_ptr_error(deque_insert(deque, 5), E_DEQUE_OUT_OF_BOUNDS);
+}
+
+TEST_CASE_FIX(deque_insert, deque_new, deque_free)
+{
+    int value = 5;
+
+    test_ptr_success(deque_insert_e(deque, 2, &value));
+    test_ptr_success(deque_insert(deque, 4));
+    test_uint_eq(deque_size(deque), 6);
+    test_int_eq(*(int *)deque_at(deque, 0), 1);
+    test_int_eq(*(int *)deque_at(deque, 1), 2);
+    test_int_eq(*(int *)deque_at(deque, 2), 5);
+    test_int_eq(*(int *)deque_at(deque, 3), 3);
+    test_int_eq(*(int *)deque_at(deque, 4), 0);
+    test_int_eq(*(int *)deque_at(deque, 5), 4);
+}
+
+TEST_CASE_FIX(deque_remove_at_oob, deque_new, deque_free)
+{
+    test_int_error(deque_remove_at(deque, 4), E_DEQUE_OUT_OF_BOUNDS);
+}
+
+TEST_CASE_FIX(deque_remove_at, deque_new, deque_free)
+{
+    int value;
+
+    test_int_success(deque_remove_at_e(deque, &value, 1));
+    test_int_eq(value, 2);
+    count = 0;
+    test_int_success(deque_remove_at_f(deque, -2, test_deque_dtor, &count));
+    test_int_eq(count, 3);
+    test_uint_eq(deque_size(deque), 2);
+    test_int_eq(*(int *)deque_at(deque, 0), 1);
+    test_int_eq(*(int *)deque_at(deque, 1), 4);
+}
+
+static int test_deque_fold(deque_const_ct deque, size_t index, void *elem, void *ctx)
+{
+    int *sum = ctx;
+
+    if(*(int *)elem != i[index])
+        return 1;
+
+    *sum = *sum * 10 + *(int *)elem;
+
+    return 0;
+}
+
+TEST_CASE_FIX(deque_fold, deque_new, deque_free)
+{
+    int sum = 0;
+
+    test_int_success(deque_fold(deque, test_deque_fold, &sum));
+    test_int_eq(sum, 1234);
+    sum = 0;
+    test_int_success(deque_fold_r(deque, test_deque_fold, &sum));
+    test_int_eq(sum, 4321);
+}
+
+TEST_CASE_FIX(deque_fold_stop, deque_new, deque_free)
+{
+    count = 0;
+    test_ptr_success(deque_insert_e(deque, 1, &i[3]));
+    test_int_eq(deque_fold(deque, test_deque_fold, &count), 1);
+    test_int_eq(count, 1);
+}
+
+/// Check deque against model vector.
+///
+/// \param model    model vector
+///
+/// \retval true    deque matches model
+/// \retval false   deque differs from model
+static bool test_deque_check(vec_const_ct model)
+{
+    size_t k;
+
+    if(deque_size(deque) != vec_size(model))
+        return false;
+
+    for(k = 0; k < vec_size(model); k++)
+        if(*(int *)deque_at(deque, k) != *(int *)vec_at(model, k))
+            return false;
+
+    return true;
+}
+
+/// Apply random operations to deque and model vector.
+///
+/// \param model    model vector
+///
+/// \returns        number of operations applied
+static size_t test_deque_model_run(vec_ct model)
+{
+    size_t op, pos;
+    int value, removed;
+
+    for(op = 0; op < MODEL_OPS; op++)
+    {
+        value = op;
+        pos = vec_size(model) ? test_deque_rand() % (vec_size(model) + 1) : 0;
+
+        switch(test_deque_rand() % (vec_size(model) < 200 ? 6 : 8))
+        {
+        case 0:
+        case 6:
+            if(!deque_push_e(deque, &value) || !vec_push_e(model, &value))
+                return op;
+            break;
+
+        case 1:
+        case 7:
+            if(!deque_push_front_e(deque, &value) || !vec_insert_e(model, 0, &value))
+                return op;
+            break;
+
+        case 2:
+        case 3:
+            if(!deque_insert_e(deque, pos, &value) || !vec_insert_e(model, pos, &value))
+                return op;
+            break;
+
+        case 4:
+            if(vec_size(model) && (deque_pop_front_e(deque, &removed) || removed != *(int *)vec_at(model, 0)
+            || vec_remove_at(model, 0)))
+                return op;
+            break;
+
+        default:
+            if(pos == vec_size(model))
+                pos = 0;
+
+            if(vec_size(model) && (deque_remove_at_e(deque, &removed, pos) || removed != *(int *)vec_at(model, pos)
+            || vec_remove_at(model, pos)))
+                return op;
+        }
+
+        if(op % 1000 == 0 && !test_deque_check(model))
+            return op;
+    }
+
+    return test_deque_check(model) ? op : 0;
+}
+
+TEST_CASE_FIX(deque_model, deque_new_empty, deque_free)
+{
+    vec_ct model;
+
+    test_ptr_success(model = vec_new(sizeof(int)));
+    test_uint_eq(test_deque_model_run(model), MODEL_OPS);
+    test_void(vec_free(model));
+}
+
+/// deque benchmark operation
+typedef enum test_deque_bench_op
+{
+    BENCH_PUSH_FRONT,   ///< push elements at front
+    BENCH_INSERT,       ///< insert elements at random positions
+    BENCH_AT,           ///< access elements at random positions
+    BENCH_ITERATE,      ///< iterate over all elements
+    BENCH_POP_FRONT,    ///< pop elements at front
+    BENCH_OPS,          ///< number of operations
+} test_deque_bench_op_id;
+
+/// benchmark containers
+static deque_ct bench_deque;
+static vec_ct bench_vec;
+static list_ct bench_list;
+static volatile int bench_sum;
+
+TEST_SETUP(deque_bench_new)
+{
+    test_ptr_success(bench_deque = deque_new(sizeof(int)));
+    test_ptr_success(bench_vec = vec_new(sizeof(int)));
+    test_ptr_success(bench_list = list_new());
+}
+
+TEST_TEARDOWN(deque_bench_free)
+{
+    test_void(deque_free(bench_deque));
+    test_void(vec_free(bench_vec));
+    test_void(list_free(bench_list));
+}
+
+static int test_deque_bench_sum_deque(deque_const_ct deque, size_t index, void *elem, void *ctx)
+{
+    bench_sum += *(int *)elem;
+
+    return 0;
+}
+
+static int test_deque_bench_sum_vec(vec_const_ct vec, size_t index, void *elem, void *ctx)
+{
+    bench_sum += *(int *)elem;
+
+    return 0;
+}
+
+static int test_deque_bench_sum_list(list_const_ct list, void *data, void *ctx)
+{
+    bench_sum += POINTER_TO_VALUE(data, int);
+
+    return 0;
+}
+
+/// Run benchmark operation on one container.
+///
+/// \param op       operation
+/// \param c        container, 0 deque, 1 vector, 2 list
+///
+/// \returns        ns per element, -1 on error
+static double test_deque_bench_run(test_deque_bench_op_id op, size_t c)
+{
+    clock_t start;
+    size_t k, pos;
+    int value;
+
+    seed    = 88172645463325252ULL;
+    start   = clock();
+
+    for(k = 0; k < BENCH_ELEMS; k++)
+    {
+        value = k;
+
+        switch(op)
+        {
+        case BENCH_PUSH_FRONT:
+        case BENCH_INSERT:
+            pos = op == BENCH_INSERT ? test_deque_rand() % (k + 1) : 0;
+
+            if(c == 0 ? !deque_insert_e(bench_deque, pos, &value)
+            : c == 1 ? !vec_insert_e(bench_vec, pos, &value)
+            : !list_insert_value(bench_list, pos, value))
+                return -1;
+            break;
+
+        case BENCH_AT:
+            pos = test_deque_rand() % BENCH_ELEMS;
+
+            bench_sum += c == 0 ? *(int *)deque_at(bench_deque, pos)
+                : c == 1 ? *(int *)vec_at(bench_vec, pos)
+                : list_value_at(bench_list, pos, int);
+            break;
+
+        case BENCH_ITERATE:
+            if(c == 0)
+                deque_fold(bench_deque, test_deque_bench_sum_deque, NULL);
+            else if(c == 1)
+                vec_fold(bench_vec, test_deque_bench_sum_vec, NULL);
+            else
+                list_fold(bench_list, test_deque_bench_sum_list, NULL);
+
+            return (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / BENCH_ELEMS;
+
+        case BENCH_POP_FRONT:
+            if(c == 0 ? deque_pop_front(bench_deque)
+            : c == 1 ? vec_remove_at(bench_vec, 0)
+            : list_remove_at(bench_list, 0))
+                return -1;
+            break;
+
+        default:
+            abort();
+        }
+    }
+
+    return (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / BENCH_ELEMS;
+}
+
+/// Check deque against vector and list.
+///
+/// \retval true    containers have equal elements
+/// \retval false   containers differ
+static bool test_deque_bench_check(void)
+{
+    size_t k;
+
+    for(k = 0; k < BENCH_ELEMS; k += 97)
+        if(*(int *)deque_at(bench_deque, k) != *(int *)vec_at(bench_vec, k)
+        || *(int *)deque_at(bench_deque, k) != list_value_at(bench_list, k, int))
+            return false;
+
+    return true;
+}
+
+/// Run benchmark operation on all containers.
+///
+/// \param op       operation
+/// \param[out] ns  ns per element for deque, vector and list
+///
+/// \retval true    success
+/// \retval false   error
+static bool test_deque_bench(test_deque_bench_op_id op, double ns[3])
+{
+    size_t c;
+
+    for(c = 0; c < 3; c++)
+        if((ns[c] = test_deque_bench_run(op, c)) < 0)
+            return false;
+
+    return true;
+}
+
+TEST_CASE_FIX(deque_bench, deque_bench_new, deque_bench_free)
+{
+    static const char *names[] = { "push front", "random insert", "random access", "iterate", "pop front" };
+    test_deque_bench_op_id op;
+    double ns[3];
+
+    for(op = 0; op < BENCH_OPS; op++)
+    {
+        test_true(test_deque_bench(op, ns));
+        test_msg_info("%s: deque %.1f ns, vec %.1f ns, list %.1f ns", names[op], ns[0], ns[1], ns[2]);
+
+        if(op == BENCH_PUSH_FRONT)
+        {
+            test_true(test_deque_bench_check());
+            test_void(deque_clear(bench_deque));
+            test_void(vec_clear(bench_vec));
+            test_void(list_clear(bench_list));
+        }
+        else if(op == BENCH_INSERT)
+        {
+            test_true(test_deque_bench_check());
+        }
+    }
+
+    test_true(deque_is_empty(bench_deque));
+}
+
+int test_suite_con_deque(void *param)
+{
+    return error_pass_int(test_run_cases("deque",
+        test_case(deque_new_chunksize),
+        test_case(deque_free_invalid_magic),
+        test_case(deque_free_f),
+        test_case(deque_clear_f),
+        test_case(deque_memsize),
+
+        test_case(deque_at_oob),
+        test_case(deque_at),
+        test_case(deque_first_empty),
+        test_case(deque_get),
+
+        test_case(deque_push_front),
+        test_case(deque_push_pointer_stable),
+        test_case(deque_pop_empty),
+        test_case(deque_pop),
+        test_case(deque_pop_f),
+        test_case(deque_pointer),
+
+        test_case(deque_insert_oob),
+        test_case(deque_insert),
+        test_case(deque_remove_at_oob),
+        test_case(deque_remove_at),
+
+        test_case(deque_fold),
+        test_case(deque_fold_stop),
+
+        test_case(deque_model),
+        test_case(deque_bench),
+
+        NULL
+    ));
+}
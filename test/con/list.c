@@ -24,6 +24,8 @@
 #include <ytil/test/run.h>
 #include <ytil/test/test.h>
 #include <ytil/con/list.h>
+#include <stdint.h>
+#include <time.h>
 
 static const struct not_a_list
 {
@@ -93,6 +95,57 @@ TEST_CASE_FIX(list_free_f, list_new, no_teardown)
     test_int_eq(count, 4);
 }
 
+TEST_CASE_ABORT(list_set_pool_invalid_magic)
+{
+    list_set_pool((list_ct)&not_a_list, 10);
+}
+
+TEST_CASE_FIX(list_set_pool, list_new, list_free)
+{
+    size_t memsize4 = list_memsize(list), memsize2;
+
+    test_void(list_set_pool(list, 2));
+    test_void(list_clear(list));
+    memsize2 = list_memsize(list);
+    test_void(list_set_pool(list, 0));
+    test_uint_eq(memsize4 - memsize2, memsize2 - list_memsize(list)); // 2 of 4 nodes pooled
+    test_void(list_set_pool(list, 2));
+
+    test_ptr_success(node = list_append_value(list, i[0]));
+    test_void(list_remove(list, node));
+    test_ptr_eq(list_append_value(list, i[1]), node); // reused from pool
+    test_int_eq(list_node_value(node, int), i[1]);
+    test_uint_eq(list_size(list), 1);
+
+    test_void(list_set_pool(list, 0));
+    test_ptr_success(node = list_append_value(list, i[2]));
+    test_uint_eq(list_size(list), 2);
+}
+
+TEST_CASE_ABORT(list_reserve_invalid_magic)
+{
+    list_reserve((list_ct)&not_a_list, 10);
+}
+
+TEST_CASE_FIX(list_reserve, list_new_empty, list_free)
+{
+    size_t memsize = list_memsize(list);
+
+    test_int_success(list_reserve(list, 3));
+    test_uint_gt(list_memsize(list), memsize);
+    memsize = list_memsize(list);
+
+    test_ptr_success(list_append_value(list, i[0]));
+    test_ptr_success(list_append_value(list, i[1]));
+    test_ptr_success(list_append_value(list, i[2]));
+    test_uint_eq(list_memsize(list), memsize); // all nodes from pool
+
+    test_ptr_success(list_append_value(list, i[3]));
+    test_uint_gt(list_memsize(list), memsize);
+    test_void(list_clear(list));
+    test_uint_eq(list_memsize(list), memsize); // surplus node freed
+}
+
 TEST_CASE_ABORT(list_clear_invalid_magic)
 {
     list_clear((list_ct)&not_a_list);
@@ -853,6 +906,131 @@ TEST_CASE_FIX(list_swap, list_new, list_free)
     test_int_eq(list_value_at(list, 3, int), 1);
 }
 
+TEST_CASE_FIX_ABORT(list_move_before_invalid_dst_magic, list_new2, list_free2)
+{
+    list_move_before((list_ct)&not_a_list, NULL, list2, list_first(list2));
+}
+
+TEST_CASE_FIX_ABORT(list_move_before_invalid_node_magic, list_new2, list_free2)
+{
+    list_move_before(list, NULL, list2, (list_node_ct)&not_a_node);
+}
+
+TEST_CASE_FIX_ABORT(list_move_before_node_not_in_src, list_new2, list_free2)
+{
+    list_move_before(list, NULL, list2, list_first(list));
+}
+
+TEST_CASE_FIX(list_move_before, list_new, list_free)
+{
+    test_void(list_move_before(list, list_first(list), list, list_last(list)));
+    test_uint_eq(list_size(list), 4);
+    test_int_eq(list_value_at(list, 0, int), 4);
+    test_int_eq(list_value_at(list, 1, int), 1);
+    test_int_eq(list_value_at(list, 2, int), 2);
+    test_int_eq(list_value_at(list, 3, int), 3);
+}
+
+TEST_CASE_FIX(list_move_before_end, list_new, list_free)
+{
+    test_void(list_move_before(list, NULL, list, list_first(list)));
+    test_int_eq(list_value_at(list, 0, int), 2);
+    test_int_eq(list_value_at(list, 3, int), 1);
+}
+
+TEST_CASE_FIX(list_move_before_self, list_new, list_free)
+{
+    test_void(list_move_before(list, list_at(list, 1), list, list_at(list, 1)));
+    test_int_eq(list_value_at(list, 0, int), 1);
+    test_int_eq(list_value_at(list, 1, int), 2);
+    test_int_eq(list_value_at(list, 2, int), 3);
+}
+
+TEST_CASE_FIX(list_move_before_other_list, list_new2, list_free2)
+{
+    test_ptr_success(node = list_append_value(list2, i[1]));
+    test_void(list_move_before(list, list_first(list), list2, node));
+    test_uint_eq(list_size(list), 2);
+    test_uint_eq(list_size(list2), 1);
+    test_int_eq(list_value_at(list, 0, int), 2);
+    test_int_eq(list_value_at(list, 1, int), 1);
+    test_void(list_remove(list, node));
+}
+
+TEST_CASE_FIX_ABORT(list_move_after_invalid_src_magic, list_new2, list_free2)
+{
+    list_move_after(list, NULL, (list_ct)&not_a_list, list_first(list2));
+}
+
+TEST_CASE_FIX_ABORT(list_move_after_pre_not_in_dst, list_new2, list_free2)
+{
+    list_move_after(list, list_first(list2), list2, list_first(list2));
+}
+
+TEST_CASE_FIX(list_move_after, list_new, list_free)
+{
+    test_void(list_move_after(list, list_last(list), list, list_first(list)));
+    test_uint_eq(list_size(list), 4);
+    test_int_eq(list_value_at(list, 0, int), 2);
+    test_int_eq(list_value_at(list, 1, int), 3);
+    test_int_eq(list_value_at(list, 2, int), 4);
+    test_int_eq(list_value_at(list, 3, int), 1);
+}
+
+TEST_CASE_FIX(list_move_after_front, list_new, list_free)
+{
+    test_void(list_move_after(list, NULL, list, list_at(list, 2)));
+    test_int_eq(list_value_at(list, 0, int), 3);
+    test_int_eq(list_value_at(list, 1, int), 1);
+    test_int_eq(list_value_at(list, 2, int), 2);
+    test_int_eq(list_value_at(list, 3, int), 4);
+}
+
+TEST_CASE_FIX(list_move_after_other_list, list_new2, list_free2)
+{
+    test_void(list_move_after(list, NULL, list2, list_first(list2)));
+    test_uint_eq(list_size(list), 2);
+    test_uint_eq(list_size(list2), 0);
+    test_ptr_success(node = list_first(list));
+    test_void(list_remove(list, node));
+}
+
+TEST_CASE_FIX_ABORT(list_splice_same_list, list_new, list_free)
+{
+    list_splice(list, NULL, list);
+}
+
+TEST_CASE_FIX(list_splice_empty, list_new2, list_free2)
+{
+    test_void(list_clear(list2));
+    test_void(list_splice(list, NULL, list2));
+    test_uint_eq(list_size(list), 1);
+    test_uint_eq(list_size(list2), 0);
+}
+
+TEST_CASE_FIX(list_splice, list_new, list_free)
+{
+    test_ptr_success(list2 = list_new());
+    test_ptr_success(list_append_value(list2, 5));
+    test_ptr_success(list_append_value(list2, 6));
+
+    test_void(list_splice(list, list_first(list), list2));
+    test_uint_eq(list_size(list), 6);
+    test_uint_eq(list_size(list2), 0);
+    test_int_eq(list_value_at(list, 0, int), 1);
+    test_int_eq(list_value_at(list, 1, int), 5);
+    test_int_eq(list_value_at(list, 2, int), 6);
+    test_int_eq(list_value_at(list, 3, int), 2);
+    test_int_eq(list_value_at(list, 5, int), 4);
+
+    test_ptr_success(list_append_value(list2, 7));
+    test_void(list_splice(list, NULL, list2));
+    test_int_eq(list_value_at(list, 0, int), 7);
+    test_ptr_success(node = list_first(list));
+    test_void(list_remove(list, node));
+    test_void(list_free(list2));
+}
+
 static int test_list_fold(list_const_ct list, void *data, void *ctx)
 {
     int *sum = ctx;
@@ -896,12 +1074,198 @@ TEST_CASE_FIX(list_fold_r, list_new, list_free)
     test_int_eq(sum, 4321);
 }
 
+/// intrusive list test element
+typedef struct test_list_elem
+{
+    int             value;  ///< element value
+    list_link_st    link;   ///< list link
+} test_list_elem_st;
+
+/// Get values of intrusive list.
+///
+/// \param head     list head
+///
+/// \returns        decimal digits of element values, first value first
+static int test_list_link_values(const list_link_st *head)
+{
+    list_link_st *link;
+    int values = 0;
+
+    list_link_foreach(head, link)
+        values = values * 10 + list_link_entry(link, test_list_elem_st, link)->value;
+
+    return values;
+}
+
+TEST_CASE(list_link)
+{
+    test_list_elem_st elems[] = { { .value = 1 }, { .value = 2 }, { .value = 3 } };
+    list_link_st head, *link;
+    int values = 0;
+
+    test_void(list_link_init(&head));
+    test_true(list_link_is_empty(&head));
+    test_void(list_link_init(&elems[0].link));
+    test_false(list_link_is_linked(&elems[0].link));
+
+    test_void(list_link_insert_before(&head, &elems[1].link));
+    test_void(list_link_insert_after(&head, &elems[0].link));
+    test_void(list_link_insert_after(&elems[1].link, &elems[2].link));
+    test_false(list_link_is_empty(&head));
+    test_true(list_link_is_linked(&elems[0].link));
+    test_uint_eq(list_link_size(&head), 3);
+    test_int_eq(test_list_link_values(&head), 123);
+
+    list_link_foreach_r(&head, link)
+        values = values * 10 + list_link_entry(link, test_list_elem_st, link)->value;
+
+    test_int_eq(values, 321);
+
+    test_void(list_link_move_after(&head, &elems[2].link));
+    test_int_eq(test_list_link_values(&head), 312);
+    test_void(list_link_move_before(&head, &elems[0].link));
+    test_int_eq(test_list_link_values(&head), 321);
+
+    test_void(list_link_remove(&elems[2].link));
+    test_false(list_link_is_linked(&elems[2].link));
+    test_int_eq(test_list_link_values(&head), 21);
+    test_void(list_link_remove(&elems[1].link));
+    test_void(list_link_remove(&elems[0].link));
+    test_true(list_link_is_empty(&head));
+}
+
+TEST_CASE(list_link_move_between_lists)
+{
+    test_list_elem_st elems[] = { { .value = 1 }, { .value = 2 } };
+    list_link_st head1, head2;
+
+    test_void(list_link_init(&head1));
+    test_void(list_link_init(&head2));
+    test_void(list_link_insert_before(&head1, &elems[0].link));
+    test_void(list_link_insert_before(&head1, &elems[1].link));
+
+    test_void(list_link_move_after(&head2, &elems[0].link));
+    test_int_eq(test_list_link_values(&head1), 2);
+    test_int_eq(test_list_link_values(&head2), 1);
+}
+
+#define BENCH_NODES     1024    ///< number of nodes in benchmark list
+#define BENCH_ROUNDS    1000    ///< number of move to front rounds
+
+/// Move nodes to front by remove and prepend.
+///
+/// \param pool     pool nodes
+///
+/// \returns        ns per move, -1 on error
+static double test_list_bench_move(bool pool)
+{
+    list_node_ct nodes[BENCH_NODES];
+    clock_t start;
+    size_t k, r;
+
+    if(!(list = list_new()))
+        return -1;
+
+    if(pool)
+        list_set_pool(list, 1);
+
+    for(k = 0; k < BENCH_NODES; k++)
+        if(!(nodes[k] = list_append_value(list, k)))
+            return list_free(list), -1;
+
+    start = clock();
+
+    for(r = 0; r < BENCH_ROUNDS; r++)
+        for(k = 0; k < BENCH_NODES; k++)
+        {
+            list_remove(list, nodes[k]);
+
+            if(!(nodes[k] = list_prepend_value(list, k)))
+                return list_free(list), -1;
+        }
+
+    start = clock() - start;
+    list_free(list);
+
+    return (double)start * 1e9 / CLOCKS_PER_SEC / (BENCH_NODES * BENCH_ROUNDS);
+}
+
+/// Move links to front.
+///
+/// \returns        ns per move
+static double test_list_bench_move_link(void)
+{
+    static test_list_elem_st elems[BENCH_NODES];
+    list_link_st head;
+    clock_t start;
+    size_t k, r;
+
+    list_link_init(&head);
+
+    for(k = 0; k < BENCH_NODES; k++)
+        list_link_insert_before(&head, &elems[k].link);
+
+    start = clock();
+
+    for(r = 0; r < BENCH_ROUNDS; r++)
+        for(k = 0; k < BENCH_NODES; k++)
+            list_link_move_after(&head, &elems[k].link);
+
+    return (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / (BENCH_NODES * BENCH_ROUNDS);
+}
+
+/// Move nodes to front by relinking.
+///
+/// \returns        ns per move, -1 on error
+static double test_list_bench_move_node(void)
+{
+    list_node_ct nodes[BENCH_NODES];
+    clock_t start;
+    size_t k, r;
+
+    if(!(list = list_new()))
+        return -1;
+
+    for(k = 0; k < BENCH_NODES; k++)
+        if(!(nodes[k] = list_append_value(list, k)))
+            return list_free(list), -1;
+
+    start = clock();
+
+    for(r = 0; r < BENCH_ROUNDS; r++)
+        for(k = 0; k < BENCH_NODES; k++)
+            list_move_after(list, NULL, list, nodes[k]);
+
+    start = clock() - start;
+    list_free(list);
+
+    return (double)start * 1e9 / CLOCKS_PER_SEC / (BENCH_NODES * BENCH_ROUNDS);
+}
+
+TEST_CASE(list_bench_move_to_front)
+{
+    double ns;
+
+    test_true((ns = test_list_bench_move(false)) >= 0);
+    test_msg_info("malloc: %.1f ns/move", ns);
+    test_true((ns = test_list_bench_move(true)) >= 0);
+    test_msg_info("pool: %.1f ns/move", ns);
+    test_true((ns = test_list_bench_move_node()) >= 0);
+    test_msg_info("relink: %.1f ns/move", ns);
+    test_true((ns = test_list_bench_move_link()) >= 0);
+    test_msg_info("intrusive: %.1f ns/move", ns);
+}
+
 int test_suite_con_list(void *param)
 {
     return error_pass_int(test_run_cases("list",
         test_case(list_free_invalid_magic),
         test_case(list_free_f_invalid_magic),
         test_case(list_free_f),
+        test_case(list_set_pool_invalid_magic),
+        test_case(list_set_pool),
+        test_case(list_reserve_invalid_magic),
+        test_case(list_reserve),
 
         test_case(list_clear_invalid_magic),
         test_case(list_clear),
@@ -1050,6 +1414,22 @@ int test_suite_con_list(void *param)
         test_case(list_swap_nodes_in_different_lists),
         test_case(list_swap),
 
+        test_case(list_move_before_invalid_dst_magic),
+        test_case(list_move_before_invalid_node_magic),
+        test_case(list_move_before_node_not_in_src),
+        test_case(list_move_before),
+        test_case(list_move_before_end),
+        test_case(list_move_before_self),
+        test_case(list_move_before_other_list),
+        test_case(list_move_after_invalid_src_magic),
+        test_case(list_move_after_pre_not_in_dst),
+        test_case(list_move_after),
+        test_case(list_move_after_front),
+        test_case(list_move_after_other_list),
+        test_case(list_splice_same_list),
+        test_case(list_splice_empty),
+        test_case(list_splice),
+
         test_case(list_fold_invalid_magic),
         test_case(list_fold_invalid_callback),
         test_case(list_fold),
@@ -1057,6 +1437,10 @@ int test_suite_con_list(void *param)
         test_case(list_fold_r_invalid_callback),
         test_case(list_fold_r),
 
+        test_case(list_link),
+        test_case(list_link_move_between_lists),
+        test_case(list_bench_move_to_front),
+
         NULL
     ));
 }
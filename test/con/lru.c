@@ -0,0 +1,245 @@
+/*
+ * Copyright (c) 2026 Martin Rödel a.k.a. Yomin Nimoy
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "cont.h"
+#include <ytil/test/run.h>
+#include <ytil/test/test.h>
+#include <ytil/con/lru.h>
+#include <stdio.h>
+
+static const struct not_an_lru
+{
+    int foo;
+} not_an_lru = { 123 };
+
+static lru_ct lru;
+static int count;
+
+
+TEST_SETUP(lru_new_empty)
+{
+    test_ptr_success(lru = lru_new(3));
+}
+
+TEST_SETUP(lru_new3)
+{
+    test_ptr_success(lru = lru_new(3));
+    test_int_success(lru_put_value(lru, LIT("foo"), 1));
+    test_int_success(lru_put_value(lru, LIT("bar"), 2));
+    test_int_success(lru_put_value(lru, LIT("baz"), 3));
+}
+
+TEST_TEARDOWN(lru_free)
+{
+    test_void(lru_free(lru));
+}
+
+static void test_lru_dtor(lru_const_ct lru, void *data, void *ctx)
+{
+    int *count = ctx;
+
+    count[0]++;
+}
+
+TEST_CASE(lru_new)
+{
+    test_ptr_success(lru = lru_new(10));
+    test_true(lru_is_empty(lru));
+    test_uint_eq(lru_size(lru), 0);
+    test_uint_eq(lru_capacity(lru), 10);
+    test_void(lru_free(lru));
+}
+
+TEST_CASE_ABORT(lru_free_invalid_magic)
+{
+    lru_free((lru_ct)&not_an_lru);
+}
+
+TEST_CASE_FIX(lru_free_f, lru_new3, no_teardown)
+{
+    count = 0;
+    test_void(lru_free_f(lru, test_lru_dtor, &count));
+    test_int_eq(count, 3);
+}
+
+TEST_CASE_FIX(lru_clear, lru_new3, lru_free)
+{
+    count = 0;
+    test_void(lru_clear_f(lru, test_lru_dtor, &count));
+    test_int_eq(count, 3);
+    test_true(lru_is_empty(lru));
+    test_false(lru_contains(lru, LIT("foo")));
+    test_int_success(lru_put_value(lru, LIT("foo"), 4));
+    test_int_eq(lru_get_value(lru, LIT("foo"), int), 4);
+}
+
+TEST_CASE_ABORT(lru_get_invalid_magic)
+{
+    lru_get((lru_ct)&not_an_lru, LIT("foo"));
+}
+
+TEST_CASE_FIX(lru_get_not_found, lru_new3, lru_free)
+{
+    test_ptr_error(lru_get(lru, LIT("xyz")), E_LRU_NOT_FOUND);
+}
+
+TEST_CASE_FIX(lru_get, lru_new3, lru_free)
+{
+    test_int_eq(lru_get_value(lru, LIT("foo"), int), 1);
+    test_int_eq(lru_get_value(lru, LIT("bar"), int), 2);
+    test_int_eq(lru_get_value(lru, LIT("baz"), int), 3);
+}
+
+TEST_CASE_FIX(lru_get_touch, lru_new3, lru_free)
+{
+    test_int_eq(lru_get_value(lru, LIT("foo"), int), 1);
+    test_int_success(lru_put_value(lru, LIT("xyz"), 4));
+    test_uint_eq(lru_size(lru), 3);
+    test_true(lru_contains(lru, LIT("foo")));
+    test_false(lru_contains(lru, LIT("bar")));
+}
+
+TEST_CASE_FIX(lru_peek_not_found, lru_new3, lru_free)
+{
+    test_ptr_error(lru_peek(lru, LIT("xyz")), E_LRU_NOT_FOUND);
+}
+
+TEST_CASE_FIX(lru_peek_no_touch, lru_new3, lru_free)
+{
+    test_ptr_eq(lru_peek(lru, LIT("foo")), VALUE_TO_POINTER(1));
+    test_int_success(lru_put_value(lru, LIT("xyz"), 4));
+    test_false(lru_contains(lru, LIT("foo")));
+    test_true(lru_contains(lru, LIT("bar")));
+}
+
+TEST_CASE_FIX(lru_put_invalid_key, lru_new_empty, lru_free)
+{
+    test_int_error(lru_put(lru, LIT(""), NULL), E_LRU_INVALID_KEY);
+}
+
+TEST_CASE_FIX(lru_put_replace, lru_new3, lru_free)
+{
+    count = 0;
+    test_int_success(lru_put_f(lru, LIT("foo"), VALUE_TO_POINTER(4), test_lru_dtor, &count));
+    test_int_eq(count, 1);
+    test_uint_eq(lru_size(lru), 3);
+    test_int_eq(lru_peek_value(lru, LIT("foo"), int), 4);
+    test_int_eq(POINTER_TO_VALUE(lru_oldest(lru), int), 2);
+}
+
+TEST_CASE_FIX(lru_put_evict, lru_new3, lru_free)
+{
+    count = 0;
+    test_int_success(lru_put_f(lru, LIT("xyz"), VALUE_TO_POINTER(4), test_lru_dtor, &count));
+    test_int_eq(count, 1);
+    test_uint_eq(lru_size(lru), 3);
+    test_false(lru_contains(lru, LIT("foo")));
+    test_int_eq(lru_peek_value(lru, LIT("xyz"), int), 4);
+    test_int_eq(POINTER_TO_VALUE(lru_oldest(lru), int), 2);
+}
+
+TEST_CASE_FIX(lru_put_evict_many, lru_new_empty, lru_free)
+{
+    char buf[16];
+    size_t k;
+
+    for(k = 0; k < 100; k++)
+    {
+        snprintf(buf, sizeof(buf), "key%zu", k);
+
+        if(lru_put_value(lru, STR(buf), k))
+            break;
+    }
+
+    test_uint_eq(k, 100);
+    test_uint_eq(lru_size(lru), 3);
+    test_int_eq(POINTER_TO_VALUE(lru_oldest(lru), int), 97);
+    test_true(lru_contains(lru, LIT("key99")));
+    test_false(lru_contains(lru, LIT("key96")));
+}
+
+TEST_CASE_FIX(lru_remove_not_found, lru_new3, lru_free)
+{
+    test_int_error(lru_remove(lru, LIT("xyz")), E_LRU_NOT_FOUND);
+}
+
+TEST_CASE_FIX(lru_remove, lru_new3, lru_free)
+{
+    count = 0;
+    test_int_success(lru_remove_f(lru, LIT("bar"), test_lru_dtor, &count));
+    test_int_eq(count, 1);
+    test_uint_eq(lru_size(lru), 2);
+    test_false(lru_contains(lru, LIT("bar")));
+    test_int_success(lru_put_value(lru, LIT("xyz"), 4));
+    test_true(lru_contains(lru, LIT("foo")));
+}
+
+TEST_CASE_FIX(lru_oldest_empty, lru_new_empty, lru_free)
+{
+    test_ptr_error(lru_oldest(lru), E_LRU_NOT_FOUND);
+}
+
+TEST_CASE_FIX(lru_evict_empty, lru_new_empty, lru_free)
+{
+    test_int_error(lru_evict(lru), E_LRU_NOT_FOUND);
+}
+
+TEST_CASE_FIX(lru_evict, lru_new3, lru_free)
+{
+    test_ptr_success(lru_get(lru, LIT("foo")));
+    test_int_success(lru_evict(lru));
+    test_false(lru_contains(lru, LIT("bar")));
+    test_int_success(lru_evict(lru));
+    test_false(lru_contains(lru, LIT("baz")));
+    test_int_success(lru_evict(lru));
+    test_true(lru_is_empty(lru));
+}
+
+int test_suite_con_lru(void *param)
+{
+    return error_pass_int(test_run_cases("lru",
+        test_case(lru_new),
+        test_case(lru_free_invalid_magic),
+        test_case(lru_free_f),
+        test_case(lru_clear),
+
+        test_case(lru_get_invalid_magic),
+        test_case(lru_get_not_found),
+        test_case(lru_get),
+        test_case(lru_get_touch),
+        test_case(lru_peek_not_found),
+        test_case(lru_peek_no_touch),
+
+        test_case(lru_put_invalid_key),
+        test_case(lru_put_replace),
+        test_case(lru_put_evict),
+        test_case(lru_put_evict_many),
+
+        test_case(lru_remove_not_found),
+        test_case(lru_remove),
+        test_case(lru_oldest_empty),
+        test_case(lru_evict_empty),
+        test_case(lru_evict),
+
+        NULL
+    ));
+}
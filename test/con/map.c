@@ -0,0 +1,458 @@
+/*
+ * Copyright (c) 2026 Martin Rödel a.k.a. Yomin Nimoy
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "cont.h"
+#include <ytil/test/run.h>
+#include <ytil/test/test.h>
+#include <ytil/con/map.h>
+#include <ytil/con/art.h>
+#include <stdint.h>
+#include <time.h>
+
+#define MANY_KEYS       5000    ///< number of keys in growth tests
+#define BENCH_KEYS      50000   ///< number of keys in benchmarks
+#define BENCH_ROUNDS    10      ///< number of lookups per key in benchmarks
+
+static const struct not_a_map
+{
+    int foo;
+} not_a_map = { 123 };
+
+static map_ct map;
+static map_node_ct node;
+static int count;
+static str_ct keys[BENCH_KEYS];
+
+
+TEST_SETUP(map_new_empty)
+{
+    test_ptr_success(map = map_new());
+}
+
+TEST_SETUP(map_new4)
+{
+    test_ptr_success(map = map_new());
+    test_ptr_success(map_insert_value(map, LIT("foobar"), 1));
+    test_ptr_success(map_insert_value(map, LIT("foobaz"), 2));
+    test_ptr_success(map_insert_value(map, LIT("fooduh"), 3));
+    test_ptr_success(map_insert_value(map, LIT("xyz"), 4));
+}
+
+TEST_TEARDOWN(map_free)
+{
+    test_void(map_free(map));
+}
+
+TEST_SETUP(map_keys_new)
+{
+    size_t k;
+
+    for(k = 0; k < BENCH_KEYS; k++)
+        if(!(keys[k] = str_dup_f("https://www.example.com/api/v%zu/users/%zu/items", k % 4, k * 7919)))
+            test_abort_fail_b("str_dup_f failed");
+}
+
+TEST_SETUP(map_keys_random_new)
+{
+    uint64_t x;
+    size_t k;
+
+    // splitmix64 is a bijection, keys are unique
+    for(k = 0; k < BENCH_KEYS; k++)
+    {
+        x = (k + 1) * 0x9e3779b97f4a7c15;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111eb;
+        x ^= x >> 31;
+
+        if(!(keys[k] = str_dup_b(&x, sizeof(x))))
+            test_abort_fail_b("str_dup_b failed");
+    }
+}
+
+TEST_TEARDOWN(map_keys_free)
+{
+    size_t k;
+
+    for(k = 0; k < BENCH_KEYS; k++)
+        str_unref(keys[k]);
+}
+
+static void test_map_dtor(map_const_ct map, void *data, void *ctx)
+{
+    int *count = ctx;
+
+    count[0] += POINTER_TO_VALUE(data, int);
+}
+
+TEST_CASE(map_new)
+{
+    test_ptr_success(map = map_new());
+    test_true(map_is_empty(map));
+    test_uint_eq(map_size(map), 0);
+    test_uint_eq(map_capacity(map), 0);
+    test_ptr_error(map_get(map, LIT("foo")), E_MAP_NOT_FOUND);
+    test_void(map_free(map));
+}
+
+TEST_CASE_ABORT(map_free_invalid_magic)
+{
+    map_free((map_ct)&not_a_map);
+}
+
+TEST_CASE_FIX(map_free_f, map_new4, no_teardown)
+{
+    count = 0;
+    test_void(map_free_f(map, test_map_dtor, &count));
+    test_int_eq(count, 10);
+}
+
+TEST_CASE_FIX(map_free_if_empty, map_new4, map_free)
+{
+    test_ptr_eq(map_free_if_empty(map), map);
+    test_void(map_clear(map));
+    test_ptr_eq(map_free_if_empty(map), NULL);
+    test_ptr_success(map = map_new());
+}
+
+TEST_CASE_FIX(map_clear_f, map_new4, map_free)
+{
+    count = 0;
+    test_void(map_clear_f(map, test_map_dtor, &count));
+    test_int_eq(count, 10);
+    test_true(map_is_empty(map));
+    test_ptr_error(map_get(map, LIT("foobar")), E_MAP_NOT_FOUND);
+    test_ptr_success(map_insert_value(map, LIT("foobar"), 5));
+    test_int_eq(map_get_value(map, LIT("foobar"), int), 5);
+}
+
+TEST_CASE_FIX(map_memsize, map_new4, map_free)
+{
+    test_uint_gt(map_memsize(map), map_capacity(map) * 3 * sizeof(void *));
+}
+
+TEST_CASE_FIX(map_reserve, map_new_empty, map_free)
+{
+    test_int_success(map_reserve(map, 100));
+    test_uint_eq(map_capacity(map), 128);
+    test_int_success(map_reserve(map, 10));
+    test_uint_eq(map_capacity(map), 128);
+}
+
+TEST_CASE_FIX(map_get_not_found, map_new4, map_free)
+{
+    test_ptr_error(map_get(map, LIT("foo")), E_MAP_NOT_FOUND);
+    test_ptr_error(map_get(map, LIT("foobarx")), E_MAP_NOT_FOUND);
+    test_ptr_error(map_get_data(map, LIT("")), E_MAP_NOT_FOUND);
+}
+
+TEST_CASE_FIX(map_get, map_new4, map_free)
+{
+    test_ptr_success(node = map_get(map, LIT("fooduh")));
+    test_int_eq(map_node_value(node, int), 3);
+    test_str_eq(str_c(map_node_key(node)), "fooduh");
+    test_int_eq(map_get_value(map, LIT("foobar"), int), 1);
+    test_int_eq(map_get_value(map, LIT("foobaz"), int), 2);
+    test_int_eq(map_get_value(map, LIT("xyz"), int), 4);
+}
+
+TEST_CASE_FIX(map_get_key_copied, map_new_empty, map_free)
+{
+    str_ct key;
+
+    test_ptr_success(key = str_dup_c("foo"));
+    test_ptr_success(map_insert_value(map, key, 1));
+    test_ptr_success(str_set_len(key, 0));
+    test_void(str_unref(key));
+    test_int_eq(map_get_value(map, LIT("foo"), int), 1);
+}
+
+TEST_CASE_FIX(map_node_set, map_new4, map_free)
+{
+    test_ptr_success(node = map_get(map, LIT("xyz")));
+    test_void(map_node_set_value(node, 5));
+    test_int_eq(map_get_value(map, LIT("xyz"), int), 5);
+}
+
+TEST_CASE_FIX(map_insert_exists, map_new4, map_free)
+{
+    test_ptr_error(map_insert(map, LIT("foobar"), NULL), E_MAP_EXISTS);
+    test_uint_eq(map_size(map), 4);
+}
+
+TEST_CASE_FIX(map_insert_empty_key, map_new_empty, map_free)
+{
+    test_ptr_success(map_insert_value(map, LIT(""), 1));
+    test_int_eq(map_get_value(map, LIT(""), int), 1);
+}
+
+TEST_CASE_FIX(map_set, map_new4, map_free)
+{
+    test_ptr_success(map_set_value(map, LIT("foobar"), 5));
+    test_ptr_success(map_set_value(map, LIT("new"), 6));
+    test_uint_eq(map_size(map), 5);
+    test_int_eq(map_get_value(map, LIT("foobar"), int), 5);
+    test_int_eq(map_get_value(map, LIT("new"), int), 6);
+}
+
+TEST_CASE_FIX(map_remove, map_new4, map_free)
+{
+    test_ptr_success(node = map_get(map, LIT("foobaz")));
+    test_void(map_remove(map, node));
+    test_uint_eq(map_size(map), 3);
+    test_ptr_error(map_get(map, LIT("foobaz")), E_MAP_NOT_FOUND);
+    test_int_eq(map_get_value(map, LIT("foobar"), int), 1);
+}
+
+TEST_CASE_FIX(map_remove_k_not_found, map_new4, map_free)
+{
+    test_int_error(map_remove_k(map, LIT("foo")), E_MAP_NOT_FOUND);
+}
+
+TEST_CASE_FIX(map_remove_kf, map_new4, map_free)
+{
+    count = 0;
+    test_int_success(map_remove_kf(map, LIT("fooduh"), test_map_dtor, &count));
+    test_int_eq(count, 3);
+    test_uint_eq(map_size(map), 3);
+}
+
+/// Check that keys in range are mapped to their index.
+///
+/// \param from     first key index
+/// \param to       last key index, exclusive
+///
+/// \retval true    all keys found
+/// \retval false   key missing or wrong value
+static bool test_map_check(size_t from, size_t to)
+{
+    map_node_ct node;
+
+    for(; from < to; from++)
+        if(!(node = map_get(map, keys[from])) || map_node_value(node, size_t) != from)
+            return false;
+
+    return true;
+}
+
+/// Insert keys in range.
+///
+/// \param from     first key index
+/// \param to       last key index, exclusive
+///
+/// \retval true    all keys inserted
+/// \retval false   insert failed
+static bool test_map_fill(size_t from, size_t to)
+{
+    for(; from < to; from++)
+        if(!map_insert_value(map, keys[from], from))
+            return false;
+
+    return true;
+}
+
+TEST_CASE_FIX(map_insert_many, map_keys_new, map_keys_free)
+{
+    test_ptr_success(map = map_new());
+    test_true(test_map_fill(0, MANY_KEYS));
+    test_uint_eq(map_size(map), MANY_KEYS);
+    test_uint_ge(map_capacity(map) - map_capacity(map) / 8, MANY_KEYS);
+    test_true(test_map_check(0, MANY_KEYS));
+    test_ptr_error(map_get(map, keys[MANY_KEYS]), E_MAP_NOT_FOUND);
+    test_void(map_free(map));
+}
+
+TEST_CASE_FIX(map_remove_many, map_keys_random_new, map_keys_free)
+{
+    size_t round, k, cap;
+
+    test_ptr_success(map = map_new());
+    test_true(test_map_fill(0, MANY_KEYS));
+    cap = map_capacity(map);
+
+    // churn through deleted slots without growing
+    for(round = 1; round < 8; round++)
+    {
+        for(k = (round - 1) * MANY_KEYS / 2; k < round * MANY_KEYS / 2; k++)
+            if(map_remove_k(map, keys[k]))
+                break;
+
+        test_uint_eq(k, round * MANY_KEYS / 2);
+        test_true(test_map_fill((round + 1) * MANY_KEYS / 2, (round + 2) * MANY_KEYS / 2));
+        test_uint_eq(map_size(map), MANY_KEYS);
+    }
+
+    test_uint_eq(map_capacity(map), cap);
+    test_true(test_map_check(7 * MANY_KEYS / 2, 9 * MANY_KEYS / 2));
+    test_ptr_error(map_get(map, keys[0]), E_MAP_NOT_FOUND);
+    test_void(map_free(map));
+}
+
+static int test_map_fold(map_const_ct map, str_const_ct key, void *data, void *ctx)
+{
+    int *sum = ctx;
+
+    if(map_get_data(map, key) != data)
+        return 1;
+
+    *sum += POINTER_TO_VALUE(data, int);
+
+    return 0;
+}
+
+static int test_map_fold_stop(map_const_ct map, str_const_ct key, void *data, void *ctx)
+{
+    int *n = ctx;
+
+    return ++*n == 2;
+}
+
+TEST_CASE_FIX(map_fold, map_new4, map_free)
+{
+    count = 0;
+    test_int_success(map_fold(map, test_map_fold, &count));
+    test_int_eq(count, 10);
+    count = 0;
+    test_int_eq(map_fold(map, test_map_fold_stop, &count), 1);
+    test_int_eq(count, 2);
+}
+
+/// Benchmark lookups in map.
+///
+/// \param[out] memsize     memory size of map
+///
+/// \returns                ns per lookup, -1 on error
+static double test_map_bench_get(size_t *memsize)
+{
+    clock_t start, end;
+    size_t k, r;
+
+    if(!(map = map_new()))
+        return -1;
+
+    if(!test_map_fill(0, BENCH_KEYS))
+        return map_free(map), -1;
+
+    start = clock();
+
+    for(r = 0; r < BENCH_ROUNDS; r++)
+        for(k = 0; k < BENCH_KEYS; k++)
+            if(!(node = map_get(map, keys[k])) || map_node_value(node, size_t) != k)
+                return map_free(map), -1;
+
+    end         = clock();
+    *memsize    = map_memsize(map);
+
+    map_free(map);
+
+    return (double)(end - start) * 1e9 / CLOCKS_PER_SEC / (BENCH_KEYS * BENCH_ROUNDS);
+}
+
+/// Benchmark lookups in ART.
+///
+/// \param[out] memsize     memory size of ART
+///
+/// \returns                ns per lookup, -1 on error
+static double test_map_bench_art_get(size_t *memsize)
+{
+    clock_t start, end;
+    art_node_ct node;
+    size_t k, r;
+    art_ct art;
+
+    if(!(art = art_new(ART_MODE_UNORDERED)))
+        return -1;
+
+    for(k = 0; k < BENCH_KEYS; k++)
+        if(!art_insert_value(art, keys[k], k))
+            return art_free(art), -1;
+
+    start = clock();
+
+    for(r = 0; r < BENCH_ROUNDS; r++)
+        for(k = 0; k < BENCH_KEYS; k++)
+            if(!(node = art_get(art, keys[k])) || art_node_value(node, size_t) != k)
+                return art_free(art), -1;
+
+    end         = clock();
+    *memsize    = art_memsize(art);
+
+    art_free(art);
+
+    return (double)(end - start) * 1e9 / CLOCKS_PER_SEC / (BENCH_KEYS * BENCH_ROUNDS);
+}
+
+TEST_CASE_FIX(map_bench_get, map_keys_new, map_keys_free)
+{
+    size_t memsize;
+    double ns;
+
+    test_true((ns = test_map_bench_get(&memsize)) >= 0);
+    test_msg_info("map: %.1f ns/get, %zu bytes", ns, memsize);
+    test_true((ns = test_map_bench_art_get(&memsize)) >= 0);
+    test_msg_info("art: %.1f ns/get, %zu bytes", ns, memsize);
+}
+
+TEST_CASE_FIX(map_bench_get_random, map_keys_random_new, map_keys_free)
+{
+    size_t memsize;
+    double ns;
+
+    test_true((ns = test_map_bench_get(&memsize)) >= 0);
+    test_msg_info("map: %.1f ns/get, %zu bytes", ns, memsize);
+    test_true((ns = test_map_bench_art_get(&memsize)) >= 0);
+    test_msg_info("art: %.1f ns/get, %zu bytes", ns, memsize);
+}
+
+int test_suite_con_map(void *param)
+{
+    return error_pass_int(test_run_cases("map",
+        test_case(map_new),
+        test_case(map_free_invalid_magic),
+        test_case(map_free_f),
+        test_case(map_free_if_empty),
+        test_case(map_clear_f),
+        test_case(map_memsize),
+        test_case(map_reserve),
+
+        test_case(map_get_not_found),
+        test_case(map_get),
+        test_case(map_get_key_copied),
+        test_case(map_node_set),
+
+        test_case(map_insert_exists),
+        test_case(map_insert_empty_key),
+        test_case(map_set),
+        test_case(map_remove),
+        test_case(map_remove_k_not_found),
+        test_case(map_remove_kf),
+        test_case(map_insert_many),
+        test_case(map_remove_many),
+
+        test_case(map_fold),
+
+        test_case(map_bench_get),
+        test_case(map_bench_get_random),
+
+        NULL
+    ));
+}
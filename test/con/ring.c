@@ -24,6 +24,13 @@
 #include <ytil/test/run.h>
 #include <ytil/test/test.h>
 #include <ytil/con/ring.h>
+#include <ytil/def.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
 
 static const struct not_a_ring
 {
@@ -64,6 +71,16 @@ TEST_SETUP(ring_new_ptr)
     test_ptr_success(ring_put_p(ring, pi[3]));
 }
 
+TEST_SETUP(ring_new_spsc)
+{
+    test_ptr_success(ring = ring_new_spsc(4, sizeof(int)));
+}
+
+TEST_SETUP(ring_new_mpmc)
+{
+    test_ptr_success(ring = ring_new_mpmc(4, sizeof(int)));
+}
+
 TEST_TEARDOWN(ring_free)
 {
     test_void(ring_free(ring));
@@ -85,6 +102,67 @@ TEST_CASE_ABORT(ring_new_c__invalid_elemsize)
     test_void(ring_new_c(1, 0));
 }
 
+TEST_CASE_ABORT(ring_new_pow2__invalid_elemsize)
+{
+    test_void(ring_new_pow2(1, 0));
+}
+
+TEST_CASE(ring_new_pow2)
+{
+    test_ptr_success(ring = ring_new_pow2(5, sizeof(int)));
+    test_uint_eq(ring_capacity(ring), 8);
+    test_void(ring_free(ring));
+
+    test_ptr_success(ring = ring_new_pow2(8, sizeof(int)));
+    test_uint_eq(ring_capacity(ring), 8);
+    test_void(ring_free(ring));
+}
+
+TEST_CASE_ABORT(ring_new_mirror__invalid_elemsize)
+{
+    test_void(ring_new_mirror(1, 0));
+}
+
+TEST_CASE(ring_new_mirror)
+{
+    size_t page = sysconf(_SC_PAGESIZE);
+
+    test_ptr_success(ring = ring_new_mirror(100, 1));
+    test_uint_eq(ring_capacity(ring) % page, 0);
+    test_void(ring_free(ring));
+
+    test_ptr_success(ring = ring_new_mirror(1, 24));
+    test_uint_eq(ring_capacity(ring) * 24 % page, 0);
+    test_true(ring_capacity(ring) < page);
+    test_void(ring_free(ring));
+}
+
+TEST_CASE_ABORT(ring_new_spsc__invalid_elemsize)
+{
+    test_void(ring_new_spsc(1, 0));
+}
+
+TEST_CASE(ring_new_spsc)
+{
+    test_ptr_success(ring = ring_new_spsc(5, sizeof(int)));
+    test_uint_eq(ring_capacity(ring), 8);
+    test_true(ring_is_empty(ring));
+    test_void(ring_free(ring));
+}
+
+TEST_CASE_ABORT(ring_new_mpmc__invalid_elemsize)
+{
+    test_void(ring_new_mpmc(1, 0));
+}
+
+TEST_CASE(ring_new_mpmc)
+{
+    test_ptr_success(ring = ring_new_mpmc(0, sizeof(int)));
+    test_uint_eq(ring_capacity(ring), 16);
+    test_true(ring_is_empty(ring));
+    test_void(ring_free(ring));
+}
+
 TEST_CASE_ABORT(ring_free__invalid_magic)
 {
     ring_free((ring_ct)&not_a_ring);
@@ -395,6 +473,61 @@ TEST_CASE_FIX(ring_put_p__overflow, ring_new_ptr, ring_free)
     test_uint_eq(ring_size(ring), 4);
 }
 
+TEST_CASE_ABORT(ring_put_n__invalid_magic)
+{
+    ring_put_n((ring_ct)&not_a_ring, i, 2);
+}
+
+TEST_CASE_FIX(ring_put_n, ring_new_empty, ring_free)
+{
+    test_uint_eq(ring_put_n(ring, i, 2), 2);
+    test_uint_eq(ring_size(ring), 2);
+    test_int_success(ring_get(ring, &k));
+    test_uint_eq(ring_put_n(ring, &i[2], 3), 3); // wraps around
+    test_uint_eq(ring_size(ring), 4);
+
+    test_int_eq(*(int *)ring_peek(ring), i[1]);
+    test_int_eq(*(int *)ring_peek_head(ring), i[4]);
+}
+
+TEST_CASE_FIX(ring_put_n__empty_elems, ring_new_empty, ring_free)
+{
+    test_uint_eq(ring_put_n(ring, NULL, 2), 2);
+    test_int_eq(*(int *)ring_peek(ring), 0);
+    test_int_eq(*(int *)ring_peek_head(ring), 0);
+}
+
+TEST_CASE_FIX(ring_put_n__partial, ring_new_empty, ring_free)
+{
+    test_ptr_success(ring_put_e(ring, &i[0]));
+    test_uint_eq(ring_put_n(ring, &i[1], 4), 3);
+    test_uint_eq(ring_size(ring), 4);
+    test_int_eq(*(int *)ring_peek_head(ring), i[3]);
+}
+
+TEST_CASE(ring_put_n__modulo)
+{
+    int elems[3];
+
+    test_ptr_success(ring = ring_new_c(3, sizeof(int)));
+    test_uint_eq(ring_put_n(ring, i, 2), 2);
+    test_uint_eq(ring_get_n(ring, NULL, 2), 2);
+    test_uint_eq(ring_put_n(ring, &i[2], 3), 3); // wraps around
+    test_int_eq(*(int *)ring_peek(ring), i[2]);
+    test_int_eq(*(int *)ring_peek_head(ring), i[4]);
+    test_uint_eq(ring_get_n(ring, elems, 3), 3);
+    test_int_eq(elems[0], i[2]);
+    test_int_eq(elems[1], i[3]);
+    test_int_eq(elems[2], i[4]);
+    test_void(ring_free(ring));
+}
+
+TEST_CASE_FIX(ring_put_n__full, ring_new, ring_free)
+{
+    test_rc_error(ring_put_n(ring, i, 2), 0, E_RING_FULL);
+    test_uint_eq(ring_size(ring), 4);
+}
+
 TEST_CASE_ABORT(ring_put_overwrite__invalid_magic)
 {
     ring_put_overwrite((ring_ct)&not_a_ring, NULL, NULL);
@@ -592,6 +725,164 @@ TEST_CASE_FIX(ring_get_p, ring_new_ptr, ring_free)
     test_ptr_eq(j, pi[0]);
 }
 
+TEST_CASE_ABORT(ring_peek_span__invalid_magic)
+{
+    size_t n;
+
+    ring_peek_span((ring_ct)&not_a_ring, &n);
+}
+
+TEST_CASE_FIX(ring_peek_span__empty, ring_new_empty, ring_free)
+{
+    size_t n;
+
+    test_ptr_error(ring_peek_span(ring, &n), E_RING_EMPTY);
+}
+
+TEST_CASE_FIX(ring_peek_span, ring_new, ring_free)
+{
+    size_t n;
+
+    test_uint_eq(ring_get_n(ring, NULL, 2), 2);
+    test_uint_eq(ring_put_n(ring, i, 1), 1);
+    test_ptr_success(j = ring_peek_span(ring, &n));
+    test_uint_eq(n, 2); // stops at end of memory
+    test_int_eq(j[0], i[2]);
+    test_int_eq(j[1], i[3]);
+}
+
+TEST_CASE_ABORT(ring_reserve_span__invalid_magic)
+{
+    size_t n;
+
+    ring_reserve_span((ring_ct)&not_a_ring, &n);
+}
+
+TEST_CASE_FIX(ring_reserve_span__full, ring_new, ring_free)
+{
+    size_t n;
+
+    test_ptr_error(ring_reserve_span(ring, &n), E_RING_FULL);
+}
+
+TEST_CASE_FIX(ring_reserve_span, ring_new_empty, ring_free)
+{
+    size_t n;
+
+    test_ptr_success(j = ring_reserve_span(ring, &n));
+    test_uint_eq(n, 4);
+    j[0] = i[0];
+    j[1] = i[1];
+    test_void(ring_commit_span(ring, 2));
+    test_uint_eq(ring_size(ring), 2);
+    test_uint_eq(ring_get_n(ring, NULL, 1), 1);
+
+    test_ptr_success(j = ring_reserve_span(ring, &n));
+    test_uint_eq(n, 2); // stops at end of memory
+    test_ptr_eq(j, (int *)ring_peek(ring) + 1);
+}
+
+TEST_CASE(ring_mirror_span)
+{
+    size_t cap, n, k;
+    char *span;
+
+    test_ptr_success(ring = ring_new_mirror(1, 1));
+    cap = ring_capacity(ring);
+
+    // move tail close to end of memory
+    test_uint_eq(ring_put_n(ring, NULL, cap - 3), cap - 3);
+    test_uint_eq(ring_get_n(ring, NULL, cap - 3), cap - 3);
+
+    test_ptr_success(span = ring_reserve_span(ring, &n));
+    test_uint_eq(n, cap);
+
+    for(k = 0; k < 10; k++)
+        span[k] = 'a' + k;
+
+    test_void(ring_commit_span(ring, 10));
+    test_ptr_success(span = ring_peek_span(ring, &n));
+    test_uint_eq(n, 10);
+    test_mem_eq(span, "abcdefghij", 10);
+    test_int_eq(*(char *)ring_peek_head(ring), 'j');
+
+    test_ptr_success(ring2 = ring_clone(ring));
+    test_ptr_success(span = ring_peek_span(ring2, &n));
+    test_uint_eq(n, 10);
+    test_mem_eq(span, "abcdefghij", 10);
+
+    test_void(ring_free(ring2));
+    test_void(ring_free(ring));
+}
+
+TEST_CASE_ABORT(ring_peek_n__invalid_magic)
+{
+    ring_peek_n((ring_ct)&not_a_ring, &k, 1);
+}
+
+TEST_CASE_FIX(ring_peek_n__empty, ring_new_empty, ring_free)
+{
+    int elems[2];
+
+    test_rc_error(ring_peek_n(ring, elems, 2), 0, E_RING_EMPTY);
+}
+
+TEST_CASE_FIX(ring_peek_n, ring_new, ring_free)
+{
+    int elems[5];
+
+    test_int_success(ring_drop(ring));
+    test_ptr_success(ring_put_e(ring, &i[4]));
+    test_uint_eq(ring_peek_n(ring, elems, 5), 4); // wraps around
+    test_uint_eq(ring_size(ring), 4);
+    test_int_eq(elems[0], i[1]);
+    test_int_eq(elems[2], i[3]);
+    test_int_eq(elems[3], i[4]);
+}
+
+TEST_CASE_FIX_ABORT(ring_peek_n__concurrent, ring_new_mpmc, ring_free)
+{
+    ring_peek_n(ring, &k, 1);
+}
+
+TEST_CASE_ABORT(ring_get_n__invalid_magic)
+{
+    ring_get_n((ring_ct)&not_a_ring, NULL, 1);
+}
+
+TEST_CASE_FIX(ring_get_n__empty, ring_new_empty, ring_free)
+{
+    int elems[2];
+
+    test_rc_error(ring_get_n(ring, elems, 2), 0, E_RING_EMPTY);
+}
+
+TEST_CASE_FIX(ring_get_n, ring_new, ring_free)
+{
+    int elems[5];
+
+    test_uint_eq(ring_get_n(ring, elems, 3), 3);
+    test_uint_eq(ring_size(ring), 1);
+    test_int_eq(elems[0], i[0]);
+    test_int_eq(elems[2], i[2]);
+
+    test_uint_eq(ring_put_n(ring, &i[4], 1), 1);
+    test_uint_eq(ring_put_n(ring, i, 2), 2);
+    test_uint_eq(ring_get_n(ring, elems, 5), 4); // wraps around
+    test_true(ring_is_empty(ring));
+    test_int_eq(elems[0], i[3]);
+    test_int_eq(elems[1], i[4]);
+    test_int_eq(elems[2], i[0]);
+    test_int_eq(elems[3], i[1]);
+}
+
+TEST_CASE_FIX(ring_get_n__drop, ring_new, ring_free)
+{
+    test_uint_eq(ring_get_n(ring, NULL, 2), 2);
+    test_uint_eq(ring_size(ring), 2);
+    test_int_eq(*(int *)ring_peek(ring), i[2]);
+}
+
 TEST_CASE_ABORT(ring_peek_head__invalid_magic)
 {
     ring_peek_head((ring_ct)&not_a_ring);
@@ -749,11 +1040,460 @@ TEST_CASE_FIX(ring_fold_r, ring_new, ring_free)
     test_int_eq(sum, 4321);
 }
 
+TEST_CASE_FIX(ring_spsc, ring_new_spsc, ring_free)
+{
+    int elems[5];
+
+    test_uint_eq(ring_capacity(ring), 4);
+    test_ptr_success(ring_put_e(ring, &i[0]));
+    test_uint_eq(ring_put_n(ring, &i[1], 4), 3);
+    test_ptr_error(ring_put_e(ring, &i[4]), E_RING_FULL);
+    test_uint_eq(ring_size(ring), 4);
+
+    test_int_success(ring_get(ring, &k));
+    test_int_eq(k, i[0]);
+    test_uint_eq(ring_put_n(ring, &i[4], 1), 1); // wraps around
+    test_uint_eq(ring_get_n(ring, elems, 5), 4);
+    test_int_eq(elems[0], i[1]);
+    test_int_eq(elems[3], i[4]);
+    test_int_error(ring_get(ring, &k), E_RING_EMPTY);
+    test_true(ring_is_empty(ring));
+}
+
+TEST_CASE_FIX(ring_spsc_free_if_empty, ring_new_spsc, ring_free)
+{
+    test_uint_eq(ring_put_n(ring, i, 2), 2);
+    count = 0;
+    test_ptr_eq(ring_free_if_empty_f(ring, test_ring_dtor, &count), ring);
+    test_int_eq(count, 0);
+    test_uint_eq(ring_size(ring), 2);
+}
+
+TEST_CASE_FIX(ring_mpmc, ring_new_mpmc, ring_free)
+{
+    int elems[5];
+
+    test_uint_eq(ring_capacity(ring), 4);
+    test_ptr_success(ring_put_e(ring, &i[0]));
+    test_uint_eq(ring_put_n(ring, &i[1], 4), 3);
+    test_ptr_error(ring_put_e(ring, &i[4]), E_RING_FULL);
+    test_uint_eq(ring_size(ring), 4);
+
+    test_int_success(ring_get(ring, &k));
+    test_int_eq(k, i[0]);
+    test_uint_eq(ring_put_n(ring, &i[4], 1), 1); // wraps around
+    test_uint_eq(ring_get_n(ring, elems, 5), 4);
+    test_int_eq(elems[0], i[1]);
+    test_int_eq(elems[3], i[4]);
+    test_int_error(ring_get(ring, &k), E_RING_EMPTY);
+    test_true(ring_is_empty(ring));
+}
+
+TEST_CASE(ring_mpmc_ptr)
+{
+    test_ptr_success(ring = ring_new_mpmc(4, sizeof(int *)));
+    test_ptr_eq(ring_put_e(ring, &pi[2]), &pi[2]);
+    test_ptr_eq(ring_get_p(ring), pi[2]);
+    test_ptr_error(ring_get_p(ring), E_RING_EMPTY);
+    test_void(ring_free(ring));
+}
+
+TEST_CASE_FIX(ring_mpmc_clear_f, ring_new_mpmc, ring_free)
+{
+    test_uint_eq(ring_put_n(ring, i, 3), 3);
+    count = 0;
+    test_void(ring_clear_f(ring, test_ring_dtor, &count));
+    test_int_eq(count, 3);
+    test_true(ring_is_empty(ring));
+    test_uint_eq(ring_put_n(ring, i, 5), 4);
+}
+
+TEST_CASE_FIX_ABORT(ring_mpmc_peek, ring_new_mpmc, ring_free)
+{
+    ring_peek(ring);
+}
+
+TEST_CASE_FIX_ABORT(ring_mpmc_put, ring_new_mpmc, ring_free)
+{
+    ring_put(ring);
+}
+
+TEST_CASE_FIX_ABORT(ring_mpmc_put_p, ring_new_mpmc, ring_free)
+{
+    ring_put_p(ring, pi[2]);
+}
+
+TEST_CASE_FIX_ABORT(ring_mpmc_put_overwrite, ring_new_mpmc, ring_free)
+{
+    ring_put_overwrite(ring, NULL, NULL);
+}
+
+TEST_CASE_FIX_ABORT(ring_mpmc_fold, ring_new_mpmc, ring_free)
+{
+    ring_fold(ring, test_ring_fold, &count);
+}
+
+#define THREAD_ITEMS    (1 << 14)   ///< number of items per producer thread
+#define THREAD_BATCH    16          ///< number of items per batch
+
+/// concurrent ring test state
+typedef struct test_ring_thread
+{
+    ring_ct     ring;           ///< concurrent ring
+    size_t      id;             ///< producer ID
+    size_t      items;          ///< number of items to put or get
+    size_t      batch;          ///< batch size
+    uint64_t    sum;            ///< sum of gotten items
+    bool        ordered;        ///< items of each producer were gotten in order
+    size_t      last[16];       ///< last gotten item per producer
+} test_ring_thread_st;
+
+/// Back off while ring is full or empty.
+///
+/// Yield first and sleep if still blocked to let preempted threads
+/// finish their commit on machines with less cores than threads.
+///
+/// \param tries    number of previous tries
+static void test_ring_backoff(size_t tries)
+{
+    if(tries < 16)
+        sched_yield();
+    else
+        nanosleep(&(struct timespec){ .tv_nsec = 10000 }, NULL);
+}
+
+static void *test_ring_producer(void *ctx)
+{
+    test_ring_thread_st *state = ctx;
+    uint64_t items[THREAD_BATCH];
+    size_t k, n, b, tries;
+
+    for(k = 0; k < state->items; k += n)
+    {
+        b = MIN(state->batch, state->items - k);
+
+        for(n = 0; n < b; n++)
+            items[n] = (uint64_t)state->id << 32 | (k + n + 1);
+
+        for(tries = 0; !(n = ring_put_n(state->ring, items, b)); tries++)
+            test_ring_backoff(tries);
+    }
+
+    return NULL;
+}
+
+static void *test_ring_consumer(void *ctx)
+{
+    test_ring_thread_st *state = ctx;
+    uint64_t items[THREAD_BATCH];
+    size_t k, n, id, tries;
+
+    state->ordered = true;
+
+    for(k = 0; k < state->items; k += n)
+    {
+        for(tries = 0; !(n = ring_get_n(state->ring, items, MIN(state->batch, state->items - k))); tries++)
+            test_ring_backoff(tries);
+
+        for(size_t m = 0; m < n; m++)
+        {
+            id = items[m] >> 32;
+
+            if(id < ELEMS(state->last))
+            {
+                state->ordered &= (items[m] & UINT32_MAX) > state->last[id];
+                state->last[id] = items[m] & UINT32_MAX;
+            }
+
+            state->sum += items[m] & UINT32_MAX;
+        }
+    }
+
+    return NULL;
+}
+
+/// Run producers and consumers over concurrent ring.
+///
+/// \param ring         concurrent ring of uint64_t
+/// \param producers    number of producer threads
+/// \param consumers    number of consumer threads, must divide total items
+/// \param batch        batch size
+/// \param sum          sum of all gotten items
+///
+/// \retval true        all items were gotten, each producer's in order
+/// \retval false       thread error or items lost, duplicated or reordered
+static bool test_ring_threads(ring_ct ring, size_t producers, size_t consumers, size_t batch, uint64_t *sum)
+{
+    test_ring_thread_st prod[producers], cons[consumers];
+    pthread_t prod_threads[producers], cons_threads[consumers];
+    size_t p, c;
+    bool ok = true;
+
+    memset(prod, 0, sizeof(prod));
+    memset(cons, 0, sizeof(cons));
+
+    for(c = 0; c < consumers; c++)
+    {
+        cons[c].ring    = ring;
+        cons[c].items   = THREAD_ITEMS * producers / consumers;
+        cons[c].batch   = batch;
+
+        if(pthread_create(&cons_threads[c], NULL, test_ring_consumer, &cons[c]))
+            return false;
+    }
+
+    for(p = 0; p < producers; p++)
+    {
+        prod[p].ring    = ring;
+        prod[p].id      = p;
+        prod[p].items   = THREAD_ITEMS;
+        prod[p].batch   = batch;
+
+        if(pthread_create(&prod_threads[p], NULL, test_ring_producer, &prod[p]))
+            return false;
+    }
+
+    for(p = 0; p < producers; p++)
+        pthread_join(prod_threads[p], NULL);
+
+    for(*sum = 0, c = 0; c < consumers; c++)
+    {
+        pthread_join(cons_threads[c], NULL);
+        *sum   += cons[c].sum;
+        ok     &= cons[c].ordered;
+    }
+
+    return ok && ring_is_empty(ring);
+}
+
+/// sum of all items put by producers
+#define THREAD_SUM(producers) ((uint64_t)(producers) * THREAD_ITEMS * (THREAD_ITEMS + 1) / 2)
+
+TEST_CASE(ring_spsc_threads)
+{
+    uint64_t sum;
+
+    test_ptr_success(ring = ring_new_spsc(64, sizeof(uint64_t)));
+    test_true(test_ring_threads(ring, 1, 1, 1, &sum));
+    test_uint_eq(sum, THREAD_SUM(1));
+    test_true(test_ring_threads(ring, 1, 1, THREAD_BATCH, &sum));
+    test_uint_eq(sum, THREAD_SUM(1));
+    test_void(ring_free(ring));
+}
+
+TEST_CASE(ring_mpmc_threads)
+{
+    uint64_t sum;
+
+    test_ptr_success(ring = ring_new_mpmc(64, sizeof(uint64_t)));
+    test_true(test_ring_threads(ring, 4, 1, 1, &sum));
+    test_uint_eq(sum, THREAD_SUM(4));
+    test_true(test_ring_threads(ring, 4, 4, THREAD_BATCH, &sum));
+    test_uint_eq(sum, THREAD_SUM(4));
+    test_void(ring_free(ring));
+}
+
+/// mutex guarded ring to compare against
+typedef struct test_ring_locked
+{
+    ring_ct         ring;       ///< ring
+    pthread_mutex_t lock;       ///< ring lock
+    size_t          items;      ///< number of items to put or get
+} test_ring_locked_st;
+
+static void *test_ring_locked_producer(void *ctx)
+{
+    test_ring_locked_st *state = ctx;
+    size_t k;
+    void *elem;
+
+    for(k = 0; k < state->items; k++)
+    {
+        do
+        {
+            pthread_mutex_lock(&state->lock);
+            elem = ring_put_e(state->ring, &k);
+            pthread_mutex_unlock(&state->lock);
+        }
+        while(!elem && (sched_yield(), true));
+    }
+
+    return NULL;
+}
+
+/// Put items from producers and get them in calling thread with mutex.
+///
+/// \param producers    number of producer threads
+///
+/// \returns            ns per item, -1 on error
+static double test_ring_bench_locked(size_t producers)
+{
+    test_ring_locked_st state = { .items = THREAD_ITEMS };
+    pthread_t threads[producers];
+    struct timespec start, end;
+    size_t p, k, item;
+    int rc;
+
+    if(!(state.ring = ring_new_c(1024, sizeof(size_t))))
+        return -1;
+
+    pthread_mutex_init(&state.lock, NULL);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for(p = 0; p < producers; p++)
+        pthread_create(&threads[p], NULL, test_ring_locked_producer, &state);
+
+    for(k = 0; k < producers * THREAD_ITEMS;)
+    {
+        pthread_mutex_lock(&state.lock);
+        rc = ring_get(state.ring, &item);
+        pthread_mutex_unlock(&state.lock);
+
+        if(rc)
+            sched_yield();
+        else
+            k++;
+    }
+
+    for(p = 0; p < producers; p++)
+        pthread_join(threads[p], NULL);
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    pthread_mutex_destroy(&state.lock);
+    ring_free(state.ring);
+    error_clear();
+
+    return ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / (producers * THREAD_ITEMS);
+}
+
+/// Put items from producers and get them with one consumer.
+///
+/// \param ring         concurrent ring of uint64_t
+/// \param producers    number of producer threads
+/// \param batch        batch size
+///
+/// \returns            ns per item, -1 on error
+static double test_ring_bench(ring_ct ring, size_t producers, size_t batch)
+{
+    struct timespec start, end;
+    uint64_t sum;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    if(!test_ring_threads(ring, producers, 1, batch, &sum) || sum != THREAD_SUM(producers))
+        return -1;
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    return ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / (producers * THREAD_ITEMS);
+}
+
+TEST_CASE(ring_bench_spsc)
+{
+    double ns;
+
+    test_ptr_success(ring = ring_new_spsc(1024, sizeof(uint64_t)));
+    test_true((ns = test_ring_bench_locked(1)) >= 0);
+    test_msg_info("mutex: %.1f ns/item", ns);
+    test_true((ns = test_ring_bench(ring, 1, 1)) >= 0);
+    test_msg_info("spsc: %.1f ns/item", ns);
+    test_true((ns = test_ring_bench(ring, 1, THREAD_BATCH)) >= 0);
+    test_msg_info("spsc batch %d: %.1f ns/item", THREAD_BATCH, ns);
+    test_void(ring_free(ring));
+}
+
+TEST_CASE(ring_bench_mpmc)
+{
+    size_t producers;
+    double ns;
+
+    test_ptr_success(ring = ring_new_mpmc(1024, sizeof(uint64_t)));
+
+    for(producers = 1; producers <= 16; producers *= 2)
+    {
+        test_true((ns = test_ring_bench_locked(producers)) >= 0);
+        test_msg_info("%2zu producers, mutex: %.1f ns/item", producers, ns);
+        test_true((ns = test_ring_bench(ring, producers, 1)) >= 0);
+        test_msg_info("%2zu producers, mpmc: %.1f ns/item", producers, ns);
+        test_true((ns = test_ring_bench(ring, producers, THREAD_BATCH)) >= 0);
+        test_msg_info("%2zu producers, mpmc batch %d: %.1f ns/item", producers, THREAD_BATCH, ns);
+    }
+
+    test_void(ring_free(ring));
+}
+
+#define BENCH_BYTES     (1 << 22)   ///< number of bytes to stream through ring
+#define BENCH_CHUNK     1500        ///< number of bytes per put and get
+
+/// Stream bytes through ring.
+///
+/// \param capacity     ring capacity
+/// \param pow2         create ring with power of 2 capacity
+/// \param bulk         use ring_put_n() and ring_get_n()
+///
+/// \returns            ns per byte, -1 on error
+static double test_ring_bench_bytes(size_t capacity, bool pow2, bool bulk)
+{
+    static char in[BENCH_CHUNK], out[BENCH_CHUNK];
+    clock_t start;
+    size_t k, n, m;
+    ring_ct ring;
+
+    if(!(ring = pow2 ? ring_new_pow2(capacity, 1) : ring_new_c(capacity, 1)))
+        return -1;
+
+    start = clock();
+
+    for(k = 0; k < BENCH_BYTES; k += BENCH_CHUNK)
+    {
+        if(bulk)
+        {
+            n = ring_put_n(ring, in, BENCH_CHUNK);
+            m = ring_get_n(ring, out, n);
+        }
+        else
+        {
+            for(n = 0; n < BENCH_CHUNK && ring_put_e(ring, &in[n]); n++);
+            for(m = 0; m < n && !ring_get(ring, &out[m]); m++);
+        }
+
+        if(n != BENCH_CHUNK || m != n)
+            return ring_free(ring), -1;
+    }
+
+    start = clock() - start;
+    ring_free(ring);
+
+    return (double)start * 1e9 / CLOCKS_PER_SEC / BENCH_BYTES;
+}
+
+TEST_CASE(ring_bench_bytes)
+{
+    double ns;
+
+    test_true((ns = test_ring_bench_bytes(4000, false, false)) >= 0);
+    test_msg_info("modulo, put_e/get: %.2f ns/byte", ns);
+    test_true((ns = test_ring_bench_bytes(4000, true, false)) >= 0);
+    test_msg_info("mask, put_e/get: %.2f ns/byte", ns);
+    test_true((ns = test_ring_bench_bytes(4000, false, true)) >= 0);
+    test_msg_info("modulo, put_n/get_n: %.2f ns/byte", ns);
+    test_true((ns = test_ring_bench_bytes(4000, true, true)) >= 0);
+    test_msg_info("mask, put_n/get_n: %.2f ns/byte", ns);
+}
+
 int test_suite_con_ring(void *param)
 {
     return error_pass_int(test_run_cases("ring",
         test_case(ring_new__invalid_elemsize),
         test_case(ring_new_c__invalid_elemsize),
+        test_case(ring_new_pow2__invalid_elemsize),
+        test_case(ring_new_pow2),
+        test_case(ring_new_mirror__invalid_elemsize),
+        test_case(ring_new_mirror),
+        test_case(ring_new_spsc__invalid_elemsize),
+        test_case(ring_new_spsc),
+        test_case(ring_new_mpmc__invalid_elemsize),
+        test_case(ring_new_mpmc),
         test_case(ring_free__invalid_magic),
         test_case(ring_free_f__invalid_magic),
         test_case(ring_free_f),
@@ -799,6 +1539,12 @@ int test_suite_con_ring(void *param)
         test_case(ring_put_p__invalid_type),
         test_case(ring_put_p),
         test_case(ring_put_p__overflow),
+        test_case(ring_put_n__invalid_magic),
+        test_case(ring_put_n),
+        test_case(ring_put_n__empty_elems),
+        test_case(ring_put_n__partial),
+        test_case(ring_put_n__modulo),
+        test_case(ring_put_n__full),
         test_case(ring_put_overwrite__invalid_magic),
         test_case(ring_put_overwrite),
         test_case(ring_put_overwrite__overflow),
@@ -830,6 +1576,21 @@ int test_suite_con_ring(void *param)
         test_case(ring_get_p__invalid_type),
         test_case(ring_get_p__empty),
         test_case(ring_get_p),
+        test_case(ring_peek_span__invalid_magic),
+        test_case(ring_peek_span__empty),
+        test_case(ring_peek_span),
+        test_case(ring_reserve_span__invalid_magic),
+        test_case(ring_reserve_span__full),
+        test_case(ring_reserve_span),
+        test_case(ring_mirror_span),
+        test_case(ring_peek_n__invalid_magic),
+        test_case(ring_peek_n__empty),
+        test_case(ring_peek_n),
+        test_case(ring_peek_n__concurrent),
+        test_case(ring_get_n__invalid_magic),
+        test_case(ring_get_n__empty),
+        test_case(ring_get_n),
+        test_case(ring_get_n__drop),
 
         test_case(ring_peek_head__invalid_magic),
         test_case(ring_peek_head__empty),
@@ -859,6 +1620,22 @@ int test_suite_con_ring(void *param)
         test_case(ring_fold_r__invalid_callback),
         test_case(ring_fold_r),
 
+        test_case(ring_spsc),
+        test_case(ring_spsc_free_if_empty),
+        test_case(ring_mpmc),
+        test_case(ring_mpmc_ptr),
+        test_case(ring_mpmc_clear_f),
+        test_case(ring_mpmc_peek),
+        test_case(ring_mpmc_put),
+        test_case(ring_mpmc_put_p),
+        test_case(ring_mpmc_put_overwrite),
+        test_case(ring_mpmc_fold),
+        test_case(ring_spsc_threads),
+        test_case(ring_mpmc_threads),
+        test_case(ring_bench_spsc),
+        test_case(ring_bench_mpmc),
+        test_case(ring_bench_bytes),
+
         NULL
     ));
 }
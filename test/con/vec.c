@@ -24,8 +24,13 @@
 #include <ytil/test/run.h>
 #include <ytil/test/test.h>
 #include <ytil/con/vec.h>
+#include <ytil/def.h>
 #include <string.h>
 #include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+
+#define VEC_BENCH_SIZE  (1 << 20)   ///< number of elements in benchmarks
 
 static const struct not_a_vector
 {
@@ -36,6 +41,7 @@ static const int i[] = { 1, 2, 33, 4, 5, 6, 7, 33, 9, 10 };
 static const int *pi[] = { &i[0], &i[1], &i[2], &i[3], &i[4], &i[5], &i[6], &i[2], &i[8], &i[9] };
 static int j[10], *k, **pk, count;
 static vec_ct vec;
+static max_align_t inline_buf[16];
 
 
 TEST_SETUP(vec_new_int)
@@ -78,6 +84,11 @@ TEST_SETUP(vec_new_ptr10)
     test_ptr_success(vec_push_en(vec, 10, pi));
 }
 
+TEST_SETUP(vec_new_inline_int)
+{
+    test_ptr_success(vec = vec_init_inline(inline_buf, 4, sizeof(int)));
+}
+
 TEST_TEARDOWN(vec_free)
 {
     test_void(vec_free(vec));
@@ -93,6 +104,77 @@ TEST_CASE_ABORT(vec_new_c_invalid_elemsize)
     test_void(vec_new_c(1, 0));
 }
 
+TEST_CASE_ABORT(vec_init_inline_invalid_elemsize)
+{
+    test_void(vec_init_inline(inline_buf, 4, 0));
+}
+
+static bool test_vec_is_inline(void)
+{
+    char *elem = vec_at(vec, 0);
+
+    return elem > (char *)inline_buf && elem < (char *)inline_buf + sizeof(inline_buf);
+}
+
+TEST_CASE(vec_inline_size)
+{
+    test_uint_le(vec_inline_size(4, sizeof(int)), sizeof(inline_buf));
+    test_uint_eq(vec_inline_size(5, sizeof(int)), vec_inline_size(4, sizeof(int)) + sizeof(int));
+}
+
+TEST_CASE_FIX(vec_inline_push, vec_new_inline_int, vec_free)
+{
+    test_uint_eq(vec_capacity(vec), 4);
+    test_ptr_success(vec_push_en(vec, 4, i));
+    test_uint_eq(vec_capacity(vec), 4);
+    test_true(test_vec_is_inline());
+    test_int_list_eq((int *)vec_at(vec, 0), i, 4);
+}
+
+TEST_CASE_FIX(vec_inline_spill, vec_new_inline_int, vec_free)
+{
+    test_ptr_success(vec_push_en(vec, 10, i));
+    test_uint_ge(vec_capacity(vec), 10);
+    test_false(test_vec_is_inline());
+    test_int_list_eq((int *)vec_at(vec, 0), i, 10);
+}
+
+TEST_CASE_FIX(vec_inline_shrink, vec_new_inline_int, vec_free)
+{
+    test_ptr_success(vec_push_en(vec, 10, i));
+    test_uint_eq(vec_truncate(vec, 2), 8);
+    test_int_success(vec_set_capacity(vec, 0));
+    test_uint_eq(vec_capacity(vec), 4);
+    test_true(test_vec_is_inline());
+    test_int_list_eq((int *)vec_at(vec, 0), i, 2);
+}
+
+TEST_CASE_FIX(vec_inline_clear, vec_new_inline_int, vec_free)
+{
+    test_ptr_success(vec_push_en(vec, 10, i));
+    test_void(vec_clear(vec));
+    test_uint_eq(vec_size(vec), 0);
+    test_uint_eq(vec_capacity(vec), 4);
+    test_ptr_success(vec_push_en(vec, 3, i));
+    test_true(test_vec_is_inline());
+}
+
+TEST_CASE_FIX(vec_inline_get_buffer, vec_new_inline_int, vec_free)
+{
+    void *buf;
+    size_t size;
+
+    test_ptr_success(vec_push_en(vec, 3, i));
+    test_int_success(vec_get_buffer(vec, &buf, &size, NULL));
+    test_uint_eq(size, 3);
+    test_uint_eq(vec_capacity(vec), 0);
+    test_int_list_eq((int *)buf, i, 3);
+    test_void(free(buf));
+
+    test_ptr_success(vec_push_en(vec, 2, i));
+    test_true(test_vec_is_inline());
+}
+
 TEST_CASE_ABORT(vec_elemsize_invalid_magic)
 {
     vec_elemsize((vec_const_ct)&not_a_vector);
@@ -2350,6 +2432,18 @@ TEST_CASE_FIX(vec_get_buffer, vec_new_int10, vec_free)
     test_void(free(buf));
 }
 
+TEST_CASE_ABORT(vec_clear_invalid_magic)
+{
+    vec_clear((vec_ct)&not_a_vector);
+}
+
+TEST_CASE_FIX(vec_clear, vec_new_int10, vec_free)
+{
+    test_void(vec_clear(vec));
+    test_uint_eq(vec_size(vec), 0);
+    test_uint_eq(vec_capacity(vec), 5);
+}
+
 TEST_CASE_ABORT(vec_truncate_invalid_magic)
 {
     vec_truncate((vec_ct)&not_a_vector, 1);
@@ -2424,6 +2518,179 @@ TEST_CASE_FIX(vec_set_capacity_f_below_current_capacity, vec_new_int10, vec_free
     test_int_eq(count, 5);
 }
 
+TEST_CASE_ABORT(vec_set_growth_invalid_magic)
+{
+    vec_set_growth((vec_ct)&not_a_vector, VEC_GROWTH_POW2, 0);
+}
+
+TEST_CASE_FIX_ABORT(vec_set_growth_invalid_factor, vec_new_int, vec_free)
+{
+    vec_set_growth(vec, VEC_GROWTH_FACTOR, 1);
+}
+
+TEST_CASE_FIX_ABORT(vec_set_growth_invalid_step, vec_new_int, vec_free)
+{
+    vec_set_growth(vec, VEC_GROWTH_STEP, 0);
+}
+
+static bool test_vec_fill(vec_ct vec, size_t n)
+{
+    for(size_t k = vec_size(vec); k < n; k++)
+        if(!vec_push_e(vec, &k))
+            return false;
+
+    return true;
+}
+
+static bool test_vec_check(vec_const_ct vec)
+{
+    for(size_t k = 0; k < vec_size(vec); k++)
+        if(*(size_t *)vec_at(vec, k) != k)
+            return false;
+
+    return true;
+}
+
+TEST_CASE(vec_growth_default)
+{
+    test_ptr_success(vec = vec_new_c(5, sizeof(size_t)));
+
+    test_true(test_vec_fill(vec, 6));
+    test_uint_eq(vec_capacity(vec), 10);
+    test_true(test_vec_fill(vec, 11));
+    test_uint_eq(vec_capacity(vec), 20);
+    test_true(test_vec_check(vec));
+
+    vec_free(vec);
+}
+
+TEST_CASE(vec_set_growth_factor)
+{
+    test_ptr_success(vec = vec_new_c(5, sizeof(size_t)));
+    vec_set_growth(vec, VEC_GROWTH_FACTOR, 3);
+
+    test_true(test_vec_fill(vec, 6));
+    test_uint_eq(vec_capacity(vec), 15);
+    test_true(test_vec_fill(vec, 16));
+    test_uint_eq(vec_capacity(vec), 45);
+    test_true(test_vec_check(vec));
+
+    vec_truncate(vec, 7);
+    test_uint_eq(vec_capacity(vec), 15);
+    test_true(test_vec_check(vec));
+
+    vec_free(vec);
+}
+
+TEST_CASE(vec_set_growth_step)
+{
+    test_ptr_success(vec = vec_new_c(5, sizeof(size_t)));
+    vec_set_growth(vec, VEC_GROWTH_STEP, 4);
+
+    test_true(test_vec_fill(vec, 6));
+    test_uint_eq(vec_capacity(vec), 9);
+    test_true(test_vec_fill(vec, 20));
+    test_uint_eq(vec_capacity(vec), 21);
+    test_true(test_vec_check(vec));
+
+    vec_truncate(vec, 12);
+    test_uint_eq(vec_capacity(vec), 17);
+    test_true(test_vec_check(vec));
+
+    vec_free(vec);
+}
+
+TEST_CASE(vec_set_growth_pow2)
+{
+    test_ptr_success(vec = vec_new_c(5, sizeof(size_t)));
+    vec_set_growth(vec, VEC_GROWTH_POW2, 0);
+
+    test_true(test_vec_fill(vec, 6));
+    test_uint_eq(vec_capacity(vec), 8);
+    test_true(test_vec_fill(vec, 100));
+    test_uint_eq(vec_capacity(vec), 128);
+    test_true(test_vec_check(vec));
+
+    vec_truncate(vec, 20);
+    test_uint_eq(vec_capacity(vec), 64);
+    test_true(test_vec_check(vec));
+
+    vec_free(vec);
+}
+
+TEST_CASE_FIX(vec_set_growth_pow2_overflow, no_setup, vec_free)
+{
+    test_ptr_success(vec = vec_new_c(5, 1));
+    vec_set_growth(vec, VEC_GROWTH_POW2, 0);
+
+    test_ptr_error(vec_push_n(vec, SIZE_MAX / 2 + 2), E_GENERIC_OOM);
+    test_uint_eq(vec_size(vec), 0);
+}
+
+TEST_CASE_ABORT(vec_set_mmap_invalid_magic)
+{
+    vec_set_mmap((vec_ct)&not_a_vector, 4096);
+}
+
+TEST_CASE(vec_set_mmap)
+{
+    test_ptr_success(vec = vec_new_c(5, sizeof(size_t)));
+    test_int_success(vec_set_mmap(vec, 4096));
+
+    test_true(test_vec_fill(vec, 100));
+    test_true(test_vec_fill(vec, 10000)); // heap to mapping
+    test_true(test_vec_fill(vec, 100000)); // remap
+    test_true(test_vec_check(vec));
+
+    test_int_success(vec_set_capacity(vec, 100000));
+    test_uint_eq(vec_capacity(vec), 100000);
+    test_true(test_vec_check(vec));
+
+    vec_truncate(vec, 10);
+    test_int_success(vec_set_capacity(vec, 10)); // mapping to heap
+    test_uint_eq(vec_capacity(vec), 10);
+    test_true(test_vec_check(vec));
+
+    vec_free(vec);
+}
+
+TEST_CASE(vec_set_mmap_existing)
+{
+    test_ptr_success(vec = vec_new_c(5, sizeof(size_t)));
+    test_true(test_vec_fill(vec, 10000));
+
+    test_int_success(vec_set_mmap(vec, 4096)); // heap to mapping
+    test_true(test_vec_check(vec));
+    test_true(test_vec_fill(vec, 20000));
+    test_true(test_vec_check(vec));
+
+    test_int_success(vec_set_mmap(vec, 0)); // mapping to heap
+    test_true(test_vec_check(vec));
+
+    vec_free(vec);
+}
+
+TEST_CASE(vec_set_mmap_get_buffer)
+{
+    size_t *buf, size, cap;
+
+    test_ptr_success(vec = vec_new_c(5, sizeof(size_t)));
+    test_int_success(vec_set_mmap(vec, 4096));
+    test_true(test_vec_fill(vec, 10000));
+
+    test_int_success(vec_get_buffer(vec, (void **)&buf, &size, &cap));
+    test_uint_eq(size, 10000);
+    test_uint_eq(buf[0], 0);
+    test_uint_eq(buf[9999], 9999);
+    free(buf);
+
+    test_uint_eq(vec_size(vec), 0);
+    test_true(test_vec_fill(vec, 10000));
+    test_true(test_vec_check(vec));
+
+    vec_free(vec);
+}
+
 static int test_vec_fold(vec_const_ct v, size_t index, void *elem, void *ctx)
 {
     int *i = elem, *sum = ctx;
@@ -2497,17 +2764,508 @@ TEST_CASE_FIX(vec_sort, vec_new_int, vec_free)
 
     vec_push_en(vec, 3, i);
     test_void(vec_sort(vec, test_vec_sort, &count));
-    test_int_eq(count, 3);
+    test_int_eq(count, 2);
     test_int_eq(*(int *)vec_at(vec, 0), 1);
     test_int_eq(*(int *)vec_at(vec, 1), 2);
     test_int_eq(*(int *)vec_at(vec, 2), 3);
 }
 
+/// test sort input pattern
+typedef enum test_vec_sort_pattern
+{
+    SORT_RANDOM,        ///< random elements
+    SORT_DUPLICATES,    ///< random elements out of 16 values
+    SORT_ASCENDING,     ///< sorted elements
+    SORT_DESCENDING,    ///< reverse sorted elements
+    SORT_ORGAN,         ///< ascending then descending elements
+} test_vec_sort_pattern_id;
+
+static uint64_t test_vec_sort_seed = 88172645463325252ULL;
+
+static uint64_t test_vec_sort_rand(void)
+{
+    test_vec_sort_seed ^= test_vec_sort_seed << 13;
+    test_vec_sort_seed ^= test_vec_sort_seed >> 7;
+    test_vec_sort_seed ^= test_vec_sort_seed << 17;
+
+    return test_vec_sort_seed;
+}
+
+static int64_t test_vec_sort_value(test_vec_sort_pattern_id pattern, size_t n, size_t k)
+{
+    switch(pattern)
+    {
+    case SORT_RANDOM:       return (int64_t)test_vec_sort_rand();
+    case SORT_DUPLICATES:   return test_vec_sort_rand() % 16;
+    case SORT_ASCENDING:    return k;
+    case SORT_DESCENDING:   return n - k;
+    case SORT_ORGAN:        return k < n / 2 ? k : n - k;
+    default:                abort();
+    }
+}
+
+static int test_vec_sort_i64(const void *elem1, const void *elem2, void *ctx)
+{
+    int64_t i1, i2;
+
+    // elements of odd sizes are not aligned
+    memcpy(&i1, elem1, sizeof(i1));
+    memcpy(&i2, elem2, sizeof(i2));
+
+    return i1 < i2 ? -1 : i1 > i2 ? 1 : 0;
+}
+
+static int test_vec_sort_u64(const void *elem1, const void *elem2, void *ctx)
+{
+    const uint64_t *i1 = elem1, *i2 = elem2;
+
+    return *i1 < *i2 ? -1 : *i1 > *i2 ? 1 : 0;
+}
+
+static int test_vec_sort_i32(const void *elem1, const void *elem2, void *ctx)
+{
+    const int32_t *i1 = elem1, *i2 = elem2;
+
+    return *i1 < *i2 ? -1 : *i1 > *i2 ? 1 : 0;
+}
+
+static int test_vec_sort_u32(const void *elem1, const void *elem2, void *ctx)
+{
+    const uint32_t *i1 = elem1, *i2 = elem2;
+
+    return *i1 < *i2 ? -1 : *i1 > *i2 ? 1 : 0;
+}
+
+/// Fill vector with pattern, elements have an int64_t key at their start.
+static bool test_vec_sort_fill(vec_ct vec, test_vec_sort_pattern_id pattern, size_t n)
+{
+    size_t k, esize = vec_elemsize(vec);
+    int64_t value;
+    char *elem;
+
+    for(k = 0; k < n; k++)
+    {
+        if(!(elem = vec_push(vec)))
+            return false;
+
+        value = test_vec_sort_value(pattern, n, k);
+        memset(elem, 0xab, esize);
+        memcpy(elem, &value, MIN(esize, sizeof(value)));
+    }
+
+    return true;
+}
+
+/// Check vector sorted by \p sort and sum of keys matches.
+static bool test_vec_sort_check(vec_const_ct vec, vec_sort_cb sort)
+{
+    size_t k;
+
+    for(k = 1; k < vec_size(vec); k++)
+        if(sort(vec_at(vec, k - 1), vec_at(vec, k), NULL) > 0)
+            return false;
+
+    return true;
+}
+
+static bool test_vec_sort_pattern(size_t esize, test_vec_sort_pattern_id pattern, size_t n)
+{
+    vec_ct vec;
+    bool rc;
+
+    if(!(vec = vec_new(esize)) || !test_vec_sort_fill(vec, pattern, n))
+        return false;
+
+    vec_sort(vec, test_vec_sort_i64, NULL);
+    rc = test_vec_sort_check(vec, test_vec_sort_i64) && vec_size(vec) == n;
+    vec_free(vec);
+
+    return rc;
+}
+
+TEST_CASE(vec_sort_patterns)
+{
+    test_true(test_vec_sort_pattern(8, SORT_RANDOM, 5000));
+    test_true(test_vec_sort_pattern(8, SORT_DUPLICATES, 5000));
+    test_true(test_vec_sort_pattern(8, SORT_ASCENDING, 5000));
+    test_true(test_vec_sort_pattern(8, SORT_DESCENDING, 5000));
+    test_true(test_vec_sort_pattern(8, SORT_ORGAN, 5000));
+}
+
+TEST_CASE(vec_sort_esize)
+{
+    test_true(test_vec_sort_pattern(16, SORT_RANDOM, 3000));
+    test_true(test_vec_sort_pattern(24, SORT_DUPLICATES, 3000));
+    test_true(test_vec_sort_pattern(100, SORT_RANDOM, 1000));
+}
+
+static bool test_vec_sort_radix(size_t esize, bool sign, test_vec_sort_pattern_id pattern, size_t n)
+{
+    vec_sort_cb sort;
+    vec_ct vec;
+    bool rc;
+    int err;
+
+    if(!(vec = vec_new(esize)) || !test_vec_sort_fill(vec, pattern, n))
+        return false;
+
+    if(esize == 4)
+    {
+        err     = sign ? vec_sort_i32(vec) : vec_sort_u32(vec);
+        sort    = sign ? test_vec_sort_i32 : test_vec_sort_u32;
+    }
+    else
+    {
+        err     = sign ? vec_sort_i64(vec) : vec_sort_u64(vec);
+        sort    = sign ? test_vec_sort_i64 : test_vec_sort_u64;
+    }
+
+    rc = !err && test_vec_sort_check(vec, sort);
+    vec_free(vec);
+
+    return rc;
+}
+
+TEST_CASE_ABORT(vec_sort_u32_invalid_magic)
+{
+    vec_sort_u32((vec_ct)&not_a_vector);
+}
+
+TEST_CASE_FIX_ABORT(vec_sort_u32_invalid_type, vec_new_ptr, vec_free)
+{
+    vec_sort_u32(vec);
+}
+
+TEST_CASE_FIX(vec_sort_u32_empty, vec_new_int, vec_free)
+{
+    test_int_success(vec_sort_u32(vec));
+}
+
+TEST_CASE(vec_sort_u32)
+{
+    test_true(test_vec_sort_radix(4, false, SORT_RANDOM, 5000));
+    test_true(test_vec_sort_radix(4, false, SORT_DUPLICATES, 5000));
+    test_true(test_vec_sort_radix(4, false, SORT_DESCENDING, 5000));
+}
+
+TEST_CASE(vec_sort_u64)
+{
+    test_true(test_vec_sort_radix(8, false, SORT_RANDOM, 5000));
+    test_true(test_vec_sort_radix(8, false, SORT_ORGAN, 5000));
+}
+
+TEST_CASE(vec_sort_i32)
+{
+    test_true(test_vec_sort_radix(4, true, SORT_RANDOM, 5000));
+}
+
+TEST_CASE(vec_sort_i64)
+{
+    test_true(test_vec_sort_radix(8, true, SORT_RANDOM, 5000));
+}
+
+static bool test_vec_sort_parallel(size_t n, size_t threads)
+{
+    vec_ct vec;
+    bool rc;
+
+    if(!(vec = vec_new(sizeof(uint64_t))) || !test_vec_sort_fill(vec, SORT_RANDOM, n))
+        return false;
+
+    rc = !vec_sort_parallel(vec, test_vec_sort_u64, NULL, threads)
+        && test_vec_sort_check(vec, test_vec_sort_u64) && vec_size(vec) == n;
+    vec_free(vec);
+
+    return rc;
+}
+
+TEST_CASE_ABORT(vec_sort_parallel_invalid_magic)
+{
+    vec_sort_parallel((vec_ct)&not_a_vector, test_vec_sort, NULL, 2);
+}
+
+TEST_CASE(vec_sort_parallel_small)
+{
+    test_true(test_vec_sort_parallel(1000, 4));
+}
+
+TEST_CASE(vec_sort_parallel)
+{
+    test_true(test_vec_sort_parallel((1 << 20) + 3, 3));
+}
+
+static double test_vec_bench_sort(size_t esize, int method)
+{
+    vec_sort_cb sort = esize == 4 ? test_vec_sort_u32 : test_vec_sort_u64;
+    clock_t start, end;
+    int rc = 0;
+
+    test_vec_sort_seed = 88172645463325252ULL;
+
+    if(!(vec = vec_new_c(VEC_BENCH_SIZE, esize)) || !test_vec_sort_fill(vec, SORT_RANDOM, VEC_BENCH_SIZE))
+        return -1;
+
+    start = clock();
+
+    switch(method)
+    {
+    case 0: qsort_r(vec_at(vec, 0), VEC_BENCH_SIZE, esize, sort, NULL); break;
+    case 1: vec_sort(vec, sort, NULL); break;
+    case 2: rc = esize == 4 ? vec_sort_u32(vec) : vec_sort_u64(vec); break;
+    case 3: rc = vec_sort_parallel(vec, sort, NULL, 4); break;
+    default: abort();
+    }
+
+    end = clock();
+
+    if(rc || !test_vec_sort_check(vec, sort))
+        return vec_free(vec), -1;
+
+    vec_free(vec);
+
+    return (double)(end - start) * 1e9 / CLOCKS_PER_SEC / VEC_BENCH_SIZE;
+}
+
+TEST_CASE(vec_bench_sort_u32)
+{
+    double ns;
+
+    test_true((ns = test_vec_bench_sort(4, 0)) >= 0);
+    test_msg_info("qsort_r: %.1f ns/elem", ns);
+    test_true((ns = test_vec_bench_sort(4, 1)) >= 0);
+    test_msg_info("vec_sort: %.1f ns/elem", ns);
+    test_true((ns = test_vec_bench_sort(4, 2)) >= 0);
+    test_msg_info("vec_sort_u32: %.1f ns/elem", ns);
+    test_true((ns = test_vec_bench_sort(4, 3)) >= 0);
+    test_msg_info("vec_sort_parallel: %.1f ns/elem", ns);
+}
+
+TEST_CASE(vec_bench_sort_u64)
+{
+    double ns;
+
+    test_true((ns = test_vec_bench_sort(8, 0)) >= 0);
+    test_msg_info("qsort_r: %.1f ns/elem", ns);
+    test_true((ns = test_vec_bench_sort(8, 1)) >= 0);
+    test_msg_info("vec_sort: %.1f ns/elem", ns);
+    test_true((ns = test_vec_bench_sort(8, 2)) >= 0);
+    test_msg_info("vec_sort_u64: %.1f ns/elem", ns);
+    test_true((ns = test_vec_bench_sort(8, 3)) >= 0);
+    test_msg_info("vec_sort_parallel: %.1f ns/elem", ns);
+}
+
+TEST_SETUP(vec_new_sorted)
+{
+    int sorted[] = { 1, 3, 3, 5, 7, 9 };
+
+    test_ptr_success(vec = vec_new_c(5, sizeof(int)));
+    test_ptr_success(vec_push_en(vec, ELEMS(sorted), sorted));
+}
+
+TEST_SETUP(vec_new_set)
+{
+    int sorted[] = { 1, 3, 5 };
+
+    test_ptr_success(vec = vec_new_c(5, sizeof(int)));
+    test_ptr_success(vec_push_en(vec, ELEMS(sorted), sorted));
+    test_uint_eq(vec_set_sorted(vec, test_vec_sort_i32, NULL), 0);
+}
+
+TEST_CASE_ABORT(vec_lower_bound_invalid_magic)
+{
+    vec_lower_bound((vec_const_ct)&not_a_vector, i, test_vec_sort_i32, NULL);
+}
+
+TEST_CASE_FIX_ABORT(vec_lower_bound_no_sort, vec_new_sorted, vec_free)
+{
+    vec_lower_bound(vec, i, NULL, NULL);
+}
+
+TEST_CASE_FIX(vec_lower_bound, vec_new_sorted, vec_free)
+{
+    int key[] = { 0, 3, 4, 9, 10 };
+
+    test_uint_eq(vec_lower_bound(vec, &key[0], test_vec_sort_i32, NULL), 0);
+    test_uint_eq(vec_lower_bound(vec, &key[1], test_vec_sort_i32, NULL), 1);
+    test_uint_eq(vec_lower_bound(vec, &key[2], test_vec_sort_i32, NULL), 3);
+    test_uint_eq(vec_lower_bound(vec, &key[3], test_vec_sort_i32, NULL), 5);
+    test_uint_eq(vec_lower_bound(vec, &key[4], test_vec_sort_i32, NULL), 6);
+}
+
+TEST_CASE_FIX(vec_upper_bound, vec_new_sorted, vec_free)
+{
+    int key[] = { 0, 3, 4, 9 };
+
+    test_uint_eq(vec_upper_bound(vec, &key[0], test_vec_sort_i32, NULL), 0);
+    test_uint_eq(vec_upper_bound(vec, &key[1], test_vec_sort_i32, NULL), 3);
+    test_uint_eq(vec_upper_bound(vec, &key[2], test_vec_sort_i32, NULL), 3);
+    test_uint_eq(vec_upper_bound(vec, &key[3], test_vec_sort_i32, NULL), 6);
+}
+
+TEST_CASE_FIX(vec_bsearch_empty, vec_new_int, vec_free)
+{
+    test_ptr_error(vec_bsearch(vec, i, test_vec_sort_i32, NULL), E_VEC_NOT_FOUND);
+}
+
+TEST_CASE_FIX(vec_bsearch, vec_new_sorted, vec_free)
+{
+    int key = 3;
+
+    test_ptr_eq(vec_bsearch(vec, &key, test_vec_sort_i32, NULL), vec_at(vec, 1));
+    key = 9;
+    test_ptr_eq(vec_bsearch(vec, &key, test_vec_sort_i32, NULL), vec_at(vec, 5));
+}
+
+TEST_CASE_FIX(vec_bsearch_not_found, vec_new_sorted, vec_free)
+{
+    int key = 4;
+
+    test_ptr_error(vec_bsearch(vec, &key, test_vec_sort_i32, NULL), E_VEC_NOT_FOUND);
+    key = 10;
+    test_ptr_error(vec_bsearch(vec, &key, test_vec_sort_i32, NULL), E_VEC_NOT_FOUND);
+}
+
+TEST_CASE_FIX(vec_insert_sorted, vec_new_sorted, vec_free)
+{
+    int key[] = { 0, 3, 10 }, sorted[] = { 0, 1, 3, 3, 3, 5, 7, 9, 10 };
+
+    test_ptr_eq(vec_insert_sorted(vec, &key[0], test_vec_sort_i32, NULL), vec_at(vec, 0));
+    test_ptr_eq(vec_insert_sorted(vec, &key[1], test_vec_sort_i32, NULL), vec_at(vec, 4));
+    test_ptr_eq(vec_insert_sorted(vec, &key[2], test_vec_sort_i32, NULL), vec_at(vec, 8));
+    test_uint_eq(vec_size(vec), ELEMS(sorted));
+    test_int_list_eq((int *)vec_at(vec, 0), sorted, ELEMS(sorted));
+}
+
+TEST_CASE_ABORT(vec_set_sorted_invalid_magic)
+{
+    vec_set_sorted((vec_ct)&not_a_vector, test_vec_sort_i32, NULL);
+}
+
+TEST_CASE_FIX(vec_set_sorted, vec_new_int10, vec_free)
+{
+    int sorted[] = { 1, 2, 4, 5, 6, 7, 9, 10, 33 };
+
+    test_false(vec_is_sorted(vec));
+    test_uint_eq(vec_set_sorted(vec, test_vec_sort_i32, NULL), 1);
+    test_true(vec_is_sorted(vec));
+    test_uint_eq(vec_size(vec), ELEMS(sorted));
+    test_int_list_eq((int *)vec_at(vec, 0), sorted, ELEMS(sorted));
+
+    test_uint_eq(vec_set_sorted(vec, NULL, NULL), 0);
+    test_false(vec_is_sorted(vec));
+}
+
+TEST_CASE_FIX(vec_set_sorted_f, vec_new_int10, vec_free)
+{
+    test_uint_eq(vec_set_sorted_f(vec, test_vec_sort_i32, NULL, test_vec_dtor, &count), 1);
+    test_int_eq(count, 1);
+}
+
+TEST_CASE_FIX_ABORT(vec_set_sorted_push, vec_new_set, vec_free)
+{
+    vec_push(vec);
+}
+
+TEST_CASE_FIX_ABORT(vec_set_sorted_insert, vec_new_set, vec_free)
+{
+    vec_insert(vec, 0);
+}
+
+TEST_CASE_FIX(vec_set_sorted_insert_sorted, vec_new_set, vec_free)
+{
+    int key[] = { 4, 0 }, sorted[] = { 0, 1, 3, 4, 5 };
+
+    test_ptr_success(vec_insert_sorted(vec, &key[0], NULL, NULL));
+    test_ptr_success(vec_insert_sorted(vec, &key[1], NULL, NULL));
+    test_int_list_eq((int *)vec_at(vec, 0), sorted, ELEMS(sorted));
+    test_ptr_eq(vec_bsearch(vec, &key[0], NULL, NULL), vec_at(vec, 3));
+}
+
+TEST_CASE_FIX(vec_set_sorted_insert_sorted_exists, vec_new_set, vec_free)
+{
+    int key = 3;
+
+    test_ptr_error(vec_insert_sorted(vec, &key, NULL, NULL), E_VEC_EXISTS);
+    test_uint_eq(vec_size(vec), 3);
+}
+
+TEST_CASE_FIX(vec_set_sorted_clone, vec_new_set, vec_free)
+{
+    vec_ct clone;
+
+    test_ptr_success(clone = vec_clone(vec));
+    test_true(vec_is_sorted(clone));
+    test_void(vec_free(clone));
+}
+
+TEST_CASE_ABORT(vec_merge_sorted_invalid_magic)
+{
+    vec_merge_sorted((vec_ct)&not_a_vector, (vec_ct)&not_a_vector, test_vec_sort_i32, NULL);
+}
+
+TEST_CASE_FIX(vec_merge_sorted, vec_new_sorted, vec_free)
+{
+    int merge[] = { 0, 3, 8, 11 }, sorted[] = { 0, 1, 3, 3, 3, 5, 7, 8, 9, 11 };
+    vec_ct src;
+
+    test_ptr_success(src = vec_new(sizeof(int)));
+    test_ptr_success(vec_push_en(src, ELEMS(merge), merge));
+    test_int_success(vec_merge_sorted(vec, src, test_vec_sort_i32, NULL));
+    test_void(vec_free(src));
+    test_uint_eq(vec_size(vec), ELEMS(sorted));
+    test_int_list_eq((int *)vec_at(vec, 0), sorted, ELEMS(sorted));
+}
+
+TEST_CASE_FIX(vec_merge_sorted_empty, vec_new_int, vec_free)
+{
+    int merge[] = { 0, 3 };
+    vec_ct src;
+
+    test_ptr_success(src = vec_new(sizeof(int)));
+    test_ptr_success(vec_push_en(src, ELEMS(merge), merge));
+    test_int_success(vec_merge_sorted(vec, src, test_vec_sort_i32, NULL));
+    test_void(vec_free(src));
+    test_int_list_eq((int *)vec_at(vec, 0), merge, ELEMS(merge));
+}
+
+TEST_CASE_FIX(vec_set_sorted_merge_sorted, vec_new_set, vec_free)
+{
+    int merge[] = { 0, 3, 3, 6, 6 }, sorted[] = { 0, 1, 3, 5, 6 };
+    vec_ct src;
+
+    test_ptr_success(src = vec_new(sizeof(int)));
+    test_ptr_success(vec_push_en(src, ELEMS(merge), merge));
+    test_int_success(vec_merge_sorted(vec, src, NULL, NULL));
+    test_void(vec_free(src));
+    test_uint_eq(vec_size(vec), ELEMS(sorted));
+    test_int_list_eq((int *)vec_at(vec, 0), sorted, ELEMS(sorted));
+}
+
+TEST_CASE_FIX(vec_set_sorted_merge_sorted_duplicates, vec_new_set, vec_free)
+{
+    int merge[] = { 1, 1, 5 }, sorted[] = { 1, 3, 5 };
+    vec_ct src;
+
+    test_ptr_success(src = vec_new(sizeof(int)));
+    test_ptr_success(vec_push_en(src, ELEMS(merge), merge));
+    test_int_success(vec_merge_sorted(vec, src, NULL, NULL));
+    test_void(vec_free(src));
+    test_uint_eq(vec_size(vec), ELEMS(sorted));
+    test_int_list_eq((int *)vec_at(vec, 0), sorted, ELEMS(sorted));
+}
+
 int test_suite_con_vec(void *param)
 {
     return error_pass_int(test_run_cases("vec",
         test_case(vec_new_invalid_elemsize),
         test_case(vec_new_c_invalid_elemsize),
+        test_case(vec_init_inline_invalid_elemsize),
+        test_case(vec_inline_size),
+        test_case(vec_inline_push),
+        test_case(vec_inline_spill),
+        test_case(vec_inline_shrink),
+        test_case(vec_inline_clear),
+        test_case(vec_inline_get_buffer),
 
         test_case(vec_elemsize_invalid_magic),
         test_case(vec_elemsize),
@@ -2921,6 +3679,8 @@ int test_suite_con_vec(void *param)
         test_case(vec_get_buffer_no_capacity),
         test_case(vec_get_buffer),
 
+        test_case(vec_clear_invalid_magic),
+        test_case(vec_clear),
         test_case(vec_truncate_invalid_magic),
         test_case(vec_truncate),
         test_case(vec_truncate_f_invalid_magic),
@@ -2934,6 +3694,18 @@ int test_suite_con_vec(void *param)
         test_case(vec_set_capacity_f_below_min_capacity),
         test_case(vec_set_capacity_f),
         test_case(vec_set_capacity_f_below_current_capacity),
+        test_case(vec_set_growth_invalid_magic),
+        test_case(vec_set_growth_invalid_factor),
+        test_case(vec_set_growth_invalid_step),
+        test_case(vec_growth_default),
+        test_case(vec_set_growth_factor),
+        test_case(vec_set_growth_step),
+        test_case(vec_set_growth_pow2),
+        test_case(vec_set_growth_pow2_overflow),
+        test_case(vec_set_mmap_invalid_magic),
+        test_case(vec_set_mmap),
+        test_case(vec_set_mmap_existing),
+        test_case(vec_set_mmap_get_buffer),
 
         test_case(vec_fold_invalid_magic),
         test_case(vec_fold_invalid_fold),
@@ -2945,6 +3717,41 @@ int test_suite_con_vec(void *param)
         test_case(vec_sort_invalid_magic),
         test_case(vec_sort_invalid_sort),
         test_case(vec_sort),
+        test_case(vec_sort_patterns),
+        test_case(vec_sort_esize),
+        test_case(vec_sort_u32_invalid_magic),
+        test_case(vec_sort_u32_invalid_type),
+        test_case(vec_sort_u32_empty),
+        test_case(vec_sort_u32),
+        test_case(vec_sort_u64),
+        test_case(vec_sort_i32),
+        test_case(vec_sort_i64),
+        test_case(vec_sort_parallel_invalid_magic),
+        test_case(vec_sort_parallel_small),
+        test_case(vec_sort_parallel),
+        test_case(vec_lower_bound_invalid_magic),
+        test_case(vec_lower_bound_no_sort),
+        test_case(vec_lower_bound),
+        test_case(vec_upper_bound),
+        test_case(vec_bsearch_empty),
+        test_case(vec_bsearch),
+        test_case(vec_bsearch_not_found),
+        test_case(vec_insert_sorted),
+        test_case(vec_set_sorted_invalid_magic),
+        test_case(vec_set_sorted),
+        test_case(vec_set_sorted_f),
+        test_case(vec_set_sorted_push),
+        test_case(vec_set_sorted_insert),
+        test_case(vec_set_sorted_insert_sorted),
+        test_case(vec_set_sorted_insert_sorted_exists),
+        test_case(vec_set_sorted_clone),
+        test_case(vec_merge_sorted_invalid_magic),
+        test_case(vec_merge_sorted),
+        test_case(vec_merge_sorted_empty),
+        test_case(vec_set_sorted_merge_sorted),
+        test_case(vec_set_sorted_merge_sorted_duplicates),
+        test_case(vec_bench_sort_u32),
+        test_case(vec_bench_sort_u64),
 
         NULL
     ));
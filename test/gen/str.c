@@ -24,9 +24,15 @@
 #include <ytil/test/run.h>
 #include <ytil/test/test.h>
 #include <ytil/gen/str.h>
+#include <ytil/con/vec.h>
 #include <ytil/ext/string.h>
 #include <ytil/ext/stdio.h>
+#include <ytil/def.h>
+#include <dlfcn.h>
+#include <pthread.h>
+#include <stdint.h>
 #include <stdlib.h>
+#include <time.h>
 
 static const struct not_a_str
 {
@@ -39,6 +45,8 @@ static const char *unescaped_b = "\0\x01\x02\x03", *escaped_b = "\\0\\x01\\x02\\
 static char *cstr;
 static void *data;
 static str_ct str, str1, str2;
+static vec_ct vec;
+static str_split_st split;
 
 
 TEST_SETUP(str_new_h)
@@ -4061,6 +4069,1157 @@ int test_suite_gen_str_remove_replace(void *param)
     ));
 }
 
+TEST_SETUP(str_new_find)
+{
+    test_ptr_success(str = str_new_l("foobarfoobazfoo"));
+}
+
+TEST_TEARDOWN(str_vec_free)
+{
+    test_void(str_unref(str));
+    test_void(vec_free(vec));
+}
+
+TEST_CASE_ABORT(str_find_invalid_str_magic)
+{
+    str_find((str_ct)&not_a_str, LIT("foo"));
+}
+
+TEST_CASE_FIX_ABORT(str_find_invalid_sub_magic, str_new_find, str_unref)
+{
+    str_find(str, (str_ct)&not_a_str);
+}
+
+TEST_CASE_FIX(str_find, str_new_find, str_unref)
+{
+    test_int_eq(str_find(str, LIT("foo")), 0);
+    test_int_eq(str_find(str, LIT("bar")), 3);
+    test_int_eq(str_find(str, LIT("baz")), 9);
+    test_int_eq(str_find(str, LIT("foobarfoobazfoo")), 0);
+}
+
+TEST_CASE_FIX(str_find_empty_sub, str_new_find, str_unref)
+{
+    test_int_eq(str_find(str, LIT("")), 0);
+}
+
+TEST_CASE_FIX(str_find_not_found, str_new_find, str_unref)
+{
+    test_rc_error(str_find(str, LIT("qux")), -1, E_STR_NOT_FOUND);
+    test_rc_error(str_find(str, LIT("foobarfoobazfooo")), -1, E_STR_NOT_FOUND);
+}
+
+TEST_CASE_FIX(str_find_bin, str_new_b, str_unref)
+{
+    test_int_eq(str_find(str, BIN("\0" "23")), 1);
+}
+
+TEST_CASE_FIX(str_find_c_invalid_cstr, str_new_find, str_unref)
+{
+    test_rc_error(str_find_c(str, NULL), -1, E_STR_INVALID_CSTR);
+}
+
+TEST_CASE_FIX(str_find_c, str_new_find, str_unref)
+{
+    test_int_eq(str_find_c(str, "baz"), 9);
+}
+
+TEST_CASE_FIX(str_find_cn_invalid_cstr, str_new_find, str_unref)
+{
+    test_rc_error(str_find_cn(str, NULL, 3), -1, E_STR_INVALID_CSTR);
+}
+
+TEST_CASE_FIX(str_find_cn, str_new_find, str_unref)
+{
+    test_int_eq(str_find_cn(str, "bazz", 3), 9);
+    test_int_eq(str_find_l(str, "oob"), 1);
+}
+
+TEST_CASE_FIX(str_find_b_invalid_data, str_new_b, str_unref)
+{
+    test_rc_error(str_find_b(str, NULL, 3), -1, E_STR_INVALID_DATA);
+}
+
+TEST_CASE_FIX(str_find_b, str_new_b, str_unref)
+{
+    test_int_eq(str_find_b(str, "\0" "23", 3), 1);
+    test_rc_error(str_find_b(str, "\0" "24", 3), -1, E_STR_NOT_FOUND);
+}
+
+TEST_CASE_ABORT(str_rfind_invalid_str_magic)
+{
+    str_rfind((str_ct)&not_a_str, LIT("foo"));
+}
+
+TEST_CASE_FIX_ABORT(str_rfind_invalid_sub_magic, str_new_find, str_unref)
+{
+    str_rfind(str, (str_ct)&not_a_str);
+}
+
+TEST_CASE_FIX(str_rfind, str_new_find, str_unref)
+{
+    test_int_eq(str_rfind(str, LIT("foo")), 12);
+    test_int_eq(str_rfind(str, LIT("bar")), 3);
+    test_int_eq(str_rfind(str, LIT("foobarfoobazfoo")), 0);
+}
+
+TEST_CASE_FIX(str_rfind_empty_sub, str_new_find, str_unref)
+{
+    test_int_eq(str_rfind(str, LIT("")), 15);
+}
+
+TEST_CASE_FIX(str_rfind_not_found, str_new_find, str_unref)
+{
+    test_rc_error(str_rfind(str, LIT("qux")), -1, E_STR_NOT_FOUND);
+}
+
+TEST_CASE_FIX(str_rfind_c_invalid_cstr, str_new_find, str_unref)
+{
+    test_rc_error(str_rfind_c(str, NULL), -1, E_STR_INVALID_CSTR);
+}
+
+TEST_CASE_FIX(str_rfind_c, str_new_find, str_unref)
+{
+    test_int_eq(str_rfind_c(str, "oo"), 13);
+}
+
+TEST_CASE_FIX(str_rfind_cn_invalid_cstr, str_new_find, str_unref)
+{
+    test_rc_error(str_rfind_cn(str, NULL, 3), -1, E_STR_INVALID_CSTR);
+}
+
+TEST_CASE_FIX(str_rfind_cn, str_new_find, str_unref)
+{
+    test_int_eq(str_rfind_cn(str, "foox", 3), 12);
+    test_int_eq(str_rfind_l(str, "oob"), 7);
+}
+
+TEST_CASE_FIX(str_rfind_b_invalid_data, str_new_b, str_unref)
+{
+    test_rc_error(str_rfind_b(str, NULL, 3), -1, E_STR_INVALID_DATA);
+}
+
+TEST_CASE_FIX(str_rfind_b, str_new_b, str_unref)
+{
+    test_int_eq(str_rfind_b(str, "\0" "23", 3), 1);
+}
+
+TEST_CASE_ABORT(str_find_all_invalid_str_magic)
+{
+    str_find_all((str_ct)&not_a_str, LIT("foo"));
+}
+
+TEST_CASE_FIX_ABORT(str_find_all_invalid_sub_magic, str_new_find, str_unref)
+{
+    str_find_all(str, (str_ct)&not_a_str);
+}
+
+TEST_CASE_FIX(str_find_all_empty_sub, str_new_find, str_unref)
+{
+    test_ptr_error(str_find_all(str, LIT("")), E_STR_EMPTY);
+}
+
+TEST_CASE_FIX(str_find_all, str_new_find, str_vec_free)
+{
+    test_ptr_success(vec = str_find_all(str, LIT("foo")));
+    test_uint_eq(vec_size(vec), 3);
+    test_uint_eq(*(size_t *)vec_at(vec, 0), 0);
+    test_uint_eq(*(size_t *)vec_at(vec, 1), 6);
+    test_uint_eq(*(size_t *)vec_at(vec, 2), 12);
+}
+
+TEST_CASE_FIX(str_find_all_none, str_new_find, str_vec_free)
+{
+    test_ptr_success(vec = str_find_all(str, LIT("qux")));
+    test_true(vec_is_empty(vec));
+}
+
+TEST_CASE_FIX(str_find_all_non_overlapping, no_setup, str_vec_free)
+{
+    test_ptr_success(str = str_new_l("aaaaa"));
+    test_ptr_success(vec = str_find_all(str, LIT("aa")));
+    test_uint_eq(vec_size(vec), 2);
+    test_uint_eq(*(size_t *)vec_at(vec, 0), 0);
+    test_uint_eq(*(size_t *)vec_at(vec, 1), 2);
+}
+
+TEST_CASE_FIX(str_find_all_c_invalid_cstr, str_new_find, str_unref)
+{
+    test_ptr_error(str_find_all_c(str, NULL), E_STR_INVALID_CSTR);
+}
+
+TEST_CASE_FIX(str_find_all_c, str_new_find, str_vec_free)
+{
+    test_ptr_success(vec = str_find_all_c(str, "oo"));
+    test_uint_eq(vec_size(vec), 3);
+}
+
+TEST_CASE_FIX(str_find_all_cn_invalid_cstr, str_new_find, str_unref)
+{
+    test_ptr_error(str_find_all_cn(str, NULL, 3), E_STR_INVALID_CSTR);
+}
+
+TEST_CASE_FIX(str_find_all_cn, str_new_find, str_vec_free)
+{
+    test_ptr_success(vec = str_find_all_cn(str, "bazz", 2));
+    test_uint_eq(vec_size(vec), 2);
+    test_uint_eq(*(size_t *)vec_at(vec, 1), 9);
+}
+
+TEST_CASE_FIX(str_find_all_b_invalid_data, str_new_b, str_unref)
+{
+    test_ptr_error(str_find_all_b(str, NULL, 3), E_STR_INVALID_DATA);
+}
+
+TEST_CASE_FIX(str_find_all_b, str_new_b, str_vec_free)
+{
+    test_ptr_success(vec = str_find_all_b(str, "\0", 1));
+    test_uint_eq(vec_size(vec), 1);
+    test_uint_eq(*(size_t *)vec_at(vec, 0), 1);
+}
+
+/// Previous byte loop implementation of memmem, reference for tests and benchmark.
+static void *test_str_memmem_loop(const void *vhaystack, size_t ssize, const void *vneedle, size_t nsize)
+{
+    const char *ptr, *haystack = vhaystack, *needle = vneedle;
+    const char *last = haystack + ssize - nsize + 1;
+
+    if(!nsize)
+        return (void *)haystack;
+
+    if(ssize < nsize)
+        return NULL;
+
+    for(; (ptr = memchr(haystack, needle[0], last - haystack)); haystack = ptr + 1)
+        if(!memcmp(ptr, needle, nsize))
+            return (void *)ptr;
+
+    return NULL;
+}
+
+/// Get last occurence of needle in haystack by brute force.
+static ssize_t test_str_rfind_naive(const char *haystack, size_t ssize, const char *needle, size_t nsize)
+{
+    size_t pos;
+
+    for(pos = ssize - nsize + 1; ssize >= nsize && pos; pos--)
+        if(!memcmp(&haystack[pos - 1], needle, nsize))
+            return pos - 1;
+
+    return -1;
+}
+
+/// Compare str_find and str_rfind with reference implementations
+/// on random haystacks over a small alphabet.
+///
+/// \retval true    all searches match
+/// \retval false   mismatch
+static bool test_str_find_random(void)
+{
+    char haystack[300], needle[80];
+    uint64_t seed = 88172645463325252ULL;
+    size_t run, k, ssize, nsize;
+    const char *ptr;
+    ssize_t pos;
+
+    for(run = 0; run < 20000; run++)
+    {
+        seed ^= seed << 13, seed ^= seed >> 7, seed ^= seed << 17;
+
+        ssize = seed % sizeof(haystack);
+        nsize = 1 + (seed >> 16) % sizeof(needle);
+
+        for(k = 0; k < ssize; k++)
+            haystack[k] = 'a' + (seed >> (k % 48)) % (2 + run % 3);
+
+        if(run % 2 && nsize <= ssize) // needle taken from haystack
+            memcpy(needle, &haystack[(seed >> 32) % (ssize - nsize + 1)], nsize);
+        else
+            for(k = 0; k < nsize; k++)
+                needle[k] = 'a' + (seed >> (k % 40)) % 2;
+
+        ptr = test_str_memmem_loop(haystack, ssize, needle, nsize);
+        pos = str_find_b(tstr_new_bs(haystack, ssize), needle, nsize);
+
+        if(pos != (ptr ? ptr - haystack : -1))
+            return false;
+
+        pos = str_rfind_b(tstr_new_bs(haystack, ssize), needle, nsize);
+
+        if(pos != test_str_rfind_naive(haystack, ssize, needle, nsize))
+            return false;
+    }
+
+    return true;
+}
+
+TEST_CASE(str_find_random)
+{
+    test_true(test_str_find_random());
+}
+
+TEST_CASE_FIX(str_find_periodic, no_setup, str_unref)
+{
+    char needle[61];
+
+    // long needle with frequent first/last byte candidates
+    memset(needle, 'a', sizeof(needle));
+    needle[40] = 'b';
+
+    test_ptr_success(str = str_prepare_set(1 << 16, 'a'));
+    test_int_error(str_find_b(str, needle, sizeof(needle)), E_STR_NOT_FOUND);
+
+    str_w(str)[(1 << 16) - 21] = 'b';
+    test_int_eq(str_find_b(str, needle, sizeof(needle)), (1 << 16) - 61);
+    test_int_eq(str_rfind_b(str, needle, sizeof(needle)), (1 << 16) - 61);
+}
+
+#define BENCH_SIZE      (1024*1024) ///< benchmark haystack size
+#define BENCH_RUNS      20          ///< benchmark searches per needle
+
+/// memmem signature
+typedef void *(*test_str_memmem_cb)(const void *haystack, size_t ssize, const void *needle, size_t nsize);
+
+/// Measure searching needle placed at the end of haystack.
+///
+/// \returns    MB/s, -1 on mismatch
+static double test_str_find_bench_run(test_str_memmem_cb memmem_cb, const char *haystack, const char *needle, size_t nsize)
+{
+    clock_t start;
+    size_t run;
+    char *ptr;
+
+    start = clock();
+
+    for(run = 0; run < BENCH_RUNS; run++)
+        if(!(ptr = memmem_cb(haystack, BENCH_SIZE, needle, nsize))
+        || (size_t)(ptr - haystack) != BENCH_SIZE - nsize)
+            return -1;
+
+    return (double)BENCH_SIZE * BENCH_RUNS / 1e6 / ((double)(clock() - start) / CLOCKS_PER_SEC);
+}
+
+TEST_SETUP(str_find_bench_new)
+{
+    test_ptr_success(data = malloc(BENCH_SIZE));
+}
+
+TEST_CASE_FIX(str_find_bench, str_find_bench_new, data_free)
+{
+    static const char *needles[] = {
+        "ERROR",
+        "connection reset",
+        "2026-10-16 12:00:00 [worker-3] ERROR connection reset by peer",
+    };
+    test_str_memmem_cb glibc_memmem;
+    uint64_t seed = 88172645463325252ULL;
+    char *haystack = data;
+    size_t n, k, nsize;
+    double mbs[3];
+
+    glibc_memmem = NULL;
+#ifdef __GLIBC__
+    *(void **)&glibc_memmem = dlsym(RTLD_NEXT, "memmem");
+#endif
+
+    for(n = 0; n < ELEMS(needles); n++)
+    {
+        nsize = strlen(needles[n]);
+
+        // log like text with needle prefixes sprinkled in
+        for(k = 0; k < BENCH_SIZE - nsize; k++)
+        {
+            seed ^= seed << 13, seed ^= seed >> 7, seed ^= seed << 17;
+            haystack[k] = seed % 7 ? 'a' + seed % 26 : ' ';
+
+            if(!(seed % 1000) && k + nsize/2 < BENCH_SIZE - nsize)
+                memcpy(&haystack[k], needles[n], nsize/2), k += nsize/2 - 1;
+        }
+
+        memcpy(&haystack[BENCH_SIZE - nsize], needles[n], nsize);
+
+        test_true((mbs[0] = test_str_find_bench_run(memmem, haystack, needles[n], nsize)) >= 0);
+        test_true((mbs[1] = test_str_find_bench_run(test_str_memmem_loop, haystack, needles[n], nsize)) >= 0);
+        test_true((mbs[2] = glibc_memmem ? test_str_find_bench_run(glibc_memmem, haystack, needles[n], nsize) : 0) >= 0);
+
+        test_msg_info("needle %2zu bytes: memmem %6.0f MB/s, byte loop %6.0f MB/s, glibc %6.0f MB/s",
+            nsize, mbs[0], mbs[1], mbs[2]);
+    }
+}
+
+int test_suite_gen_str_find(void *param)
+{
+    return error_pass_int(test_run_cases(NULL,
+        test_case(str_find_invalid_str_magic),
+        test_case(str_find_invalid_sub_magic),
+        test_case(str_find),
+        test_case(str_find_empty_sub),
+        test_case(str_find_not_found),
+        test_case(str_find_bin),
+        test_case(str_find_c_invalid_cstr),
+        test_case(str_find_c),
+        test_case(str_find_cn_invalid_cstr),
+        test_case(str_find_cn),
+        test_case(str_find_b_invalid_data),
+        test_case(str_find_b),
+
+        test_case(str_rfind_invalid_str_magic),
+        test_case(str_rfind_invalid_sub_magic),
+        test_case(str_rfind),
+        test_case(str_rfind_empty_sub),
+        test_case(str_rfind_not_found),
+        test_case(str_rfind_c_invalid_cstr),
+        test_case(str_rfind_c),
+        test_case(str_rfind_cn_invalid_cstr),
+        test_case(str_rfind_cn),
+        test_case(str_rfind_b_invalid_data),
+        test_case(str_rfind_b),
+
+        test_case(str_find_all_invalid_str_magic),
+        test_case(str_find_all_invalid_sub_magic),
+        test_case(str_find_all_empty_sub),
+        test_case(str_find_all),
+        test_case(str_find_all_none),
+        test_case(str_find_all_non_overlapping),
+        test_case(str_find_all_c_invalid_cstr),
+        test_case(str_find_all_c),
+        test_case(str_find_all_cn_invalid_cstr),
+        test_case(str_find_all_cn),
+        test_case(str_find_all_b_invalid_data),
+        test_case(str_find_all_b),
+
+        test_case(str_find_random),
+        test_case(str_find_periodic),
+        test_case(str_find_bench),
+
+        NULL
+    ));
+}
+
+TEST_TEARDOWN(str_split_free)
+{
+    test_void(str_split_free(&split));
+    test_void(str_unref(str));
+}
+
+/// Check that split yields the expected fields and ends.
+///
+/// \param split    split iterator
+/// \param fields   expected fields, NULL terminated
+///
+/// \retval true    fields match
+/// \retval false   mismatch
+static bool test_str_split_check(str_split_st *split, const char *const *fields)
+{
+    str_ct field;
+
+    for(; *fields; fields++)
+        if(!(field = str_split_next(split))
+        || str_cmp_b(field, *fields, strlen(*fields)))
+            return false;
+
+    return !str_split_next(split) && error_check(0, 1, E_STR_END);
+}
+
+TEST_CASE_ABORT(str_split_init_invalid_magic)
+{
+    str_split_init(&split, (str_ct)&not_a_str, ',');
+}
+
+TEST_CASE_FIX(str_split_char, no_setup, str_split_free)
+{
+    const char *fields[] = { "a", "bb", "", "ccc", NULL };
+
+    test_ptr_success(str = str_new_l("a,bb,,ccc"));
+    test_ptr_success(str_split_init(&split, str, ','));
+    test_uint_eq(str_get_refs(str), 2);
+    test_true(test_str_split_check(&split, fields));
+}
+
+TEST_CASE_FIX(str_split_char_trailing, no_setup, str_split_free)
+{
+    const char *fields[] = { "", "a", "", NULL };
+
+    test_ptr_success(str = str_new_l(",a,"));
+    test_ptr_success(str_split_init(&split, str, ','));
+    test_true(test_str_split_check(&split, fields));
+}
+
+TEST_CASE_FIX(str_split_char_empty, str_new_empty, str_split_free)
+{
+    const char *fields[] = { "", NULL };
+
+    test_ptr_success(str_split_init(&split, str, ','));
+    test_true(test_str_split_check(&split, fields));
+}
+
+TEST_CASE_FIX(str_split_char_bin, str_new_b, str_split_free)
+{
+    str_ct field;
+
+    test_ptr_success(str_split_init(&split, str, '\0'));
+    test_ptr_success(field = str_split_next(&split));
+    test_int_eq(str_cmp_b(field, "1", 1), 0);
+    test_ptr_success(field = str_split_next(&split));
+    test_int_eq(str_cmp_b(field, "23456789", 8), 0);
+    test_ptr_error(str_split_next(&split), E_STR_END);
+}
+
+TEST_CASE(str_split_char_transient)
+{
+    const char *fields[] = { "x", "y", NULL };
+    str_const_ct tstr = LIT("x y");
+
+    test_ptr_success(str_split_init(&split, tstr, ' '));
+    test_false(split.ref);
+    test_true(test_str_split_check(&split, fields));
+    test_void(str_split_free(&split));
+}
+
+TEST_CASE_FIX(str_split_unref, no_setup, str_split_free)
+{
+    test_ptr_success(str = str_new_l("a,b"));
+    test_ptr_success(str_split_init(&split, str, ','));
+    test_uint_eq(str_get_refs(str), 2);
+    test_void(str_split_free(&split));
+    test_uint_eq(str_get_refs(str), 1);
+    test_ptr_success(str_split_init(&split, str, ','));
+}
+
+TEST_CASE_FIX(str_split_field, no_setup, str_split_free)
+{
+    str_ct field, dup;
+
+    test_ptr_success(str = str_new_l("foo,bar"));
+    test_ptr_success(str_split_init(&split, str, ','));
+    test_ptr_success(str_split_next(&split));
+    test_ptr_success(field = str_split_next(&split));
+    test_true(str_is_transient(field));
+    test_true(str_is_const(field));
+    test_true(str_is_binary(field));
+    test_uint_eq(str_memsize(field), 0);
+    test_ptr_eq(str_buc(field), str_buc(str) + 4);
+    test_ptr_error(str_append_c(field, "x"), E_STR_CONST);
+
+    test_ptr_success(dup = str_dup(field));
+    test_ptr_ne(str_bc(dup), str_bc(field));
+    test_int_eq(str_cmp_b(dup, "bar", 3), 0);
+    test_void(str_unref(dup));
+}
+
+TEST_CASE_FIX(str_split_set_invalid_set, str_new_s, str_unref)
+{
+    test_ptr_error(str_split_init_set(&split, str, NULL), E_STR_INVALID_CSTR);
+}
+
+TEST_CASE_FIX(str_split_set, no_setup, str_split_free)
+{
+    const char *fields[] = { "a", "b", "", "c", NULL };
+
+    test_ptr_success(str = str_new_l("a b\t\tc"));
+    test_ptr_success(str_split_init_set(&split, str, " \t"));
+    test_true(test_str_split_check(&split, fields));
+}
+
+TEST_CASE_FIX(str_split_sub_invalid_sub, str_new_s, str_unref)
+{
+    test_ptr_error(str_split_init_sub(&split, str, NULL, 2), E_STR_INVALID_DATA);
+}
+
+TEST_CASE_FIX(str_split_sub_empty_sub, str_new_s, str_unref)
+{
+    test_ptr_error(str_split_init_sub(&split, str, "", 0), E_STR_EMPTY);
+}
+
+TEST_CASE_FIX(str_split_sub, no_setup, str_split_free)
+{
+    const char *fields[] = { "a", ":b", "c", "", NULL };
+
+    test_ptr_success(str = str_new_l("a:::b::c::"));
+    test_ptr_success(str_split_init_l(&split, str, "::"));
+    test_true(test_str_split_check(&split, fields));
+}
+
+#define CSV_FIELDS  100 ///< number of fields in CSV line
+
+/// Create CSV line of CSV_FIELDS fields.
+///
+/// \returns    new str
+static str_ct test_str_split_csv(void)
+{
+    str_ct csv;
+    size_t f;
+
+    if(!(csv = str_dup_c("")))
+        return NULL;
+
+    for(f = 0; f < CSV_FIELDS; f++)
+        if(!str_append_f(csv, f ? ",field%zu" : "field%zu", f))
+            return str_unref(csv), NULL;
+
+    return csv;
+}
+
+/// Split CSV line and check that all fields are views without heap memory.
+///
+/// \retval true    all fields are views
+/// \retval false   error
+static bool test_str_split_check_csv(void)
+{
+    const char *data = str_bc(str);
+    char expected[16];
+    str_ct field;
+    size_t f;
+
+    for(f = 0; (field = str_split_next(&split)); f++)
+    {
+        snprintf(expected, sizeof(expected), "field%zu", f);
+
+        if(str_memsize(field)
+        || str_bc(field) < (const void *)data
+        || (const char *)str_bc(field) + str_len(field) > data + str_len(str)
+        || str_cmp_b(field, expected, strlen(expected)))
+            return false;
+    }
+
+    return f == CSV_FIELDS;
+}
+
+TEST_CASE_FIX(str_split_csv, no_setup, str_split_free)
+{
+    test_ptr_success(str = test_str_split_csv());
+    test_ptr_success(str_split_init(&split, str, ','));
+    test_true(test_str_split_check_csv());
+}
+
+#define BENCH_LINES 2000 ///< number of CSV lines split in benchmark
+
+TEST_CASE_FIX(str_split_bench, no_setup, str_unref)
+{
+    clock_t start;
+    size_t line, pos, end, fields;
+    const char *ptr;
+    double ns[2];
+    str_ct field;
+
+    test_ptr_success(str = test_str_split_csv());
+
+    start = clock();
+
+    for(line = 0, fields = 0; line < BENCH_LINES; line++)
+    {
+        str_split_init(&split, str, ',');
+
+        for(; str_split_next(&split); fields++);
+
+        str_split_free(&split);
+    }
+
+    ns[0] = (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / fields;
+    test_uint_eq(fields, BENCH_LINES * CSV_FIELDS);
+    start = clock();
+
+    for(line = 0, fields = 0; line < BENCH_LINES; line++)
+    {
+        for(pos = 0; pos <= str_len(str); pos = end + 1, fields++)
+        {
+            if(!(ptr = memchr((const char *)str_bc(str) + pos, ',', str_len(str) - pos)))
+                end = str_len(str);
+            else
+                end = ptr - (const char *)str_bc(str);
+
+            if(!(field = str_substr(str, pos, end - pos)))
+                break;
+
+            str_unref(field);
+        }
+    }
+
+    ns[1] = (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / fields;
+    test_uint_eq(fields, BENCH_LINES * CSV_FIELDS);
+
+    test_msg_info("split %.1f ns/field, substr %.1f ns/field", ns[0], ns[1]);
+}
+
+int test_suite_gen_str_split(void *param)
+{
+    return error_pass_int(test_run_cases(NULL,
+        test_case(str_split_init_invalid_magic),
+        test_case(str_split_char),
+        test_case(str_split_char_trailing),
+        test_case(str_split_char_empty),
+        test_case(str_split_char_bin),
+        test_case(str_split_char_transient),
+        test_case(str_split_unref),
+        test_case(str_split_field),
+        test_case(str_split_set_invalid_set),
+        test_case(str_split_set),
+        test_case(str_split_sub_invalid_sub),
+        test_case(str_split_sub_empty_sub),
+        test_case(str_split_sub),
+        test_case(str_split_csv),
+        test_case(str_split_bench),
+
+        NULL
+    ));
+}
+
+TEST_CASE_ABORT(str_hash_invalid_magic)
+{
+    str_hash((str_ct)&not_a_str);
+}
+
+TEST_CASE_FIX(str_hash_equal, str_new_h, str_unref)
+{
+    test_uint_eq(str_hash(str), str_hash_b(lit, strlen(lit)));
+    test_uint_eq(str_hash(str), str_hash(LIT("1234567890")));
+    test_uint_eq(str_hash(str), str_hash(BIN("1234567890")));
+    test_uint_ne(str_hash(str), str_hash(LIT("123456789")));
+}
+
+TEST_CASE(str_hash_empty)
+{
+    test_uint_eq(str_hash(LIT("")), str_hash_b(NULL, 0));
+    test_uint_ne(str_hash(LIT("")), str_hash(BIN("\0")));
+}
+
+/// Check that all prefixes and all single bit flips of data hash differently.
+///
+/// \retval true    all hashes differ
+/// \retval false   collision
+static bool test_str_hash_check_distinct(void)
+{
+    unsigned char data[200];
+    uint64_t hashes[sizeof(data)], hash;
+    size_t i, k;
+
+    for(i = 0; i < sizeof(data); i++)
+        data[i] = i * 7;
+
+    for(i = 0; i < sizeof(data); i++)
+    {
+        hashes[i] = str_hash_b(data, i);
+
+        for(k = 0; k < i; k++)
+            if(hashes[k] == hashes[i])
+                return false;
+    }
+
+    hash = str_hash_b(data, sizeof(data));
+
+    for(i = 0; i < sizeof(data) * 8; i++)
+    {
+        data[i / 8] ^= 1 << i % 8;
+
+        if(str_hash_b(data, sizeof(data)) == hash)
+            return false;
+
+        data[i / 8] ^= 1 << i % 8;
+    }
+
+    return true;
+}
+
+TEST_CASE(str_hash_distinct)
+{
+    test_true(test_str_hash_check_distinct());
+}
+
+TEST_CASE_FIX(str_hash_write, no_setup, str_unref)
+{
+    char *data;
+
+    test_ptr_success(str = str_dup_c("foo"));
+    test_uint_eq(str_hash(str), str_hash_b("foo", 3));
+    test_ptr_success(data = str_w(str));
+    test_uint_eq(str_hash(str), str_hash_b("foo", 3));
+    data[0] = 'g';
+    test_ptr_success(str_update(str));
+    test_uint_eq(str_hash(str), str_hash_b("goo", 3));
+}
+
+TEST_CASE_FIX(str_hash_modify, no_setup, str_unref)
+{
+    test_ptr_success(str = str_dup_c("foo"));
+    test_uint_eq(str_hash(str), str_hash_b("foo", 3));
+    test_ptr_success(str_append_c(str, "bar"));
+    test_uint_eq(str_hash(str), str_hash_b("foobar", 6));
+    test_int_success(str_overwrite_c(str, 0, "baz"));
+    test_uint_eq(str_hash(str), str_hash_b("bazbar", 6));
+    test_ptr_success(str_transpose_upper(str));
+    test_uint_eq(str_hash(str), str_hash_b("BAZBAR", 6));
+    test_ptr_success(str_cut_head(str, 3));
+    test_uint_eq(str_hash(str), str_hash_b("BAR", 3));
+    test_ptr_success(str_set_s(str, "qux"));
+    test_uint_eq(str_hash(str), str_hash_b("qux", 3));
+    test_ptr_success(str_clear(str));
+    test_uint_eq(str_hash(str), str_hash_b("", 0));
+}
+
+TEST_CASE_FIX(str_hash_volatile, no_setup, str_unref)
+{
+    char *data;
+
+    test_ptr_success(str = str_dup_c("foo"));
+    test_ptr_success(data = str_w(str));
+    test_ptr_success(str_mark_volatile(str));
+    test_uint_eq(str_hash(str), str_hash_b("foo", 3));
+    data[0] = 'g';
+    test_uint_eq(str_hash(str), str_hash_b("goo", 3));
+}
+
+TEST_CASE(str_hash_intern)
+{
+    test_ptr_success(str1 = str_intern_l("hash-intern"));
+    test_uint_eq(str_hash(str1), str_hash_b("hash-intern", 11));
+}
+
+#define BENCH_HASHES 100000 ///< number of hashes per benchmark run
+
+/// Measure hashing data of len.
+///
+/// \returns    ns per hash
+static double test_str_hash_bench_run(const void *data, size_t len)
+{
+    volatile uint64_t sink;
+    clock_t start;
+    size_t n;
+
+    start = clock();
+
+    for(n = 0; n < BENCH_HASHES; n++)
+        sink = str_hash_b(data, len);
+
+    (void)sink;
+
+    return (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / BENCH_HASHES;
+}
+
+TEST_CASE(str_hash_bench)
+{
+    static const size_t lens[] = { 16, 64, 4096 };
+    volatile uint64_t sink;
+    char data[4096];
+    clock_t start;
+    size_t l, n;
+    double ns;
+
+    memset(data, 'x', sizeof(data));
+
+    for(l = 0; l < ELEMS(lens); l++)
+    {
+        ns = test_str_hash_bench_run(data, lens[l]);
+        test_msg_info("%4zu bytes: %6.1f ns/hash, %5.2f GB/s", lens[l], ns, lens[l] / ns);
+    }
+
+    test_ptr_success(str1 = str_intern_l("X-Forwarded-For"));
+    start = clock();
+
+    for(n = 0; n < BENCH_HASHES; n++)
+        sink = str_hash(str1);
+
+    (void)sink;
+    ns = (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / BENCH_HASHES;
+    test_msg_info("interned: %.1f ns/hash", ns);
+}
+
+int test_suite_gen_str_hash(void *param)
+{
+    return error_pass_int(test_run_cases(NULL,
+        test_case(str_hash_invalid_magic),
+        test_case(str_hash_equal),
+        test_case(str_hash_empty),
+        test_case(str_hash_distinct),
+        test_case(str_hash_write),
+        test_case(str_hash_modify),
+        test_case(str_hash_volatile),
+        test_case(str_hash_intern),
+        test_case(str_hash_bench),
+
+        NULL
+    ));
+}
+
+TEST_CASE_ABORT(str_intern_invalid_magic)
+{
+    str_intern((str_ct)&not_a_str);
+}
+
+TEST_CASE(str_intern_invalid_cstr)
+{
+    test_ptr_error(str_intern_c(NULL), E_STR_INVALID_CSTR);
+    test_ptr_error(str_intern_cn(NULL, 3), E_STR_INVALID_CSTR);
+}
+
+TEST_CASE(str_intern_invalid_data)
+{
+    test_ptr_error(str_intern_b(NULL, 3), E_STR_INVALID_DATA);
+}
+
+TEST_CASE(str_intern_equal)
+{
+    test_ptr_success(str1 = str_intern(LIT("intern-equal")));
+    test_ptr_eq(str_intern_c("intern-equal"), str1);
+    test_ptr_eq(str_intern_l("intern-equal"), str1);
+    test_ptr_eq(str_intern_cn("intern-equal-foo", 12), str1);
+    test_ptr_eq(str_intern_b("intern-equal", 12), str1);
+    test_ptr_eq(str_intern(str1), str1);
+    test_str_eq(str_c(str1), "intern-equal");
+}
+
+TEST_CASE(str_intern_different)
+{
+    test_ptr_success(str1 = str_intern_l("intern-foo"));
+    test_ptr_success(str2 = str_intern_l("intern-bar"));
+    test_ptr_ne(str1, str2);
+    test_ptr_ne(str_intern_l("intern-fo"), str1);
+}
+
+TEST_CASE(str_intern_empty)
+{
+    test_ptr_success(str1 = str_intern_l(""));
+    test_true(str_is_empty(str1));
+    test_ptr_eq(str_intern(LIT("")), str1);
+}
+
+TEST_CASE_FIX(str_intern_heap, str_new_h, str_unref)
+{
+    test_ptr_success(str1 = str_intern(str));
+    test_ptr_ne(str1, str);
+    test_ptr_ne(str_bc(str1), str_bc(str));
+    test_ptr_eq(str_intern_c(lit), str1);
+    test_uint_eq(str_get_refs(str), 1);
+}
+
+TEST_CASE(str_intern_bin)
+{
+    test_ptr_success(str1 = str_intern_b("in\0tern", 7));
+    test_true(str_is_binary(str1));
+    test_uint_eq(str_len(str1), 7);
+    test_int_eq(str_cmp_b(str1, "in\0tern", 7), 0);
+    test_ptr_success(str2 = str_intern_l("intern-text"));
+    test_false(str_is_binary(str2));
+}
+
+TEST_CASE(str_intern_const)
+{
+    test_ptr_success(str1 = str_intern_l("intern-const"));
+    test_true(str_is_interned(str1));
+    test_true(str_is_const(str1));
+    test_false(str_is_interned(LIT("intern-const")));
+    test_ptr_error(str_append_c(str1, "x"), E_STR_CONST);
+    test_ptr_error(str_clear(str1), E_STR_CONST);
+}
+
+TEST_CASE(str_intern_immortal)
+{
+    size_t refs;
+
+    test_ptr_success(str1 = str_intern_l("intern-immortal"));
+    refs = str_get_refs(str1);
+    test_ptr_eq(str_ref(str1), str1);
+    test_ptr_eq(str_unref(str1), str1);
+    test_ptr_eq(str_unref(str1), str1);
+    test_uint_eq(str_get_refs(str1), refs);
+    test_str_eq(str_c(str1), "intern-immortal");
+}
+
+TEST_CASE(str_intern_split)
+{
+    const char *fields[] = { "k1", "k2", NULL };
+    size_t refs;
+
+    test_ptr_success(str1 = str_intern_l("k1,k2"));
+    refs = str_get_refs(str1);
+    test_ptr_success(str_split_init(&split, str1, ','));
+    test_false(split.ref);
+    test_true(test_str_split_check(&split, fields));
+    test_void(str_split_free(&split));
+    test_uint_eq(str_get_refs(str1), refs);
+}
+
+TEST_CASE_FIX(str_intern_dup, no_setup, str_unref)
+{
+    test_ptr_success(str1 = str_intern_l("intern-dup"));
+    test_ptr_success(str = str_dup(str1));
+    test_false(str_is_interned(str));
+    test_ptr_eq(str_bc(str), str_bc(str1));
+    test_ptr_success(str_append_c(str, "x"));
+    test_str_eq(str_c(str), "intern-dupx");
+    test_str_eq(str_c(str1), "intern-dup");
+}
+
+#define INTERN_KEYS     5000    ///< number of keys in intern tests
+#define INTERN_THREADS  4       ///< number of threads in intern thread test
+
+/// Intern INTERN_KEYS keys starting at an offset.
+///
+/// \param strs     interned strs, indexed by key
+/// \param offset   key to start with
+///
+/// \retval true    success
+/// \retval false   error
+static bool test_str_intern_keys(str_const_ct *strs, size_t offset)
+{
+    char key[32];
+    size_t k, n;
+
+    for(n = 0; n < INTERN_KEYS; n++)
+    {
+        k = (offset + n) % INTERN_KEYS;
+        snprintf(key, sizeof(key), "intern-key-%zu", k);
+
+        if(!(strs[k] = str_intern_c(key)) || str_cmp_c(strs[k], key))
+            return false;
+    }
+
+    return true;
+}
+
+TEST_CASE(str_intern_many)
+{
+    str_const_ct strs[2][INTERN_KEYS];
+    size_t count;
+
+    count = str_intern_count();
+    test_true(test_str_intern_keys(strs[0], 0));
+    test_uint_eq(str_intern_count(), count + INTERN_KEYS);
+    test_true(test_str_intern_keys(strs[1], INTERN_KEYS / 2));
+    test_uint_eq(str_intern_count(), count + INTERN_KEYS);
+    test_int_eq(memcmp(strs[0], strs[1], sizeof(strs[0])), 0);
+}
+
+/// intern thread state
+typedef struct test_str_intern_thread
+{
+    pthread_t thread;                   ///< thread
+    size_t offset;                      ///< key to start with
+    str_const_ct strs[INTERN_KEYS];     ///< interned strs, indexed by key
+    bool ok;                            ///< all keys interned
+} test_str_intern_thread_st;
+
+static void *test_str_intern_thread(void *ctx)
+{
+    test_str_intern_thread_st *state = ctx;
+
+    state->ok = test_str_intern_keys(state->strs, state->offset);
+
+    return NULL;
+}
+
+TEST_CASE(str_intern_threads)
+{
+    static test_str_intern_thread_st threads[INTERN_THREADS];
+    size_t t;
+
+    for(t = 0; t < INTERN_THREADS; t++)
+    {
+        threads[t].offset = t * INTERN_KEYS / INTERN_THREADS;
+        test_int_eq(pthread_create(&threads[t].thread, NULL, test_str_intern_thread, &threads[t]), 0);
+    }
+
+    for(t = 0; t < INTERN_THREADS; t++)
+        test_int_eq(pthread_join(threads[t].thread, NULL), 0);
+
+    for(t = 0; t < INTERN_THREADS; t++)
+    {
+        test_true(threads[t].ok);
+        test_int_eq(memcmp(threads[t].strs, threads[0].strs, sizeof(threads[0].strs)), 0);
+    }
+}
+
+TEST_CASE(str_intern_free)
+{
+    test_ptr_success(str_intern_l("intern-free"));
+    test_uint_gt(str_intern_count(), 0);
+    test_void(str_intern_free());
+    test_uint_eq(str_intern_count(), 0);
+    test_ptr_success(str1 = str_intern_l("intern-free"));
+    test_str_eq(str_c(str1), "intern-free");
+    test_uint_eq(str_intern_count(), 1);
+}
+
+#define BENCH_KEYS      100     ///< number of distinct keys in intern benchmark
+#define BENCH_ROUNDS    1000    ///< number of times each key is created
+
+/// Create each benchmark key BENCH_ROUNDS times.
+///
+/// \param keys     keys
+/// \param intern   intern keys instead of duplicating them
+/// \param[out] mem heap bytes allocated by duplicates
+///
+/// \returns        ns per key, -1 on error
+static double test_str_intern_bench_run(char keys[][32], bool intern, size_t *mem)
+{
+    size_t round, k;
+    clock_t start;
+    str_ct tmp;
+
+    start = clock();
+
+    for(round = 0, *mem = 0; round < BENCH_ROUNDS; round++)
+        for(k = 0; k < BENCH_KEYS; k++)
+        {
+            if(intern)
+            {
+                if(!str_intern_c(keys[k]))
+                    return -1;
+
+                continue;
+            }
+
+            if(!(tmp = str_dup_c(keys[k])))
+                return -1;
+
+            *mem += str_memsize(tmp);
+            str_unref(tmp);
+        }
+
+    return (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / (BENCH_ROUNDS * BENCH_KEYS);
+}
+
+TEST_CASE(str_intern_bench)
+{
+    char keys[BENCH_KEYS][32];
+    size_t k, count, mem;
+    double ns[2];
+
+    for(k = 0; k < BENCH_KEYS; k++)
+        snprintf(keys[k], sizeof(keys[k]), "X-Header-Name-%zu", k);
+
+    count = str_intern_count();
+    test_true((ns[0] = test_str_intern_bench_run(keys, true, &mem)) >= 0);
+    test_uint_eq(str_intern_count(), count + BENCH_KEYS);
+    test_true((ns[1] = test_str_intern_bench_run(keys, false, &mem)) >= 0);
+
+    test_msg_info("intern %.1f ns/key, str_dup_c %.1f ns/key, %zu bytes of duplicates",
+        ns[0], ns[1], mem);
+}
+
+int test_suite_gen_str_intern(void *param)
+{
+    return error_pass_int(test_run_cases(NULL,
+        test_case(str_intern_invalid_magic),
+        test_case(str_intern_invalid_cstr),
+        test_case(str_intern_invalid_data),
+        test_case(str_intern_equal),
+        test_case(str_intern_different),
+        test_case(str_intern_empty),
+        test_case(str_intern_heap),
+        test_case(str_intern_bin),
+        test_case(str_intern_const),
+        test_case(str_intern_immortal),
+        test_case(str_intern_split),
+        test_case(str_intern_dup),
+        test_case(str_intern_many),
+        test_case(str_intern_threads),
+        test_case(str_intern_free),
+        test_case(str_intern_bench),
+
+        NULL
+    ));
+}
+
 TEST_CASE_ABORT(str_substr_invalid_magic)
 {
     str_substr((str_ct)&not_a_str, 0, 0);
@@ -5700,6 +6859,10 @@ int test_suite_gen_str(void *param)
         test_suite(gen_str_insert),
         test_suite(gen_str_cat),
         test_suite(gen_str_remove_replace),
+        test_suite(gen_str_find),
+        test_suite(gen_str_split),
+        test_suite(gen_str_hash),
+        test_suite(gen_str_intern),
         test_suite(gen_str_sub),
         test_suite(gen_str_mod),
         test_suite(gen_str_cmp),